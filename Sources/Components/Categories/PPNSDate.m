@@ -8,29 +8,245 @@
 
 #import "PPNSDate.h"
 
+// Longest string the fixed-format parser reads, "yyyy-MM-ddTHH:mm:ss.fffffffff+HH:MM"
+#define PPNSDATE_MAXIMUM_LENGTH 35
+
+// Dates before the Gregorian reform are left to the formatters, which switch to the Julian calendar
+#define PPNSDATE_MINIMUM_YEAR 1583
+#define PPNSDATE_MAXIMUM_YEAR 9999
+
+/**
+ * Days since 1970-01-01 of a proleptic Gregorian date
+ */
+static int64_t PPNSDateDaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Proleptic Gregorian date of a number of days since 1970-01-01
+ */
+static void PPNSDateCivilFromDays(int64_t days, int64_t *year, int64_t *month, int64_t *day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthPrime = (5 * dayOfYear + 2) / 153;
+    *day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+    *month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+    *year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+static BOOL PPNSDateReadDigits(const unichar *characters, NSUInteger length, NSUInteger *position, NSUInteger count, int64_t *value) {
+    if(*position + count > length) {
+        return NO;
+    }
+    int64_t result = 0;
+    for(NSUInteger i = 0; i < count; i++) {
+        unichar c = characters[*position + i];
+        if(c < '0' || c > '9') {
+            return NO;
+        }
+        result = result * 10 + (c - '0');
+    }
+    *position += count;
+    *value = result;
+    return YES;
+}
+
+/**
+ * Parse yyyy-MM-dd'T'HH:mm:ss, optional fractional seconds, then Z or a +HH:MM, +HHMM or +HH offset.
+ * Returns NO for anything else so the caller can fall back to a formatter.
+ */
+static BOOL PPNSDateParseFixedFormat(NSString *dateString, NSTimeInterval *timeInterval) {
+    NSUInteger length = dateString.length;
+    if(length < 20 || length > PPNSDATE_MAXIMUM_LENGTH) {
+        return NO;
+    }
+    unichar characters[PPNSDATE_MAXIMUM_LENGTH];
+    [dateString getCharacters:characters range:NSMakeRange(0, length)];
+    
+    NSUInteger position = 0;
+    int64_t year, month, day, hour, minute, second;
+    if(!PPNSDateReadDigits(characters, length, &position, 4, &year) || characters[position++] != '-' ||
+       !PPNSDateReadDigits(characters, length, &position, 2, &month) || characters[position++] != '-' ||
+       !PPNSDateReadDigits(characters, length, &position, 2, &day) || characters[position++] != 'T' ||
+       !PPNSDateReadDigits(characters, length, &position, 2, &hour) || characters[position++] != ':' ||
+       !PPNSDateReadDigits(characters, length, &position, 2, &minute) || characters[position++] != ':' ||
+       !PPNSDateReadDigits(characters, length, &position, 2, &second)) {
+        return NO;
+    }
+    
+    static const int64_t daysInMonth[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if(year < PPNSDATE_MINIMUM_YEAR || month < 1 || month > 12 || day < 1 || day > daysInMonth[month - 1] || hour > 23 || minute > 59 || second > 59) {
+        return NO;
+    }
+    if(month == 2 && day == 29 && !((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+        return NO;
+    }
+    
+    double fraction = 0;
+    if(position < length && characters[position] == '.') {
+        position++;
+        int64_t fractionDigits = 0;
+        double scale = 1;
+        while(position < length && characters[position] >= '0' && characters[position] <= '9') {
+            fractionDigits = fractionDigits * 10 + (characters[position] - '0');
+            scale *= 10;
+            position++;
+        }
+        if(scale == 1) {
+            return NO;
+        }
+        fraction = fractionDigits / scale;
+    }
+    
+    if(position >= length) {
+        return NO;
+    }
+    int64_t offset = 0;
+    unichar designator = characters[position++];
+    if(designator == 'Z' || designator == 'z') {
+        offset = 0;
+    }
+    else if(designator == '+' || designator == '-') {
+        int64_t offsetHours, offsetMinutes = 0;
+        if(!PPNSDateReadDigits(characters, length, &position, 2, &offsetHours)) {
+            return NO;
+        }
+        if(position < length) {
+            if(characters[position] == ':') {
+                position++;
+            }
+            if(!PPNSDateReadDigits(characters, length, &position, 2, &offsetMinutes)) {
+                return NO;
+            }
+        }
+        if(offsetHours > 23 || offsetMinutes > 59) {
+            return NO;
+        }
+        offset = (offsetHours * 3600 + offsetMinutes * 60) * (designator == '-' ? -1 : 1);
+    }
+    else {
+        return NO;
+    }
+    if(position != length) {
+        return NO;
+    }
+    
+    int64_t seconds = PPNSDateDaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset;
+    *timeInterval = (NSTimeInterval)seconds + fraction;
+    return YES;
+}
+
 @implementation PPNSDate
 
+#pragma mark - Fallback formatters
+
+// Formatters are immutable once configured, and safe to share between threads
+
++ (NSDateFormatter *)apiFriendDateFormatter {
+    static NSDateFormatter *dateFormatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [[NSDateFormatter alloc] init];
+        [dateFormatter setLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"]];
+        dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZZZZZ";
+    });
+    return dateFormatter;
+}
+
++ (NSISO8601DateFormatter *)ISO8601DateFormatter {
+    static NSISO8601DateFormatter *dateFormatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [[NSISO8601DateFormatter alloc] init];
+    });
+    return dateFormatter;
+}
+
++ (NSDateFormatter *)fractionalSecondsDateFormatter {
+    static NSDateFormatter *dateFormatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [[NSDateFormatter alloc] init];
+        [dateFormatter setLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"]];
+        dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ";
+    });
+    return dateFormatter;
+}
+
+#pragma mark - Formatting
+
 + (NSString *)apiFriendStringFromDate:(NSDate *)date {
-    NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
-    NSLocale *enUSPOSIXLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
-    [dateFormatter setLocale:enUSPOSIXLocale];
-    dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZZZZZ";
-    return [dateFormatter stringFromDate:date];
+    if(!date) {
+        return nil;
+    }
+    
+    // Same output as the formatter: local time, whole seconds and a Z or +HH:MM offset
+    NSTimeZone *timeZone = [NSTimeZone defaultTimeZone];
+    NSInteger offset = [timeZone secondsFromGMTForDate:date];
+    NSTimeInterval timeInterval = floor(date.timeIntervalSince1970);
+    if(offset % 60 != 0 || !isfinite(timeInterval)) {
+        return [[PPNSDate apiFriendDateFormatter] stringFromDate:date];
+    }
+    
+    int64_t seconds = (int64_t)timeInterval + offset;
+    int64_t days = (seconds >= 0 ? seconds : seconds - 86399) / 86400;
+    int64_t secondOfDay = seconds - days * 86400;
+    int64_t year, month, day;
+    PPNSDateCivilFromDays(days, &year, &month, &day);
+    if(year < PPNSDATE_MINIMUM_YEAR || year > PPNSDATE_MAXIMUM_YEAR) {
+        return [[PPNSDate apiFriendDateFormatter] stringFromDate:date];
+    }
+    
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lld", (long long)year, (long long)month, (long long)day, (long long)(secondOfDay / 3600), (long long)(secondOfDay / 60 % 60), (long long)(secondOfDay % 60));
+    if(offset == 0) {
+        length += snprintf(buffer + length, sizeof(buffer) - length, "Z");
+    }
+    else {
+        NSInteger absoluteOffset = labs(offset);
+        length += snprintf(buffer + length, sizeof(buffer) - length, "%c%02ld:%02ld", offset < 0 ? '-' : '+', (long)(absoluteOffset / 3600), (long)(absoluteOffset / 60 % 60));
+    }
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
 }
 
-+ (NSDate *)parseDateTime:(NSString *)dateString {    
-    NSDate *date = [[[NSISO8601DateFormatter alloc] init] dateFromString:dateString];
+#pragma mark - Parsing
+
++ (NSDate *)parseDateTime:(NSString *)dateString {
+    if(!dateString) {
+        return nil;
+    }
+    
+    NSTimeInterval timeInterval;
+    if(PPNSDateParseFixedFormat(dateString, &timeInterval)) {
+        return [NSDate dateWithTimeIntervalSince1970:timeInterval];
+    }
+    
+    NSDate *date = [[PPNSDate ISO8601DateFormatter] dateFromString:dateString];
     if (date == nil) {
-        NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
-        NSLocale *enUSPOSIXLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
-        [dateFormatter setLocale:enUSPOSIXLocale];
-        dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ";
-        date = [dateFormatter dateFromString:dateString];
+        date = [[PPNSDate fractionalSecondsDateFormatter] dateFromString:dateString];
     }
     return date;
 }
 
 + (NSDate *)parseDateTime:(NSString *)dateString timeZone:(NSTimeZone *)timeZone {
+    if(!dateString) {
+        return nil;
+    }
+    
+    // A string with its own offset means the same instant in any time zone
+    NSTimeInterval timeInterval;
+    if(PPNSDateParseFixedFormat(dateString, &timeInterval)) {
+        return [NSDate dateWithTimeIntervalSince1970:timeInterval];
+    }
+    
     NSISO8601DateFormatter *formatter = [[NSISO8601DateFormatter alloc] init];
     [formatter setTimeZone:timeZone];
     NSDate *date = [formatter dateFromString:dateString];
@@ -565,6 +565,15 @@ typedef NS_OPTIONS(NSInteger, PPDeviceProxyReliabilityBufferType) {
     PPDeviceProxyReliabilityBufferTypeAlert
 };
 
+typedef NS_OPTIONS(NSInteger, PPDeviceProxyQueueRecordId) {
+    PPDeviceProxyQueueRecordIdNone = -1
+};
+
+typedef NS_ENUM(NSInteger, PPDeviceProxyTransport) {
+    PPDeviceProxyTransportLongPoll = 0,
+    PPDeviceProxyTransportWebSocket = 1
+};
+
 typedef NS_OPTIONS(NSInteger, PPDeviceProxyLocalProgress) {
     PPDeviceProxyLocalProgressNone                  = -1,
     PPDeviceProxyLocalProgressDefault               = 0,
@@ -629,7 +638,8 @@ typedef NS_OPTIONS(NSInteger, PPVideoTokenExpireTimeInterval) {
 typedef NS_OPTIONS(NSInteger, PPWebSocketResourceEndpoint) {
     PPWebSocketResourceEndpointCamera = 0,
     PPWebSocketResourceEndpointViewer = 1,
-    PPWebSocketResourceEndpointDefault = 2
+    PPWebSocketResourceEndpointDefault = 2,
+    PPWebSocketResourceEndpointDeviceIO = 3
 };
 
 /** Viewer status */
@@ -651,6 +661,7 @@ typedef NS_OPTIONS(NSInteger, PPWebSocketGoal) {
 
 /** Types */
 typedef NS_OPTIONS(NSInteger, PPWebSocketType) {
+    PPWebSocketTypeAny                      = 0, // Any type, when routing received messages
     PPWebSocketTypeNarratives               = 1, // Narratives
     PPWebSocketTypeOrganizationNarratives   = 2, // Organization Narratives
     PPWebSocketTypeLocationStates           = 3, // Location States
@@ -680,6 +691,10 @@ typedef NS_OPTIONS(NSInteger, PPWebSocketErrorCode) {
     PPWebSocketErrorCodeServiceTemporarilyUnavailable = 30,
 };
 
+#define WEBSOCKET_DEFAULT_BATCH_INTERVAL 0.1
+#define WEBSOCKET_DEFAULT_MAXIMUM_PENDING_MESSAGES 500
+#define WEBSOCKET_DEFAULT_RECONNECT_BASE_DELAY 1.0
+
 // MARK: Device Activation Info
 
 typedef NS_OPTIONS(NSInteger, PPDeviceActivationInfoPort) {
@@ -735,6 +750,11 @@ typedef NS_OPTIONS(NSInteger, PPDeviceMeasurementsHistoryRowCount) {
     PPDeviceMeasurementsHistoryRowCountMaximum = 1000
 };
 
+typedef NS_OPTIONS(NSInteger, PPDeviceMeasurementsMaxConcurrentRequests) {
+    PPDeviceMeasurementsMaxConcurrentRequestsNone = -1,
+    PPDeviceMeasurementsMaxConcurrentRequestsDefault = 4
+};
+
 typedef NS_OPTIONS(NSInteger, PPDeviceMeasurementsDataRequestByEmail) {
     PPDeviceMeasurementsDataRequestByEmailNone = -1,
     PPDeviceMeasurementsDataRequestByEmailFalse = 0,
@@ -3120,6 +3140,16 @@ typedef NS_OPTIONS(NSInteger, PPOrganizationObjectParent) {
 
 // MARK: - Networking
 
+/**
+ * Response processing lanes.
+ * Interactive is for UI-facing requests, Background for housekeeping and proxy traffic, Bulk for large payloads.
+ */
+typedef NS_ENUM(NSInteger, PPBaseModelResponseLane) {
+    PPBaseModelResponseLaneInteractive = 1,
+    PPBaseModelResponseLaneBackground = 2,
+    PPBaseModelResponseLaneBulk = 3
+};
+
 typedef NS_OPTIONS(NSInteger, PPCloudEngineType) {
     PPCloudEngineTypeDefault,
     PPCloudEngineTypeApp,
@@ -3202,6 +3232,14 @@ typedef NS_OPTIONS(NSInteger, PPVayyarContextId) {
 #define PROVIDEO_CACHE_REFRESH_TIME_SECONDS 60
 #define FILE_UPLOAD_ATTEMPT_LIMIT 1
 #define PROXY_DEFAULT_POST_FILE_RETRY_INTERVAL 20
+#define PROXY_DEFAULT_MEASUREMENT_COALESCING_INTERVAL 1.0
+#define PROXY_DEFAULT_MAXIMUM_MEASUREMENT_BATCH_SIZE 1
+#define PROXY_DEFAULT_FILE_FRAGMENTS_IN_FLIGHT 4
+#define PROXY_FILE_FRAGMENT_SIZE_UNIT 10240
+#define PROXY_DEFAULT_FILE_FRAGMENT_SIZE (PROXY_FILE_FRAGMENT_SIZE_UNIT * 25)
+#define PROXY_DEFAULT_MINIMUM_FILE_FRAGMENT_SIZE (PROXY_FILE_FRAGMENT_SIZE_UNIT * 5)
+#define PROXY_DEFAULT_MAXIMUM_FILE_FRAGMENT_SIZE (PROXY_FILE_FRAGMENT_SIZE_UNIT * 200)
+#define PROXY_DEFAULT_FILE_FRAGMENT_DURATION 2.0
 
 
 #define PPDeviceProxyRegisterFailed 100
@@ -3599,6 +3637,38 @@ typedef NS_OPTIONS(NSInteger, PPVayyarContextId) {
 #define HTTP_HEADER_CONTENT_DISPOSITION @"Content-Disposition"
 #define HTTP_HEADER_CONTENT_LENGTH @"Content-Length"
 
+// MARK: Retry Policy
+
+typedef NS_ENUM(NSInteger, PPRetryPolicyCircuitState) {
+    PPRetryPolicyCircuitStateClosed = 0,
+    PPRetryPolicyCircuitStateOpen = 1,
+    PPRetryPolicyCircuitStateHalfOpen = 2
+};
+
+typedef NS_ENUM(NSInteger, PPRetryPolicyEvent) {
+    PPRetryPolicyEventRetry = 0,
+    PPRetryPolicyEventRetryDenied = 1,
+    PPRetryPolicyEventCircuitOpened = 2,
+    PPRetryPolicyEventCircuitClosed = 3
+};
+
+#define RETRY_POLICY_NO_RETRY -1
+#define RETRY_POLICY_DEFAULT_BASE_DELAY 1.0
+#define RETRY_POLICY_DEFAULT_MAXIMUM_DELAY 300.0
+#define RETRY_POLICY_DEFAULT_FAILURE_THRESHOLD 5
+#define RETRY_POLICY_DEFAULT_OPEN_INTERVAL 30.0
+#define RETRY_POLICY_DEFAULT_PROBE_INTERVAL 60.0
+#define RETRY_POLICY_DEFAULT_BUDGET_RATIO 0.1
+#define RETRY_POLICY_DEFAULT_MAXIMUM_BUDGET 10.0
+
+// MARK: HTTP Metrics
+
+#define HTTP_METRICS_MAXIMUM_ROUTES 256
+
+// MARK: Model Store
+
+#define MODEL_STORE_DEFAULT_FLUSH_INTERVAL 0.5
+
 
 // MARK: -
 // MARK: - Blocks -
@@ -3615,6 +3685,19 @@ typedef void (^PPNSArrayBlock)(NSArray * _Nullable a);
 typedef void (^PPNSDictionaryBlock)(NSDictionary * _Nullable a);
 typedef void (^PPFileBlock)(PPFile * _Nullable f);
 
+// MARK: - Base Model
+
+typedef void (^PPBaseModelJSONElementBlock)(id _Nonnull element);
+
+// MARK: - Retry Policy
+
+typedef void (^PPRetryPolicyEventBlock)(PPRetryPolicyEvent event, NSString * _Nonnull host, NSTimeInterval delay);
+
+// MARK: - Websocket
+
+typedef void (^PPWebSocketMessagesBlock)(NSArray<NSDictionary *> * _Nonnull messages);
+typedef id _Nullable (^PPWebSocketCoalescingKeyBlock)(NSDictionary * _Nonnull message);
+
 // MARK: - Cloud Connectivity
 
 @class PPCloudConnectivityCloud;
@@ -3685,6 +3768,8 @@ typedef void (^PPUserAccountsBlock)(PPUser * _Nullable user, NSError * _Nullable
 typedef void (^PPDeviceMeasurementsBlock)(NSArray * _Nullable measurements, NSError * _Nullable error);
 typedef void (^PPDeviceMeasurementsCommandsBlock)(NSArray * _Nullable commands, NSError * _Nullable error);
 typedef void (^PPDeviceMeasurementsReadingsBlock)(NSArray * _Nullable readings, NSError * _Nullable error);
+typedef void (^PPDeviceMeasurementsDeviceBlock)(NSString * _Nonnull deviceId, NSArray * _Nullable measurements, NSError * _Nullable error);
+typedef void (^PPDeviceMeasurementsBatchBlock)(NSDictionary * _Nonnull measurements, NSDictionary * _Nonnull errors);
 typedef void (^PPDeviceMeasurementsAlertsBlock)(NSArray * _Nullable alerts, NSError * _Nullable error);
 typedef void (^PPDeviceMeasurementsUnitsBlock)(NSArray * _Nullable units, NSError * _Nullable error);
 
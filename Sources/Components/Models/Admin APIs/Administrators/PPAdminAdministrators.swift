@@ -25,8 +25,8 @@ import Foundation
      */
     @objc public class func getRoles(_ callback: @escaping (([Any]?, Error?) -> (Void))) {
         let components = NSURLComponents(string: "roles")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.administrators.getRoles()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -43,7 +43,7 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(roles, err)
@@ -70,8 +70,8 @@ import Foundation
         assert(userId != .none, "\(#function) missing userId")
         assert(roleId != -1, "\(#function) missing roleId")
         let components = NSURLComponents(string: "users/\(userId.rawValue)/roles/\(roleId)")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.administrators.grantAdministrativeRoles()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().put(components?.string) { responseData in
             queue.async {
@@ -83,14 +83,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             queue.async {
                 callback(error)
             }
@@ -106,8 +106,8 @@ import Foundation
                                                       callback: @escaping ((Error?) -> (Void))) {
         assert(userId != .none, "\(#function) missing userId")
         let components = NSURLComponents(string: "users/\(userId.rawValue)/roles")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.administrators.revokeAdministrativeRoles()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -119,14 +119,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             queue.async {
                 callback(error)
             }
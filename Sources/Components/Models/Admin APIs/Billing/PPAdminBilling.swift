@@ -22,8 +22,7 @@ import Foundation
     @objc public class func generateBill(_ organizationId: PPOrganizationId,
                                          date: Date?,
                                          callback: @escaping ((String?, Dictionary<String, Any>?, Dictionary<String, Any>?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.billing.generateBill()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, nil, nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -36,8 +35,7 @@ import Foundation
                                     startDate: Date,
                                     endDate: Date?,
                                     callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.billing.getBills()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -48,8 +46,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func removeBillingBot(_ organizationId: PPOrganizationId,
                                              callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.billing.removeBillingBot()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 }
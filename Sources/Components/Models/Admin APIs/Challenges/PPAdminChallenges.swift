@@ -43,8 +43,7 @@ import Foundation
                                              parentId: NSNumber?,
                                              challenge: Dictionary<String, Any>,
                                              callback: @escaping ((NSNumber?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -61,8 +60,7 @@ import Foundation
                                              searchBy: String?,
                                              parentId: NSNumber?,
                                              callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -77,8 +75,7 @@ import Foundation
                                              challengeId: Int,
                                              challenge: Dictionary<String, Any>,
                                              callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -89,8 +86,7 @@ import Foundation
     @objc public class func deleteAChallenge(_ organizationId: PPOrganizationId,
                                              challengeId: Int,
                                              callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -104,8 +100,7 @@ import Foundation
                                                   challengeId: Int,
                                                   status: Int,
                                                   callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -126,8 +121,7 @@ import Foundation
                                             status: NSNumber?,
                                             locationId: PPLocationId,
                                             callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -141,8 +135,7 @@ import Foundation
                                          status: Int,
                                          locationId: PPLocationId,
                                          callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -157,8 +150,7 @@ import Foundation
                                            challengeId: Int,
                                            locationId: PPLocationId,
                                            callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 }
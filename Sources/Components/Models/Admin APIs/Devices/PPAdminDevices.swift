@@ -86,8 +86,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getUsers()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -110,14 +110,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models?.0, models?.1, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
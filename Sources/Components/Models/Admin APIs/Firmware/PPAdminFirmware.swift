@@ -26,8 +26,7 @@ import Foundation
                                                   index: String?,
                                                   data: Data,
                                                   callback: @escaping ((NSNumber?, Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.uploadFirmwareVersion()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
        callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -38,8 +37,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func getFirmwareVersions(_ deviceType: PPDeviceTypeId,
                                                 callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getFirmwareVersions()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
        callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -50,8 +48,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func deleteFirmwareVersions(_ versionId: Int,
                                                    callback: @escaping ((Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteFirmwareVersions()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
        callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -65,8 +62,7 @@ import Foundation
                                             forced: NSNumber?,
                                             groupId: PPOrganizationGroupId,
                                             callback: @escaping ((PPDeviceFirmwareUpdateJobId, Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.createUpdateJob()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(.none, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -78,8 +74,7 @@ import Foundation
     @objc public class func getUpdateJobs(_ deviceType: PPDeviceTypeId,
                                             groupId: PPOrganizationGroupId,
                                             callback: @escaping (([PPDeviceFirmwareUpdateJob]?, Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getUpdateJobs()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -90,8 +85,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func deleteUpdateJob(_ jobId: PPDeviceFirmwareUpdateJobId,
                                             callback: @escaping ((Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteUpdateJob()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -104,8 +98,7 @@ import Foundation
     @objc public class func updateFirmwareGroupForDevice(_ deviceId: String,
                                                          groupId: PPOrganizationGroupId,
                                                          callback: @escaping ((Error?) -> (Void))) {
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.updateFirmwareGroupForDevice()")
-       PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+       PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 }
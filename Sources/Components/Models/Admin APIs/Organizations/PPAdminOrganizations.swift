@@ -68,8 +68,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.getOrganizations()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -87,14 +87,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -174,9 +174,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.createAnOrganization()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -192,14 +192,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_organizationId, _error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(.none, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -276,9 +276,9 @@ import Foundation
             return
         }
       
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.updateOrganization()")
+        let queue = PPBaseModel.responseQueue(.interactive)
       
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
       
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -290,14 +290,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -310,8 +310,8 @@ import Foundation
     @objc public class func deleteOrganization(_ organizationId: PPOrganizationId,
                                                callback: @escaping ((Error?) -> (Void))) {
         let components = NSURLComponents(string: "organizations")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.deleteOrganization()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -323,14 +323,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -380,13 +380,13 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.uploadLargeObject()")
+        let queue = PPBaseModel.responseQueue(.bulk)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { progress in
             
-            PPLogAPIs(#file, message: "> \(queue.label) \(String(describing: progress))")
+            PPLogAPIs(#file, message: "> \(#function) \(String(describing: progress))")
             DispatchQueue.main.async {
                 if let progressBlock = progressBlock {
                     progressBlock(progress)
@@ -402,14 +402,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -443,9 +443,9 @@ import Foundation
             callback(nil, PPBaseModel.resultCode(toNSError: 14, originatingClass: NSStringFromClass(self), argument: "\(error.localizedDescription)"))
             return
         }
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.getObjectContent()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         cloudEngine.operationWithRequest(includingResponse: request as URLRequest?) { responseData, response in
             queue.async {
@@ -464,14 +464,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(responseData, _error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -489,9 +489,9 @@ import Foundation
         assert(objectName.addingPercentEncoding(withAllowedCharacters: .urlPathAllowed) != nil)
         let components = NSURLComponents(string: "organizations/\(organizationId.rawValue)/objects/\(objectName.addingPercentEncoding(withAllowedCharacters: .urlPathAllowed)!)")
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.deleteObject()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -503,14 +503,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -527,8 +527,8 @@ import Foundation
                                                      callback: @escaping (([PPOrganizationObject]?, Error?) -> (Void))) {
         assert(organizationId != .none)
         let components = NSURLComponents(string: "organizations/\(organizationId.rawValue)/objects")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.listObjectsAndProperties()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -546,14 +546,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -597,9 +597,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.setProperties()")
+        let queue = PPBaseModel.responseQueue(.interactive)
       
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
       
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -611,14 +611,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -634,8 +634,8 @@ import Foundation
                                               callback: @escaping (([PPUser]?, Error?) -> (Void))) {
         assert(organizationId != .none)
         let components = NSURLComponents(string: "organizations/\(organizationId.rawValue)/admins")
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.getAdministrators()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -653,14 +653,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -687,9 +687,9 @@ import Foundation
         }
         components?.queryItems = queryItems
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.addAnAdministrator()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().put(components?.string) { responseData in
             queue.async {
@@ -701,14 +701,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -725,9 +725,9 @@ import Foundation
         assert(userId != .none)
         let components = NSURLComponents(string: "organizations/\(organizationId.rawValue)/admins/\(userId.rawValue)")
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.removeAdministrator()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -739,14 +739,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -800,9 +800,9 @@ import Foundation
         }
         components?.queryItems = queryItems
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.organizations.getOrganizationTotals()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -816,14 +816,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(totals, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -114,8 +114,7 @@ import Foundation
     @objc public class func setCollection(_ organizationId: PPOrganizationId,
                                           collectionId: NSNumber?,
                                           callback: @escaping ((NSNumber?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.setCollection()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -126,8 +125,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func getCollections(_ organizationId: PPOrganizationId,
                                            callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.getCollections()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -142,8 +140,7 @@ import Foundation
                                          collectionId: NSNumber?,
                                          question: PPQuestion,
                                          callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.askAQuestion()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -157,8 +154,7 @@ import Foundation
                                          questionId: PPQuestionId,
                                          userId: PPUserId,
                                          callback: @escaping (([PPQuestion]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.getQuestions()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -170,8 +166,7 @@ import Foundation
     @objc public class func updateAQuestion(_ organizationId: PPOrganizationId,
                                             question: PPQuestion,
                                             callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.updateAQuestion()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -183,8 +178,7 @@ import Foundation
     @objc public class func deleteAQuestion(_ organizationId: PPOrganizationId,
                                             questionId: PPQuestionId,
                                             callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.deleteAQuestion()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -198,8 +192,7 @@ import Foundation
                                          questionId: PPQuestionId,
                                          userId: PPUserId,
                                          callback: @escaping ((NSNumber?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.updateAnswer()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -215,8 +208,7 @@ import Foundation
                                                     questionId: PPQuestionId,
                                                     order: NSNumber?,
                                                     callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.addQuestionToCollection()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -229,8 +221,7 @@ import Foundation
                                                          collectionId: Int,
                                                          questionId: PPQuestionId,
                                                          callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.questions.deleteQuestionFromCollection()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
     
@@ -31,8 +31,7 @@ import Foundation
     @available(*, deprecated, message: "Not available")
     @objc public class func getGroups(_ organizationId: PPOrganizationId,
                                       callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.reports.getGroups()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
     
@@ -44,8 +43,7 @@ import Foundation
                                                        groupId: NSNumber?,
                                                        status: Int,
                                                        callback: @escaping ((Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.reports.putGroupOrganizationStatus()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -84,8 +82,7 @@ import Foundation
                                        reportGroupId: NSNumber?,
                                        analytic: NSNumber?,
                                        callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.reports.getReports()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -103,8 +100,7 @@ import Foundation
                                             deliveryType: Int,
                                             organizationId: PPOrganizationId,
                                             callback: @escaping ((String?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.reports.generateReports()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 
@@ -123,8 +119,7 @@ import Foundation
                                                    endDate: Date,
                                                    organizationId: PPOrganizationId,
                                                    callback: @escaping (([Dictionary<String, Any>]?, Error?) -> (Void))) {
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.reports.getReportExecutionData()")
-        PPLogAPIs(#file, message: "! \(queue.label) [NOT IMPLEMENTED]")
+        PPLogAPIs(#file, message: "! \(#function) [NOT IMPLEMENTED]")
         callback(nil, PPBaseModel.resultCode(toNSError: 29))
     }
 }
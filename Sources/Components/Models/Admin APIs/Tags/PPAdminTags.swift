@@ -41,8 +41,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.tags.popularTags()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -59,14 +59,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -118,9 +118,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.tags.applyTags()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -132,14 +132,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -171,8 +171,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.tags.deleteTags()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -184,14 +184,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
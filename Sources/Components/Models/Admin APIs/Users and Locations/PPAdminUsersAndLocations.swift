@@ -67,8 +67,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getUsers()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -86,14 +86,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -181,8 +181,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getLocations()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -200,14 +200,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -340,9 +340,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.createLocation()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -354,14 +354,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -485,9 +485,9 @@ import Foundation
             return
         }
             
-            let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.editLocation()")
+            let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -499,14 +499,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -528,9 +528,9 @@ import Foundation
 
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteLocation()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -542,14 +542,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -599,9 +599,9 @@ import Foundation
             return
         }
         
-       let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.addOrUpdateOrRemoveLocations()")
+       let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -613,14 +613,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -702,8 +702,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getOrganizationNarratives()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -723,14 +723,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, nextMarker, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -788,9 +788,9 @@ import Foundation
             return
         }
             
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.postInvitiation()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -802,14 +802,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -863,9 +863,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.createAGroup()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -877,14 +877,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -923,8 +923,8 @@ import Foundation
         }
         components?.queryItems = queryItems;
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.getGroups()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().get(components?.string) { responseData in
             queue.async {
@@ -942,14 +942,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(models, err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(nil, PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -998,9 +998,9 @@ import Foundation
             return
         }
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.updateAGroup()")
+        let queue = PPBaseModel.responseQueue(.interactive)
         
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().operation(with: request as URLRequest?) { responseData in
             queue.async {
@@ -1012,14 +1012,14 @@ import Foundation
                     _error = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(_error)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
@@ -1036,8 +1036,8 @@ import Foundation
         assert(groupId != .none)
         let components = NSURLComponents(string: "organizations/\(organizationId.rawValue)/groups/\(groupId.rawValue)")
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.admin.usersandlocations.deleteAGroup()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         
         PPCloudEngine.sharedAdmin().delete(components?.string) { responseData in
             queue.async {
@@ -1049,14 +1049,14 @@ import Foundation
                     err = error
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(err)
                 }
             }
         } failure: { error in
-            PPLogAPIs(#file, message: "< \(queue.label)")
+            PPLogAPIs(#file, message: "< \(#function)")
             DispatchQueue.main.async {
                 callback(PPBaseModel.resultCode(toNSError: 10003, originatingClass: NSStringFromClass(self), argument: error == nil ? nil : "Error domain: \((error! as NSError).domain), code: \((error! as NSError).code), userInfo: \((error! as NSError).userInfo)"))
             }
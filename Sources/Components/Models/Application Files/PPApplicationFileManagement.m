@@ -228,15 +228,15 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
 
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
     [request setHTTPBody:data];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.applicationfilemanagement.uploadFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request progressBlock:^(NSProgress *progress) {
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"> %s %@", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL), progress);
+            PPLogAPI(@"> %s %@", __PRETTY_FUNCTION__, progress);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if(progressBlock) {
@@ -259,7 +259,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
                     fileId = (PPApplicationFileId)((NSString *)[root objectForKey:@"fileId"]).integerValue;
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(fileId, error);
@@ -269,7 +269,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPApplicationFileIdNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -321,9 +321,9 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
     else {
         cloudEngine = [[PPCloudEngine alloc] initSingleton:PPCloudEngineTypeApp];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.applicationfilemanagement.getFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [cloudEngine GET:requestString success:^(NSData *responseData) {
         
@@ -353,7 +353,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
                     }
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(files, tempKey, tempKeyExpire, error);
@@ -363,7 +363,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -396,9 +396,9 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
     if(expiration != PPFileURLExpirationNone) {
         [requestString appendFormat:@"expiration=%@&", (expiration) ? @"true" : @"false"];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.applicationfilemanagement.getDownloadURL()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -419,7 +419,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(contentUrl, thumbnailUrl, error);
@@ -429,7 +429,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -488,9 +488,9 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
     if(range.location != 0 && range.length != 0) {
         [request setValue:[NSString stringWithFormat:@"bytes=%li-%li", (long)range.location, (long)range.length] forHTTPHeaderField:HTTP_HEADER_RANGE];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.applicationfilemanagement.downloadFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [cloudEngine operationWithRequestIncludingResponse:request success:^(NSData *responseData, NSObject *response) {
         
@@ -517,7 +517,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
                 contentDisposition = [responseHeaders objectForKey:@"Content-Disposition"];
             }
 
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(responseData, contentType, contentRange, acceptRanges, contentDisposition, statusCode, error);
@@ -527,7 +527,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, nil, nil, -1, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -554,9 +554,9 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.applicationfilemanagement.deleteFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
@@ -564,7 +564,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -574,7 +574,7 @@ __strong static NSMutableDictionary*_sharedApplicationFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
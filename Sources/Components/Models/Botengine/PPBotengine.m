@@ -52,10 +52,10 @@
     if(organizationId != PPOrganizationIdNone) {
         [request appendFormat:@"organizationId=%li&", (long)organizationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.searchAppStore()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
 
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -73,7 +73,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(composerApps, error);
@@ -83,7 +83,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, error);
@@ -109,16 +109,16 @@
     
     [request appendFormat:@"%@?", name];
     [request appendFormat:@"bundle=%@", bundle];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.getAppObject()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             UIImage *image = [[UIImage alloc] initWithData:responseData];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(image, nil);
@@ -128,7 +128,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, error);
@@ -160,9 +160,9 @@
     if(organizationId != PPOrganizationIdNone) {
         [request appendFormat:@"organizationId=%li&", (long)organizationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.getAppInformation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -179,7 +179,7 @@
                 composerApp.bundle = bundle;
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(composerApp, error);
@@ -189,7 +189,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, error);
@@ -225,9 +225,9 @@
         [request appendFormat:@"circleId=%li&", (long)circleId];
     }
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.purchaseAppInstance()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppStrippedEngine] POST:request success:^(NSData *responseData) {
         
@@ -242,7 +242,7 @@
                 instanceId = ((NSString *)[root objectForKey:@"appInstanceId"]).intValue;
             }
 
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(instanceId, error);
@@ -252,7 +252,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPBotengineAppInstanceIdNone, error);
@@ -343,16 +343,16 @@
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppStrippedEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:urlString relativeToURL:[[PPCloudEngine sharedAppStrippedEngine] getBaseURL]].absoluteString parameters:nil error:&error];
 
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.configureAppInstance()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -362,7 +362,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -406,9 +406,9 @@
     if(userId != PPUserIdNone) {
         [request appendFormat:@"userId=%li&", (long)userId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.getAppInstances()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -426,7 +426,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(appInstances, error);
@@ -436,7 +436,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, error);
@@ -457,16 +457,16 @@
  */
 + (void)deleteAppInstances:(NSInteger)appInstanceId callback:(PPErrorBlock)callback {
     NSString *request = [NSString stringWithFormat:@"appstore/appInstance?appInstanceId=%lu", (long unsigned)appInstanceId];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.deleteAppInstances()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] DELETE:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -476,7 +476,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -507,9 +507,9 @@
     if(lang) {
         [request appendFormat:@"lang=%@&", lang];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.getAppReviews()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -530,7 +530,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(rating, reviews, error);
@@ -540,7 +540,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, error);
@@ -602,16 +602,16 @@
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppStrippedEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:urlString relativeToURL:[[PPCloudEngine sharedAppStrippedEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.writeAppReview()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -621,7 +621,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -643,16 +643,16 @@
     NSMutableString *request = [NSMutableString stringWithString:@"appstore/reviews/"];
     [request appendFormat:@"%lu/", (long unsigned)reviewId];
     [request appendFormat:@"vote/%li", (long)vote];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.voteForReview()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] PUT:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -662,7 +662,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -718,16 +718,16 @@
     
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppStrippedEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:urlString relativeToURL:[[PPCloudEngine sharedAppStrippedEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.postDataStream()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -737,7 +737,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -766,9 +766,9 @@
         [request appendFormat:@"organizationId=%li&", (long)organizationId];
     }
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.botengine.getSummary()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppStrippedEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -784,7 +784,7 @@
                 microServices = [root objectForKey:@"microServices"];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(dataStreams, microServices, error);
@@ -794,7 +794,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, error);
@@ -318,9 +318,9 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.createCircle()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -336,7 +336,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(circleId, error);
@@ -346,7 +346,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPCircleIdNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -371,9 +371,9 @@
             [requestString appendFormat:@"circleId=%@&", circleId];
         }
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.getCircles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -391,7 +391,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(circles, error);
@@ -401,7 +401,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -440,9 +440,9 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.modifyCircle()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -450,7 +450,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -459,7 +459,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -478,9 +478,9 @@
 + (void)deleteCircle:(PPCircleId)circleId callback:(PPErrorBlock)callback {
     NSAssert1(circleId != PPCountryIdNone, @"%s missing circleId", __FUNCTION__);
     NSMutableString *requestString = [[NSMutableString alloc] initWithFormat:@"circles?circleId=%li&", (long)circleId];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.deleteCircle()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -488,7 +488,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -497,7 +497,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -564,9 +564,9 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.addMembers()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -574,7 +574,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -583,7 +583,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -662,9 +662,9 @@
         [request setValue:circleKey forHTTPHeaderField:HTTP_HEADER_CIRCLE_KEY];
     }
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.updateMemberStatus()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -672,7 +672,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -681,7 +681,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -713,9 +713,9 @@
     if(circleUserId != nil) {
         [requestString appendFormat:@"circleUserId=%@&", circleUserId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.removeMembers*(", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -723,7 +723,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -732,7 +732,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -793,14 +793,14 @@
     
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
     [request setHTTPBody:data];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.uploadFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request progressBlock:^(NSProgress *progress) {
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"> %s %@", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL), progress);
+            PPLogAPI(@"> %s %@", __PRETTY_FUNCTION__, progress);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if(progressBlock) {
@@ -834,7 +834,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(fileId, thumbnail, monthlyDataIn, monthlyDataMax, error);
@@ -844,7 +844,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPFileIdNone, PPFileThumbnailNone, PPCircleDataNone, PPCircleDataNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -887,9 +887,9 @@
     if(endDate) {
         [requestString appendFormat:@"endDate=%@&", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:[PPNSDate apiFriendStringFromDate:endDate]]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.getFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -929,7 +929,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(files, tempKey, tempKeyExpire, monthlyDataIn, monthlyDataMax, error);
@@ -939,7 +939,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, PPCircleDataNone, PPCircleDataNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -985,14 +985,14 @@
     
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
     [request setHTTPBody:data];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cirlces.uploadFileFragment()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request progressBlock:^(NSProgress *progress) {
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"> %s %@", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL), progress);
+            PPLogAPI(@"> %s %@", __PRETTY_FUNCTION__, progress);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if(progressBlock) {
@@ -1013,7 +1013,7 @@
                 thumbnail = (PPFileThumbnail)((NSString *)[root objectForKey:@"thumbnail"]).integerValue;
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(thumbnail, error);
@@ -1023,7 +1023,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPFileThumbnailNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1085,9 +1085,9 @@
     if(range.location != 0 && range.length != 0) {
         [request setValue:[NSString stringWithFormat:@"bytes=%li-%li", (long)range.location, (long)range.length] forHTTPHeaderField:HTTP_HEADER_RANGE];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.downloadFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequestIncludingResponse:request success:^(NSData *responseData, NSObject *response) {
         
         dispatch_async(queue, ^{
@@ -1111,7 +1111,7 @@
                 contentDisposition = [responseHeaders objectForKey:HTTP_HEADER_CONTENT_DISPOSITION];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(responseData, contentType, contentRange, acceptRanges, contentDisposition, statusCode, error);
@@ -1121,7 +1121,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, nil, nil, -1, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1158,9 +1158,9 @@
     if(expiration != PPFileURLExpirationNone) {
         [requestString appendFormat:@"expiration=%@&", (expiration) ? @"true" : @"false"];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.getDownloadURL()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1186,7 +1186,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(contentUrl, thumbnailUrl, m3u8Url, error);
@@ -1196,7 +1196,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1219,9 +1219,9 @@
     NSAssert1(circleId != PPCountryIdNone, @"%s missing circleId", __FUNCTION__);
     NSAssert1(fileId != PPFileIdNone, @"%s missing fileId", __FUNCTION__);
     NSMutableString *requestString = [[NSMutableString alloc] initWithFormat:@"circles/%li/files/%li?", (long)circleId, (long)fileId];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.deleteFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1229,7 +1229,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1238,7 +1238,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -1285,9 +1285,9 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.makePost()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1303,7 +1303,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(postId, error);
@@ -1313,7 +1313,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPCirclePostIdNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -1359,9 +1359,9 @@
     if(searchText) {
         [requestString appendFormat:@"searchText=%@&", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:searchText]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.getPosts()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1379,7 +1379,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(posts, error);
@@ -1389,7 +1389,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -1418,9 +1418,9 @@
     NSAssert1(circleId != PPCountryIdNone, @"%s missing circleId", __FUNCTION__);
     NSAssert1(postId != PPCirclePostIdNone, @"%s missing postId", __FUNCTION__);
     NSMutableString *requestString = [[NSMutableString alloc] initWithFormat:@"circles/%li/posts?postId=%li", (long)circleId, (long)postId];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.deletePost()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1428,7 +1428,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1437,7 +1437,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -1461,9 +1461,9 @@
     NSAssert1(postId != PPCirclePostIdNone, @"%s missing postId", __FUNCTION__);
     NSAssert1(type != PPCircleReactionTypeNone, @"%s missing type", __FUNCTION__);
     NSMutableString *requestString = [[NSMutableString alloc] initWithFormat:@"circles/%li/posts/%li/reactions/%li", (long)circleId, (long)postId, (long)type];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.react()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] PUT:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1471,7 +1471,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1480,7 +1480,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -1501,9 +1501,9 @@
 + (void)getDevices:(PPCircleId)circleId callback:(PPCircleDevicesBlock)callback {
     NSAssert1(circleId != PPCountryIdNone, @"%s missing circleId", __FUNCTION__);
     NSMutableString *requestString = [[NSMutableString alloc] initWithFormat:@"circles/%li/devices?", (long)circleId];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.circles.getDevices()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -1537,7 +1537,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(devices, error);
@@ -1547,7 +1547,7 @@
             
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -34,9 +34,9 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
 + (void)checkAvailability:(PPCloudConnectivityAvailabilityBlock)callback {
     NSURLComponents *components = [NSURLComponents componentsWithString:@"watch"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloud.checkAvailability()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedDefaultEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -45,7 +45,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
             NSString *status = [[NSString alloc] initWithData:responseData encoding:NSUTF8StringEncoding];
 
             PPLogAPI(@"%@", [PPCurlDebug responseToDescription:@{@"status":status}]);
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(status, nil);
@@ -55,7 +55,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -94,9 +94,9 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
 
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloud.getConnectionSettings()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -115,7 +115,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(clouds, error);
@@ -125,7 +125,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -174,9 +174,9 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloud.getServer()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -193,7 +193,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(server, error);
@@ -203,7 +203,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -253,9 +253,9 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloud.getServerURL()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
 
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -267,7 +267,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
             
             NSURL *url = [NSURL URLWithString:urlString];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(url, nil);
@@ -277,7 +277,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -302,9 +302,9 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
     components.queryItems = @[[[NSURLQueryItem alloc] initWithName:@"deviceId" value:deviceId]];
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloud.getCloudInstances()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -319,7 +319,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
                 cloud = [PPCloudConnectivityCloud initWithDictionary:root];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(cloud, error);
@@ -329,7 +329,7 @@ static NSTimeInterval kSystemEndTimeInterval   = 5000000000; // 2128-06-11T08:53
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
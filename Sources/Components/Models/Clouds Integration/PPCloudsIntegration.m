@@ -85,9 +85,9 @@
  **/
 + (void)getThirdPartyClouds:(PPCloudsIntegrationCloudsCallback)callback {
     NSMutableString *requestString = [[NSMutableString alloc] initWithString:@"authorize?"];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloudsintegration.getThirdPartyClouds()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -105,7 +105,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(applications, error);
@@ -115,7 +115,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -185,9 +185,9 @@
     if(userId != PPUserIdNone) {
         [requestString appendFormat:@"userId=%li&", (long)userId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloudsintegration.revokeAccessToThirdyPartyCloud()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -195,7 +195,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -204,7 +204,7 @@
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -359,9 +359,9 @@
         
         [request setHTTPBody:[dataString dataUsingEncoding:NSUTF8StringEncoding]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloudsintegration.getAccessToken()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedDefaultEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -394,7 +394,7 @@
                         [errorInfo setObject:@"server_error: Internal server error" forKey:NSLocalizedDescriptionKey];
                     }
                     error = [NSError errorWithDomain:@"com.ppc.oauth" code:-1 userInfo:errorInfo];
-                    PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+                    PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
                     
                     dispatch_async(dispatch_get_main_queue(), ^{
                         callback(nil, [PPBaseModel resultCodeToNSError:-1 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -405,7 +405,7 @@
                 token = [PPCloudsIntegrationHostAccessToken initWithDictionary:[root objectForKey:@"root"]];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(token, error);
@@ -415,7 +415,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -453,16 +453,16 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloudsintegration.updateOauthClien()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedDefaultEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -472,7 +472,7 @@
         
         dispatch_async(queue, ^{
         
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -499,9 +499,9 @@
     if(userId != PPUserIdNone) {
         [requestString appendFormat:@"user_id=%li&", (long)userId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.cloudsintegration.revokeOAuthClien()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -509,7 +509,7 @@
             NSError *error;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -519,7 +519,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
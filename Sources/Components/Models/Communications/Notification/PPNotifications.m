@@ -8,6 +8,7 @@
 
 #import "PPNotifications.h"
 #import "PPCloudEngine.h"
+#import "PPModelStore.h"
 
 @implementation PPNotifications
 
@@ -15,62 +16,74 @@
 
 #pragma mark - Notification Subscriptions
 
-__strong static NSMutableDictionary*_sharedSubscriptions = nil;
+/**
+ * Subscriptions are kept one record per subscription, so a change only rewrites that subscription
+ */
++ (PPModelStore *)subscriptionsStore {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [PPNotifications migrateArchivedDefaultsKey:@"user.notificationSubscriptions" toStore:[PPModelStore sharedStoreNamed:@"notificationSubscriptions"] recordKey:^NSString *(PPNotificationSubscription *subscription) {
+            return [PPNotifications recordKeyForSubscription:subscription];
+        }];
+    });
+    return [PPModelStore sharedStoreNamed:@"notificationSubscriptions"];
+}
+
++ (NSString *)recordKeyForSubscription:(PPNotificationSubscription *)subscription {
+    if(subscription.type != PPNotificationSubscriptionTypeNone) {
+        return [NSString stringWithFormat:@"type.%li", (long)subscription.type];
+    }
+    return [NSString stringWithFormat:@"name.%@", subscription.name];
+}
 
 /**
- * Shared subscriptions across the entire application
+ * Move a cache that was archived as a whole into NSUserDefaults, user ID -> object or array of objects, into a store
  */
-+ (NSArray *)sharedSubscriptionsForUser:(PPUserId)userId {
-#ifdef DEBUG
-#ifdef DEBUG_MODELS
-    NSLog(@"> %s", __PRETTY_FUNCTION__);
-#endif
-#endif
-    if(!_sharedSubscriptions) {
-        [PPNotifications initializeSharedSubscriptions];
++ (void)migrateArchivedDefaultsKey:(NSString *)defaultsKey toStore:(PPModelStore *)store recordKey:(NSString *(^)(id object))recordKey {
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    NSData *storedData = [defaults objectForKey:defaultsKey];
+    if(!storedData) {
+        return;
     }
-    NSMutableArray *sharedSubscriptions = [[NSMutableArray alloc] initWithCapacity:0];
-    NSMutableArray *subscriptionsArrayDebug = [[NSMutableArray alloc] initWithCapacity:0];
-    for(NSString *userIdKey in _sharedSubscriptions.allKeys) {
-        for(PPNotificationSubscription *subscription in [_sharedSubscriptions objectForKey:userIdKey]) {
-            NSMutableDictionary *subscriptionIdentifiers = [[NSMutableDictionary alloc] initWithCapacity:2];
-            [subscriptionIdentifiers setValue:@(subscription.type) forKey:@"type"];
-            if(subscription.name) {
-                [subscriptionIdentifiers setValue:subscription.name forKey:@"name"];
-            }
-            [subscriptionsArrayDebug addObject:subscriptionIdentifiers];
-            
-            if([userIdKey isEqualToString:[NSString stringWithFormat:@"%li", (long)userId]]) {
-                [sharedSubscriptions addObject:subscription];
-            }
+    
+    NSDictionary *archived;
+    @try {
+        NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:storedData error:nil];
+        unarchiver.requiresSecureCoding = NO;
+        archived = (NSDictionary *)[unarchiver decodeObjectForKey:NSKeyedArchiveRootObjectKey];
+        [unarchiver finishDecoding];
+    }
+    @catch (NSException *exception) {
+        NSLog(@"%s Unable to read %@: %@", __PRETTY_FUNCTION__, defaultsKey, exception);
+    }
+    for(NSString *userIdKey in archived) {
+        id objects = [archived objectForKey:userIdKey];
+        for(id object in ([objects isKindOfClass:[NSArray class]] ? objects : @[objects])) {
+            [store setObject:object forKey:recordKey(object) userId:(PPUserId)userIdKey.integerValue];
         }
     }
-    
-#ifdef DEBUG
-#ifdef DEBUG_MODELS
-    NSLog(@"< %s sharedSubscriptions=%@", __PRETTY_FUNCTION__, subscriptionsArrayDebug);
-#endif
-#endif
-    return sharedSubscriptions;
+    [store flush];
+    [defaults removeObjectForKey:defaultsKey];
 }
 
-+ (void)initializeSharedSubscriptions {
+/**
+ * Shared subscriptions across the entire application
+ */
++ (NSArray *)sharedSubscriptionsForUser:(PPUserId)userId {
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"> %s", __PRETTY_FUNCTION__);
 #endif
 #endif
-    _sharedSubscriptions = [[NSMutableDictionary alloc] initWithCapacity:0];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    NSData *storedSubscriptionsData = [defaults objectForKey:@"user.notificationSubscriptions"];
-    if(storedSubscriptionsData) {
-        _sharedSubscriptions = (NSMutableDictionary *)[NSKeyedUnarchiver unarchiveObjectWithData:storedSubscriptionsData];
-    }
+    // In the order they were added
+    NSArray *sharedSubscriptions = [[PPNotifications subscriptionsStore] orderedObjectsForUser:userId];
+    
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s", __PRETTY_FUNCTION__);
+    NSLog(@"< %s sharedSubscriptions=%@", __PRETTY_FUNCTION__, sharedSubscriptions);
 #endif
 #endif
+    return sharedSubscriptions;
 }
 
 /**
@@ -86,42 +99,29 @@ __strong static NSMutableDictionary*_sharedSubscriptions = nil;
     NSLog(@"> %s subscriptions=%@", __PRETTY_FUNCTION__, subscriptions);
 #endif
 #endif
-    if(!_sharedSubscriptions) {
-        [PPNotifications initializeSharedSubscriptions];
-    }
-    
-    NSMutableArray *subscriptionsArray = [_sharedSubscriptions objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(!subscriptionsArray) {
-        subscriptionsArray = [[NSMutableArray alloc] initWithCapacity:0];
-    }
+    PPModelStore *store = [PPNotifications subscriptionsStore];
+    NSDictionary *records = [store objectsForUser:userId];
     
-    NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
     for(PPNotificationSubscription *subscription in subscriptions) {
         
         BOOL found = NO;
-        for(PPNotificationSubscription *sharedSubscription in subscriptionsArray) {
+        for(NSString *key in records) {
+            PPNotificationSubscription *sharedSubscription = [records objectForKey:key];
             if([sharedSubscription isEqualToSubscription:subscription]) {
                 [sharedSubscription sync:subscription];
+                [store touchObjectForKey:key userId:userId];
                 found = YES;
                 break;
             }
         }
         if(!found) {
-            [indexSet addIndex:[subscriptions indexOfObject:subscription]];
+            [store setObject:subscription forKey:[PPNotifications recordKeyForSubscription:subscription] userId:userId];
         }
     }
     
-    [subscriptionsArray addObjectsFromArray:[subscriptions objectsAtIndexes:indexSet]];
-    [_sharedSubscriptions setObject:subscriptionsArray forKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    
-    NSData *sharedSubscriptionData = [NSKeyedArchiver archivedDataWithRootObject:_sharedSubscriptions];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    [defaults setObject:sharedSubscriptionData forKey:@"user.notificationSubscriptions"];
-    [defaults synchronize];
-    
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s subscriptionsArray=%@", __PRETTY_FUNCTION__, subscriptionsArray);
+    NSLog(@"< %s subscriptions=%@", __PRETTY_FUNCTION__, [store objectsForUser:userId].allKeys);
 #endif
 #endif
 }
@@ -139,44 +139,40 @@ __strong static NSMutableDictionary*_sharedSubscriptions = nil;
     NSLog(@"> %s subscriptions=%@", __PRETTY_FUNCTION__, subscriptions);
 #endif
 #endif
+    PPModelStore *store = [PPNotifications subscriptionsStore];
+    NSDictionary *records = [store objectsForUser:userId];
     
-    if(!_sharedSubscriptions) {
-        [PPNotifications initializeSharedSubscriptions];
-    }
-    
-    NSMutableArray *subscriptionsArray = [_sharedSubscriptions objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(!subscriptionsArray) {
-        subscriptionsArray = [[NSMutableArray alloc] initWithCapacity:0];
-    }
-    
-    NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
     for(PPNotificationSubscription *subscription in subscriptions) {
-        for(PPNotificationSubscription *sharedSubscription in subscriptionsArray) {
+        for(NSString *key in records) {
+            PPNotificationSubscription *sharedSubscription = [records objectForKey:key];
             if([sharedSubscription isEqualToSubscription:subscription]) {
-                [indexSet addIndex:[subscriptionsArray indexOfObject:sharedSubscription]];
+                [store removeObjectForKey:key userId:userId];
                 break;
             }
         }
     }
     
-    [subscriptionsArray removeObjectsAtIndexes:indexSet];
-    [_sharedSubscriptions setObject:subscriptionsArray forKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    
-    NSData *sharedSubscriptionData = [NSKeyedArchiver archivedDataWithRootObject:_sharedSubscriptions];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    [defaults setObject:sharedSubscriptionData forKey:@"user.notificationSubscriptions"];
-    [defaults synchronize];
-    
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s subscriptionsArray=%@", __PRETTY_FUNCTION__, subscriptionsArray);
+    NSLog(@"< %s subscriptions=%@", __PRETTY_FUNCTION__, [store objectsForUser:userId].allKeys);
 #endif
 #endif
 }
 
 #pragma mark Notification Tokens
 
-__strong static NSMutableDictionary*_sharedTokens = nil;
+/**
+ * One token record per user
+ */
++ (PPModelStore *)tokensStore {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [PPNotifications migrateArchivedDefaultsKey:@"user.notificationTokens" toStore:[PPModelStore sharedStoreNamed:@"notificationTokens"] recordKey:^NSString *(id object) {
+            return @"token";
+        }];
+    });
+    return [PPModelStore sharedStoreNamed:@"notificationTokens"];
+}
 
 /**
  * Shared subscriptions across the entire application
@@ -187,47 +183,16 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     NSLog(@"> %s", __PRETTY_FUNCTION__);
 #endif
 #endif
-    if(!_sharedTokens) {
-        [PPNotifications initializeSharedTokens];
-    }
-    PPNotificationToken *sharedToken;
-    NSMutableArray *tokensArray = [[NSMutableArray alloc] initWithCapacity:0];
-    for(NSString *userIdKey in _sharedTokens.allKeys) {
-        PPNotificationToken *token = [_sharedTokens objectForKey:userIdKey];
-        [tokensArray addObject:@{@"token": token.token}];
-        
-        if([userIdKey isEqualToString:[NSString stringWithFormat:@"%li", (long)userId]]) {
-            sharedToken = token;
-        }
-    }
+    PPNotificationToken *sharedToken = [[PPNotifications tokensStore] objectForKey:@"token" userId:userId];
     
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s sharedTokens=%@", __PRETTY_FUNCTION__, tokensArray);
+    NSLog(@"< %s sharedToken=%@", __PRETTY_FUNCTION__, sharedToken.token);
 #endif
 #endif
     return sharedToken;
 }
 
-+ (void)initializeSharedTokens {
-#ifdef DEBUG
-#ifdef DEBUG_MODELS
-    NSLog(@"> %s", __PRETTY_FUNCTION__);
-#endif
-#endif
-    _sharedTokens = [[NSMutableDictionary alloc] initWithCapacity:0];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    NSData *storedTokensData = [defaults objectForKey:@"user.notificationTokens"];
-    if(storedTokensData) {
-        _sharedTokens = (NSMutableDictionary *)[NSKeyedUnarchiver unarchiveObjectWithData:storedTokensData];
-    }
-#ifdef DEBUG
-#ifdef DEBUG_MODELS
-    NSLog(@"< %s", __PRETTY_FUNCTION__);
-#endif
-#endif
-}
-
 /**
  * Add APNs token.
  * Add APNs to non-volatile reference.
@@ -241,24 +206,12 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     NSLog(@"> %s notificationToken=%@", __PRETTY_FUNCTION__, notificationToken);
 #endif
 #endif
-    if(!_sharedTokens) {
-        [PPNotifications initializeSharedTokens];
-    }
-    
-    PPNotificationToken *token = (PPNotificationToken *)[_sharedTokens objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(token) {
-        if(![token isEqualToToken:notificationToken]) {
-            token = notificationToken;
-        }
+    PPModelStore *store = [PPNotifications tokensStore];
+    PPNotificationToken *token = [store objectForKey:@"token" userId:userId];
+    if(!token || ![token isEqualToToken:notificationToken]) {
+        [store setObject:notificationToken forKey:@"token" userId:userId];
     }
     
-    [_sharedTokens setObject:notificationToken forKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    
-    NSData *sharedTokenData = [NSKeyedArchiver archivedDataWithRootObject:_sharedTokens];
-    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-    [defaults setObject:sharedTokenData forKey:@"user.notificationTokens"];
-    [defaults synchronize];
-    
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"< %s token=%@", __PRETTY_FUNCTION__, notificationToken.token);
@@ -279,21 +232,10 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     NSLog(@"> %s notificationToken=%@", __PRETTY_FUNCTION__, notificationToken);
 #endif
 #endif
-    if(!_sharedTokens) {
-        [PPNotifications initializeSharedTokens];
-    }
-    PPNotificationToken *token = (PPNotificationToken *)[_sharedTokens objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(token) {
-        if([token isEqualToToken:notificationToken]) {
-            token = nil;
-        }
-    }
-    
-    if(token) {
-        [_sharedTokens setObject:token forKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    }
-    else {
-        [_sharedTokens removeObjectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
+    PPModelStore *store = [PPNotifications tokensStore];
+    PPNotificationToken *token = [store objectForKey:@"token" userId:userId];
+    if(token && [token isEqualToToken:notificationToken]) {
+        [store removeObjectForKey:@"token" userId:userId];
     }
 }
 
@@ -370,9 +312,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
  **/
 + (void)getNotificationSubscriptions:(PPNotificationSubscriptionsBlock)callback {
     NSURLComponents *components = [NSURLComponents componentsWithString:@"notificationSubscriptions"];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.getNotificationSubscription()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -389,7 +331,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
                     [subscriptions addObject:subscription];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(subscriptions, error);
@@ -399,7 +341,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain,
@@ -449,9 +391,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.setNotificationSubscription()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] PUT:components.string success:^(NSData *responseData) {
         
@@ -459,7 +401,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -469,7 +411,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -500,9 +442,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.registerAnAppForPushNotifications()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] PUT:components.string success:^(NSData *responseData) {
         
@@ -510,7 +452,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -520,7 +462,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -541,9 +483,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     NSAssert1(notificationToken != nil, @"%s missing notificationToken", __FUNCTION__);
     NSURLComponents *components = [NSURLComponents componentsWithString:[NSString stringWithFormat:@"notificationToken/%@", notificationToken]];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.unregisterAnAppForPushNotifications()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:components.string success:^(NSData *responseData) {
         
@@ -551,7 +493,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -561,7 +503,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -622,9 +564,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.sendNotification()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -632,7 +574,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -642,7 +584,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -676,9 +618,9 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.communications.notifications.getNotifications()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -696,7 +638,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
                     [notifications addObject:notification];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(notifications, error);
@@ -706,7 +648,7 @@ __strong static NSMutableDictionary*_sharedTokens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -16,6 +16,8 @@
 #import "PPDeviceMeasurementUnit.h"
 #import "PPDeviceCommand.h"
 #import "PPDeviceDataRequest.h"
+#import "PPDeviceMeasurementsStore.h"
+#import "PPHTTPOperation.h"
 
 @interface PPDeviceMeasurements : PPBaseModel
 
@@ -114,6 +116,21 @@
 + (void)getMeasurementsWithSearchTerms:(PPLocationId)locationId userId:(PPUserId)userId deviceId:(NSString * _Nullable )deviceId paramNames:(NSArray * _Nullable )paramNames shared:(PPDeviceShared)shared callback:(PPDeviceMeasurementsBlock _Nonnull )callback;
 + (void)getMeasurementsWithSearchTerms:(PPLocationId)locationId userId:(PPUserId)userId deviceId:(NSString * _Nonnull )deviceId paramNames:(NSArray * _Nullable )paramNames callback:(PPDeviceMeasurementsBlock _Nonnull )callback __attribute__((deprecated));
 
+/**
+ * Get current measurements for multiple devices.
+ * Devices are fetched with a single location-wide request. If the location-wide request fails, requests are made per device, at most maxConcurrentRequests at a time.
+ *
+ * @param deviceIds Required NSArray Device IDs to extract parameters from
+ * @param locationId Required PPLocationId Location of the devices
+ * @param userId PPUserId Optional user ID search field for an administrator to retrieve parameters of the devices owned by this user.
+ * @param paramNames NSArray Optional Parameter names to extract.
+ * @param shared PPDeviceShared Get parameters from devices shared in circle.
+ * @param maxConcurrentRequests PPDeviceMeasurementsMaxConcurrentRequests Maximum per-device requests in flight. PPDeviceMeasurementsMaxConcurrentRequestsNone for the default.
+ * @param progress PPDeviceMeasurementsDeviceBlock Optional block called on the main queue as each device completes
+ * @param callback PPDeviceMeasurementsBatchBlock Called once on the main queue with measurement arrays and errors, both keyed by device ID
+ **/
++ (void)getCurrentMeasurementsForDevices:(NSArray * _Nonnull )deviceIds locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray * _Nullable )paramNames shared:(PPDeviceShared)shared maxConcurrentRequests:(PPDeviceMeasurementsMaxConcurrentRequests)maxConcurrentRequests progress:(PPDeviceMeasurementsDeviceBlock _Nullable )progress callback:(PPDeviceMeasurementsBatchBlock _Nonnull )callback;
+
 /**
  * Send Set Commands
  * This API allows to send commands to multiple devices simultaneously.
@@ -159,6 +176,43 @@
  **/
 + (void)getHistoryOfMeasurements:(NSString * _Nonnull )deviceId startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nullable )endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray * _Nullable )paramNames index:(NSString * _Nullable )index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise callback:(PPDeviceMeasurementsReadingsBlock _Nonnull )callback;
 
+/**
+ * Get History of Measurements in time windows.
+ * The range is split into windows fetched in parallel, at most maxConcurrentRequests at a time. Each window's readings are delivered in time order as soon as every earlier window has been delivered, so only a few windows are held in memory.
+ *
+ * @param deviceId Required NSString Device ID for which to get a history of measurements
+ * @param startDate Required NSDate Start date to begin receiving measurements.
+ * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
+ * @param locationId Required PPLocationId Request information on a specific location
+ * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
+ * @param paramNames NSArray Only obtain measurements for given parameter names. Multiple names can be passed.
+ * @param index NSString Only obtain measurements for parameters with this index number.
+ * @param interval PPDeviceMeasurementsHistoryInterval Aggregate the readings by this interval, in minutes
+ * @param aggregation PPDeviceMeasurementsHistoryAggregation Interval aggregation algorithm
+ * @param reduceNoise PPDeviceMeasurementsHistoryReduceNoise Return tiny parametert values less than defined threshold as zero
+ * @param windowInterval NSTimeInterval Length of each window in seconds. 0 for one day.
+ * @param maxConcurrentRequests PPDeviceMeasurementsMaxConcurrentRequests Maximum windows in flight. PPDeviceMeasurementsMaxConcurrentRequestsNone for the default.
+ * @param readings PPDeviceMeasurementsReadingsBlock Called on the main queue with each window's readings, oldest first
+ * @param callback PPErrorBlock Called once on the main queue when every window was delivered, on the first error, or with no error after cancellation
+ * @return PPHTTPOperation Cancel to stop the read. No readings are delivered after cancellation.
+ **/
++ (PPHTTPOperation * _Nonnull )getHistoryOfMeasurements:(NSString * _Nonnull )deviceId startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nullable )endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray * _Nullable )paramNames index:(NSString * _Nullable )index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise windowInterval:(NSTimeInterval)windowInterval maxConcurrentRequests:(PPDeviceMeasurementsMaxConcurrentRequests)maxConcurrentRequests readings:(PPDeviceMeasurementsReadingsBlock _Nonnull )readings callback:(PPErrorBlock _Nonnull )callback;
+
+/**
+ * Get History of Measurements from the local time-series store.
+ * Only the range after the stored history is requested from the cloud, then stored. Only numeric parameters are stored.
+ *
+ * @param deviceId Required NSString Device ID for which to get a history of measurements
+ * @param startDate Required NSDate Start date to begin receiving measurements.
+ * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
+ * @param locationId Required PPLocationId Request information on a specific location
+ * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
+ * @param paramNames Required NSArray Parameter names to obtain measurements for
+ * @param index NSString Only obtain measurements for parameters with this index number.
+ * @param callback PPDeviceMeasurementsReadingsBlock Device measurements readings callback block containing historical readings, oldest first
+ **/
++ (void)getStoredHistoryOfMeasurements:(NSString * _Nonnull )deviceId startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nullable )endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray * _Nonnull )paramNames index:(NSString * _Nullable )index callback:(PPDeviceMeasurementsReadingsBlock _Nonnull )callback;
+
 #pragma mark - Get the Last N Measurements
 
 /**
@@ -8,6 +8,29 @@
 
 #import "PPDeviceMeasurements.h"
 #import "PPCloudEngine.h"
+#import "PPDeviceMeasurementsStore.h"
+
+#define HISTORY_DEFAULT_WINDOW_INTERVAL (24 * 60 * 60)
+
+/**
+ * State of a windowed history read. Only touched on the main queue.
+ */
+@interface PPDeviceMeasurementsHistoryReader : NSObject
+@property (nonatomic, strong) NSArray *windowStartDates;
+@property (nonatomic, strong) NSDate *endDate;
+@property (nonatomic) NSInteger maxConcurrentRequests;
+@property (nonatomic) NSInteger nextRequestIndex;
+@property (nonatomic) NSInteger nextDeliveryIndex;
+@property (nonatomic, strong) NSMutableDictionary *completedWindows;
+@property (nonatomic, strong) NSMutableDictionary *operations;
+@property (nonatomic) BOOL finished;
+@property (nonatomic, copy) NSString *(^requestStringForWindow)(NSDate *startDate, NSDate *endDate);
+@property (nonatomic, copy) PPDeviceMeasurementsReadingsBlock readings;
+@property (nonatomic, copy) PPErrorBlock callback;
+@end
+
+@implementation PPDeviceMeasurementsHistoryReader
+@end
 
 @implementation PPDeviceMeasurements
 
@@ -15,7 +38,7 @@
 
 /**
  * Add measurements.
- * Add measurements to local reference.
+ * Add measurements to local reference. Numeric parameters are kept in the local time-series store.
  *
  * @param measurements NSArray Array of measurements to add.
  * @param userId Required PPUserId User Id to associate these objects with
@@ -24,6 +47,11 @@
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"> %s measurements=%@", __PRETTY_FUNCTION__, measurements);
+#endif
+#endif
+    [[PPDeviceMeasurementsStore storeForUserId:userId] addMeasurements:measurements callback:nil];
+#ifdef DEBUG
+#ifdef DEBUG_MODELS
     NSLog(@"< %s", __PRETTY_FUNCTION__);
 #endif
 #endif
@@ -31,7 +59,7 @@
 
 /**
  * Add readings.
- * Add readings to local reference.
+ * Add readings to local reference. Numeric parameters are kept in the local time-series store.
  *
  * @param readings NSArray Array of readings to add.
  * @param userId Required PPUserId User Id to associate these objects with
@@ -40,6 +68,11 @@
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"> %s readings=%@", __PRETTY_FUNCTION__, readings);
+#endif
+#endif
+    [[PPDeviceMeasurementsStore storeForUserId:userId] addReadings:readings callback:nil];
+#ifdef DEBUG
+#ifdef DEBUG_MODELS
     NSLog(@"< %s", __PRETTY_FUNCTION__);
 #endif
 #endif
@@ -116,9 +149,9 @@
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getCurrentMeasurements()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -136,7 +169,7 @@
                     [measurements addObject:measurement];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(measurements, error);
@@ -146,7 +179,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -230,9 +263,9 @@
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.sendCommand()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -251,7 +284,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(commandResponses, error);
@@ -261,7 +294,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -322,9 +355,9 @@
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getMeasurementsWithSearchTerms()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -343,7 +376,7 @@
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(measurements, error);
@@ -353,7 +386,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -366,6 +399,91 @@
     [PPDeviceMeasurements getMeasurementsWithSearchTerms:locationId userId:userId deviceId:deviceId paramNames:paramNames shared:PPDeviceSharedNone callback:callback];
 }
 
++ (void)getCurrentMeasurementsForDevices:(NSArray *)deviceIds locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames shared:(PPDeviceShared)shared maxConcurrentRequests:(PPDeviceMeasurementsMaxConcurrentRequests)maxConcurrentRequests progress:(PPDeviceMeasurementsDeviceBlock)progress callback:(PPDeviceMeasurementsBatchBlock)callback {
+    NSAssert1(locationId != PPLocationIdNone, @"%s missing locationId", __FUNCTION__);
+    NSAssert1(deviceIds != nil, @"%s missing deviceIds", __FUNCTION__);
+    
+    if(deviceIds.count == 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            callback(@{}, @{});
+        });
+        return;
+    }
+    
+    // One round-trip for the whole location
+    [PPDeviceMeasurements getMeasurementsWithSearchTerms:locationId userId:userId deviceId:nil paramNames:paramNames shared:shared callback:^(NSArray * _Nullable measurements, NSError * _Nullable error) {
+        if(error) {
+            PPLogAPI(@"%s location-wide request failed, requesting per device: %@", __PRETTY_FUNCTION__, error);
+            [PPDeviceMeasurements fanOutCurrentMeasurementsForDevices:deviceIds locationId:locationId userId:userId paramNames:paramNames shared:shared maxConcurrentRequests:maxConcurrentRequests progress:progress callback:callback];
+            return;
+        }
+        
+        NSMutableDictionary *measurementsByDevice = [[NSMutableDictionary alloc] initWithCapacity:deviceIds.count];
+        for(NSString *deviceId in deviceIds) {
+            [measurementsByDevice setObject:[[NSMutableArray alloc] initWithCapacity:1] forKey:deviceId];
+        }
+        for(PPDeviceMeasurement *measurement in measurements) {
+            [[measurementsByDevice objectForKey:measurement.deviceId] addObject:measurement];
+        }
+        
+        if(progress) {
+            for(NSString *deviceId in deviceIds) {
+                progress(deviceId, [measurementsByDevice objectForKey:deviceId], nil);
+            }
+        }
+        callback(measurementsByDevice, @{});
+    }];
+}
+
+/**
+ * Per-device requests with at most maxConcurrentRequests in flight.
+ * Completions arrive on the main queue, which also serializes the bookkeeping.
+ */
++ (void)fanOutCurrentMeasurementsForDevices:(NSArray *)deviceIds locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames shared:(PPDeviceShared)shared maxConcurrentRequests:(PPDeviceMeasurementsMaxConcurrentRequests)maxConcurrentRequests progress:(PPDeviceMeasurementsDeviceBlock)progress callback:(PPDeviceMeasurementsBatchBlock)callback {
+    NSInteger width = (maxConcurrentRequests > 0) ? maxConcurrentRequests : PPDeviceMeasurementsMaxConcurrentRequestsDefault;
+    NSArray *pendingDeviceIds = [[NSOrderedSet orderedSetWithArray:deviceIds] array];
+    
+    NSMutableDictionary *measurementsByDevice = [[NSMutableDictionary alloc] initWithCapacity:pendingDeviceIds.count];
+    NSMutableDictionary *errorsByDevice = [[NSMutableDictionary alloc] initWithCapacity:0];
+    __block NSUInteger nextIndex = 0;
+    __block NSUInteger completed = 0;
+    
+    __block __weak void (^weakRequestNext)(void);
+    void (^requestNext)(void);
+    weakRequestNext = requestNext = ^{
+        if(nextIndex >= pendingDeviceIds.count) {
+            return;
+        }
+        NSString *deviceId = [pendingDeviceIds objectAtIndex:nextIndex++];
+        void (^strongRequestNext)(void) = weakRequestNext;
+        
+        [PPDeviceMeasurements getCurrentMeasurements:deviceId locationId:locationId userId:userId paramNames:paramNames shared:shared callback:^(NSArray * _Nullable measurements, NSError * _Nullable error) {
+            if(error) {
+                [errorsByDevice setObject:error forKey:deviceId];
+            }
+            else {
+                [measurementsByDevice setObject:measurements forKey:deviceId];
+            }
+            
+            if(progress) {
+                progress(deviceId, measurements, error);
+            }
+            
+            completed++;
+            if(completed == pendingDeviceIds.count) {
+                callback(measurementsByDevice, errorsByDevice);
+            }
+            else {
+                strongRequestNext();
+            }
+        }];
+    };
+    
+    for(NSInteger i = 0; i < width && i < pendingDeviceIds.count; i++) {
+        requestNext();
+    }
+}
+
 /**
  * Send Set Commands
  * This API allows to send commands to multiple devices simultaneously.
@@ -432,9 +550,9 @@
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.sendSetCommands()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -452,7 +570,7 @@
                     [commandResponses addObject:command];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(commandResponses, error);
@@ -462,7 +580,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -494,25 +612,9 @@
 #pragma mark - Get History of Measurements
 
 /**
- * Get History of Measurements
- *
- * @param deviceId Required NSString Device ID for which to get a history of measurements
- * @param startDate Required NSDate Start date to begin receiving measurements.
- * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
- * @param locationId Required PPLocationId Request information on a specific location
- * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
- * @param paramNames NSArray Only obtain measurements for given parameter names. Multiple names can be passed.
- * @param index NSString Only obtain measurements for parameters with this index number.
- * @param interval PPDeviceMeasurementsHistoryInterval OAggregate the readings by this interval, in minutes
- * @param aggregation PPDeviceMeasurementsHistoryAggregation Interval aggregation algorithm
- * @param reduceNoise PPDeviceMeasurementsHistoryReduceNoise Return tiny parametert values less than defined threshold as zero
- * @param callback PPDeviceMeasurementsReadingsBlock Device measurements readings callback block containing array of devices and historical readings
- **/
-+ (void)getHistoryOfMeasurements:(NSString *)deviceId startDate:(NSDate *)startDate endDate:(NSDate *)endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames index:(NSString *)index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise callback:(PPDeviceMeasurementsReadingsBlock)callback {
-    NSAssert1(locationId != PPLocationIdNone, @"%s missing locationId", __FUNCTION__);
-    NSAssert1(deviceId != nil, @"%s missing deviceId", __FUNCTION__);
-    NSAssert1(startDate != nil, @"%s missing startDate", __FUNCTION__);
-    
+ * Request string for a history of measurements
+ */
++ (NSString *)historyRequestString:(NSString *)deviceId startDate:(NSDate *)startDate endDate:(NSDate *)endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames index:(NSString *)index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise {
     NSURLComponents *components = [NSURLComponents componentsWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"devices/%@/parametersByDate/%@", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:deviceId], [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:[PPNSDate apiFriendStringFromDate:startDate]]]] resolvingAgainstBaseURL:NO];
 
     NSMutableArray *queryItems = @[].mutableCopy;
@@ -550,27 +652,51 @@
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getHistoryOfMeasurements()", DISPATCH_QUEUE_SERIAL);
+    return components.string;
+}
+
+/**
+ * Get History of Measurements
+ *
+ * @param deviceId Required NSString Device ID for which to get a history of measurements
+ * @param startDate Required NSDate Start date to begin receiving measurements.
+ * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
+ * @param locationId Required PPLocationId Request information on a specific location
+ * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
+ * @param paramNames NSArray Only obtain measurements for given parameter names. Multiple names can be passed.
+ * @param index NSString Only obtain measurements for parameters with this index number.
+ * @param interval PPDeviceMeasurementsHistoryInterval OAggregate the readings by this interval, in minutes
+ * @param aggregation PPDeviceMeasurementsHistoryAggregation Interval aggregation algorithm
+ * @param reduceNoise PPDeviceMeasurementsHistoryReduceNoise Return tiny parametert values less than defined threshold as zero
+ * @param callback PPDeviceMeasurementsReadingsBlock Device measurements readings callback block containing array of devices and historical readings
+ **/
++ (void)getHistoryOfMeasurements:(NSString *)deviceId startDate:(NSDate *)startDate endDate:(NSDate *)endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames index:(NSString *)index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise callback:(PPDeviceMeasurementsReadingsBlock)callback {
+    NSAssert1(locationId != PPLocationIdNone, @"%s missing locationId", __FUNCTION__);
+    NSAssert1(deviceId != nil, @"%s missing deviceId", __FUNCTION__);
+    NSAssert1(startDate != nil, @"%s missing startDate", __FUNCTION__);
+    
+    NSString *requestString = [PPDeviceMeasurements historyRequestString:deviceId startDate:startDate endDate:endDate locationId:locationId userId:userId paramNames:paramNames index:index interval:interval aggregation:aggregation reduceNoise:reduceNoise];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
+    
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
-    [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
+    [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error = nil;
-            NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
+            NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:0];
             
-            NSMutableArray *readings;
+            [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) streamingKey:@"readings" element:^(id readingDict) {
+                PPDeviceMeasurementsReading *reading = [PPDeviceMeasurementsReading initWithDictionary:readingDict];
+                [readings addObject:reading];
+            } error:&error];
             
-            if(!error) {
-                readings = [[NSMutableArray alloc] initWithCapacity:0];
-                for(NSDictionary *readingDict in [root objectForKey:@"readings"]) {
-                    PPDeviceMeasurementsReading *reading = [PPDeviceMeasurementsReading initWithDictionary:readingDict];
-                    [readings addObject:reading];
-                }
+            if(error) {
+                readings = nil;
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(readings, error);
@@ -580,7 +706,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -589,6 +715,232 @@
     }];
 }
 
+/**
+ * Get History of Measurements in time windows.
+ * The range is split into windows fetched in parallel, at most maxConcurrentRequests at a time. Each window's readings are delivered in time order as soon as every earlier window has been delivered, so only a few windows are held in memory.
+ *
+ * @param deviceId Required NSString Device ID for which to get a history of measurements
+ * @param startDate Required NSDate Start date to begin receiving measurements.
+ * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
+ * @param locationId Required PPLocationId Request information on a specific location
+ * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
+ * @param paramNames NSArray Only obtain measurements for given parameter names. Multiple names can be passed.
+ * @param index NSString Only obtain measurements for parameters with this index number.
+ * @param interval PPDeviceMeasurementsHistoryInterval Aggregate the readings by this interval, in minutes
+ * @param aggregation PPDeviceMeasurementsHistoryAggregation Interval aggregation algorithm
+ * @param reduceNoise PPDeviceMeasurementsHistoryReduceNoise Return tiny parametert values less than defined threshold as zero
+ * @param windowInterval NSTimeInterval Length of each window in seconds. 0 for one day.
+ * @param maxConcurrentRequests PPDeviceMeasurementsMaxConcurrentRequests Maximum windows in flight. PPDeviceMeasurementsMaxConcurrentRequestsNone for the default.
+ * @param readings PPDeviceMeasurementsReadingsBlock Called on the main queue with each window's readings, oldest first
+ * @param callback PPErrorBlock Called once on the main queue when every window was delivered, on the first error, or with no error after cancellation
+ * @return PPHTTPOperation Cancel to stop the read. No readings are delivered after cancellation.
+ **/
++ (PPHTTPOperation *)getHistoryOfMeasurements:(NSString *)deviceId startDate:(NSDate *)startDate endDate:(NSDate *)endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames index:(NSString *)index interval:(PPDeviceMeasurementsHistoryInterval)interval aggregation:(PPDeviceMeasurementsHistoryAggregation)aggregation reduceNoise:(PPDeviceMeasurementsHistoryReduceNoise)reduceNoise windowInterval:(NSTimeInterval)windowInterval maxConcurrentRequests:(PPDeviceMeasurementsMaxConcurrentRequests)maxConcurrentRequests readings:(PPDeviceMeasurementsReadingsBlock)readings callback:(PPErrorBlock)callback {
+    NSAssert1(locationId != PPLocationIdNone, @"%s missing locationId", __FUNCTION__);
+    NSAssert1(deviceId != nil, @"%s missing deviceId", __FUNCTION__);
+    NSAssert1(startDate != nil, @"%s missing startDate", __FUNCTION__);
+    
+    if(windowInterval <= 0) {
+        windowInterval = HISTORY_DEFAULT_WINDOW_INTERVAL;
+    }
+    if(!endDate) {
+        endDate = [NSDate date];
+    }
+    
+    NSMutableArray *windowStartDates = [[NSMutableArray alloc] initWithCapacity:MAX(1, [endDate timeIntervalSinceDate:startDate] / windowInterval + 1)];
+    NSDate *windowStartDate = startDate;
+    do {
+        [windowStartDates addObject:windowStartDate];
+        windowStartDate = [windowStartDate dateByAddingTimeInterval:windowInterval];
+    } while([windowStartDate compare:endDate] == NSOrderedAscending);
+    
+    PPDeviceMeasurementsHistoryReader *reader = [[PPDeviceMeasurementsHistoryReader alloc] init];
+    reader.windowStartDates = windowStartDates;
+    reader.endDate = endDate;
+    reader.maxConcurrentRequests = (maxConcurrentRequests > 0) ? maxConcurrentRequests : PPDeviceMeasurementsMaxConcurrentRequestsDefault;
+    reader.completedWindows = [[NSMutableDictionary alloc] initWithCapacity:reader.maxConcurrentRequests];
+    reader.operations = [[NSMutableDictionary alloc] initWithCapacity:reader.maxConcurrentRequests];
+    reader.readings = readings;
+    reader.callback = callback;
+    reader.requestStringForWindow = ^NSString *(NSDate *windowStartDate, NSDate *windowEndDate) {
+        return [PPDeviceMeasurements historyRequestString:deviceId startDate:windowStartDate endDate:windowEndDate locationId:locationId userId:userId paramNames:paramNames index:index interval:interval aggregation:aggregation reduceNoise:reduceNoise];
+    };
+    
+    PPLogAPI(@"> %s %lu windows", __PRETTY_FUNCTION__, (unsigned long)windowStartDates.count);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [PPDeviceMeasurements requestHistoryWindows:reader];
+    });
+    
+    return [[PPHTTPOperation alloc] initWithCancellationHandler:^{
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [PPDeviceMeasurements finishHistoryReader:reader error:nil];
+        });
+    }];
+}
+
+/**
+ * Start windows until the concurrency limit is reached.
+ * Windows complete out of order, so only windows ahead of the next delivery count against the limit.
+ */
++ (void)requestHistoryWindows:(PPDeviceMeasurementsHistoryReader *)reader {
+    while(!reader.finished && reader.nextRequestIndex < reader.windowStartDates.count && reader.nextRequestIndex - reader.nextDeliveryIndex < reader.maxConcurrentRequests) {
+        NSInteger windowIndex = reader.nextRequestIndex++;
+        NSDate *windowStartDate = [reader.windowStartDates objectAtIndex:windowIndex];
+        BOOL lastWindow = (windowIndex == reader.windowStartDates.count - 1);
+        NSDate *windowEndDate = lastWindow ? reader.endDate : [reader.windowStartDates objectAtIndex:windowIndex + 1];
+        
+        dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
+        
+        PPHTTPOperation *operation = [[PPCloudEngine sharedAppEngine] GET:reader.requestStringForWindow(windowStartDate, windowEndDate) success:^(NSData *responseData) {
+            
+            dispatch_async(queue, ^{
+                
+                NSError *error = nil;
+                NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:0];
+                
+                [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) streamingKey:@"readings" element:^(id readingDict) {
+                    PPDeviceMeasurementsReading *reading = [PPDeviceMeasurementsReading initWithDictionary:readingDict];
+                    
+                    // Window ends are shared with the next window
+                    if(!lastWindow && reading.timeStamp && [reading.timeStamp compare:windowEndDate] != NSOrderedAscending) {
+                        return;
+                    }
+                    [readings addObject:reading];
+                } error:&error];
+                
+                [readings sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(PPDeviceMeasurementsReading *a, PPDeviceMeasurementsReading *b) {
+                    return [a.timeStamp compare:b.timeStamp];
+                }];
+                
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    if(reader.finished) {
+                        return;
+                    }
+                    if(error) {
+                        [PPDeviceMeasurements finishHistoryReader:reader error:error];
+                        return;
+                    }
+                    [reader.operations removeObjectForKey:@(windowIndex)];
+                    [reader.completedWindows setObject:readings forKey:@(windowIndex)];
+                    [PPDeviceMeasurements deliverHistoryWindows:reader];
+                });
+            });
+        } failure:^(NSError *error) {
+            NSError *readerError = [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]];
+            
+            // The reader is only touched on the main queue, and the failure may arrive before GET returns
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [PPDeviceMeasurements finishHistoryReader:reader error:readerError];
+            });
+        }];
+        
+        if(operation) {
+            [reader.operations setObject:operation forKey:@(windowIndex)];
+        }
+    }
+}
+
+/**
+ * Deliver completed windows in order, then keep the pipeline full
+ */
++ (void)deliverHistoryWindows:(PPDeviceMeasurementsHistoryReader *)reader {
+    NSArray *readings;
+    while(!reader.finished && (readings = [reader.completedWindows objectForKey:@(reader.nextDeliveryIndex)])) {
+        [reader.completedWindows removeObjectForKey:@(reader.nextDeliveryIndex)];
+        reader.nextDeliveryIndex++;
+        if(readings.count > 0) {
+            reader.readings(readings, nil);
+        }
+    }
+    
+    if(reader.nextDeliveryIndex == reader.windowStartDates.count) {
+        PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
+        [PPDeviceMeasurements finishHistoryReader:reader error:nil];
+    }
+    else {
+        [PPDeviceMeasurements requestHistoryWindows:reader];
+    }
+}
+
++ (void)finishHistoryReader:(PPDeviceMeasurementsHistoryReader *)reader error:(NSError *)error {
+    if(reader.finished) {
+        return;
+    }
+    reader.finished = YES;
+    
+    for(PPHTTPOperation *operation in reader.operations.allValues) {
+        [operation cancel];
+    }
+    [reader.operations removeAllObjects];
+    [reader.completedWindows removeAllObjects];
+    
+    reader.callback(error);
+}
+
+/**
+ * Get History of Measurements from the local time-series store.
+ * Only the range after the stored history is requested from the cloud, then stored. Only numeric parameters are stored.
+ *
+ * @param deviceId Required NSString Device ID for which to get a history of measurements
+ * @param startDate Required NSDate Start date to begin receiving measurements.
+ * @param endDate NSDate End date to stop receiving measurements. Default is the current date.
+ * @param locationId Required PPLocationId Request information on a specific location
+ * @param userId PPUserId User ID to receive measurements from, only called by administrator accounts
+ * @param paramNames Required NSArray Parameter names to obtain measurements for
+ * @param index NSString Only obtain measurements for parameters with this index number.
+ * @param callback PPDeviceMeasurementsReadingsBlock Device measurements readings callback block containing historical readings, oldest first
+ **/
++ (void)getStoredHistoryOfMeasurements:(NSString *)deviceId startDate:(NSDate *)startDate endDate:(NSDate *)endDate locationId:(PPLocationId)locationId userId:(PPUserId)userId paramNames:(NSArray *)paramNames index:(NSString *)index callback:(PPDeviceMeasurementsReadingsBlock)callback {
+    NSAssert1(paramNames.count > 0, @"%s missing paramNames", __FUNCTION__);
+    
+    if(!endDate) {
+        endDate = [NSDate date];
+    }
+    
+    PPDeviceMeasurementsStore *store = [PPDeviceMeasurementsStore storeForUserId:userId];
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
+    
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
+    
+    void (^readLocally)(void) = ^{
+        dispatch_async(queue, ^{
+            NSArray *readings = [store readingsForDeviceId:deviceId paramNames:paramNames index:index startDate:startDate endDate:endDate];
+            
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                callback(readings, nil);
+            });
+        });
+    };
+    
+    // The store waits for its I/O queue, keep it off the main queue
+    dispatch_async(queue, ^{
+        NSDate *coveredEndDate = [store coveredEndDateForDeviceId:deviceId paramNames:paramNames index:index startDate:startDate];
+        if(coveredEndDate && [coveredEndDate compare:endDate] != NSOrderedAscending) {
+            readLocally();
+            return;
+        }
+        
+        // Ask the cloud only for the missing tail
+        NSDate *requestStartDate = coveredEndDate ?: startDate;
+        [PPDeviceMeasurements getHistoryOfMeasurements:deviceId startDate:requestStartDate endDate:endDate locationId:locationId userId:userId paramNames:paramNames index:index interval:PPDeviceMeasurementsHistoryIntervalNone aggregation:PPDeviceMeasurementsHistoryAggregationNone reduceNoise:PPDeviceMeasurementsHistoryReduceNoiseNone callback:^(NSArray * _Nullable readings, NSError * _Nullable error) {
+            if(error) {
+                PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
+                callback(nil, error);
+                return;
+            }
+            
+            dispatch_async(queue, ^{
+                [store setCoveredRangeForDeviceId:deviceId paramNames:paramNames index:index startDate:requestStartDate endDate:endDate];
+                [store addReadings:readings];
+                readLocally();
+            });
+        }];
+    });
+}
+
 #pragma mark - Get the Last N Measurements
 
 /**
@@ -644,27 +996,26 @@
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
               
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getLastNMeasurements()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error = nil;
-            NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
+            NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:0];
             
-            NSMutableArray *readings;
+            [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) streamingKey:@"readings" element:^(id readingDict) {
+                PPDeviceMeasurementsReading *reading = [PPDeviceMeasurementsReading initWithDictionary:readingDict];
+                [readings addObject:reading];
+            } error:&error];
             
-            if(!error) {
-                readings = [[NSMutableArray alloc] initWithCapacity:0];
-                for(NSDictionary *readingDict in [root objectForKey:@"readings"]) {
-                    PPDeviceMeasurementsReading *reading = [PPDeviceMeasurementsReading initWithDictionary:readingDict];
-                    [readings addObject:reading];
-                }
+            if(error) {
+                readings = nil;
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(readings, error);
@@ -675,7 +1026,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -724,9 +1075,9 @@
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getHistoryOfAlerts()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -744,7 +1095,7 @@
                     [alerts addObject:alert];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(alerts, error);
@@ -754,7 +1105,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -826,9 +1177,9 @@
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.submitDataRequest()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -836,7 +1187,7 @@
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -846,7 +1197,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -877,9 +1228,9 @@
 + (void)getUnitsOfMeasurement:(PPDeviceMeasurementsUnitsBlock)callback {
     NSURLComponents *components = [NSURLComponents componentsWithString:@"units"];
 
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.deviceMeasurements.getUnitsOfMeasurements()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -897,7 +1248,7 @@
                     [units addObject:unit];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(units, error);
@@ -908,7 +1259,7 @@
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -0,0 +1,127 @@
+//
+//  PPDeviceMeasurementsStore.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "PPDeviceMeasurementsReading.h"
+#import "PPDeviceMeasurement.h"
+
+/**
+ * On-device time-series store for numeric device parameters.
+ * Each series is keyed by device ID, parameter name and index, and kept as immutable columnar blocks of timestamps and values that are memory-mapped for reads.
+ * Non-numeric values are not stored.
+ * Files are read and written on a serial I/O queue. Methods that return a value wait for that queue, so call them off the main queue.
+ */
+@interface PPDeviceMeasurementsStore : NSObject
+
+/**
+ * Store for a user. Stores live in the caches directory.
+ *
+ * @param userId Required PPUserId User Id to associate these values with
+ */
++ (PPDeviceMeasurementsStore * _Nonnull )storeForUserId:(PPUserId)userId;
+
+/**
+ * Values older than this are removed. Default is 30 days.
+ */
+@property (atomic) NSTimeInterval retentionInterval;
+
+/**
+ * Maximum disk usage in bytes for this user. Oldest blocks are removed first. Default is 50 MB.
+ */
+@property (atomic) unsigned long long maximumDiskSize;
+
+#pragma mark - Writing
+
+/**
+ * Add the numeric parameters of historical readings, merged by timestamp.
+ * A value at a timestamp that is already stored replaces it.
+ *
+ * @param readings Required NSArray Array of PPDeviceMeasurementsReading
+ * @return NSUInteger Number of timestamps that were not stored yet
+ */
+- (NSUInteger)addReadings:(NSArray * _Nonnull )readings;
+
+/**
+ * Add the numeric parameters of historical readings without waiting for the I/O queue.
+ *
+ * @param readings Required NSArray Array of PPDeviceMeasurementsReading
+ * @param callback PPNSIntegerBlock Called on the main queue with the number of timestamps that were not stored yet
+ */
+- (void)addReadings:(NSArray * _Nonnull )readings callback:(PPNSIntegerBlock _Nullable )callback;
+
+/**
+ * Add the numeric parameters of current measurements, using each parameter's last update date.
+ *
+ * @param measurements Required NSArray Array of PPDeviceMeasurement
+ * @return NSUInteger Number of timestamps that were not stored yet
+ */
+- (NSUInteger)addMeasurements:(NSArray * _Nonnull )measurements;
+
+/**
+ * Add the numeric parameters of current measurements without waiting for the I/O queue.
+ *
+ * @param measurements Required NSArray Array of PPDeviceMeasurement
+ * @param callback PPNSIntegerBlock Called on the main queue with the number of timestamps that were not stored yet
+ */
+- (void)addMeasurements:(NSArray * _Nonnull )measurements callback:(PPNSIntegerBlock _Nullable )callback;
+
+/**
+ * Record that the cloud history between two dates is stored for these series.
+ * A range that does not touch the current one replaces it, and the series is cleared.
+ *
+ * @param deviceId Required NSString Device ID
+ * @param paramNames Required NSArray Parameter names
+ * @param index NSString Parameter index
+ * @param startDate Required NSDate Start of the range
+ * @param endDate Required NSDate End of the range
+ */
+- (void)setCoveredRangeForDeviceId:(NSString * _Nonnull )deviceId paramNames:(NSArray * _Nonnull )paramNames index:(NSString * _Nullable )index startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nonnull )endDate;
+
+/**
+ * End of the stored cloud history, if every series covers startDate.
+ *
+ * @param deviceId Required NSString Device ID
+ * @param paramNames Required NSArray Parameter names
+ * @param index NSString Parameter index
+ * @param startDate Required NSDate Start of the requested range
+ * @return NSDate Date the cloud should be asked from, nil if startDate is not covered
+ */
+- (NSDate * _Nullable )coveredEndDateForDeviceId:(NSString * _Nonnull )deviceId paramNames:(NSArray * _Nonnull )paramNames index:(NSString * _Nullable )index startDate:(NSDate * _Nonnull )startDate;
+
+#pragma mark - Reading
+
+/**
+ * Scan a series in time order.
+ *
+ * @param deviceId Required NSString Device ID
+ * @param paramName Required NSString Parameter name
+ * @param index NSString Parameter index
+ * @param startDate Required NSDate Inclusive start
+ * @param endDate Required NSDate Inclusive end
+ * @param block Required Called with each timestamp in milliseconds and value
+ * @return NSUInteger Number of values scanned
+ */
+- (NSUInteger)enumerateValuesForDeviceId:(NSString * _Nonnull )deviceId paramName:(NSString * _Nonnull )paramName index:(NSString * _Nullable )index startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nonnull )endDate usingBlock:(void (^ _Nonnull )(int64_t timeStampMs, double value, BOOL * _Nonnull stop))block;
+
+/**
+ * Readings rebuilt from the stored series, oldest first. Parameters with the same timestamp share a reading.
+ *
+ * @param deviceId Required NSString Device ID
+ * @param paramNames Required NSArray Parameter names
+ * @param index NSString Parameter index
+ * @param startDate Required NSDate Inclusive start
+ * @param endDate Required NSDate Inclusive end
+ * @return NSArray Array of PPDeviceMeasurementsReading
+ */
+- (NSArray * _Nonnull )readingsForDeviceId:(NSString * _Nonnull )deviceId paramNames:(NSArray * _Nonnull )paramNames index:(NSString * _Nullable )index startDate:(NSDate * _Nonnull )startDate endDate:(NSDate * _Nonnull )endDate;
+
+/**
+ * Remove every stored value for this user
+ */
+- (void)removeAllValues;
+
+@end
@@ -0,0 +1,730 @@
+//
+//  PPDeviceMeasurementsStore.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPDeviceMeasurementsStore.h"
+#import <CommonCrypto/CommonDigest.h>
+
+#define MEASUREMENTS_STORE_DEFAULT_RETENTION_INTERVAL (30 * 24 * 60 * 60)
+#define MEASUREMENTS_STORE_DEFAULT_MAXIMUM_DISK_SIZE (50 * 1024 * 1024)
+
+/**
+ * Values per block. Blocks below this are rewritten when new values are appended.
+ */
+#define MEASUREMENTS_STORE_BLOCK_CAPACITY 4096
+
+static uint32_t const kBlockMagic = 0x53545050; // "PPTS"
+static uint32_t const kBlockVersion = 1;
+
+static NSString *kSeriesMetadataFilename = @"series.plist";
+static NSString *kSeriesDeviceIdKey = @"deviceId";
+static NSString *kSeriesParamNameKey = @"paramName";
+static NSString *kSeriesIndexKey = @"index";
+static NSString *kSeriesCoveredStartKey = @"coveredStart";
+static NSString *kSeriesCoveredEndKey = @"coveredEnd";
+
+/**
+ * Block file layout, native byte order:
+ * header, int64_t timestamps[count] in milliseconds, double values[count]
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+} PPDeviceMeasurementsStoreBlockHeader;
+
+/**
+ * One immutable block of a series
+ */
+@interface PPDeviceMeasurementsStoreBlock : NSObject
+@property (nonatomic) int64_t firstTimeStamp;
+@property (nonatomic) int64_t lastTimeStamp;
+@property (nonatomic) NSUInteger count;
+@property (nonatomic, strong) NSURL *url;
+@end
+
+@implementation PPDeviceMeasurementsStoreBlock
+@end
+
+/**
+ * A series, its blocks in time order and its covered cloud range
+ */
+@interface PPDeviceMeasurementsStoreSeries : NSObject
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSMutableDictionary *metadata;
+@property (nonatomic, strong) NSMutableArray *blocks;
+@end
+
+@implementation PPDeviceMeasurementsStoreSeries
+@end
+
+@interface PPDeviceMeasurementsStore ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSMutableDictionary *series;
+
+// Every file read and write, and every change to the series, happens on this queue
+@property (nonatomic, strong) dispatch_queue_t ioQueue;
+@end
+
+@implementation PPDeviceMeasurementsStore
+
++ (PPDeviceMeasurementsStore *)storeForUserId:(PPUserId)userId {
+    static NSMutableDictionary *_stores = nil;
+    static NSLock *_storesLock = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _stores = [[NSMutableDictionary alloc] initWithCapacity:1];
+        _storesLock = [[NSLock alloc] init];
+    });
+
+    [_storesLock lock];
+    PPDeviceMeasurementsStore *store = [_stores objectForKey:@(userId)];
+    if(!store) {
+        NSURL *cachesURL = [[NSFileManager defaultManager] URLForDirectory:NSCachesDirectory inDomain:NSUserDomainMask appropriateForURL:nil create:YES error:nil];
+        NSURL *directoryURL = [[cachesURL URLByAppendingPathComponent:@"com.peoplepowerco.lib.Peoplepower.Measurements" isDirectory:YES] URLByAppendingPathComponent:@(userId).stringValue isDirectory:YES];
+        store = [[PPDeviceMeasurementsStore alloc] initWithDirectoryURL:directoryURL];
+        [_stores setObject:store forKey:@(userId)];
+    }
+    [_storesLock unlock];
+    return store;
+}
+
+- (id)initWithDirectoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if(self) {
+        self.retentionInterval = MEASUREMENTS_STORE_DEFAULT_RETENTION_INTERVAL;
+        self.maximumDiskSize = MEASUREMENTS_STORE_DEFAULT_MAXIMUM_DISK_SIZE;
+        self.directoryURL = directoryURL;
+        self.series = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.ioQueue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.measurementsStore", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+
+        // Stores are created from the main queue, read the series later
+        dispatch_async(_ioQueue, ^{
+            [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+            [self loadSeries];
+        });
+    }
+    return self;
+}
+
+#pragma mark - Series
+
+- (NSString *)keyForDeviceId:(NSString *)deviceId paramName:(NSString *)paramName index:(NSString *)index {
+    NSData *identityData = [[NSString stringWithFormat:@"%@\n%@\n%@", deviceId, paramName, index ?: @""] dataUsingEncoding:NSUTF8StringEncoding];
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(identityData.bytes, (CC_LONG)identityData.length, digest);
+
+    NSMutableString *key = [[NSMutableString alloc] initWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for(NSInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [key appendFormat:@"%02x", digest[i]];
+    }
+    return key;
+}
+
+- (void)loadSeries {
+    NSArray *directories = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_directoryURL includingPropertiesForKeys:nil options:NSDirectoryEnumerationSkipsHiddenFiles error:nil];
+    for(NSURL *seriesURL in directories) {
+        NSMutableDictionary *metadata = [[NSDictionary dictionaryWithContentsOfURL:[seriesURL URLByAppendingPathComponent:kSeriesMetadataFilename]] mutableCopy];
+        if(!metadata) {
+            [[NSFileManager defaultManager] removeItemAtURL:seriesURL error:nil];
+            continue;
+        }
+
+        PPDeviceMeasurementsStoreSeries *series = [[PPDeviceMeasurementsStoreSeries alloc] init];
+        series.directoryURL = seriesURL;
+        series.metadata = metadata;
+        series.blocks = [[NSMutableArray alloc] initWithCapacity:0];
+
+        NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:seriesURL includingPropertiesForKeys:@[NSURLFileSizeKey] options:NSDirectoryEnumerationSkipsHiddenFiles error:nil];
+        for(NSURL *file in files) {
+            if(![file.pathExtension isEqualToString:@"block"]) {
+                continue;
+            }
+            NSArray *range = [[file.lastPathComponent stringByDeletingPathExtension] componentsSeparatedByString:@"-"];
+            NSNumber *fileSize;
+            [file getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil];
+            if(range.count != 2 || fileSize.unsignedLongLongValue < sizeof(PPDeviceMeasurementsStoreBlockHeader)) {
+                [[NSFileManager defaultManager] removeItemAtURL:file error:nil];
+                continue;
+            }
+
+            PPDeviceMeasurementsStoreBlock *block = [[PPDeviceMeasurementsStoreBlock alloc] init];
+            block.firstTimeStamp = [range[0] longLongValue];
+            block.lastTimeStamp = [range[1] longLongValue];
+            block.count = (NSUInteger)((fileSize.unsignedLongLongValue - sizeof(PPDeviceMeasurementsStoreBlockHeader)) / (sizeof(int64_t) + sizeof(double)));
+            block.url = file;
+            [series.blocks addObject:block];
+        }
+        [series.blocks sortUsingComparator:^NSComparisonResult(PPDeviceMeasurementsStoreBlock *a, PPDeviceMeasurementsStoreBlock *b) {
+            return (a.firstTimeStamp < b.firstTimeStamp) ? NSOrderedAscending : (a.firstTimeStamp > b.firstTimeStamp) ? NSOrderedDescending : NSOrderedSame;
+        }];
+
+        [_series setObject:series forKey:seriesURL.lastPathComponent];
+    }
+}
+
+/**
+ * Must be called on the I/O queue
+ */
+- (PPDeviceMeasurementsStoreSeries *)seriesForDeviceId:(NSString *)deviceId paramName:(NSString *)paramName index:(NSString *)index create:(BOOL)create {
+    NSString *key = [self keyForDeviceId:deviceId paramName:paramName index:index];
+    PPDeviceMeasurementsStoreSeries *series = [_series objectForKey:key];
+    if(!series && create) {
+        series = [[PPDeviceMeasurementsStoreSeries alloc] init];
+        series.directoryURL = [_directoryURL URLByAppendingPathComponent:key isDirectory:YES];
+        series.metadata = [[NSMutableDictionary alloc] initWithDictionary:@{kSeriesDeviceIdKey: deviceId, kSeriesParamNameKey: paramName}];
+        if(index) {
+            [series.metadata setObject:index forKey:kSeriesIndexKey];
+        }
+        series.blocks = [[NSMutableArray alloc] initWithCapacity:1];
+
+        [[NSFileManager defaultManager] createDirectoryAtURL:series.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        [self saveMetadata:series];
+        [_series setObject:series forKey:key];
+    }
+    return series;
+}
+
+- (void)saveMetadata:(PPDeviceMeasurementsStoreSeries *)series {
+    [series.metadata writeToURL:[series.directoryURL URLByAppendingPathComponent:kSeriesMetadataFilename] atomically:YES];
+}
+
+#pragma mark - Blocks
+
+/**
+ * Validate block data and point into its time stamps and values
+ */
+static BOOL PPDeviceMeasurementsStoreBlockContents(NSData *data, const int64_t **timeStamps, const double **values, NSUInteger *count) {
+    if(data.length < sizeof(PPDeviceMeasurementsStoreBlockHeader)) {
+        return NO;
+    }
+
+    const PPDeviceMeasurementsStoreBlockHeader *header = data.bytes;
+    if(header->magic != kBlockMagic || header->version != kBlockVersion || data.length < sizeof(PPDeviceMeasurementsStoreBlockHeader) + header->count * (sizeof(int64_t) + sizeof(double))) {
+        return NO;
+    }
+
+    *count = header->count;
+    *timeStamps = (const int64_t *)((const uint8_t *)data.bytes + sizeof(PPDeviceMeasurementsStoreBlockHeader));
+    *values = (const double *)(*timeStamps + header->count);
+    return YES;
+}
+
+- (PPDeviceMeasurementsStoreBlock *)writeBlock:(PPDeviceMeasurementsStoreSeries *)series timeStamps:(const int64_t *)timeStamps values:(const double *)values count:(NSUInteger)count {
+    PPDeviceMeasurementsStoreBlockHeader header = {kBlockMagic, kBlockVersion, (uint32_t)count, 0};
+    NSMutableData *data = [[NSMutableData alloc] initWithCapacity:sizeof(header) + count * (sizeof(int64_t) + sizeof(double))];
+    [data appendBytes:&header length:sizeof(header)];
+    [data appendBytes:timeStamps length:count * sizeof(int64_t)];
+    [data appendBytes:values length:count * sizeof(double)];
+
+    PPDeviceMeasurementsStoreBlock *block = [[PPDeviceMeasurementsStoreBlock alloc] init];
+    block.firstTimeStamp = timeStamps[0];
+    block.lastTimeStamp = timeStamps[count - 1];
+    block.count = count;
+    block.url = [series.directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@"%020lld-%020lld.block", block.firstTimeStamp, block.lastTimeStamp]];
+
+    if(![data writeToURL:block.url atomically:YES]) {
+        return nil;
+    }
+    return block;
+}
+
+/**
+ * Memory-mapped block contents, nil if the block is missing or invalid
+ */
+- (NSData *)mappedBlock:(PPDeviceMeasurementsStoreBlock *)block timeStamps:(const int64_t **)timeStamps values:(const double **)values count:(NSUInteger *)count {
+    NSData *data = [NSData dataWithContentsOfURL:block.url options:NSDataReadingMappedAlways error:nil];
+    if(!PPDeviceMeasurementsStoreBlockContents(data, timeStamps, values, count)) {
+        return nil;
+    }
+    return data;
+}
+
+/**
+ * Write sorted values as blocks of at most MEASUREMENTS_STORE_BLOCK_CAPACITY
+ */
+- (void)writeBlocks:(PPDeviceMeasurementsStoreSeries *)series timeStamps:(const int64_t *)timeStamps values:(const double *)values count:(NSUInteger)count {
+    for(NSUInteger offset = 0; offset < count; offset += MEASUREMENTS_STORE_BLOCK_CAPACITY) {
+        NSUInteger length = MIN(MEASUREMENTS_STORE_BLOCK_CAPACITY, count - offset);
+        PPDeviceMeasurementsStoreBlock *block = [self writeBlock:series timeStamps:timeStamps + offset values:values + offset count:length];
+        if(block) {
+            [series.blocks addObject:block];
+        }
+    }
+    [series.blocks sortUsingComparator:^NSComparisonResult(PPDeviceMeasurementsStoreBlock *a, PPDeviceMeasurementsStoreBlock *b) {
+        return (a.firstTimeStamp < b.firstTimeStamp) ? NSOrderedAscending : (a.firstTimeStamp > b.firstTimeStamp) ? NSOrderedDescending : NSOrderedSame;
+    }];
+}
+
+#pragma mark - Writing
+
+static BOOL PPDeviceMeasurementsStoreParseValue(NSString *string, double *value) {
+    if(string.length == 0) {
+        return NO;
+    }
+    const char *chars = string.UTF8String;
+    char *end = NULL;
+    double parsed = strtod(chars, &end);
+    if(end == chars || *end != '\0' || !isfinite(parsed)) {
+        return NO;
+    }
+    *value = parsed;
+    return YES;
+}
+
+- (NSUInteger)addReadings:(NSArray *)readings {
+    __block NSUInteger stored = 0;
+    dispatch_sync(_ioQueue, ^{
+        stored = [self addPoints:[self pointsForReadings:readings]];
+    });
+    return stored;
+}
+
+- (void)addReadings:(NSArray *)readings callback:(PPNSIntegerBlock)callback {
+    dispatch_async(_ioQueue, ^{
+        NSUInteger stored = [self addPoints:[self pointsForReadings:readings]];
+        if(callback) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                callback(stored);
+            });
+        }
+    });
+}
+
+- (NSUInteger)addMeasurements:(NSArray *)measurements {
+    __block NSUInteger stored = 0;
+    dispatch_sync(_ioQueue, ^{
+        stored = [self addPoints:[self pointsForMeasurements:measurements]];
+    });
+    return stored;
+}
+
+- (void)addMeasurements:(NSArray *)measurements callback:(PPNSIntegerBlock)callback {
+    dispatch_async(_ioQueue, ^{
+        NSUInteger stored = [self addPoints:[self pointsForMeasurements:measurements]];
+        if(callback) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                callback(stored);
+            });
+        }
+    });
+}
+
+- (NSDictionary *)pointsForReadings:(NSArray *)readings {
+    NSMutableDictionary *points = [[NSMutableDictionary alloc] initWithCapacity:0];
+    for(PPDeviceMeasurementsReading *reading in readings) {
+        if(!reading.deviceId || !reading.timeStamp) {
+            continue;
+        }
+        for(PPDeviceParameter *parameter in reading.params) {
+            [self collectParameter:parameter deviceId:reading.deviceId timeStamp:reading.timeStamp points:points];
+        }
+    }
+    return points;
+}
+
+- (NSDictionary *)pointsForMeasurements:(NSArray *)measurements {
+    NSMutableDictionary *points = [[NSMutableDictionary alloc] initWithCapacity:0];
+    for(PPDeviceMeasurement *measurement in measurements) {
+        if(!measurement.deviceId) {
+            continue;
+        }
+        for(PPDeviceParameter *parameter in measurement.parameters) {
+            NSDate *timeStamp = parameter.lastUpdateDate ?: measurement.lastMeasureDate;
+            if(timeStamp) {
+                [self collectParameter:parameter deviceId:measurement.deviceId timeStamp:timeStamp points:points];
+            }
+        }
+    }
+    return points;
+}
+
+/**
+ * Group numeric values by series. Values are kept as [timeStamp, value] pairs.
+ */
+- (void)collectParameter:(PPDeviceParameter *)parameter deviceId:(NSString *)deviceId timeStamp:(NSDate *)timeStamp points:(NSMutableDictionary *)points {
+    double value;
+    if(!parameter.name || !PPDeviceMeasurementsStoreParseValue(parameter.value, &value)) {
+        return;
+    }
+
+    NSArray *seriesIdentity = @[deviceId, parameter.name, parameter.index ?: [NSNull null]];
+    NSMutableData *seriesPoints = [points objectForKey:seriesIdentity];
+    if(!seriesPoints) {
+        seriesPoints = [[NSMutableData alloc] initWithCapacity:0];
+        [points setObject:seriesPoints forKey:seriesIdentity];
+    }
+
+    int64_t timeStampMs = (int64_t)llround(timeStamp.timeIntervalSince1970 * 1000);
+    [seriesPoints appendBytes:&timeStampMs length:sizeof(timeStampMs)];
+    [seriesPoints appendBytes:&value length:sizeof(value)];
+}
+
+typedef struct {
+    int64_t timeStamp;
+    double value;
+} PPDeviceMeasurementsStorePoint;
+
+static int PPDeviceMeasurementsStoreComparePoints(const void *a, const void *b) {
+    int64_t left = ((const PPDeviceMeasurementsStorePoint *)a)->timeStamp;
+    int64_t right = ((const PPDeviceMeasurementsStorePoint *)b)->timeStamp;
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+/**
+ * Must be called on the I/O queue
+ */
+- (NSUInteger)addPoints:(NSDictionary *)points {
+    NSUInteger stored = 0;
+    for(NSArray *seriesIdentity in points) {
+        NSMutableData *seriesPoints = [points objectForKey:seriesIdentity];
+        NSString *index = (seriesIdentity[2] == [NSNull null]) ? nil : seriesIdentity[2];
+        PPDeviceMeasurementsStoreSeries *series = [self seriesForDeviceId:seriesIdentity[0] paramName:seriesIdentity[1] index:index create:YES];
+        stored += [self appendPoints:seriesPoints.mutableBytes count:seriesPoints.length / sizeof(PPDeviceMeasurementsStorePoint) series:series];
+    }
+    [self applyRetention];
+    return stored;
+}
+
+/**
+ * Must be called on the I/O queue
+ */
+- (NSUInteger)appendPoints:(PPDeviceMeasurementsStorePoint *)points count:(NSUInteger)count series:(PPDeviceMeasurementsStoreSeries *)series {
+    if(count == 0) {
+        return 0;
+    }
+
+    // Sort and keep the last value for each timestamp
+    mergesort(points, count, sizeof(PPDeviceMeasurementsStorePoint), PPDeviceMeasurementsStoreComparePoints);
+    NSUInteger unique = 0;
+    for(NSUInteger i = 0; i < count; i++) {
+        if(unique > 0 && points[unique - 1].timeStamp == points[i].timeStamp) {
+            points[unique - 1] = points[i];
+        }
+        else {
+            points[unique++] = points[i];
+        }
+    }
+
+    PPDeviceMeasurementsStoreBlock *lastBlock = series.blocks.lastObject;
+
+    // Values after the last block are appended, everything else is merged into the blocks it overlaps
+    NSUInteger newerStart = unique;
+    while(newerStart > 0 && (!lastBlock || points[newerStart - 1].timeStamp > lastBlock.lastTimeStamp)) {
+        newerStart--;
+    }
+
+    NSUInteger stored = unique - newerStart;
+    if(newerStart > 0) {
+        stored += [self mergePoints:points count:newerStart series:series];
+    }
+
+    if(newerStart < unique) {
+        NSUInteger newerCount = unique - newerStart;
+        NSMutableData *newerTimeStamps = [[NSMutableData alloc] initWithCapacity:newerCount * sizeof(int64_t)];
+        NSMutableData *newerValues = [[NSMutableData alloc] initWithCapacity:newerCount * sizeof(double)];
+        for(NSUInteger i = newerStart; i < unique; i++) {
+            [newerTimeStamps appendBytes:&points[i].timeStamp length:sizeof(int64_t)];
+            [newerValues appendBytes:&points[i].value length:sizeof(double)];
+        }
+
+        // Fill the last block up instead of leaving many small blocks behind
+        lastBlock = series.blocks.lastObject;
+        if(lastBlock && lastBlock.count < MEASUREMENTS_STORE_BLOCK_CAPACITY) {
+            const int64_t *lastTimeStamps;
+            const double *lastValues;
+            NSUInteger lastCount;
+            NSData *mapped = [self mappedBlock:lastBlock timeStamps:&lastTimeStamps values:&lastValues count:&lastCount];
+            if(mapped) {
+                NSMutableData *mergedTimeStamps = [[NSMutableData alloc] initWithBytes:lastTimeStamps length:lastCount * sizeof(int64_t)];
+                NSMutableData *mergedValues = [[NSMutableData alloc] initWithBytes:lastValues length:lastCount * sizeof(double)];
+                [mergedTimeStamps appendData:newerTimeStamps];
+                [mergedValues appendData:newerValues];
+                newerTimeStamps = mergedTimeStamps;
+                newerValues = mergedValues;
+                newerCount += lastCount;
+            }
+            [[NSFileManager defaultManager] removeItemAtURL:lastBlock.url error:nil];
+            [series.blocks removeObject:lastBlock];
+        }
+        [self writeBlocks:series timeStamps:newerTimeStamps.bytes values:newerValues.bytes count:newerCount];
+    }
+
+    return stored;
+}
+
+/**
+ * Merge sorted, unique points by timestamp into the blocks their range overlaps.
+ * A point replaces the stored value at its timestamp. Points in a gap between blocks are written as a new block.
+ * Must be called on the I/O queue.
+ *
+ * @return NSUInteger Number of timestamps that were not stored yet
+ */
+- (NSUInteger)mergePoints:(const PPDeviceMeasurementsStorePoint *)points count:(NSUInteger)count series:(PPDeviceMeasurementsStoreSeries *)series {
+    int64_t first = points[0].timeStamp;
+    int64_t last = points[count - 1].timeStamp;
+
+    NSMutableArray *overlapping = [[NSMutableArray alloc] initWithCapacity:1];
+    for(PPDeviceMeasurementsStoreBlock *block in series.blocks) {
+        if(block.lastTimeStamp >= first && block.firstTimeStamp <= last) {
+            [overlapping addObject:block];
+        }
+    }
+
+    NSMutableData *mergedTimeStamps = [[NSMutableData alloc] initWithCapacity:count * sizeof(int64_t)];
+    NSMutableData *mergedValues = [[NSMutableData alloc] initWithCapacity:count * sizeof(double)];
+    NSUInteger added = 0;
+    NSUInteger i = 0;
+
+    for(PPDeviceMeasurementsStoreBlock *block in overlapping) {
+        const int64_t *blockTimeStamps;
+        const double *blockValues;
+        NSUInteger blockCount;
+        NSData *mapped = [self mappedBlock:block timeStamps:&blockTimeStamps values:&blockValues count:&blockCount];
+        for(NSUInteger j = 0; mapped && j < blockCount; j++) {
+            while(i < count && points[i].timeStamp < blockTimeStamps[j]) {
+                [mergedTimeStamps appendBytes:&points[i].timeStamp length:sizeof(int64_t)];
+                [mergedValues appendBytes:&points[i].value length:sizeof(double)];
+                added++;
+                i++;
+            }
+            if(i < count && points[i].timeStamp == blockTimeStamps[j]) {
+                [mergedTimeStamps appendBytes:&points[i].timeStamp length:sizeof(int64_t)];
+                [mergedValues appendBytes:&points[i].value length:sizeof(double)];
+                i++;
+            }
+            else {
+                [mergedTimeStamps appendBytes:&blockTimeStamps[j] length:sizeof(int64_t)];
+                [mergedValues appendBytes:&blockValues[j] length:sizeof(double)];
+            }
+        }
+    }
+    for(; i < count; i++) {
+        [mergedTimeStamps appendBytes:&points[i].timeStamp length:sizeof(int64_t)];
+        [mergedValues appendBytes:&points[i].value length:sizeof(double)];
+        added++;
+    }
+
+    // New blocks may reuse the name of a block they replace, so only remove files that were not overwritten
+    [series.blocks removeObjectsInArray:overlapping];
+    [self writeBlocks:series timeStamps:mergedTimeStamps.bytes values:mergedValues.bytes count:mergedTimeStamps.length / sizeof(int64_t)];
+    NSSet *writtenURLs = [NSSet setWithArray:[series.blocks valueForKey:@"url"]];
+    for(PPDeviceMeasurementsStoreBlock *block in overlapping) {
+        if(![writtenURLs containsObject:block.url]) {
+            [[NSFileManager defaultManager] removeItemAtURL:block.url error:nil];
+        }
+    }
+
+    return added;
+}
+
+/**
+ * Remove blocks past the retention interval, then the oldest blocks above the disk limit.
+ * Must be called on the I/O queue.
+ */
+- (void)applyRetention {
+    int64_t cutoff = (int64_t)llround(([[NSDate date] timeIntervalSince1970] - self.retentionInterval) * 1000);
+
+    unsigned long long totalSize = 0;
+    NSMutableArray *candidates = [[NSMutableArray alloc] initWithCapacity:0];
+    for(PPDeviceMeasurementsStoreSeries *series in _series.allValues) {
+        for(PPDeviceMeasurementsStoreBlock *block in [series.blocks copy]) {
+            if(block.lastTimeStamp < cutoff) {
+                [self removeBlock:block series:series];
+                continue;
+            }
+            totalSize += sizeof(PPDeviceMeasurementsStoreBlockHeader) + block.count * (sizeof(int64_t) + sizeof(double));
+            [candidates addObject:@[block, series]];
+        }
+
+        NSNumber *coveredStart = [series.metadata objectForKey:kSeriesCoveredStartKey];
+        if(coveredStart && coveredStart.longLongValue < cutoff) {
+            [series.metadata setObject:@(cutoff) forKey:kSeriesCoveredStartKey];
+            [self saveMetadata:series];
+        }
+    }
+
+    if(totalSize <= self.maximumDiskSize) {
+        return;
+    }
+
+    [candidates sortUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b) {
+        int64_t left = ((PPDeviceMeasurementsStoreBlock *)a[0]).lastTimeStamp;
+        int64_t right = ((PPDeviceMeasurementsStoreBlock *)b[0]).lastTimeStamp;
+        return (left < right) ? NSOrderedAscending : (left > right) ? NSOrderedDescending : NSOrderedSame;
+    }];
+    for(NSArray *candidate in candidates) {
+        if(totalSize <= self.maximumDiskSize) {
+            break;
+        }
+        PPDeviceMeasurementsStoreBlock *block = candidate[0];
+        PPDeviceMeasurementsStoreSeries *series = candidate[1];
+        totalSize -= sizeof(PPDeviceMeasurementsStoreBlockHeader) + block.count * (sizeof(int64_t) + sizeof(double));
+        [self removeBlock:block series:series];
+
+        // The cloud range before the removed block is no longer stored
+        NSNumber *coveredStart = [series.metadata objectForKey:kSeriesCoveredStartKey];
+        if(coveredStart && coveredStart.longLongValue <= block.lastTimeStamp) {
+            [series.metadata setObject:@(block.lastTimeStamp + 1) forKey:kSeriesCoveredStartKey];
+            [self saveMetadata:series];
+        }
+    }
+}
+
+- (void)removeBlock:(PPDeviceMeasurementsStoreBlock *)block series:(PPDeviceMeasurementsStoreSeries *)series {
+    [[NSFileManager defaultManager] removeItemAtURL:block.url error:nil];
+    [series.blocks removeObject:block];
+}
+
+#pragma mark - Coverage
+
+- (void)setCoveredRangeForDeviceId:(NSString *)deviceId paramNames:(NSArray *)paramNames index:(NSString *)index startDate:(NSDate *)startDate endDate:(NSDate *)endDate {
+    int64_t start = (int64_t)llround(startDate.timeIntervalSince1970 * 1000);
+    int64_t end = (int64_t)llround(endDate.timeIntervalSince1970 * 1000);
+
+    dispatch_sync(_ioQueue, ^{
+        for(NSString *paramName in paramNames) {
+            PPDeviceMeasurementsStoreSeries *series = [self seriesForDeviceId:deviceId paramName:paramName index:index create:YES];
+            NSNumber *coveredStart = [series.metadata objectForKey:kSeriesCoveredStartKey];
+            NSNumber *coveredEnd = [series.metadata objectForKey:kSeriesCoveredEndKey];
+
+            int64_t seriesStart = start;
+            int64_t seriesEnd = end;
+            if(coveredStart && coveredEnd && start <= coveredEnd.longLongValue && end >= coveredStart.longLongValue) {
+                seriesStart = MIN(start, coveredStart.longLongValue);
+                seriesEnd = MAX(end, coveredEnd.longLongValue);
+            }
+            else {
+                // Disjoint ranges would leave a gap that looks stored
+                for(PPDeviceMeasurementsStoreBlock *block in [series.blocks copy]) {
+                    [self removeBlock:block series:series];
+                }
+            }
+
+            [series.metadata setObject:@(seriesStart) forKey:kSeriesCoveredStartKey];
+            [series.metadata setObject:@(seriesEnd) forKey:kSeriesCoveredEndKey];
+            [self saveMetadata:series];
+        }
+    });
+}
+
+- (NSDate *)coveredEndDateForDeviceId:(NSString *)deviceId paramNames:(NSArray *)paramNames index:(NSString *)index startDate:(NSDate *)startDate {
+    int64_t start = (int64_t)llround(startDate.timeIntervalSince1970 * 1000);
+    __block int64_t end = INT64_MAX;
+
+    dispatch_sync(_ioQueue, ^{
+        for(NSString *paramName in paramNames) {
+            PPDeviceMeasurementsStoreSeries *series = [self seriesForDeviceId:deviceId paramName:paramName index:index create:NO];
+            NSNumber *coveredStart = [series.metadata objectForKey:kSeriesCoveredStartKey];
+            NSNumber *coveredEnd = [series.metadata objectForKey:kSeriesCoveredEndKey];
+            if(!coveredStart || !coveredEnd || coveredStart.longLongValue > start || coveredEnd.longLongValue < start) {
+                end = INT64_MIN;
+                break;
+            }
+            end = MIN(end, coveredEnd.longLongValue);
+        }
+    });
+
+    if(end == INT64_MIN || end == INT64_MAX) {
+        return nil;
+    }
+    return [NSDate dateWithTimeIntervalSince1970:end / 1000.0];
+}
+
+#pragma mark - Reading
+
+- (NSUInteger)enumerateValuesForDeviceId:(NSString *)deviceId paramName:(NSString *)paramName index:(NSString *)index startDate:(NSDate *)startDate endDate:(NSDate *)endDate usingBlock:(void (^)(int64_t, double, BOOL *))block {
+    int64_t start = (int64_t)llround(startDate.timeIntervalSince1970 * 1000);
+    int64_t end = (int64_t)llround(endDate.timeIntervalSince1970 * 1000);
+
+    // Appends rewrite the last block and retention removes blocks, so map on the I/O queue.
+    // A mapping outlives the file being replaced or removed, so the scan itself runs off the queue.
+    NSMutableArray *mappedBlocks = [[NSMutableArray alloc] initWithCapacity:0];
+    dispatch_sync(_ioQueue, ^{
+        for(PPDeviceMeasurementsStoreBlock *storeBlock in [self seriesForDeviceId:deviceId paramName:paramName index:index create:NO].blocks) {
+            if(storeBlock.lastTimeStamp < start) {
+                continue;
+            }
+            if(storeBlock.firstTimeStamp > end) {
+                break;
+            }
+
+            const int64_t *timeStamps;
+            const double *values;
+            NSUInteger count;
+            NSData *mapped = [self mappedBlock:storeBlock timeStamps:&timeStamps values:&values count:&count];
+            if(mapped) {
+                [mappedBlocks addObject:mapped];
+            }
+        }
+    });
+
+    NSUInteger scanned = 0;
+    BOOL stop = NO;
+    for(NSData *mapped in mappedBlocks) {
+        const int64_t *timeStamps;
+        const double *values;
+        NSUInteger count;
+        PPDeviceMeasurementsStoreBlockContents(mapped, &timeStamps, &values, &count);
+
+        // Lower bound of start
+        NSUInteger low = 0;
+        NSUInteger high = count;
+        while(low < high) {
+            NSUInteger middle = low + (high - low) / 2;
+            if(timeStamps[middle] < start) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        for(NSUInteger i = low; i < count && timeStamps[i] <= end; i++) {
+            block(timeStamps[i], values[i], &stop);
+            scanned++;
+            if(stop) {
+                return scanned;
+            }
+        }
+    }
+    return scanned;
+}
+
+- (NSArray *)readingsForDeviceId:(NSString *)deviceId paramNames:(NSArray *)paramNames index:(NSString *)index startDate:(NSDate *)startDate endDate:(NSDate *)endDate {
+    NSMutableDictionary *parametersByTimeStamp = [[NSMutableDictionary alloc] initWithCapacity:0];
+    for(NSString *paramName in paramNames) {
+        [self enumerateValuesForDeviceId:deviceId paramName:paramName index:index startDate:startDate endDate:endDate usingBlock:^(int64_t timeStampMs, double value, BOOL *stop) {
+            NSDate *timeStamp = [NSDate dateWithTimeIntervalSince1970:timeStampMs / 1000.0];
+            NSMutableArray *parameters = [parametersByTimeStamp objectForKey:@(timeStampMs)];
+            if(!parameters) {
+                parameters = [[NSMutableArray alloc] initWithCapacity:paramNames.count];
+                [parametersByTimeStamp setObject:parameters forKey:@(timeStampMs)];
+            }
+            [parameters addObject:[[PPDeviceParameter alloc] initWithName:paramName index:index value:[NSString stringWithFormat:@"%.15g", value] lastUpdateDate:timeStamp]];
+        }];
+    }
+
+    NSArray *timeStamps = [parametersByTimeStamp.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:timeStamps.count];
+    for(NSNumber *timeStampMs in timeStamps) {
+        NSDate *timeStamp = [NSDate dateWithTimeIntervalSince1970:timeStampMs.longLongValue / 1000.0];
+        [readings addObject:[[PPDeviceMeasurementsReading alloc] initWithDeviceId:deviceId timeStamp:timeStamp params:[parametersByTimeStamp objectForKey:timeStampMs]]];
+    }
+    return readings;
+}
+
+- (void)removeAllValues {
+    dispatch_sync(_ioQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+        [[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        [self.series removeAllObjects];
+    });
+}
+
+@end
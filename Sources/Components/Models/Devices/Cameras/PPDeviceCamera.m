@@ -13,6 +13,8 @@
 @property (nonatomic) BOOL settingUpCameraSessionAndPublisher;
 @end
 
+typedef void (^PPDeviceCameraParameterHandler)(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex);
+
 @implementation PPDeviceCamera
 @synthesize selectedCamera;
 @synthesize selectedFlash;
@@ -174,429 +176,452 @@
     }
 }
 
-- (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate {
-    [super setParameter:paramName value:paramValue index:paramIndex lastUpdateDate:paramLastUpdateDate];
-    
-    // Camera
-    if([paramName isEqualToString:SELECTED_CAMERA]) {
-        if(selectedCamera != (PPDeviceParametersSelectedCamera)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
-            selectedCamera = (PPDeviceParametersSelectedCamera)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
-            if(paramValue.integerValue == PPDeviceParametersSelectedCameraFront && selectedFlash == PPDeviceParametersSelectedFlashOn) {
-                [self willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-                selectedFlash = PPDeviceParametersSelectedFlashWasOn;
-                [self didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+/**
+ * Parameter name -> handler that applies it to the typed properties, built once
+ */
++ (NSDictionary *)parameterHandlers {
+    static NSDictionary *parameterHandlers = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *handlers = [[NSMutableDictionary alloc] initWithCapacity:0];
+        
+        // Camera
+        handlers[SELECTED_CAMERA] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->selectedCamera != (PPDeviceParametersSelectedCamera)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
+                camera->selectedCamera = (PPDeviceParametersSelectedCamera)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
+                if(paramValue.integerValue == PPDeviceParametersSelectedCameraFront && camera->selectedFlash == PPDeviceParametersSelectedFlashOn) {
+                    [camera willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                    camera->selectedFlash = PPDeviceParametersSelectedFlashWasOn;
+                    [camera didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                }
             }
-        }
-    }
-    
-    // Flash
-    else if([paramName isEqualToString:FLASH_ON]) {
-        if(selectedCamera == PPDeviceParametersSelectedCameraFront && paramValue.integerValue == PPDeviceParametersSelectedFlashOn) {
-            paramValue = [NSString stringWithFormat:@"%li", (long)PPDeviceParametersSelectedFlashWasOn];
-        }
-        if(selectedFlash != (PPDeviceParametersSelectedFlash)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-            selectedFlash = (PPDeviceParametersSelectedFlash)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-        }
-    }
-    
-    // Motion Detection/Recording
-    else if([paramName isEqualToString:MOTION_STATUS]) {
-        if(motionStatus != (PPDeviceParametersCameraMotionStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(motionStatus))];
-            motionStatus = (PPDeviceParametersCameraMotionStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(motionStatus))];
-        }
-    }
-    else if([paramName isEqualToString:RECORD_SECONDS]) {
-        if(recordSeconds != (PPDeviceParametersRecordSeconds)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(recordSeconds))];
-            recordSeconds = (PPDeviceParametersRecordSeconds)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(recordSeconds))];
-        }
-    }
-    else if([paramName isEqualToString:MOTION_SENSITIVITY]) {
-        if(motionSensitivity != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(motionSensitivity))];
-            motionSensitivity = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(motionSensitivity))];
-        }
-    }
-    else if([paramName isEqualToString:MOTION_ACTIVITY]) {
-        if(motionActivity != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(motionActivity))];
-            motionActivity = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(motionActivity))];
-        }
-    }
-    else if([paramName isEqualToString:RAPID_MOTION_STATUS]) {
-        if(rapidMotionStatus != (PPDeviceParametersRapidMotionStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(rapidMotionStatus))];
-            rapidMotionStatus = (PPDeviceParametersRapidMotionStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(rapidMotionStatus))];
-        }
-    }
-    else if([paramName isEqualToString:MOTION_COUNTDOWN_TIME]) {
-        if(motionCountDownTime != (PPDeviceParametersMotionCountDownTime)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(motionCountDownTime))];
-            motionCountDownTime = (PPDeviceParametersMotionCountDownTime)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(motionCountDownTime))];
-        }
-    }
-    else if([paramName isEqualToString:RECORD_FULL_DURATION]) {
-        if(recordFullDuration != (PPDeviceParametersRecordFullDuration)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(recordFullDuration))];
-            recordFullDuration = (PPDeviceParametersRecordFullDuration)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(recordFullDuration))];
-        }
-    }
-    else if([paramName isEqualToString:RECORD_STATUS]) {
-        if(recordStatus != (PPDeviceParametersRecordStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
-            recordStatus = (PPDeviceParametersRecordStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
-        }
-    }
-    
-    // Audio Detection/Recording
-    else if([paramName isEqualToString:AUDIO_STATUS]) {
-        if(audioStatus != (PPDeviceParametersAudioStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
-            audioStatus = (PPDeviceParametersAudioStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
-        }
-    }
-    else if([paramName isEqualToString:AUDIO_SENSITIVITY]) {
-        if(audioSensitivity != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
-            audioSensitivity = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
-        }
-    }
-    else if([paramName isEqualToString:AUDIO_ACTIVITY]) {
-        if(audioActivity != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
-            audioActivity = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
-        }
-    }
-    
-    // Streaming
-    else if([paramName isEqualToString:AUDIO_STREAMING]) {
-        if(audioStreaming != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
-            audioStreaming = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
-        }
-    }
-    else if([paramName isEqualToString:VIDEO_STREAMING]) {
-        if(videoStreaming != (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
-            videoStreaming = (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
-        }
-    }
-    else if([paramName isEqualToString:ACCESS_CAMERA_SETTINGS]) {
-        if(accessCameraSettings != (PPDeviceParametersAccessCameraSettings)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(accessCameraSettings))];
-            accessCameraSettings = (PPDeviceParametersAccessCameraSettings)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(accessCameraSettings))];
-        }
-    }
+        };
+        
+        // Flash
+        handlers[FLASH_ON] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->selectedCamera == PPDeviceParametersSelectedCameraFront && paramValue.integerValue == PPDeviceParametersSelectedFlashOn) {
+                paramValue = [NSString stringWithFormat:@"%li", (long)PPDeviceParametersSelectedFlashWasOn];
+            }
+            if(camera->selectedFlash != (PPDeviceParametersSelectedFlash)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                camera->selectedFlash = (PPDeviceParametersSelectedFlash)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+            }
+        };
+        
+        // Motion Detection/Recording
+        handlers[MOTION_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->motionStatus != (PPDeviceParametersCameraMotionStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(motionStatus))];
+                camera->motionStatus = (PPDeviceParametersCameraMotionStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(motionStatus))];
+            }
+        };
+        handlers[RECORD_SECONDS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->recordSeconds != (PPDeviceParametersRecordSeconds)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(recordSeconds))];
+                camera->recordSeconds = (PPDeviceParametersRecordSeconds)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(recordSeconds))];
+            }
+        };
+        handlers[MOTION_SENSITIVITY] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->motionSensitivity != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(motionSensitivity))];
+                camera->motionSensitivity = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(motionSensitivity))];
+            }
+        };
+        handlers[MOTION_ACTIVITY] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->motionActivity != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(motionActivity))];
+                camera->motionActivity = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(motionActivity))];
+            }
+        };
+        handlers[RAPID_MOTION_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->rapidMotionStatus != (PPDeviceParametersRapidMotionStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(rapidMotionStatus))];
+                camera->rapidMotionStatus = (PPDeviceParametersRapidMotionStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(rapidMotionStatus))];
+            }
+        };
+        handlers[MOTION_COUNTDOWN_TIME] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->motionCountDownTime != (PPDeviceParametersMotionCountDownTime)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(motionCountDownTime))];
+                camera->motionCountDownTime = (PPDeviceParametersMotionCountDownTime)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(motionCountDownTime))];
+            }
+        };
+        handlers[RECORD_FULL_DURATION] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->recordFullDuration != (PPDeviceParametersRecordFullDuration)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(recordFullDuration))];
+                camera->recordFullDuration = (PPDeviceParametersRecordFullDuration)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(recordFullDuration))];
+            }
+        };
+        handlers[RECORD_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->recordStatus != (PPDeviceParametersRecordStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
+                camera->recordStatus = (PPDeviceParametersRecordStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
+            }
+        };
+        
+        // Audio Detection/Recording
+        handlers[AUDIO_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->audioStatus != (PPDeviceParametersAudioStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
+                camera->audioStatus = (PPDeviceParametersAudioStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
+            }
+        };
+        handlers[AUDIO_SENSITIVITY] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->audioSensitivity != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
+                camera->audioSensitivity = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
+            }
+        };
+        handlers[AUDIO_ACTIVITY] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->audioActivity != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
+                camera->audioActivity = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
+            }
+        };
+        
+        // Streaming
+        handlers[AUDIO_STREAMING] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->audioStreaming != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
+                camera->audioStreaming = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
+            }
+        };
+        handlers[VIDEO_STREAMING] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->videoStreaming != (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
+                camera->videoStreaming = (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
+            }
+        };
+        handlers[ACCESS_CAMERA_SETTINGS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->accessCameraSettings != (PPDeviceParametersAccessCameraSettings)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(accessCameraSettings))];
+                camera->accessCameraSettings = (PPDeviceParametersAccessCameraSettings)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(accessCameraSettings))];
+            }
+        };
 #if !TARGET_OS_WATCH
-    else if([paramName isEqualToString:STREAM_ID]) {
-        if(![streamId isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(streamId))];
-            streamId = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(streamId))];
-        }
-    }
+        handlers[STREAM_ID] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->streamId isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(streamId))];
+                camera->streamId = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(streamId))];
+            }
+        };
 #endif
-    else if([paramName isEqualToString:WARNING_STATUS]) {
-        if(warningStatus != (PPDeviceParametersWarningStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(warningStatus))];
-            warningStatus = (PPDeviceParametersWarningStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(warningStatus))];
-        }
-    }
-    else if([paramName isEqualToString:WARNING_TEXT]) {
-        if(![warningText isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(warningText))];
-            warningText = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(warningText))];
-        }
-    }
-    else if([paramName isEqualToString:SUPPORTS_VIDEO_CALL]) {
-        if(supportsVideoCall != paramValue.boolValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
-            supportsVideoCall = paramValue.boolValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
-        }
-    }
+        handlers[WARNING_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->warningStatus != (PPDeviceParametersWarningStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(warningStatus))];
+                camera->warningStatus = (PPDeviceParametersWarningStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(warningStatus))];
+            }
+        };
+        handlers[WARNING_TEXT] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->warningText isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(warningText))];
+                camera->warningText = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(warningText))];
+            }
+        };
+        handlers[SUPPORTS_VIDEO_CALL] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->supportsVideoCall != paramValue.boolValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
+                camera->supportsVideoCall = paramValue.boolValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
+            }
+        };
 #if !TARGET_OS_WATCH
-    else if([paramName isEqualToString:RECORD_STREAM]) {
-        if(recordStream != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(recordStream))];
-            recordStream = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(recordStream))];
-        }
-    }
+        handlers[RECORD_STREAM] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->recordStream != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(recordStream))];
+                camera->recordStream = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(recordStream))];
+            }
+        };
 #endif
-    else if([paramName isEqualToString:MOTION_ALARM]) {
-        if(motionAlarm != (PPDeviceParametersAlarm)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(motionAlarm))];
-            motionAlarm = (PPDeviceParametersAlarm)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(motionAlarm))];
-        }
-    }
-    
-    // Robot
-    else if([paramName isEqualToString:ROBOT_CONNECTED]) {
-        if(robotConnected != (PPDeviceParametersRobotConnected)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(robotConnected))];
-            robotConnected = (PPDeviceParametersRobotConnected)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(robotConnected))];
-        }
-    }
-    else if([paramName isEqualToString:ROBOT_MOTION_DIRECTION]) {
-        if(robotMotionDirection != (PPDeviceParametersRobotMotionDirection)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(robotMotionDirection))];
-            robotMotionDirection = (PPDeviceParametersRobotMotionDirection)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(robotMotionDirection))];
-        }
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_SPHERICAL_COORDINATES]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantagePoints))];
-        NSInteger vantageIndex = 0;
-        if(paramIndex) {
-            vantageIndex = paramIndex.integerValue;
-        }
-        paramValue = [paramValue stringByReplacingOccurrencesOfString:@"[" withString:@""];
-        paramValue = [paramValue stringByReplacingOccurrencesOfString:@"]" withString:@""];
-        NSArray *vantagePointArray = [paramValue componentsSeparatedByString:@","];
-        PPDeviceParameterRobotVantagePoint *vantagePoint = [[PPDeviceParameterRobotVantagePoint alloc] initWithZoomLevel:[vantagePointArray objectAtIndex:0] horizontalRotation:[vantagePointArray objectAtIndex:1] verticalRotation:[vantagePointArray objectAtIndex:2]];
-        if(robotVantagePoints.count > vantageIndex) {
-            [robotVantagePoints replaceObjectAtIndex:vantageIndex withObject:vantagePoint];
-        }
-        else {
-            [robotVantagePoints addObject:vantagePoint];
-        }
-        [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantagePoints))];
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_TIME]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantageTimers))];
-        NSInteger vantageIndex = 0;
-        if(paramIndex) {
-            vantageIndex = paramIndex.integerValue;
-        }
-        if(robotVantageTimers.count > vantageIndex) {
-            [robotVantageTimers replaceObjectAtIndex:vantageIndex withObject:paramValue];
-        }
-        else {
-            // Set every index below our current to -1 so we can maintain our current indexed value
-            while(robotVantageTimers.count < vantageIndex) {
-                [robotVantageTimers addObject:@"-1"];
+        handlers[MOTION_ALARM] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->motionAlarm != (PPDeviceParametersAlarm)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(motionAlarm))];
+                camera->motionAlarm = (PPDeviceParametersAlarm)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(motionAlarm))];
             }
-            [robotVantageTimers addObject:paramValue];
-        }
-        [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantageTimers))];
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_NAME]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
-        NSInteger vantageIndex = 0;
-        if(paramIndex) {
-            vantageIndex = paramIndex.integerValue;
-        }
-        if(robotVantageNames.count > vantageIndex) {
-            [robotVantageNames replaceObjectAtIndex:vantageIndex withObject:paramValue];
-        }
-        else {
-            // Set every index below our current to -1 so we can maintain our current indexed value
-            while(robotVantageNames.count < vantageIndex) {
-                [robotVantageNames addObject:@" "];
+        };
+        
+        // Robot
+        handlers[ROBOT_CONNECTED] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->robotConnected != (PPDeviceParametersRobotConnected)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(robotConnected))];
+                camera->robotConnected = (PPDeviceParametersRobotConnected)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(robotConnected))];
             }
-            [robotVantageNames addObject:paramValue];
-        }
-        [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_SEQUENCE]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantageSequence))];
-        if([paramValue isEqualToString:@"-1"]) {
-            robotVantageSequence = [[NSMutableArray alloc] init];
-        }
-        else {
-            NSArray *vantageIndexes = [paramValue componentsSeparatedByString:@","];
-            robotVantageSequence = [[NSMutableArray alloc] initWithArray:vantageIndexes];
-        }
-        [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_CONFIGURATION_STATUS]) {
-        if(robotVantageConfigurationStatus != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantageConfigurationStatus))];
-            robotVantageConfigurationStatus = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantageConfigurationStatus))];
-        }
-    }
-    else if([paramName isEqualToString:ROBOT_VANTAGE_MOVE_TO_INDEX]) {
-        if(robotVantageMoveToIndex != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(robotVantageMoveToIndex))];
-            robotVantageMoveToIndex = paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(robotVantageMoveToIndex))];
-        }
-    }
-    else if([paramName isEqualToString:ROBOT_ORIENTATION]) {
-        if(robotOrientation != paramValue.boolValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(robotOrientation))];
-            robotOrientation = paramValue.boolValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(robotOrientation))];
-        }
-    }
-    
-    // Twitter
-    else if([paramName isEqualToString:TWITTER_AUTO_SHARE]) {
-        if(twitterAutoShare != (PPDeviceParametersTwitterAutoShare)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
-            twitterAutoShare = (PPDeviceParametersTwitterAutoShare)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
-        }
-    }
-    else if([paramName isEqualToString:TWITTER_DESCRIPTION]) {
-        if(![twitterDescription isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(twitterDescription))];
-            twitterDescription = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(twitterDescription))];
-        }
-    }
-    else if([paramName isEqualToString:TWITTER_REMINDER]) {
-        if(twitterReminder != (PPDeviceParametersTwitterReminder)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(twitterReminder))];
-            twitterReminder = (PPDeviceParametersTwitterReminder)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(twitterReminder))];
-        }
-    }
-    else if([paramName isEqualToString:TWITTER_STATUS]) {
-        if(twitterStatus != (PPDeviceParametersTwitterStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(twitterStatus))];
-            twitterStatus = (PPDeviceParametersTwitterStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(twitterStatus))];
-        }
+        };
+        handlers[ROBOT_MOTION_DIRECTION] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->robotMotionDirection != (PPDeviceParametersRobotMotionDirection)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(robotMotionDirection))];
+                camera->robotMotionDirection = (PPDeviceParametersRobotMotionDirection)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(robotMotionDirection))];
+            }
+        };
+        handlers[ROBOT_VANTAGE_SPHERICAL_COORDINATES] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantagePoints))];
+            NSInteger vantageIndex = 0;
+            if(paramIndex) {
+                vantageIndex = paramIndex.integerValue;
+            }
+            paramValue = [paramValue stringByReplacingOccurrencesOfString:@"[" withString:@""];
+            paramValue = [paramValue stringByReplacingOccurrencesOfString:@"]" withString:@""];
+            NSArray *vantagePointArray = [paramValue componentsSeparatedByString:@","];
+            PPDeviceParameterRobotVantagePoint *vantagePoint = [[PPDeviceParameterRobotVantagePoint alloc] initWithZoomLevel:[vantagePointArray objectAtIndex:0] horizontalRotation:[vantagePointArray objectAtIndex:1] verticalRotation:[vantagePointArray objectAtIndex:2]];
+            if(camera->robotVantagePoints.count > vantageIndex) {
+                [camera->robotVantagePoints replaceObjectAtIndex:vantageIndex withObject:vantagePoint];
+            }
+            else {
+                [camera->robotVantagePoints addObject:vantagePoint];
+            }
+            [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantagePoints))];
+        };
+        handlers[ROBOT_VANTAGE_TIME] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantageTimers))];
+            NSInteger vantageIndex = 0;
+            if(paramIndex) {
+                vantageIndex = paramIndex.integerValue;
+            }
+            if(camera->robotVantageTimers.count > vantageIndex) {
+                [camera->robotVantageTimers replaceObjectAtIndex:vantageIndex withObject:paramValue];
+            }
+            else {
+                // Set every index below our current to -1 so we can maintain our current indexed value
+                while(camera->robotVantageTimers.count < vantageIndex) {
+                    [camera->robotVantageTimers addObject:@"-1"];
+                }
+                [camera->robotVantageTimers addObject:paramValue];
+            }
+            [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantageTimers))];
+        };
+        handlers[ROBOT_VANTAGE_NAME] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
+            NSInteger vantageIndex = 0;
+            if(paramIndex) {
+                vantageIndex = paramIndex.integerValue;
+            }
+            if(camera->robotVantageNames.count > vantageIndex) {
+                [camera->robotVantageNames replaceObjectAtIndex:vantageIndex withObject:paramValue];
+            }
+            else {
+                // Set every index below our current to -1 so we can maintain our current indexed value
+                while(camera->robotVantageNames.count < vantageIndex) {
+                    [camera->robotVantageNames addObject:@" "];
+                }
+                [camera->robotVantageNames addObject:paramValue];
+            }
+            [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
+        };
+        handlers[ROBOT_VANTAGE_SEQUENCE] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantageSequence))];
+            if([paramValue isEqualToString:@"-1"]) {
+                camera->robotVantageSequence = [[NSMutableArray alloc] init];
+            }
+            else {
+                NSArray *vantageIndexes = [paramValue componentsSeparatedByString:@","];
+                camera->robotVantageSequence = [[NSMutableArray alloc] initWithArray:vantageIndexes];
+            }
+            [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantageNames))];
+        };
+        handlers[ROBOT_VANTAGE_CONFIGURATION_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->robotVantageConfigurationStatus != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantageConfigurationStatus))];
+                camera->robotVantageConfigurationStatus = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantageConfigurationStatus))];
+            }
+        };
+        handlers[ROBOT_VANTAGE_MOVE_TO_INDEX] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->robotVantageMoveToIndex != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(robotVantageMoveToIndex))];
+                camera->robotVantageMoveToIndex = paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(robotVantageMoveToIndex))];
+            }
+        };
+        handlers[ROBOT_ORIENTATION] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->robotOrientation != paramValue.boolValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(robotOrientation))];
+                camera->robotOrientation = paramValue.boolValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(robotOrientation))];
+            }
+        };
         
-        if(twitterAutoShare != paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
-            twitterAutoShare = (PPDeviceParametersTwitterAutoShare)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
-        }
-    }
-    
-    // Various
-    else if([paramName isEqualToString:HD_STATUS]) {
-        if(HDStatus != (PPDeviceParametersHDStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(HDStatus))];
-            // Pro features need an extra check
-            HDStatus = (PPDeviceParametersHDStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(HDStatus))];
-        }
-    }
-    else if ([paramName isEqualToString:BATTERY_LEVEL]) {
-        if(batteryLevel != (PPDeviceParametersBatteryLevel)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
-            batteryLevel = (PPDeviceParametersBatteryLevel)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
-        }
-    }
-    else if([paramName isEqualToString:CHARGING]) {
-        if(charging != (PPDeviceParametersCharging)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(charging))];
-            charging = (PPDeviceParametersCharging)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(charging))];
-        }
-    }
-    else if([paramName isEqualToString:VERSION]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(version))];
-        version = [[PPVersion alloc] initWithVersion:paramValue];
-        [self didChangeValueForKey:NSStringFromSelector(@selector(version))];
-    }
-    else if([paramName isEqualToString:AVAILABLE_BYTES]) {
-        if(availableBytes != [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
-            availableBytes = [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue];
-            [self didChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
-        }
-    }
-    else if([paramName isEqualToString:BLACKOUT_SCREEN_ON]) {
-        if(blackoutScreenOn != (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
-            blackoutScreenOn = (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
-        }
-    }
-    else if([paramName isEqualToString:AUTO_FOCUS]) {
-        if(autoFocus != (PPDeviceParametersAutoFocus)paramValue.boolValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(autoFocus))];
-            autoFocus = (PPDeviceParametersAutoFocus)paramValue.boolValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(autoFocus))];
-        }
-    }
-    else if([paramName isEqualToString:OUTPUT_VOLUME]) {
-        if(outputVolume != (PPDeviceParametersOutputVolume)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
-            outputVolume = (PPDeviceParametersOutputVolume)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
-        }
-    }
-    else if([paramName isEqualToString:CAPTURE_IMAGE]) {
-        if(captureImage != (PPDeviceParametersCaptureImage)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(captureImage))];
-            captureImage = (PPDeviceParametersCaptureImage)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(captureImage))];
-        }
-    }
+        // Twitter
+        handlers[TWITTER_AUTO_SHARE] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->twitterAutoShare != (PPDeviceParametersTwitterAutoShare)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
+                camera->twitterAutoShare = (PPDeviceParametersTwitterAutoShare)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
+            }
+        };
+        handlers[TWITTER_DESCRIPTION] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->twitterDescription isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(twitterDescription))];
+                camera->twitterDescription = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(twitterDescription))];
+            }
+        };
+        handlers[TWITTER_REMINDER] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->twitterReminder != (PPDeviceParametersTwitterReminder)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(twitterReminder))];
+                camera->twitterReminder = (PPDeviceParametersTwitterReminder)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(twitterReminder))];
+            }
+        };
+        handlers[TWITTER_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->twitterStatus != (PPDeviceParametersTwitterStatus)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(twitterStatus))];
+                camera->twitterStatus = (PPDeviceParametersTwitterStatus)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(twitterStatus))];
+            }
+        
+            if(camera->twitterAutoShare != paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
+                camera->twitterAutoShare = (PPDeviceParametersTwitterAutoShare)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(twitterAutoShare))];
+            }
+        };
+        
+        // Various
+        handlers[HD_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->HDStatus != (PPDeviceParametersHDStatus)paramValue.integerValue > 0) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(HDStatus))];
+                // Pro features need an extra check
+                camera->HDStatus = (PPDeviceParametersHDStatus)paramValue.integerValue > 0;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(HDStatus))];
+            }
+        };
+        handlers[BATTERY_LEVEL] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->batteryLevel != (PPDeviceParametersBatteryLevel)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
+                camera->batteryLevel = (PPDeviceParametersBatteryLevel)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
+            }
+        };
+        handlers[CHARGING] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->charging != (PPDeviceParametersCharging)paramValue.integerValue > 0) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(charging))];
+                camera->charging = (PPDeviceParametersCharging)paramValue.integerValue > 0;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(charging))];
+            }
+        };
+        handlers[VERSION] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            [camera willChangeValueForKey:NSStringFromSelector(@selector(version))];
+            camera->version = [[PPVersion alloc] initWithVersion:paramValue];
+            [camera didChangeValueForKey:NSStringFromSelector(@selector(version))];
+        };
+        handlers[AVAILABLE_BYTES] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            unsigned long availableBytes = [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue];
+            if(camera->availableBytes != availableBytes) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
+                camera->availableBytes = availableBytes;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
+            }
+        };
+        handlers[BLACKOUT_SCREEN_ON] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->blackoutScreenOn != (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
+                camera->blackoutScreenOn = (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
+            }
+        };
+        handlers[AUTO_FOCUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->autoFocus != (PPDeviceParametersAutoFocus)paramValue.boolValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(autoFocus))];
+                camera->autoFocus = (PPDeviceParametersAutoFocus)paramValue.boolValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(autoFocus))];
+            }
+        };
+        handlers[OUTPUT_VOLUME] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->outputVolume != (PPDeviceParametersOutputVolume)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
+                camera->outputVolume = (PPDeviceParametersOutputVolume)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
+            }
+        };
+        handlers[CAPTURE_IMAGE] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->captureImage != (PPDeviceParametersCaptureImage)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(captureImage))];
+                camera->captureImage = (PPDeviceParametersCaptureImage)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(captureImage))];
+            }
+        };
+        
+        // Security
+        handlers[ALARM] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->alarm != (PPDeviceParametersAlarm)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(alarm))];
+                camera->alarm = (PPDeviceParametersAlarm)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(alarm))];
+            }
+        };
+        handlers[PLAY_SOUND] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->playSound isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(playSound))];
+                camera->playSound = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(playSound))];
+            }
+        };
+        handlers[COUNTDOWN] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->countdown != (PPDeviceParametersCountdown)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(countdown))];
+                camera->countdown = (PPDeviceParametersCountdown)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(countdown))];
+            }
+        };
+        handlers[VISUAL_COUNTDOWN] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(camera->visualCountdown != (PPDeviceParametersVisualCountdown)paramValue.integerValue) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(visualCountdown))];
+                camera->visualCountdown = (PPDeviceParametersVisualCountdown)paramValue.integerValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(visualCountdown))];
+            }
+        };
+        handlers[KEYPAD_STATUS] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->keypadStatus isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(keypadStatus))];
+                camera->keypadStatus = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(keypadStatus))];
+            }
+        };
+        handlers[MODE] = ^(PPDeviceCamera *camera, NSString *paramValue, NSString *paramIndex) {
+            if(![camera->mode isEqualToString:paramValue]) {
+                [camera willChangeValueForKey:NSStringFromSelector(@selector(mode))];
+                camera->mode = paramValue;
+                [camera didChangeValueForKey:NSStringFromSelector(@selector(mode))];
+            }
+        };
+        
+        parameterHandlers = handlers;
+    });
+    return parameterHandlers;
+}
+
+- (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate {
+    [super setParameter:paramName value:paramValue index:paramIndex lastUpdateDate:paramLastUpdateDate];
     
-    // Security
-    else if([paramName isEqualToString:ALARM]) {
-        if(alarm != (PPDeviceParametersAlarm)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alarm))];
-            alarm = (PPDeviceParametersAlarm)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alarm))];
-        }
-    }
-    else if([paramName isEqualToString:PLAY_SOUND]) {
-        if(![playSound isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(playSound))];
-            playSound = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(playSound))];
-        }
-    }
-    else if([paramName isEqualToString:COUNTDOWN]) {
-        if(countdown != (PPDeviceParametersCountdown)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(countdown))];
-            countdown = (PPDeviceParametersCountdown)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(countdown))];
-        }
-    }
-    else if([paramName isEqualToString:VISUAL_COUNTDOWN]) {
-        if(visualCountdown != (PPDeviceParametersVisualCountdown)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(visualCountdown))];
-            visualCountdown = (PPDeviceParametersVisualCountdown)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(visualCountdown))];
-        }
-    }
-    else if([paramName isEqualToString:KEYPAD_STATUS]) {
-        if(![keypadStatus isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(keypadStatus))];
-            keypadStatus = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(keypadStatus))];
-        }
+    if(!paramName) {
+        return;
     }
-    else if([paramName isEqualToString:MODE]) {
-        if(![mode isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(mode))];
-            mode = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(mode))];
-        }
+    PPDeviceCameraParameterHandler handler = [[PPDeviceCamera parameterHandlers] objectForKey:paramName];
+    if(handler) {
+        handler(self, paramValue, paramIndex);
     }
 }
 #if !TARGET_OS_WATCH
@@ -8,6 +8,7 @@
 
 #import "PPDeviceFirmwareUpdateDownloadManager.h"
 #import "PPDeviceFirmwareUpdateJob.h"
+#import <CommonCrypto/CommonDigest.h>
 
 #if !TARGET_OS_WATCH
 #import <AssetsLibrary/ALAsset.h>
@@ -15,8 +16,419 @@
 
 #import <AVFoundation/AVFoundation.h>
 
+/**
+ * Size of the chunks read back from a partial file when a download resumes
+ */
+static const NSUInteger PPDeviceFirmwareUpdateDownloadReadLength = 64 * 1024;
+
+typedef NS_ENUM(NSInteger, PPDeviceFirmwareUpdateDownloadDigest) {
+    PPDeviceFirmwareUpdateDownloadDigestNone = 0,
+    PPDeviceFirmwareUpdateDownloadDigestMD5,
+    PPDeviceFirmwareUpdateDownloadDigestSHA1,
+    PPDeviceFirmwareUpdateDownloadDigestSHA256
+};
+
+/**
+ * State of one firmware transfer. Only touched on the shared session's delegate queue.
+ */
+@interface PPDeviceFirmwareUpdateDownload : NSObject {
+    union {
+        CC_MD5_CTX md5;
+        CC_SHA1_CTX sha1;
+        CC_SHA256_CTX sha256;
+    } _context;
+}
+
+@property (nonatomic, strong) PPDeviceFirmwareUpdateJob *job;
+@property (nonatomic, strong) NSString *partialFilePath;
+@property (nonatomic, strong) NSString *validatorFilePath;
+@property (nonatomic, strong) NSFileHandle *fileHandle;
+@property (nonatomic, strong) NSURLSessionDataTask *task;
+@property (nonatomic) PPDeviceFirmwareUpdateDownloadDigest digest;
+@property (nonatomic) unsigned long long receivedLength;
+
+// Writing to the partial file failed, the task was cancelled to stop the transfer
+@property (nonatomic) BOOL writeFailed;
+@property (nonatomic, strong) NSProgress *progress;
+@property (nonatomic, copy) void (^progressBlock)(NSProgress *progress);
+@property (nonatomic, copy) void (^completionBlock)(NSError *error);
+
+@end
+
+@implementation PPDeviceFirmwareUpdateDownload
+
+- (void)resetDigest {
+    switch(_digest) {
+        case PPDeviceFirmwareUpdateDownloadDigestMD5:
+            CC_MD5_Init(&_context.md5);
+            break;
+        case PPDeviceFirmwareUpdateDownloadDigestSHA1:
+            CC_SHA1_Init(&_context.sha1);
+            break;
+        case PPDeviceFirmwareUpdateDownloadDigestSHA256:
+            CC_SHA256_Init(&_context.sha256);
+            break;
+        default:
+            break;
+    }
+}
+
+- (void)updateDigest:(NSData *)data {
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        switch(self->_digest) {
+            case PPDeviceFirmwareUpdateDownloadDigestMD5:
+                CC_MD5_Update(&self->_context.md5, bytes, (CC_LONG)byteRange.length);
+                break;
+            case PPDeviceFirmwareUpdateDownloadDigestSHA1:
+                CC_SHA1_Update(&self->_context.sha1, bytes, (CC_LONG)byteRange.length);
+                break;
+            case PPDeviceFirmwareUpdateDownloadDigestSHA256:
+                CC_SHA256_Update(&self->_context.sha256, bytes, (CC_LONG)byteRange.length);
+                break;
+            default:
+                break;
+        }
+    }];
+}
+
+/**
+ * @return NSString Lowercase hex digest of everything received, nil if the job has no usable checksum
+ */
+- (NSString *)finalDigest {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    NSUInteger digestLength = 0;
+    switch(_digest) {
+        case PPDeviceFirmwareUpdateDownloadDigestMD5:
+            CC_MD5_Final(digest, &_context.md5);
+            digestLength = CC_MD5_DIGEST_LENGTH;
+            break;
+        case PPDeviceFirmwareUpdateDownloadDigestSHA1:
+            CC_SHA1_Final(digest, &_context.sha1);
+            digestLength = CC_SHA1_DIGEST_LENGTH;
+            break;
+        case PPDeviceFirmwareUpdateDownloadDigestSHA256:
+            CC_SHA256_Final(digest, &_context.sha256);
+            digestLength = CC_SHA256_DIGEST_LENGTH;
+            break;
+        default:
+            return nil;
+    }
+    NSMutableString *hex = [[NSMutableString alloc] initWithCapacity:digestLength * 2];
+    for(NSUInteger i = 0; i < digestLength; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+@end
+
+/**
+ * One URL session shared by every firmware download, writing each response to disk as it arrives.
+ */
+@interface PPDeviceFirmwareUpdateDownloadSession : NSObject <NSURLSessionDataDelegate>
+
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSOperationQueue *delegateQueue;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, PPDeviceFirmwareUpdateDownload *> *downloads;
+
++ (PPDeviceFirmwareUpdateDownloadSession *)sharedSession;
+
+- (void)download:(PPDeviceFirmwareUpdateDownload *)download;
+- (void)cancel:(PPDeviceFirmwareUpdateDownload *)download;
+
+@end
+
+@implementation PPDeviceFirmwareUpdateDownloadSession
+
++ (PPDeviceFirmwareUpdateDownloadSession *)sharedSession {
+    static PPDeviceFirmwareUpdateDownloadSession *sharedSession = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedSession = [[PPDeviceFirmwareUpdateDownloadSession alloc] init];
+    });
+    return sharedSession;
+}
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        _delegateQueue = [[NSOperationQueue alloc] init];
+        _delegateQueue.maxConcurrentOperationCount = 1;
+        _delegateQueue.name = @"com.peoplepowerco.lib.firmware.download";
+        _downloads = [[NSMutableDictionary alloc] initWithCapacity:0];
+    
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        configuration.URLCache = nil;
+        _session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:_delegateQueue];
+    }
+    return self;
+}
+
+/**
+ * Open the partial file and request whatever it is missing.
+ * Bytes already on disk are fed back through the digest first, so the checksum still covers the whole image.
+ */
+- (void)download:(PPDeviceFirmwareUpdateDownload *)download {
+    [_delegateQueue addOperationWithBlock:^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        if(![fileManager fileExistsAtPath:download.partialFilePath]) {
+            [fileManager createFileAtPath:download.partialFilePath contents:nil attributes:nil];
+        }
+        download.fileHandle = [NSFileHandle fileHandleForUpdatingAtPath:download.partialFilePath];
+        if(!download.fileHandle) {
+            [self finish:download error:[PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])]];
+            return;
+        }
+    
+        [download resetDigest];
+        download.receivedLength = 0;
+        while(YES) {
+            @autoreleasepool {
+                NSData *data = [download.fileHandle readDataOfLength:PPDeviceFirmwareUpdateDownloadReadLength];
+                if(data.length == 0) {
+                    break;
+                }
+                [download updateDigest:data];
+                download.receivedLength += data.length;
+            }
+        }
+    
+        // Only resume when the server can tell us the image changed, or when the checksum would catch it
+        NSString *validator = [NSString stringWithContentsOfFile:download.validatorFilePath encoding:NSUTF8StringEncoding error:nil];
+        if(download.receivedLength > 0 && !validator && download.digest == PPDeviceFirmwareUpdateDownloadDigestNone) {
+            [download.fileHandle truncateFileAtOffset:0];
+            [download resetDigest];
+            download.receivedLength = 0;
+        }
+        
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:download.job.url]];
+        if(download.receivedLength > 0) {
+            [request setValue:[NSString stringWithFormat:@"bytes=%llu-", download.receivedLength] forHTTPHeaderField:@"Range"];
+            if(validator) {
+                [request setValue:validator forHTTPHeaderField:@"If-Range"];
+            }
+        }
+        download.task = [self.session dataTaskWithRequest:request];
+        [self.downloads setObject:download forKey:@(download.task.taskIdentifier)];
+        [download.task resume];
+    }];
+}
+
+/**
+ * Cancel a download once it has started. Its partial file is kept.
+ */
+- (void)cancel:(PPDeviceFirmwareUpdateDownload *)download {
+    [_delegateQueue addOperationWithBlock:^{
+        [download.task cancel];
+    }];
+}
+
+/**
+ * Drop the partial file and its validator so the next attempt downloads the whole image
+ */
+- (void)discardPartialFile:(PPDeviceFirmwareUpdateDownload *)download {
+    [[NSFileManager defaultManager] removeItemAtPath:download.partialFilePath error:nil];
+    [[NSFileManager defaultManager] removeItemAtPath:download.validatorFilePath error:nil];
+}
+
+/**
+ * Keep the strong ETag, or else the Last-Modified date, of the image being written so a resume only appends to the same image
+ */
+- (void)storeValidator:(NSURLResponse *)response download:(PPDeviceFirmwareUpdateDownload *)download {
+    NSDictionary *headers = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).allHeaderFields : nil;
+    NSString *validator = [headers objectForKey:@"ETag"];
+    if([validator hasPrefix:@"W/"]) {
+        // Weak validators can't be used with If-Range
+        validator = nil;
+    }
+    if(!validator) {
+        validator = [headers objectForKey:@"Last-Modified"];
+    }
+    if(validator) {
+        [validator writeToFile:download.validatorFilePath atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    }
+    else {
+        [[NSFileManager defaultManager] removeItemAtPath:download.validatorFilePath error:nil];
+    }
+}
+
+- (void)finish:(PPDeviceFirmwareUpdateDownload *)download error:(NSError *)error {
+    [download.fileHandle closeFile];
+    download.fileHandle = nil;
+    
+    if(!error) {
+        NSString *expectedDigest = download.job.checkSum.lowercaseString;
+        NSString *digest = [download finalDigest];
+        if(digest && ![digest isEqualToString:expectedDigest]) {
+            // A corrupt partial file can never complete, so start over next time
+            [self discardPartialFile:download];
+            error = [PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])];
+        }
+        else {
+            NSString *localFilePath = [PPDeviceFirmwareUpdateDownloadManager localFilePathForJob:download.job];
+            [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+            NSError *moveError;
+            if(![[NSFileManager defaultManager] moveItemAtPath:download.partialFilePath toPath:localFilePath error:&moveError]) {
+                error = [PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])];
+            }
+            [[NSFileManager defaultManager] removeItemAtPath:download.validatorFilePath error:nil];
+        }
+    }
+    
+    void (^completionBlock)(NSError *error) = download.completionBlock;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        completionBlock(error);
+    });
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition disposition))completionHandler {
+    PPDeviceFirmwareUpdateDownload *download = [_downloads objectForKey:@(dataTask.taskIdentifier)];
+    if(!download) {
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    
+    NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 200;
+    unsigned long long totalLength = 0;
+    
+    if(statusCode == 206) {
+        // Content-Range: bytes {start}-{end}/{total}. Only append if the server resumed where the partial file ends.
+        NSString *contentRange = [((NSHTTPURLResponse *)response).allHeaderFields objectForKey:@"Content-Range"];
+        unsigned long long start = 0;
+        NSScanner *scanner = [NSScanner scannerWithString:contentRange ?: @""];
+        BOOL valid = [scanner scanString:@"bytes" intoString:nil] && [scanner scanUnsignedLongLong:&start];
+        if(!valid || start != download.receivedLength) {
+            completionHandler(NSURLSessionResponseCancel);
+            [self discardPartialFile:download];
+            [_downloads removeObjectForKey:@(dataTask.taskIdentifier)];
+            [self finish:download error:[PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])]];
+            return;
+        }
+        NSRange slash = [contentRange rangeOfString:@"/"];
+        if(slash.location != NSNotFound) {
+            totalLength = (unsigned long long)[contentRange substringFromIndex:slash.location + 1].longLongValue;
+        }
+    }
+    else if(statusCode == 416 && download.receivedLength > 0) {
+        // Content-Range: bytes */{total}. The partial file may already hold the whole image if it was interrupted before being moved into place.
+        NSString *contentRange = [((NSHTTPURLResponse *)response).allHeaderFields objectForKey:@"Content-Range"];
+        NSRange slash = [contentRange rangeOfString:@"/"];
+        unsigned long long total = (slash.location != NSNotFound) ? (unsigned long long)[contentRange substringFromIndex:slash.location + 1].longLongValue : 0;
+        if(download.digest == PPDeviceFirmwareUpdateDownloadDigestNone || (total && total != download.receivedLength)) {
+            // Nothing can confirm the partial file is the image, so download it again from the start
+            completionHandler(NSURLSessionResponseCancel);
+            [_downloads removeObjectForKey:@(dataTask.taskIdentifier)];
+            [download.fileHandle closeFile];
+            download.fileHandle = nil;
+            [self discardPartialFile:download];
+            [self download:download];
+            return;
+        }
+        totalLength = download.receivedLength;
+    }
+    else if(statusCode >= 200 && statusCode < 300) {
+        // The server ignored the range or the image changed, so the partial file is replaced
+        [download.fileHandle truncateFileAtOffset:0];
+        [download resetDigest];
+        download.receivedLength = 0;
+        [self storeValidator:response download:download];
+        if(response.expectedContentLength != NSURLResponseUnknownLength) {
+            totalLength = (unsigned long long)response.expectedContentLength;
+        }
+    }
+    else {
+        completionHandler(NSURLSessionResponseCancel);
+        [_downloads removeObjectForKey:@(dataTask.taskIdentifier)];
+        [self finish:download error:[PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])]];
+        return;
+    }
+    
+    download.progress = [NSProgress progressWithTotalUnitCount:(int64_t)totalLength];
+    download.progress.completedUnitCount = (int64_t)download.receivedLength;
+    
+    if(statusCode == 416) {
+        completionHandler(NSURLSessionResponseCancel);
+        [_downloads removeObjectForKey:@(dataTask.taskIdentifier)];
+        [self finish:download error:nil];
+        return;
+    }
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    PPDeviceFirmwareUpdateDownload *download = [_downloads objectForKey:@(dataTask.taskIdentifier)];
+    if(!download) {
+        return;
+    }
+    
+    @try {
+        [download.fileHandle writeData:data];
+    }
+    @catch (NSException *exception) {
+        // Cut off the torn write, so the next attempt resumes after the last byte that reached the file
+        @try {
+            [download.fileHandle truncateFileAtOffset:download.receivedLength];
+        }
+        @catch (NSException *truncateException) {
+            [[NSFileManager defaultManager] removeItemAtPath:download.partialFilePath error:nil];
+            [[NSFileManager defaultManager] removeItemAtPath:download.validatorFilePath error:nil];
+        }
+        download.writeFailed = YES;
+        [dataTask cancel];
+        return;
+    }
+    [download updateDigest:data];
+    download.receivedLength += data.length;
+    download.progress.completedUnitCount = (int64_t)download.receivedLength;
+    
+    if(download.progressBlock) {
+        NSProgress *progress = download.progress;
+        void (^progressBlock)(NSProgress *progress) = download.progressBlock;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            progressBlock(progress);
+        });
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    PPDeviceFirmwareUpdateDownload *download = [_downloads objectForKey:@(task.taskIdentifier)];
+    if(!download) {
+        return;
+    }
+    [_downloads removeObjectForKey:@(task.taskIdentifier)];
+    
+    if(error) {
+        // The partial file is kept, so the next attempt resumes from where this one stopped
+        [download.fileHandle synchronizeFile];
+        [download.fileHandle closeFile];
+        download.fileHandle = nil;
+    
+        // A cancelled download reports NSURLErrorCancelled so it isn't mistaken for a completed one, unless it was cancelled because the file could not be written
+        NSError *downloadError = error;
+        if(download.writeFailed || ![error.domain isEqualToString:NSURLErrorDomain] || error.code != NSURLErrorCancelled) {
+            downloadError = [PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])];
+        }
+        void (^completionBlock)(NSError *error) = download.completionBlock;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completionBlock(downloadError);
+        });
+        return;
+    }
+    
+    [self finish:download error:nil];
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask willCacheResponse:(NSCachedURLResponse *)proposedResponse completionHandler:(void (^)(NSCachedURLResponse *cachedResponse))completionHandler {
+    completionHandler(nil);
+}
+
+@end
+
 @interface PPDeviceFirmwareUpdateDownloadManager()
-@property (nonatomic, strong) PPHTTPOperation *downloadOperation;
+@property (nonatomic, strong) PPDeviceFirmwareUpdateDownload *download;
 
 #if !TARGET_OS_WATCH
 @property (nonatomic, strong) AVAssetExportSession *assetExport;
@@ -27,40 +439,57 @@
 
 @implementation PPDeviceFirmwareUpdateDownloadManager
 
+/**
+ * Download the firmware image to localFilePathForJob:.
+ * The image is written to disk as it arrives. An interrupted or cancelled download leaves a partial file that the next call resumes with an HTTP Range request, guarded by If-Range when the server sent a validator.
+ * If the job has an MD5, SHA-1 or SHA-256 hex checkSum, the image is verified before it is moved into place.
+ */
 - (void)download:(PPDeviceFirmwareUpdateJob *)job tempKey:(NSString *)tempKey {
-    __block PPDeviceFirmwareUpdateJob *singleJob = job;
-    NSURL *url = [NSURL URLWithString:job.url];
-
     __weak PPDeviceFirmwareUpdateDownloadManager *weakSelf = self;
-
-    PPCloudEngine *cloudEngine = [[PPCloudEngine alloc] initSingleton:PPCloudEngineTypeApp];
-    NSURLRequest *request = [NSURLRequest requestWithURL:url];
     
-    PPHTTPOperation *operation = [cloudEngine operationWithRequest:request progressBlock:^(NSProgress *progress) {
+    PPDeviceFirmwareUpdateDownload *download = [[PPDeviceFirmwareUpdateDownload alloc] init];
+    download.job = job;
+    download.partialFilePath = [[PPDeviceFirmwareUpdateDownloadManager localFilePathForJob:job] stringByAppendingPathExtension:@"part"];
+    download.validatorFilePath = [download.partialFilePath stringByAppendingPathExtension:@"validator"];
+    switch(job.checkSum.length) {
+        case CC_MD5_DIGEST_LENGTH * 2:
+            download.digest = PPDeviceFirmwareUpdateDownloadDigestMD5;
+            break;
+        case CC_SHA1_DIGEST_LENGTH * 2:
+            download.digest = PPDeviceFirmwareUpdateDownloadDigestSHA1;
+            break;
+        case CC_SHA256_DIGEST_LENGTH * 2:
+            download.digest = PPDeviceFirmwareUpdateDownloadDigestSHA256;
+            break;
+        default:
+            download.digest = PPDeviceFirmwareUpdateDownloadDigestNone;
+            break;
+    }
+    download.progressBlock = ^(NSProgress *progress) {
         if([weakSelf.delegate respondsToSelector:@selector(downloading:progress:)]) {
-            [weakSelf.delegate downloading:singleJob progress:progress];
+            [weakSelf.delegate downloading:job progress:progress];
         }
-    } success:^(NSData *responseData, NSObject *response) {
-        weakSelf.downloadOperation = nil;
-        if([weakSelf.delegate respondsToSelector:@selector(completedDownload:error:)]) {
-            [weakSelf.delegate completedDownload:singleJob error:nil];
+    };
+    download.completionBlock = ^(NSError *error) {
+        if(weakSelf.download == download) {
+            weakSelf.download = nil;
         }
-    } failure:^(NSError *error) {
-        weakSelf.downloadOperation = nil;
         if([weakSelf.delegate respondsToSelector:@selector(completedDownload:error:)]) {
-            [weakSelf.delegate completedDownload:singleJob error:[PPBaseModel resultCodeToNSError:10042 originatingClass:NSStringFromClass([self class])]];
+            [weakSelf.delegate completedDownload:job error:error];
         }
-    }];
+    };
     
-    _downloadOperation = operation;
+    _download = download;
+    [[PPDeviceFirmwareUpdateDownloadSession sharedSession] download:download];
 }
 
 /**
- * Cancel the operation
+ * Cancel the download. The partial file is kept so the download can be resumed.
+ * The delegate's completedDownload:error: gets an NSURLErrorCancelled error.
  */
 - (void)cancelDownload {
-    if(_downloadOperation) {
-        [_downloadOperation cancel];
+    if(_download) {
+        [[PPDeviceFirmwareUpdateDownloadSession sharedSession] cancel:_download];
     }
 }
 
@@ -70,17 +499,11 @@
     return localFilePath;
 }
 
+/**
+ * @return BOOL YES if the complete, verified image is at localFilePathForJob:
+ */
 + (BOOL)downloadedJob:(PPDeviceFirmwareUpdateJob *)job {
-    NSArray *files = [[NSBundle mainBundle] pathsForResourcesOfType:@".img" inDirectory:@"./"];
-    
-    NSMutableArray *filesArray = [[NSMutableArray alloc] initWithCapacity:files.count + 1];
-    for(NSString *filePath in files) {
-        [filesArray addObject:filePath.lastPathComponent];
-        if([filePath.lastPathComponent isEqualToString:job.url.lastPathComponent]) {
-            return YES;
-        }
-    }
-    return NO;
+    return [[NSFileManager defaultManager] fileExistsAtPath:[PPDeviceFirmwareUpdateDownloadManager localFilePathForJob:job]];
 }
 
 @end
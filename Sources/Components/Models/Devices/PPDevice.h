@@ -32,6 +32,8 @@
 @property (nonatomic, strong) NSDate *lastDataReceivedDate;
 @property (nonatomic, strong) NSDate *lastMeasureDate;
 @property (nonatomic, strong) NSDate *lastConnectedDate;
+
+// Setting parameters keeps a copy of the array. Edit them through this property, so lookups by name see the change.
 @property (nonatomic, strong) NSMutableArray *parameters;
 @property (nonatomic, strong) NSMutableArray *properties;
 @property (nonatomic, strong) NSString *icon;
@@ -46,10 +48,46 @@
 
 + (PPDevice *)initWithDictionary:(NSDictionary *)deviceDict;
 
+/**
+ * Build a device, optionally keeping its dictionary to build type attributes, parameters, properties, spaces and dates
+ * only when they are first read. Each one is built once, even when first read from several threads at the same time.
+ * Lists that show names, icons and connection states skip most of the parse time and memory.
+ *
+ * @param deviceDict Required NSDictionary Device from the cloud
+ * @param lazy BOOL YES to build sub-objects on first access
+ */
++ (PPDevice *)initWithDictionary:(NSDictionary *)deviceDict lazy:(BOOL)lazy;
+
+/**
+ * Whether initWithDictionary: builds lazy devices. Default is NO.
+ */
++ (BOOL)lazyMaterialization;
++ (void)setLazyMaterialization:(BOOL)lazy;
+
+/**
+ * NO while a lazy device still has sub-objects to build
+ */
+- (BOOL)isMaterialized;
+
 - (PPDeviceParameter *)parameterWithName:(NSString *)paramName index:(NSString *)paramIndex;
 
 - (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate;
 
+/**
+ * Apply many parameters at once, e.g. from a measurement.
+ * Parameters whose value did not change are left in place.
+ *
+ * @param parameters Required NSArray PPDeviceParameter parameters to apply
+ **/
+- (void)applyParameters:(NSArray *)parameters;
+
+/**
+ * Apply parameters straight from their JSON dictionaries, without creating intermediate parameter objects.
+ *
+ * @param parameterDicts Required NSArray NSDictionary parameters with name, index, value and lastUpdateTime
+ **/
+- (void)applyParameterDictionaries:(NSArray *)parameterDicts;
+
 #pragma mark - Helper methods
 
 - (BOOL)isEqualToDevice:(PPDevice *)device;
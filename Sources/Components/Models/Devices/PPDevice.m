@@ -6,6 +6,119 @@
 //
 
 #import "PPDevice.h"
+#import <stdatomic.h>
+
+/**
+ * Members of a lazy device still waiting to be built from its dictionary
+ */
+typedef NS_OPTIONS(NSUInteger, PPDeviceLazyMember) {
+    PPDeviceLazyMemberNone = 0,
+    PPDeviceLazyMemberTypeAttributes = 1 << 0,
+    PPDeviceLazyMemberParameters = 1 << 1,
+    PPDeviceLazyMemberProperties = 1 << 2,
+    PPDeviceLazyMemberSpaces = 1 << 3,
+    PPDeviceLazyMemberStartDate = 1 << 4,
+    PPDeviceLazyMemberLastDataReceivedDate = 1 << 5,
+    PPDeviceLazyMemberLastMeasureDate = 1 << 6,
+    PPDeviceLazyMemberLastConnectedDate = 1 << 7,
+    PPDeviceLazyMemberAll = 0xFF
+};
+
+static atomic_bool _lazyMaterialization;
+
+/**
+ * Parameters array that counts its changes, so a device notices edits made straight to its parameters
+ */
+@interface PPDeviceParameterArray : NSMutableArray {
+    NSMutableArray *_storage;
+}
+@property (nonatomic, readonly) NSUInteger mutations;
+@end
+
+@implementation PPDeviceParameterArray
+
+- (id)init {
+    return [self initWithCapacity:0];
+}
+
+- (id)initWithCapacity:(NSUInteger)numItems {
+    self = [super init];
+    if(self) {
+        _storage = [[NSMutableArray alloc] initWithCapacity:numItems];
+    }
+    return self;
+}
+
+- (id)initWithObjects:(const id [])objects count:(NSUInteger)cnt {
+    self = [super init];
+    if(self) {
+        _storage = [[NSMutableArray alloc] initWithObjects:objects count:cnt];
+    }
+    return self;
+}
+
+- (Class)classForCoder {
+    return [NSMutableArray class];
+}
+
+- (NSUInteger)count {
+    return _storage.count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    return [_storage objectAtIndex:index];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len {
+    return [_storage countByEnumeratingWithState:state objects:buffer count:len];
+}
+
+- (void)insertObject:(id)anObject atIndex:(NSUInteger)index {
+    [_storage insertObject:anObject atIndex:index];
+    _mutations++;
+}
+
+- (void)removeObjectAtIndex:(NSUInteger)index {
+    [_storage removeObjectAtIndex:index];
+    _mutations++;
+}
+
+- (void)addObject:(id)anObject {
+    [_storage addObject:anObject];
+    _mutations++;
+}
+
+- (void)removeLastObject {
+    [_storage removeLastObject];
+    _mutations++;
+}
+
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)anObject {
+    [_storage replaceObjectAtIndex:index withObject:anObject];
+    _mutations++;
+}
+
+@end
+
+@interface PPDevice () {
+    // Device dictionary the pending members are built from
+    NSDictionary *_lazyDict;
+    
+    // PPDeviceLazyMember flags of the members not built yet
+    atomic_uint_fast32_t _lazyMembers;
+    
+    // Parameter name -> (index or NSNull -> NSNumber slot in parameters)
+    NSMutableDictionary *_parameterSlots;
+    
+    // Parameter name -> NSNumber slot of the first parameter with that name
+    NSMutableDictionary *_parameterFirstSlots;
+    
+    // Array and number of changes the slots were built for, so direct changes to parameters are noticed
+    __weak PPDeviceParameterArray *_indexedParameters;
+    NSUInteger _indexedMutations;
+}
+
+@end
 
 @implementation PPDevice
 
@@ -28,6 +141,16 @@
 //@synthesize lastConnectedDate;
 //@synthesize icon;
 
+// Accessors of lazy members are implemented below
+@synthesize typeAttributes = _typeAttributes;
+@synthesize parameters = _parameters;
+@synthesize properties = _properties;
+@synthesize spaces = _spaces;
+@synthesize startDate = _startDate;
+@synthesize lastDataReceivedDate = _lastDataReceivedDate;
+@synthesize lastMeasureDate = _lastMeasureDate;
+@synthesize lastConnectedDate = _lastConnectedDate;
+
 - (id)initWithDeviceId:(NSString *)deviceId proxyId:(NSString *)proxyId name:(NSString *)name connected:(PPDeviceConnected)connected restricted:(PPDeviceRestricted)restricted shared:(PPDeviceShared)shared newDevice:(PPDeviceNewDevice)newDevice goalId:(PPDeviceTypeGoalId)goalId typeId:(PPDeviceTypeId)typeId category:(PPDeviceTypeCategory)category typeAttributes:(NSMutableArray *)typeAttributes locationId:(PPLocationId)locationId startDate:(NSDate *)startDate lastDataReceivedDate:(NSDate *)lastDataReceivedDate lastMeasureDate:(NSDate *)lastMeasureDate lastConnectedDate:(NSDate *)lastConnectedDate parameters:(NSMutableArray *)parameters properties:(NSMutableArray *)properties icon:(NSString *)icon spaces:(NSMutableArray *)spaces modelId:(NSString *)modelId userId:(PPUserId)userId {
     self = [super init];
     if(self) {
@@ -63,6 +186,10 @@
 }
 
 + (PPDevice *)initWithDictionary:(NSDictionary *)deviceDict {
+    return [PPDevice initWithDictionary:deviceDict lazy:[PPDevice lazyMaterialization]];
+}
+
++ (PPDevice *)initWithDictionary:(NSDictionary *)deviceDict lazy:(BOOL)lazy {
     NSString *deviceId = [deviceDict objectForKey:@"id"];
     
     NSString *proxyId = [deviceDict objectForKey:@"proxyId"];;
@@ -104,42 +231,6 @@
     }
     NSString *icon = [deviceDict objectForKey:@"icon"];
     
-    NSString *startDateString = [deviceDict objectForKey:@"startDate"];
-    NSDate *startDate;
-    
-    if(startDateString != nil) {
-        if(![startDateString isEqualToString:@""]) {
-            startDate = [PPNSDate parseDateTime:startDateString];
-        }
-    }
-    
-    NSString *lastDataReceivedDateString = [deviceDict objectForKey:@"lastDataReceivedDate"];
-    NSDate *lastDataReceivedDate;
-    
-    if(lastDataReceivedDateString != nil) {
-        if(![lastDataReceivedDateString isEqualToString:@""]) {
-            lastDataReceivedDate = [PPNSDate parseDateTime:lastDataReceivedDateString];
-        }
-    }
-    
-    NSString *lastMeasureDateString = [deviceDict objectForKey:@"lastMeasureDate"];
-    NSDate *lastMeasureDate;
-    
-    if(lastMeasureDateString != nil) {
-        if(![lastMeasureDateString isEqualToString:@""]) {
-            lastMeasureDate = [PPNSDate parseDateTime:lastMeasureDateString];
-        }
-    }
-    
-    NSString *lastConnectedDateString = [deviceDict objectForKey:@"lastConnectedDate"];
-    NSDate *lastConnectedDate;
-    
-    if(lastConnectedDateString != nil) {
-        if(![lastConnectedDateString isEqualToString:@""]) {
-            lastConnectedDate = [PPNSDate parseDateTime:lastConnectedDateString];
-        }
-    }
-    
     PPDeviceTypeId typeId = PPDeviceTypeIdNone;
     if([deviceDict objectForKey:@"type"]) {
         typeId = (PPDeviceTypeId)((NSString *)[deviceDict objectForKey:@"type"]).integerValue;
@@ -151,42 +242,6 @@
         category = (PPDeviceTypeCategory)((NSString *)[deviceDict objectForKey:@"typeCategory"]).integerValue;
     }
     
-    NSMutableArray *typeAttributes;
-    if([deviceDict objectForKey:@"typeAttributes"]) {
-        typeAttributes = [[NSMutableArray alloc] initWithCapacity:0];
-        for(NSDictionary *typeAttributeDict in [deviceDict objectForKey:@"typeAttributes"]) {
-            PPDeviceTypeAttribute *attribute = [PPDeviceTypeAttribute initWithDictionary:typeAttributeDict];
-            [typeAttributes addObject:attribute];
-        }
-    }
-    
-    NSMutableArray *parameters;
-    if([deviceDict objectForKey:@"parameters"]) {
-        parameters = [[NSMutableArray alloc] initWithCapacity:0];
-        for(NSDictionary *parameterDict in [deviceDict objectForKey:@"parameters"]) {
-            PPDeviceParameter *parameter = [PPDeviceParameter initWithDictionary:parameterDict];
-            [parameters addObject:parameter];
-        }
-    }
-    
-    NSMutableArray *properties;
-    if([deviceDict objectForKey:@"properties"]) {
-        properties = [[NSMutableArray alloc] initWithCapacity:0];
-        for(NSDictionary *propertyDict in [deviceDict objectForKey:@"properties"]) {
-            PPDeviceProperty *property = [PPDeviceProperty initWithDictionary:propertyDict];
-            [properties addObject:property];
-        }
-    }
-    
-    NSMutableArray *spaces;
-    if([deviceDict objectForKey:@"spaces"]) {
-        spaces = [[NSMutableArray alloc] initWithCapacity:0];
-        for(NSDictionary *spaceDict in [deviceDict objectForKey:@"spaces"]) {
-            PPLocationSpace *space = [PPLocationSpace initWithDictionary:spaceDict];
-            [spaces addObject:space];
-        }
-    }
-    
     NSString *modelId = [deviceDict objectForKey:@"modelId"];
     
     PPUserId userId = PPUserIdNone;
@@ -194,41 +249,367 @@
         userId = (PPUserId)((NSString *)[deviceDict objectForKey:@"userId"]).integerValue;
     }
     
+    if(lazy) {
+        PPDevice *device = [[PPDevice alloc] initWithDeviceId:deviceId proxyId:proxyId name:name connected:connected restricted:restricted shared:shared newDevice:newDevice goalId:goalId typeId:typeId category:category typeAttributes:nil locationId:locationId startDate:nil lastDataReceivedDate:nil lastMeasureDate:nil lastConnectedDate:nil parameters:nil properties:nil icon:icon spaces:nil modelId:modelId userId:userId];
+        device->_lazyDict = deviceDict;
+        atomic_store_explicit(&device->_lazyMembers, PPDeviceLazyMemberAll, memory_order_release);
+        return device;
+    }
+    
+    NSMutableArray *typeAttributes = [PPDevice typeAttributesFromArray:[deviceDict objectForKey:@"typeAttributes"]];
+    NSMutableArray *parameters = [PPDevice parametersFromArray:[deviceDict objectForKey:@"parameters"]];
+    NSMutableArray *properties = [PPDevice propertiesFromArray:[deviceDict objectForKey:@"properties"]];
+    NSMutableArray *spaces = [PPDevice spacesFromArray:[deviceDict objectForKey:@"spaces"]];
+    NSDate *startDate = [PPDevice dateFromString:[deviceDict objectForKey:@"startDate"]];
+    NSDate *lastDataReceivedDate = [PPDevice dateFromString:[deviceDict objectForKey:@"lastDataReceivedDate"]];
+    NSDate *lastMeasureDate = [PPDevice dateFromString:[deviceDict objectForKey:@"lastMeasureDate"]];
+    NSDate *lastConnectedDate = [PPDevice dateFromString:[deviceDict objectForKey:@"lastConnectedDate"]];
+    
     PPDevice *device = [[PPDevice alloc] initWithDeviceId:deviceId proxyId:proxyId name:name connected:connected restricted:restricted shared:shared newDevice:newDevice goalId:goalId typeId:typeId category:category typeAttributes:typeAttributes locationId:locationId startDate:startDate lastDataReceivedDate:lastDataReceivedDate lastMeasureDate:lastMeasureDate lastConnectedDate:lastConnectedDate parameters:parameters properties:properties icon:icon spaces:spaces modelId:modelId userId:userId];
     return device;
 }
 
++ (NSMutableArray *)typeAttributesFromArray:(NSArray *)typeAttributeDicts {
+    if(!typeAttributeDicts) {
+        return nil;
+    }
+    NSMutableArray *typeAttributes = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *typeAttributeDict in typeAttributeDicts) {
+        PPDeviceTypeAttribute *attribute = [PPDeviceTypeAttribute initWithDictionary:typeAttributeDict];
+        [typeAttributes addObject:attribute];
+    }
+    return typeAttributes;
+}
+
++ (NSMutableArray *)parametersFromArray:(NSArray *)parameterDicts {
+    if(!parameterDicts) {
+        return nil;
+    }
+    NSMutableArray *parameters = [[PPDeviceParameterArray alloc] initWithCapacity:parameterDicts.count];
+    for(NSDictionary *parameterDict in parameterDicts) {
+        PPDeviceParameter *parameter = [PPDeviceParameter initWithDictionary:parameterDict];
+        [parameters addObject:parameter];
+    }
+    return parameters;
+}
+
++ (NSMutableArray *)propertiesFromArray:(NSArray *)propertyDicts {
+    if(!propertyDicts) {
+        return nil;
+    }
+    NSMutableArray *properties = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *propertyDict in propertyDicts) {
+        PPDeviceProperty *property = [PPDeviceProperty initWithDictionary:propertyDict];
+        [properties addObject:property];
+    }
+    return properties;
+}
+
++ (NSMutableArray *)spacesFromArray:(NSArray *)spaceDicts {
+    if(!spaceDicts) {
+        return nil;
+    }
+    NSMutableArray *spaces = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *spaceDict in spaceDicts) {
+        PPLocationSpace *space = [PPLocationSpace initWithDictionary:spaceDict];
+        [spaces addObject:space];
+    }
+    return spaces;
+}
+
++ (NSDate *)dateFromString:(NSString *)dateString {
+    if(dateString == nil || [dateString isEqualToString:@""]) {
+        return nil;
+    }
+    return [PPNSDate parseDateTime:dateString];
+}
+
+#pragma mark - Lazy materialization
+
++ (BOOL)lazyMaterialization {
+    return atomic_load_explicit(&_lazyMaterialization, memory_order_relaxed);
+}
+
++ (void)setLazyMaterialization:(BOOL)lazy {
+    atomic_store_explicit(&_lazyMaterialization, lazy, memory_order_relaxed);
+}
+
+- (BOOL)isMaterialized {
+    return atomic_load_explicit(&_lazyMembers, memory_order_acquire) == PPDeviceLazyMemberNone;
+}
+
+/**
+ * Build a member from the device dictionary on its first access.
+ * Only the first access of each member takes the lock.
+ */
+- (void)materialize:(PPDeviceLazyMember)member {
+    if((atomic_load_explicit(&_lazyMembers, memory_order_acquire) & member) == 0) {
+        return;
+    }
+    @synchronized(self) {
+        if((atomic_load_explicit(&_lazyMembers, memory_order_acquire) & member) == 0) {
+            return;
+        }
+        switch (member) {
+            case PPDeviceLazyMemberTypeAttributes:
+                _typeAttributes = [PPDevice typeAttributesFromArray:[_lazyDict objectForKey:@"typeAttributes"]];
+                break;
+            case PPDeviceLazyMemberParameters:
+                _parameters = [PPDevice parametersFromArray:[_lazyDict objectForKey:@"parameters"]];
+                break;
+            case PPDeviceLazyMemberProperties:
+                _properties = [PPDevice propertiesFromArray:[_lazyDict objectForKey:@"properties"]];
+                break;
+            case PPDeviceLazyMemberSpaces:
+                _spaces = [PPDevice spacesFromArray:[_lazyDict objectForKey:@"spaces"]];
+                break;
+            case PPDeviceLazyMemberStartDate:
+                _startDate = [PPDevice dateFromString:[_lazyDict objectForKey:@"startDate"]];
+                break;
+            case PPDeviceLazyMemberLastDataReceivedDate:
+                _lastDataReceivedDate = [PPDevice dateFromString:[_lazyDict objectForKey:@"lastDataReceivedDate"]];
+                break;
+            case PPDeviceLazyMemberLastMeasureDate:
+                _lastMeasureDate = [PPDevice dateFromString:[_lazyDict objectForKey:@"lastMeasureDate"]];
+                break;
+            case PPDeviceLazyMemberLastConnectedDate:
+                _lastConnectedDate = [PPDevice dateFromString:[_lazyDict objectForKey:@"lastConnectedDate"]];
+                break;
+            default:
+                break;
+        }
+        [self forgetLazyMember:member];
+    }
+}
+
+/**
+ * A member that is set is no longer built from the dictionary.
+ * Must be called while holding the lock.
+ */
+- (void)forgetLazyMember:(PPDeviceLazyMember)member {
+    uint_fast32_t remaining = atomic_fetch_and_explicit(&_lazyMembers, ~(uint_fast32_t)member, memory_order_release) & ~(uint_fast32_t)member;
+    if(remaining == PPDeviceLazyMemberNone) {
+        _lazyDict = nil;
+    }
+}
+
+- (void)setLazyMember:(PPDeviceLazyMember)member {
+    if((atomic_load_explicit(&_lazyMembers, memory_order_acquire) & member) == 0) {
+        return;
+    }
+    @synchronized(self) {
+        [self forgetLazyMember:member];
+    }
+}
+
+- (NSMutableArray *)typeAttributes {
+    [self materialize:PPDeviceLazyMemberTypeAttributes];
+    return _typeAttributes;
+}
+
+- (void)setTypeAttributes:(NSMutableArray *)typeAttributes {
+    [self setLazyMember:PPDeviceLazyMemberTypeAttributes];
+    _typeAttributes = typeAttributes;
+}
+
+- (NSMutableArray *)parameters {
+    [self materialize:PPDeviceLazyMemberParameters];
+    return _parameters;
+}
+
+- (NSMutableArray *)properties {
+    [self materialize:PPDeviceLazyMemberProperties];
+    return _properties;
+}
+
+- (void)setProperties:(NSMutableArray *)properties {
+    [self setLazyMember:PPDeviceLazyMemberProperties];
+    _properties = properties;
+}
+
+- (NSMutableArray *)spaces {
+    [self materialize:PPDeviceLazyMemberSpaces];
+    return _spaces;
+}
+
+- (void)setSpaces:(NSMutableArray *)spaces {
+    [self setLazyMember:PPDeviceLazyMemberSpaces];
+    _spaces = spaces;
+}
+
+- (NSDate *)startDate {
+    [self materialize:PPDeviceLazyMemberStartDate];
+    return _startDate;
+}
+
+- (void)setStartDate:(NSDate *)startDate {
+    [self setLazyMember:PPDeviceLazyMemberStartDate];
+    _startDate = startDate;
+}
+
+- (NSDate *)lastDataReceivedDate {
+    [self materialize:PPDeviceLazyMemberLastDataReceivedDate];
+    return _lastDataReceivedDate;
+}
+
+- (void)setLastDataReceivedDate:(NSDate *)lastDataReceivedDate {
+    [self setLazyMember:PPDeviceLazyMemberLastDataReceivedDate];
+    _lastDataReceivedDate = lastDataReceivedDate;
+}
+
+- (NSDate *)lastMeasureDate {
+    [self materialize:PPDeviceLazyMemberLastMeasureDate];
+    return _lastMeasureDate;
+}
+
+- (void)setLastMeasureDate:(NSDate *)lastMeasureDate {
+    [self setLazyMember:PPDeviceLazyMemberLastMeasureDate];
+    _lastMeasureDate = lastMeasureDate;
+}
+
+- (NSDate *)lastConnectedDate {
+    [self materialize:PPDeviceLazyMemberLastConnectedDate];
+    return _lastConnectedDate;
+}
+
+- (void)setLastConnectedDate:(NSDate *)lastConnectedDate {
+    [self setLazyMember:PPDeviceLazyMemberLastConnectedDate];
+    _lastConnectedDate = lastConnectedDate;
+}
+
 #pragma mark - Parameters
 
+- (void)setParameters:(NSMutableArray *)parameters {
+    [self setLazyMember:PPDeviceLazyMemberParameters];
+    
+    // Only a parameter array tells the index about direct changes
+    if(parameters && ![parameters isKindOfClass:[PPDeviceParameterArray class]]) {
+        parameters = [[PPDeviceParameterArray alloc] initWithArray:parameters];
+    }
+    _parameters = parameters;
+    _indexedParameters = nil;
+}
+
+- (void)rebuildParameterIndex {
+    _parameterSlots = [[NSMutableDictionary alloc] initWithCapacity:_parameters.count];
+    _parameterFirstSlots = [[NSMutableDictionary alloc] initWithCapacity:_parameters.count];
+    [_parameters enumerateObjectsUsingBlock:^(PPDeviceParameter *param, NSUInteger slot, BOOL *stop) {
+        [self indexParameter:param slot:slot];
+    }];
+    _indexedParameters = (PPDeviceParameterArray *)_parameters;
+    _indexedMutations = _indexedParameters.mutations;
+}
+
+- (BOOL)parameterIndexIsCurrent {
+    return _indexedParameters && _indexedParameters == _parameters && _indexedMutations == _indexedParameters.mutations;
+}
+
+- (void)indexParameter:(PPDeviceParameter *)param slot:(NSUInteger)slot {
+    if(!param.name) {
+        return;
+    }
+    NSMutableDictionary *slots = [_parameterSlots objectForKey:param.name];
+    if(!slots) {
+        slots = [[NSMutableDictionary alloc] initWithCapacity:1];
+        [_parameterSlots setObject:slots forKey:param.name];
+        [_parameterFirstSlots setObject:@(slot) forKey:param.name];
+    }
+    id key = param.index ? param.index : [NSNull null];
+    if(![slots objectForKey:key]) {
+        [slots setObject:@(slot) forKey:key];
+    }
+}
+
+/**
+ * Slot of a parameter in the parameters array, NSNotFound if there is none.
+ * Without an index, the first parameter with the name matches.
+ */
+- (NSUInteger)slotForParameterWithName:(NSString *)paramName index:(NSString *)paramIndex {
+    [self materialize:PPDeviceLazyMemberParameters];
+    if(!paramName || !_parameters) {
+        return NSNotFound;
+    }
+    if(![self parameterIndexIsCurrent]) {
+        [self rebuildParameterIndex];
+    }
+    
+    NSNumber *slot = paramIndex ? [[_parameterSlots objectForKey:paramName] objectForKey:paramIndex] : [_parameterFirstSlots objectForKey:paramName];
+    if(slot && ![self parameterAtSlot:slot.unsignedIntegerValue matchesName:paramName index:paramIndex]) {
+        // A parameter object was renamed or given another index in place
+        [self rebuildParameterIndex];
+        slot = paramIndex ? [[_parameterSlots objectForKey:paramName] objectForKey:paramIndex] : [_parameterFirstSlots objectForKey:paramName];
+    }
+    return slot ? slot.unsignedIntegerValue : NSNotFound;
+}
+
+- (BOOL)parameterAtSlot:(NSUInteger)slot matchesName:(NSString *)paramName index:(NSString *)paramIndex {
+    if(slot >= _parameters.count) {
+        return NO;
+    }
+    PPDeviceParameter *param = [_parameters objectAtIndex:slot];
+    return [param.name isEqualToString:paramName] && (!paramIndex || [param.index isEqualToString:paramIndex]);
+}
+
 - (PPDeviceParameter *)parameterWithName:(NSString *)paramName index:(NSString *)paramIndex {
-    for(PPDeviceParameter *param in self.parameters) {
-        if([param.name isEqualToString:paramName]) {
-            if(paramIndex) {
-                if([param.index isEqualToString:paramIndex]) {
-                    return param;
-                }
-            }
-            else {
-                return param;
-            }
-        }
+    NSUInteger slot = [self slotForParameterWithName:paramName index:paramIndex];
+    if(slot == NSNotFound) {
+        return nil;
     }
-    return nil;
+    return [self.parameters objectAtIndex:slot];
 }
 
 - (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate {
     if(!self.parameters) {
         self.parameters = [[NSMutableArray alloc] initWithCapacity:0];
     }
-    PPDeviceParameter *param = [self parameterWithName:paramName index:paramIndex];
-    PPDeviceParameter *newParam = [[PPDeviceParameter alloc] initWithName:paramName index:paramIndex value:paramValue lastUpdateDate:paramLastUpdateDate];
-    if(param) {
-        if(![param.value isEqualToString:newParam.value] || [param.lastUpdateDate compare:newParam.lastUpdateDate] != NSOrderedSame) {
-            [self.parameters replaceObjectAtIndex:[self.parameters indexOfObject:param] withObject:newParam];
+    NSUInteger slot = [self slotForParameterWithName:paramName index:paramIndex];
+    if(slot != NSNotFound) {
+        PPDeviceParameter *param = [self.parameters objectAtIndex:slot];
+        BOOL sameValue = (param.value == paramValue) || [param.value isEqualToString:paramValue];
+        BOOL sameDate = (param.lastUpdateDate == paramLastUpdateDate) || [param.lastUpdateDate isEqualToDate:paramLastUpdateDate];
+        if(sameValue) {
+            // Nothing to replace when only the time moved
+            if(!sameDate && paramLastUpdateDate) {
+                param.lastUpdateDate = paramLastUpdateDate;
+            }
+            return;
         }
+        PPDeviceParameter *newParam = [[PPDeviceParameter alloc] initWithName:paramName index:paramIndex value:paramValue lastUpdateDate:paramLastUpdateDate];
+        [self.parameters replaceObjectAtIndex:slot withObject:newParam];
+        
+        // Same name in the same slot, so the index still holds
+        _indexedMutations = _indexedParameters.mutations;
     }
     else {
-        [self.parameters addObject:newParam];
+        [self appendParameter:[[PPDeviceParameter alloc] initWithName:paramName index:paramIndex value:paramValue lastUpdateDate:paramLastUpdateDate]];
+    }
+}
+
+- (void)appendParameter:(PPDeviceParameter *)param {
+    NSMutableArray *parameters = self.parameters;
+    BOOL current = [self parameterIndexIsCurrent];
+    [parameters addObject:param];
+    if(current) {
+        [self indexParameter:param slot:parameters.count - 1];
+        _indexedMutations = _indexedParameters.mutations;
+    }
+}
+
+- (void)applyParameters:(NSArray *)parameters {
+    for(PPDeviceParameter *param in parameters) {
+        [self setParameter:param.name value:param.value index:param.index lastUpdateDate:param.lastUpdateDate];
+    }
+}
+
+- (void)applyParameterDictionaries:(NSArray *)parameterDicts {
+    NSDate *now = [NSDate date];
+    for(NSDictionary *paramDict in parameterDicts) {
+        NSString *lastUpdateTimeString = [paramDict objectForKey:@"lastUpdateTime"];
+        NSDate *lastUpdateTime = now;
+        if(lastUpdateTimeString != nil && ![lastUpdateTimeString isEqualToString:@""]) {
+            lastUpdateTime = [PPNSDate parseDateTime:lastUpdateTimeString];
+        }
+        [self setParameter:[paramDict objectForKey:@"name"] value:[paramDict objectForKey:@"value"] index:[paramDict objectForKey:@"index"] lastUpdateDate:lastUpdateTime];
     }
 }
 
@@ -333,16 +714,16 @@
         }
     }
     if(device.parameters) {
+        if(!self.parameters) {
+            self.parameters = [[NSMutableArray alloc] initWithCapacity:device.parameters.count];
+        }
         for(PPDeviceParameter *newParameter in device.parameters) {
-            BOOL found = NO;
-            for(PPDeviceParameter *parameter in self.parameters) {
-                if([parameter.name isEqualToString:newParameter.name]) {
-                    found = YES;
-                    [parameter sync:newParameter];
-                }
+            NSUInteger slot = [self slotForParameterWithName:newParameter.name index:newParameter.index];
+            if(slot != NSNotFound) {
+                [[self.parameters objectAtIndex:slot] sync:newParameter];
             }
-            if(!found) {
-                [self.parameters addObject:newParameter];
+            else {
+                [self appendParameter:newParameter];
             }
         }
     }
@@ -26,13 +26,23 @@
 /**
  * Shared devices across the entire application
  *
- * @param location PPLocation Location devices
+ * @param location PPLocation Location devices. Devices at every location if nil.
  * @param userId Required PPUserId User Id to associate these devices with
  *
- * @return NSArray Array of shared devices
+ * @return NSArray Array of shared devices, in the order they were added
  */
 + (NSArray *)sharedDevicesForLocation:(PPLocation *)location userId:(PPUserId)userId;
 
+/**
+ * Shared device by ID
+ *
+ * @param deviceId Required NSString Device ID
+ * @param userId Required PPUserId User Id the device is associated with
+ *
+ * @return PPDevice Shared device, nil if there is none
+ */
++ (PPDevice *)sharedDeviceWithId:(NSString *)deviceId userId:(PPUserId)userId;
+
 /**
  * Add devices.
  * Add devices to local reference.
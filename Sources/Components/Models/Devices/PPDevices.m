@@ -9,12 +9,121 @@
 #import "PPDevices.h"
 #import "PPCloudEngine.h"
 
+/**
+ * Shared devices of one user.
+ * Devices are indexed by device ID, and by the location they had when they were last added.
+ */
+@interface PPDevicesRegistryUser : NSObject
+
+// Device IDs in the order they were added
+@property (nonatomic, strong) NSMutableOrderedSet *deviceIds;
+
+// Device ID -> PPDevice
+@property (nonatomic, strong) NSMutableDictionary *devices;
+
+// NSNumber location ID -> NSMutableOrderedSet of device IDs
+@property (nonatomic, strong) NSMutableDictionary *locationDeviceIds;
+
+// Device ID -> NSNumber location ID the device is indexed under
+@property (nonatomic, strong) NSMutableDictionary *deviceLocationIds;
+
+@end
+
+@implementation PPDevicesRegistryUser
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        _deviceIds = [[NSMutableOrderedSet alloc] initWithCapacity:0];
+        _devices = [[NSMutableDictionary alloc] initWithCapacity:0];
+        _locationDeviceIds = [[NSMutableDictionary alloc] initWithCapacity:0];
+        _deviceLocationIds = [[NSMutableDictionary alloc] initWithCapacity:0];
+    }
+    return self;
+}
+
+- (void)indexDevice:(PPDevice *)device {
+    NSNumber *locationId = @(device.locationId);
+    NSNumber *indexedLocationId = [_deviceLocationIds objectForKey:device.deviceId];
+    if([indexedLocationId isEqualToNumber:locationId]) {
+        return;
+    }
+    [self unindexDeviceId:device.deviceId];
+    
+    NSMutableOrderedSet *deviceIds = [_locationDeviceIds objectForKey:locationId];
+    if(!deviceIds) {
+        deviceIds = [[NSMutableOrderedSet alloc] initWithCapacity:0];
+        [_locationDeviceIds setObject:deviceIds forKey:locationId];
+    }
+    [deviceIds addObject:device.deviceId];
+    [_deviceLocationIds setObject:locationId forKey:device.deviceId];
+}
+
+- (void)unindexDeviceId:(NSString *)deviceId {
+    NSNumber *indexedLocationId = [_deviceLocationIds objectForKey:deviceId];
+    if(!indexedLocationId) {
+        return;
+    }
+    NSMutableOrderedSet *deviceIds = [_locationDeviceIds objectForKey:indexedLocationId];
+    [deviceIds removeObject:deviceId];
+    if(deviceIds.count == 0) {
+        [_locationDeviceIds removeObjectForKey:indexedLocationId];
+    }
+    [_deviceLocationIds removeObjectForKey:deviceId];
+}
+
+- (void)addDevice:(PPDevice *)device {
+    PPDevice *sharedDevice = [_devices objectForKey:device.deviceId];
+    if(sharedDevice && sharedDevice.class == device.class) {
+        [sharedDevice sync:device];
+        [self indexDevice:sharedDevice];
+        return;
+    }
+    
+    // A device that changed class replaces the old object and moves to the end
+    if(sharedDevice) {
+        [sharedDevice sync:device];
+        [device sync:sharedDevice];
+        [_deviceIds removeObject:device.deviceId];
+    }
+    [_devices setObject:device forKey:device.deviceId];
+    [_deviceIds addObject:device.deviceId];
+    [self indexDevice:device];
+}
+
+- (void)removeDeviceId:(NSString *)deviceId {
+    [self unindexDeviceId:deviceId];
+    [_devices removeObjectForKey:deviceId];
+    [_deviceIds removeObject:deviceId];
+}
+
+- (NSArray *)devicesForLocationId:(PPLocationId)locationId {
+    NSOrderedSet *deviceIds = (locationId == PPLocationIdNone) ? _deviceIds : [_locationDeviceIds objectForKey:@(locationId)];
+    NSMutableArray *devices = [[NSMutableArray alloc] initWithCapacity:deviceIds.count];
+    for(NSString *deviceId in deviceIds) {
+        [devices addObject:[_devices objectForKey:deviceId]];
+    }
+    return devices;
+}
+
+@end
+
 @implementation PPDevices
 
 #pragma mark - Session Management
 
+// NSNumber user ID -> PPDevicesRegistryUser. Read on sharedDevicesQueue, written with barriers.
 __strong static NSMutableDictionary*_sharedDevices = nil;
 
++ (dispatch_queue_t)sharedDevicesQueue {
+    static dispatch_queue_t queue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices", DISPATCH_QUEUE_CONCURRENT);
+    });
+    return queue;
+}
+
 /**
  * Shared devices across the entire application
  */
@@ -28,32 +137,45 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         [PPDevices initializeSharedDevices];
     }
     
-    NSMutableArray *sharedDevicesArray = [[NSMutableArray alloc] initWithCapacity:0];
-    NSMutableArray *devicesArrayDebug = [[NSMutableArray alloc] initWithCapacity:0];
-    for(NSString *userIdKey in _sharedDevices.allKeys) {
-        for(PPDevice *device in [_sharedDevices objectForKey:userIdKey]) {
-            [devicesArrayDebug addObject:@{@"deviceId": device.deviceId, @"locationId": @(device.locationId)}];
-            [devicesArrayDebug addObject:@{@"class": [device class]}];
-            if([userIdKey isEqualToString:[NSString stringWithFormat:@"%li", (long)userId]]) {
-                [sharedDevicesArray addObject:device];
-            }
-        }
-    }
+    PPLocationId locationId = location ? location.locationId : PPLocationIdNone;
+    __block NSArray *sharedDevicesArray = nil;
+    dispatch_sync([PPDevices sharedDevicesQueue], ^{
+        PPDevicesRegistryUser *user = [_sharedDevices objectForKey:@(userId)];
+        sharedDevicesArray = user ? [user devicesForLocationId:locationId] : @[];
+    });
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s sharedDevices=%@", __PRETTY_FUNCTION__, devicesArrayDebug);
+    NSLog(@"< %s sharedDevices=%@", __PRETTY_FUNCTION__, sharedDevicesArray);
 #endif
 #endif
     return sharedDevicesArray;
 }
 
+/**
+ * Shared device by ID
+ */
++ (PPDevice *)sharedDeviceWithId:(NSString *)deviceId userId:(PPUserId)userId {
+    if(!deviceId || !_sharedDevices) {
+        return nil;
+    }
+    
+    __block PPDevice *sharedDevice = nil;
+    dispatch_sync([PPDevices sharedDevicesQueue], ^{
+        PPDevicesRegistryUser *user = [_sharedDevices objectForKey:@(userId)];
+        sharedDevice = [user.devices objectForKey:deviceId];
+    });
+    return sharedDevice;
+}
+
 + (void)initializeSharedDevices {
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"> %s", __PRETTY_FUNCTION__);
 #endif
 #endif
-    _sharedDevices = [[NSMutableDictionary alloc] initWithCapacity:0];
+    dispatch_barrier_sync([PPDevices sharedDevicesQueue], ^{
+        _sharedDevices = [[NSMutableDictionary alloc] initWithCapacity:0];
+    });
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
     NSLog(@"< %s", __PRETTY_FUNCTION__);
@@ -78,47 +200,24 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         [PPDevices initializeSharedDevices];
     }
     
-    NSMutableArray *devicesArray = [_sharedDevices objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(!devicesArray) {
-        devicesArray = [[NSMutableArray alloc] initWithCapacity:0];
-    }
-    
-    NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
-    NSMutableIndexSet *indexSetToRemove = [[NSMutableIndexSet alloc] init];
-    for(PPDevice *device in devices) {
+    dispatch_barrier_sync([PPDevices sharedDevicesQueue], ^{
+        PPDevicesRegistryUser *user = [_sharedDevices objectForKey:@(userId)];
+        if(!user) {
+            user = [[PPDevicesRegistryUser alloc] init];
+            [_sharedDevices setObject:user forKey:@(userId)];
+        }
         
-        BOOL found = NO;
-        for(PPDevice *sharedDevice in devicesArray) {
-            if([sharedDevice isEqualToDevice:device]) {
-                if(sharedDevice.class != device.class) {
-                    [indexSetToRemove addIndex:[devicesArray indexOfObject:sharedDevice]];
-                    [sharedDevice sync:device];
-                    [device sync:sharedDevice];
-                    continue;
-                }
-                [sharedDevice sync:device];
-                found = YES;
-                break;
+        for(PPDevice *device in devices) {
+            // Devices are identified by ID, one without an ID can never be found again
+            if(!device.deviceId) {
+                continue;
             }
+            [user addDevice:device];
         }
-        if(!found) {
-//            if([PPDeviceProxyLocal isLocalDeviceWithId:device.deviceId locationId:[[PPUserAccounts currentUser] currentLocation].locationId]) {
-//                [devicesArray addObject:[PPDeviceProxyLocal initWithDevice:device]];
-//            }
-//            else {
-                [indexSet addIndex:[devices indexOfObject:device]];
-//            }
-        }
-    }
-    
-    if([indexSetToRemove count] > 0) {
-        [devicesArray removeObjectsAtIndexes:indexSetToRemove];
-    }
-    [devicesArray addObjectsFromArray:[devices objectsAtIndexes:indexSet]];
-    [_sharedDevices setObject:devicesArray forKey:[NSString stringWithFormat:@"%li", (long)userId]];
+    });
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s indexSet=%@", __PRETTY_FUNCTION__, indexSet);
+    NSLog(@"< %s", __PRETTY_FUNCTION__);
 #endif
 #endif
 }
@@ -141,26 +240,17 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         [PPDevices initializeSharedDevices];
     }
     
-    NSMutableArray *devicesArray = [_sharedDevices objectForKey:[NSString stringWithFormat:@"%li", (long)userId]];
-    if(!devicesArray) {
-        devicesArray = [[NSMutableArray alloc] initWithCapacity:0];
-    }
-    
-    NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
-    for(PPDevice *device in devices) {
-        for(PPDevice *sharedDevice in devicesArray) {
-            if([sharedDevice isEqualToDevice:device]) {
-                [indexSet addIndex:[devicesArray indexOfObject:sharedDevice]];
-                break;
+    dispatch_barrier_sync([PPDevices sharedDevicesQueue], ^{
+        PPDevicesRegistryUser *user = [_sharedDevices objectForKey:@(userId)];
+        for(PPDevice *device in devices) {
+            if(device.deviceId) {
+                [user removeDeviceId:device.deviceId];
             }
         }
-    }
-    
-    [devicesArray removeObjectsAtIndexes:indexSet];
-    [_sharedDevices setObject:devicesArray forKey:[NSString stringWithFormat:@"%li", (long)userId]];
+    });
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
-    NSLog(@"< %s indexSet=%@", __PRETTY_FUNCTION__, indexSet);
+    NSLog(@"< %s", __PRETTY_FUNCTION__);
 #endif
 #endif
 }
@@ -175,13 +265,8 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
  * @return PPDevice Local device
  **/
 + (PPDevice *)localDeviceForLocation:(PPLocation *)location userId:(PPUserId)userId {
-    for(PPDevice *device in [_sharedDevices objectForKey:[NSString stringWithFormat:@"%li", (long)userId]]) {
-        if([PPDeviceProxyLocal isLocalDeviceWithId:device.deviceId locationId:location.locationId]) {
-            return device;
-            break;
-        }
-    }
-    return nil;
+    NSString *localDeviceId = [PPDeviceProxyLocal localDeviceId:location.locationId];
+    return [PPDevices sharedDeviceWithId:localDeviceId userId:userId];
 }
 #endif
 #pragma mark Firmware Update Jobs
@@ -328,9 +413,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     if(properties) {
         [request setHTTPBody:body];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.registerDevice()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -365,14 +450,14 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(deviceId, authToken, deviceTypeId, exist, host, port, useSSL, error);
             });
         });
     } failure:^(NSError *error) {
-        PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+        PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
         
         dispatch_async(dispatch_get_main_queue(), ^{
             callback(nil, nil, PPDeviceTypeIdNone, PPDevicesExistNone, nil, PPDevicesPortNone, PPDevicesUseSSLNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -431,53 +516,51 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     components.queryItems = queryItems;
 
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getListOfDevicesForLocation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error = nil;
-            NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            
-            NSArray *sortedDevices;
-            
-            if(!error) {
-                NSMutableArray *devices = [NSMutableArray arrayWithCapacity:0];
-                for(NSDictionary *deviceDict in [root objectForKey:@"devices"]) {
-                    PPDevice *device;
-                    NSString *deviceId = [deviceDict objectForKey:@"id"];
-                    PPDeviceTypeId typeId = PPDeviceTypeIdNone;
-                    if([deviceDict objectForKey:@"type"]) {
-                        typeId = (PPDeviceTypeId)((NSString *)[deviceDict objectForKey:@"type"]).integerValue;
-                    }
-                    switch (typeId) {
+            NSMutableArray *devices = [NSMutableArray arrayWithCapacity:0];
+            [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) streamingKey:@"devices" element:^(id deviceDict) {
+                PPDevice *device;
+                NSString *deviceId = [deviceDict objectForKey:@"id"];
+                PPDeviceTypeId typeId = PPDeviceTypeIdNone;
+                if([deviceDict objectForKey:@"type"]) {
+                    typeId = (PPDeviceTypeId)((NSString *)[deviceDict objectForKey:@"type"]).integerValue;
+                }
+                switch (typeId) {
 
 #if !TARGET_OS_WATCH
-                        case PPDeviceTypeIdiOSMobileCamera:
-                            if([deviceId rangeOfString:[PPDeviceProxyLocal localUDID]].location != NSNotFound) {
-                                device = [PPDeviceCameraLocal initWithDictionary:deviceDict];
-                                break;
-                            }
-                            // Fallthrough
-                            
-                        case PPDeviceTypeIdiOSPictureFrame:
-                            if([deviceId rangeOfString:[PPDeviceProxyLocal localUDID]].location != NSNotFound) {
-                                device = [PPDevicePictureFrameLocal initWithDictionary:deviceDict];
-                                break;
-                            }
-                            // Fallthrough
-#endif
-                        default:
-                            device = [PPDevice initWithDictionary:deviceDict];
+                    case PPDeviceTypeIdiOSMobileCamera:
+                        if([deviceId rangeOfString:[PPDeviceProxyLocal localUDID]].location != NSNotFound) {
+                            device = [PPDeviceCameraLocal initWithDictionary:deviceDict];
                             break;
-                    }
-                    
-                    [devices addObject:device];
+                        }
+                        // Fallthrough
+                        
+                    case PPDeviceTypeIdiOSPictureFrame:
+                        if([deviceId rangeOfString:[PPDeviceProxyLocal localUDID]].location != NSNotFound) {
+                            device = [PPDevicePictureFrameLocal initWithDictionary:deviceDict];
+                            break;
+                        }
+                        // Fallthrough
+#endif
+                    default:
+                        device = [PPDevice initWithDictionary:deviceDict];
+                        break;
                 }
                 
+                [devices addObject:device];
+            } error:&error];
+            
+            NSArray *sortedDevices;
+            
+            if(!error) {
                 sortedDevices = [devices sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
                     PPDevice *firstDevice = (PPDevice *)a;
                     PPDevice *secondDevice = (PPDevice *)b;
@@ -494,7 +577,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                 }];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(sortedDevices, error);
@@ -504,7 +587,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -554,9 +637,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.deleteDevices()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:components.string success:^(NSData *responseData) {
         
@@ -564,7 +647,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -574,7 +657,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -616,9 +699,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getDevice()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -672,7 +755,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                 NSDictionary *locationDict = [root objectForKey:@"location"];
                 location = [PPLocation initWithDictionary:locationDict];
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(device, location, error);
@@ -682,7 +765,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -797,9 +880,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.updateDeviceAtLocation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -807,7 +890,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -817,7 +900,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -872,9 +955,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.deleteDeviceAtLocation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:components.string success:^(NSData *responseData) {
         
@@ -882,7 +965,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -892,7 +975,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -926,9 +1009,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getDeviceActivationInfo()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -942,7 +1025,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             if(!error) {
                 activationInfo = [PPDeviceActivationInfo initWithDictionary:root];
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(activationInfo, error);
@@ -952,7 +1035,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -985,9 +1068,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     components.queryItems = queryItems;
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getDeviceActivationInfoAtLocation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -1001,7 +1084,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             if(!error) {
                 activationInfo = [PPDeviceActivationInfo initWithDictionary:root];
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(activationInfo, error);
@@ -1011,7 +1094,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1055,9 +1138,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.setDeviceProperty()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] PUT:components.string success:^(NSData *responseData) {
         
@@ -1065,7 +1148,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1075,7 +1158,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1123,9 +1206,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"POST" URLString:[NSURL URLWithString:components.string relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:body];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.setDeviceProperties()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -1133,7 +1216,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1143,7 +1226,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1182,9 +1265,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getDeviceProperties()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -1202,7 +1285,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                     [properties addObject:property];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(properties, error);
@@ -1212,7 +1295,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1251,9 +1334,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.deleteDeviceProperties()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:components.string success:^(NSData *responseData) {
         
@@ -1261,7 +1344,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1271,7 +1354,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1309,9 +1392,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getDeviceFirmwareUpdateJobs()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -1329,7 +1412,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                     [jobs addObject:job];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(jobs, error);
@@ -1339,7 +1422,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1380,9 +1463,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     components.queryItems = queryItems;
     components.percentEncodedQuery = [[components.percentEncodedQuery stringByReplacingOccurrencesOfString:@"+" withString:@"%2B"] stringByReplacingOccurrencesOfString:@"%20" withString:@"+"];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.setCurrentFirmwareUpdateStatus()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:components.string success:^(NSData *responseData) {
         
@@ -1390,7 +1473,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1400,7 +1483,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1461,9 +1544,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     }
     [request setValue:appId forHTTPHeaderField:@"APP_ID"];
        
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.getVideoToken()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -1479,7 +1562,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
                     token = [PPVideoToken initWithDictionary:root];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(token, error);
@@ -1489,7 +1572,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, error);
@@ -1516,9 +1599,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
     
     NSURLComponents *components = [NSURLComponents componentsWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"locations/%@/devices/%@/spaces/%@", @(locationId), [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:deviceId], @(spaceId)]] resolvingAgainstBaseURL:NO];
         
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.linkSpace()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] PUT:components.string success:^(NSData *responseData) {
         
@@ -1526,7 +1609,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1536,7 +1619,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
@@ -1560,9 +1643,9 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
     NSURLComponents *components = [NSURLComponents componentsWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"locations/%@/devices/%@/spaces/%@", @(locationId), [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:deviceId], @(spaceId)]] resolvingAgainstBaseURL:NO];
         
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.devices.unlinkSpace()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:components.string success:^(NSData *responseData) {
         
@@ -1570,7 +1653,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1580,7 +1663,7 @@ __strong static NSMutableDictionary*_sharedDevices = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@",error.userInfo]]);
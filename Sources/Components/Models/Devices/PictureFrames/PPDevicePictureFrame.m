@@ -13,6 +13,8 @@
 @property (nonatomic) BOOL settingUpPictureFrameSessionAndPublisher;
 @end
 
+typedef void (^PPDevicePictureFrameParameterHandler)(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex);
+
 @implementation PPDevicePictureFrame
 @synthesize selectedCamera;
 @synthesize selectedFlash;
@@ -120,214 +122,237 @@
     [super setProperties:properties];
 }
 
-- (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate {
-    [super setParameter:paramName value:paramValue index:paramIndex lastUpdateDate:paramLastUpdateDate];
-    
-    // Camera
-    if([paramName isEqualToString:SELECTED_CAMERA]) {
-        if(selectedCamera != (PPDeviceParametersSelectedCamera)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
-            selectedCamera = (PPDeviceParametersSelectedCamera)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
-            if(paramValue.integerValue == PPDeviceParametersSelectedCameraFront && selectedFlash == PPDeviceParametersSelectedFlashOn) {
-                [self willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-                selectedFlash = PPDeviceParametersSelectedFlashWasOn;
-                [self didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+/**
+ * Parameter name -> handler that applies it to the typed properties, built once
+ */
++ (NSDictionary *)parameterHandlers {
+    static NSDictionary *parameterHandlers = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *handlers = [[NSMutableDictionary alloc] initWithCapacity:0];
+        
+        // Camera
+        handlers[SELECTED_CAMERA] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->selectedCamera != (PPDeviceParametersSelectedCamera)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
+                pictureFrame->selectedCamera = (PPDeviceParametersSelectedCamera)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(selectedCamera))];
+                if(paramValue.integerValue == PPDeviceParametersSelectedCameraFront && pictureFrame->selectedFlash == PPDeviceParametersSelectedFlashOn) {
+                    [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                    pictureFrame->selectedFlash = PPDeviceParametersSelectedFlashWasOn;
+                    [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                }
             }
-        }
-    }
-    
-    // Flash
-    else if([paramName isEqualToString:FLASH_ON]) {
-        if(selectedCamera == PPDeviceParametersSelectedCameraFront && paramValue.integerValue == PPDeviceParametersSelectedFlashOn) {
-            paramValue = [NSString stringWithFormat:@"%li", (long)PPDeviceParametersSelectedFlashWasOn];
-        }
-        if(selectedFlash != (PPDeviceParametersSelectedFlash)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-            selectedFlash = (PPDeviceParametersSelectedFlash)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
-        }
-    }
-    
-    // Recording
-    else if([paramName isEqualToString:AUDIO_STATUS]) {
-        if(audioStatus != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
-            audioStatus = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
-        }
-    }
-    else if([paramName isEqualToString:AUDIO_SENSITIVITY]) {
-        if(audioSensitivity != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
-            audioSensitivity = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
-        }
-    }
-    else if([paramName isEqualToString:AUDIO_ACTIVITY]) {
-        if(audioActivity != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
-            audioActivity = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
-        }
-    }
-    else if([paramName isEqualToString:RECORD_STATUS]) {
-        if(recordStatus != (PPDeviceParametersRecordStatus)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
-            recordStatus = (PPDeviceParametersRecordStatus)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
-        }
-    }
-    
-    // Streaming
-    else if([paramName isEqualToString:AUDIO_STREAMING]) {
-        if(audioStreaming != (PPDeviceParametersAudioStreaming)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
-            audioStreaming = (PPDeviceParametersAudioStreaming)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
-        }
-    }
-    else if([paramName isEqualToString:VIDEO_STREAMING]) {
-        if(videoStreaming != (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
-            videoStreaming = (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
-        }
-    }
+        };
+        
+        // Flash
+        handlers[FLASH_ON] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->selectedCamera == PPDeviceParametersSelectedCameraFront && paramValue.integerValue == PPDeviceParametersSelectedFlashOn) {
+                paramValue = [NSString stringWithFormat:@"%li", (long)PPDeviceParametersSelectedFlashWasOn];
+            }
+            if(pictureFrame->selectedFlash != (PPDeviceParametersSelectedFlash)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+                pictureFrame->selectedFlash = (PPDeviceParametersSelectedFlash)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(selectedFlash))];
+            }
+        };
+        
+        // Recording
+        handlers[AUDIO_STATUS] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->audioStatus != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
+                pictureFrame->audioStatus = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(audioStatus))];
+            }
+        };
+        handlers[AUDIO_SENSITIVITY] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->audioSensitivity != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
+                pictureFrame->audioSensitivity = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(audioSensitivity))];
+            }
+        };
+        handlers[AUDIO_ACTIVITY] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->audioActivity != (PPDeviceParametersAudioStatus)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
+                pictureFrame->audioActivity = (PPDeviceParametersAudioStatus)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(audioActivity))];
+            }
+        };
+        handlers[RECORD_STATUS] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->recordStatus != (PPDeviceParametersRecordStatus)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
+                pictureFrame->recordStatus = (PPDeviceParametersRecordStatus)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(recordStatus))];
+            }
+        };
+        
+        // Streaming
+        handlers[AUDIO_STREAMING] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->audioStreaming != (PPDeviceParametersAudioStreaming)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
+                pictureFrame->audioStreaming = (PPDeviceParametersAudioStreaming)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(audioStreaming))];
+            }
+        };
+        handlers[VIDEO_STREAMING] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->videoStreaming != (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
+                pictureFrame->videoStreaming = (PPDeviceParametersVideoStreaming)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(videoStreaming))];
+            }
+        };
 #if !TARGET_OS_WATCH
-    else if([paramName isEqualToString:STREAM_ID]) {
-        if(![streamId isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(streamId))];
-            streamId = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(streamId))];
-        }
-    }
+        handlers[STREAM_ID] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->streamId isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(streamId))];
+                pictureFrame->streamId = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(streamId))];
+            }
+        };
 #endif
-    else if([paramName isEqualToString:SUPPORTS_VIDEO_CALL]) {
-        if(supportsVideoCall != paramValue.boolValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
-            supportsVideoCall = paramValue.boolValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
-        }
-    }
-    else if ([paramName isEqualToString:BATTERY_LEVEL]) {
-        if(batteryLevel != (PPDeviceParametersBatteryLevel)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
-            batteryLevel = (PPDeviceParametersBatteryLevel)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
-        }
-    }
-    else if([paramName isEqualToString:CHARGING]) {
-        if(charging != (PPDeviceParametersCharging)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(charging))];
-            charging = (PPDeviceParametersCharging)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(charging))];
-        }
-    }
-    else if([paramName isEqualToString:VERSION]) {
-        [self willChangeValueForKey:NSStringFromSelector(@selector(version))];
-        version = [[PPVersion alloc] initWithVersion:paramValue];
-        [self didChangeValueForKey:NSStringFromSelector(@selector(version))];
-    }
-    else if([paramName isEqualToString:AVAILABLE_BYTES]) {
-        if(availableBytes != [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
-            availableBytes = [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue];
-            [self didChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
-        }
-    }
-    else if([paramName isEqualToString:BLACKOUT_SCREEN_ON]) {
-        if(blackoutScreenOn != (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
-            blackoutScreenOn = (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
-        }
-    }
-    else if([paramName isEqualToString:OUTPUT_VOLUME]) {
-        if(outputVolume != (PPDeviceParametersOutputVolume)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
-            outputVolume = (PPDeviceParametersOutputVolume)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
-        }
-    }
+        handlers[SUPPORTS_VIDEO_CALL] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->supportsVideoCall != paramValue.boolValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
+                pictureFrame->supportsVideoCall = paramValue.boolValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(supportsVideoCall))];
+            }
+        };
+        handlers[BATTERY_LEVEL] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->batteryLevel != (PPDeviceParametersBatteryLevel)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
+                pictureFrame->batteryLevel = (PPDeviceParametersBatteryLevel)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(batteryLevel))];
+            }
+        };
+        handlers[CHARGING] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->charging != (PPDeviceParametersCharging)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(charging))];
+                pictureFrame->charging = (PPDeviceParametersCharging)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(charging))];
+            }
+        };
+        handlers[VERSION] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(version))];
+            pictureFrame->version = [[PPVersion alloc] initWithVersion:paramValue];
+            [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(version))];
+        };
+        handlers[AVAILABLE_BYTES] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            unsigned long availableBytes = [[[[NSNumberFormatter alloc] init] numberFromString:paramValue] unsignedLongValue];
+            if(pictureFrame->availableBytes != availableBytes) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
+                pictureFrame->availableBytes = availableBytes;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(availableBytes))];
+            }
+        };
+        handlers[BLACKOUT_SCREEN_ON] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->blackoutScreenOn != (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
+                pictureFrame->blackoutScreenOn = (PPDeviceParametersBlackoutScreenOn)paramValue.integerValue > 0;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(blackoutScreenOn))];
+            }
+        };
+        handlers[OUTPUT_VOLUME] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->outputVolume != (PPDeviceParametersOutputVolume)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
+                pictureFrame->outputVolume = (PPDeviceParametersOutputVolume)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(outputVolume))];
+            }
+        };
+        
+        // Care
+        handlers[ALERT_TITLE] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->alertTitle isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertTitle))];
+                pictureFrame->alertTitle = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertTitle))];
+            }
+        };
+        handlers[ALERT_SUBTITLE] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->alertSubtitle isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertSubtitle))];
+                pictureFrame->alertSubtitle = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertSubtitle))];
+            }
+        };
+        handlers[ALERT_QUESTION_ID] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->alertQuestionId != (PPQuestionId)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertQuestionId))];
+                pictureFrame->alertQuestionId = (PPQuestionId)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertQuestionId))];
+            }
+        };
+        handlers[ALERT_MESSAGE] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->alertMessage isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertMessage))];
+                pictureFrame->alertMessage = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertMessage))];
+            }
+        };
+        handlers[ALERT_ICON] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->alertIcon isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertIcon))];
+                pictureFrame->alertIcon = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertIcon))];
+            }
+        };
+        handlers[ALERT_TIMESTAMP_MS] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if([pictureFrame->alertTimestamp timeIntervalSince1970] != (NSTimeInterval)paramValue.integerValue / 1000) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertTimestamp))];
+                pictureFrame->alertTimestamp = [NSDate dateWithTimeIntervalSince1970:(NSTimeInterval)paramValue.integerValue / 1000];
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertTimestamp))];
+            }
+        };
+        handlers[ALERT_DURATION_MS] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->alertDuration != (PPDeviceParametersAlertDuration)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertDuration))];
+                pictureFrame->alertDuration = (PPDeviceParametersAlertDuration)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertDuration))];
+            }
+        };
+        handlers[ALERT_PRIORITY] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->alertPriority != (PPDeviceParametersAlertPriority)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertPriority))];
+                pictureFrame->alertPriority = (PPDeviceParametersAlertPriority)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertPriority))];
+            }
+        };
+        handlers[PLAY_SOUND] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->playSound isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(playSound))];
+                pictureFrame->playSound = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(playSound))];
+            }
+        };
+        handlers[ALERT_STATUS] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(pictureFrame->alertStatus != (PPDeviceParametersAlertStatus)paramValue.integerValue) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(alertStatus))];
+                pictureFrame->alertStatus = (PPDeviceParametersAlertStatus)paramValue.integerValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(alertStatus))];
+            }
+        };
+        handlers[NOTIFICATION] = ^(PPDevicePictureFrame *pictureFrame, NSString *paramValue, NSString *paramIndex) {
+            if(![pictureFrame->notification isEqualToString:paramValue]) {
+                [pictureFrame willChangeValueForKey:NSStringFromSelector(@selector(notification))];
+                pictureFrame->notification = paramValue;
+                [pictureFrame didChangeValueForKey:NSStringFromSelector(@selector(notification))];
+            }
+        };
+        
+        parameterHandlers = handlers;
+    });
+    return parameterHandlers;
+}
+
+- (void)setParameter:(NSString *)paramName value:(NSString *)paramValue index:(NSString *)paramIndex lastUpdateDate:(NSDate *)paramLastUpdateDate {
+    [super setParameter:paramName value:paramValue index:paramIndex lastUpdateDate:paramLastUpdateDate];
     
-    // Care
-    else if([paramName isEqualToString:ALERT_TITLE]) {
-        if(![alertTitle isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertTitle))];
-            alertTitle = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertTitle))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_SUBTITLE]) {
-        if(![alertSubtitle isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertSubtitle))];
-            alertSubtitle = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertSubtitle))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_QUESTION_ID]) {
-        if(alertQuestionId != (PPQuestionId)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertQuestionId))];
-            alertQuestionId = (PPQuestionId)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertQuestionId))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_MESSAGE]) {
-        if(![alertMessage isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertMessage))];
-            alertMessage = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertMessage))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_ICON]) {
-        if(![alertIcon isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertIcon))];
-            alertIcon = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertIcon))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_TIMESTAMP_MS]) {
-        if([alertTimestamp timeIntervalSince1970] != (NSTimeInterval)paramValue.integerValue / 1000) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertTimestamp))];
-            alertTimestamp = [NSDate dateWithTimeIntervalSince1970:(NSTimeInterval)paramValue.integerValue / 1000];
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertTimestamp))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_DURATION_MS]) {
-        if(alertDuration != (PPDeviceParametersAlertDuration)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertDuration))];
-            alertDuration = (PPDeviceParametersAlertDuration)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertDuration))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_PRIORITY]) {
-        if(alertPriority != (PPDeviceParametersAlertPriority)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertPriority))];
-            alertPriority = (PPDeviceParametersAlertPriority)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertPriority))];
-        }
-    }
-    else if([paramName isEqualToString:PLAY_SOUND]) {
-        if(![playSound isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(playSound))];
-            playSound = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(playSound))];
-        }
-    }
-    else if([paramName isEqualToString:ALERT_STATUS]) {
-        if(alertStatus != (PPDeviceParametersAlertStatus)paramValue.integerValue) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(alertStatus))];
-            alertStatus = (PPDeviceParametersAlertStatus)paramValue.integerValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(alertStatus))];
-        }
+    if(!paramName) {
+        return;
     }
-    else if([paramName isEqualToString:NOTIFICATION]) {
-        if(![notification isEqualToString:paramValue]) {
-            [self willChangeValueForKey:NSStringFromSelector(@selector(notification))];
-            notification = paramValue;
-            [self didChangeValueForKey:NSStringFromSelector(@selector(notification))];
-        }
+    PPDevicePictureFrameParameterHandler handler = [[PPDevicePictureFrame parameterHandlers] objectForKey:paramName];
+    if(handler) {
+        handler(self, paramValue, paramIndex);
     }
 }
 #if !TARGET_OS_WATCH
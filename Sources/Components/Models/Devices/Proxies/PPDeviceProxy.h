@@ -14,6 +14,7 @@
 #import "PPDeviceProxyLocal.h"
 #import "PPDeviceProxyLocalCamera.h"
 #import "PPDeviceProxyLocalPictureFrame.h"
+#import "PPDeviceProxyFileUpload.h"
 
 @protocol PPDeviceProxyDelegate <NSObject>
 
@@ -51,6 +52,38 @@
 @property (nonatomic) NSInteger persistentTimeout;
 @property (nonatomic) NSInteger postFileRetryInterval;
 
+/**
+ * Time to wait after a measurement is queued before sending, so measurements queued close together share a request.
+ * Default is 1 second.
+ */
+@property (nonatomic) NSTimeInterval measurementCoalescingInterval;
+
+/**
+ * Maximum number of measurements sent in one request. Each measurement keeps its own entry and timestamp, in the order it was queued.
+ * A full batch is sent without waiting for the coalescing interval.
+ * Default is 1, which sends one measurement per request.
+ */
+@property (nonatomic) NSInteger maximumMeasurementBatchSize;
+
+/**
+ * Maximum number of fragments uploading at once when a whole file is sent.
+ * Default is 4; 1 sends one fragment at a time.
+ */
+@property (nonatomic) NSInteger maximumFileFragmentsInFlight;
+
+/**
+ * How commands are received and outbound elements are sent.
+ * PPDeviceProxyTransportWebSocket keeps one WebSocket to the device server, which carries commands down and measurements, alerts and command responses up,
+ * so sending no longer interrupts the long poll with a new request. The long poll is used whenever the WebSocket is not connected.
+ * Default is PPDeviceProxyTransportLongPoll.
+ */
+@property (nonatomic) PPDeviceProxyTransport transport;
+
+/**
+ * Number of HTTP requests and WebSocket connections made to the device server
+ */
+@property (atomic, readonly) NSUInteger deviceIORequests;
+
 //+ (void)registerDeviceType:(PPDeviceTypeId)devicetypeId location:(PPLocation *)location proxyId:(NSString *)proxyId callback:(PPProxyRegisterBlock)callback;
 
 - (id)initWithAuthToken:(NSString *)authToken server:(PPCloudConnectivityServer *)server localDevice:(PPDeviceProxyLocal *)localDevice;
@@ -71,6 +104,29 @@
 
 - (void)sendFile:(NSData *)data fileType:(PPFileFileType)fileType isThumbnail:(BOOL)isThumbnail rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device incomplete:(BOOL)incomplete fragmentIndex:(NSInteger)fragmentIndex expectedTotalBytes:(unsigned long long)expectedTotalBytes fileRef:(NSString *)fileRef replacementFileId:(NSString *)replacementFileId attempt:(NSInteger)attempt callback:(PPFileAcknowledgmentBlock)callback;
 
+/**
+ * Send a whole file as a pipeline of fragments. See PPDeviceProxyFileUpload.
+ *
+ * @param data Required NSData Complete file content
+ * @param fileType PPFileFileType Video, image or audio
+ * @param degrees NSInteger Rotation in degrees
+ * @param totalDuration NSInteger Duration in seconds
+ * @param device PPDevice Device that generated the file
+ * @param replacementFileId NSString Existing file ID to replace
+ * @param acknowledgmentBlock PPFileAcknowledgmentBlock Called for each acknowledged fragment, in fragment order
+ * @param callback PPFileAcknowledgmentBlock Called once the file is complete or the upload failed
+ * @return PPDeviceProxyFileUpload Upload in progress, which may be cancelled
+ */
+- (PPDeviceProxyFileUpload *)sendFile:(NSData *)data fileType:(PPFileFileType)fileType rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device replacementFileId:(NSString *)replacementFileId acknowledgment:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback;
+
+/**
+ * Send a whole file from disk as a pipeline of fragments. Only the fragments in flight are held in memory.
+ *
+ * @param fileURL Required NSURL Local file
+ * See sendFile:fileType:rotation:totalDuration:fromDevice:replacementFileId:acknowledgment:callback: for the other parameters
+ */
+- (PPDeviceProxyFileUpload *)sendFileAtURL:(NSURL *)fileURL fileType:(PPFileFileType)fileType rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device replacementFileId:(NSString *)replacementFileId acknowledgment:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback;
+
 + (PPDeviceMeasurementsAlertId)uniqueAlertId;
 
 /**
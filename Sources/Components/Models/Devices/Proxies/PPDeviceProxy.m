@@ -11,17 +11,51 @@
 #import "PPDeviceProxyLocal.h"
 #import "PPUserAccounts.h"
 #import "PPFileManagement.h"
+#import "PPDeviceProxyQueue.h"
+#import "PPDeviceProxyPendingQueue.h"
+#import "PPRetryPolicy.h"
+#import "PPWebSocket.h"
+#import <stdatomic.h>
 
-@interface PPDeviceProxy ()
+/**
+ * A queued command response, measurement or alert and its record in the outbound queue
+ */
+@interface PPDeviceProxyOutboundElement : NSObject
+@property (nonatomic, strong) id element;
+@property (nonatomic) PPDeviceProxyReliabilityBufferType type;
+@property (nonatomic) PPDeviceProxyQueueRecordId recordId;
+
+// Sender queue only. The element went through the outbound queue, whether or not its record could be written.
+@property (nonatomic) BOOL written;
+@end
+
+@implementation PPDeviceProxyOutboundElement
+@end
+
+@interface PPDeviceProxy () <PPWebSocketDelegate> {
+    // A pass writing new elements to the outbound queue is waiting on the sender queue
+    atomic_bool _outboundWriteScheduled;
+}
 - (void)processServerResponse:(NSDictionary *)responseData;
 - (void)processCommand:(PPDeviceCommand *)command;
 - (void)listenToCommands:(BOOL)listen;
 - (void)drainProxyQueue;
+- (void)flushPendingMeasurements;
+- (void)cancelLongPollRequest;
+- (void)requeueReliabilityBuffer;
+- (void)acknowledgeReliabilityBuffer;
+- (void)enqueueOutbound:(id)element type:(PPDeviceProxyReliabilityBufferType)type;
+- (void)writeOutbound;
+- (void)openOutboundQueueForLocationId:(PPLocationId)locationId;
+- (PPWebSocket *)deviceIOWebSocketWithURL:(NSString *)URLString;
 
 @property (nonatomic, strong) NSMutableDictionary *commandBlocks;
-@property (nonatomic, strong) NSMutableArray *commandResponses;
-@property (nonatomic, strong) NSMutableArray *pendingMeasurements;
-@property (nonatomic, strong) NSMutableArray *pendingAlerts;
+@property (nonatomic, strong) PPDeviceProxyPendingQueue *commandResponses;
+@property (nonatomic, strong) PPDeviceProxyPendingQueue *pendingMeasurements;
+@property (nonatomic, strong) PPDeviceProxyPendingQueue *pendingAlerts;
+
+// Every element enqueued while the outbound queue is open, until the sender queue writes its record
+@property (nonatomic, strong) PPDeviceProxyPendingQueue *unwrittenOutbound;
 @property (nonatomic, strong) NSMutableArray *outstandingCommands;
 @property (nonatomic, strong) NSMutableDictionary *reliabilityBuffer;
 @property (nonatomic, strong) NSMutableArray *userServicesCallbackBuffer;
@@ -37,6 +71,25 @@
 @property (nonatomic, strong) PPHTTPOperation *proxyNetworkOperation;
 @property (nonatomic, strong) NSLock *proxyNetworkOperationLock;
 
+// The operation in flight is the long poll GET, not a POST carrying measurements, alerts or responses
+@property (nonatomic) BOOL proxyNetworkOperationIsLongPoll;
+@property (nonatomic) NSUInteger measurementFlushGeneration;
+@property (nonatomic) BOOL measurementFlushScheduled;
+@property (nonatomic, strong) PPDeviceProxyQueue *outboundQueue;
+@property (nonatomic, strong) dispatch_queue_t senderQueue;
+@property (atomic, readwrite) NSUInteger deviceIORequests;
+
+// WebSocket command channel, opened and closed on the main queue
+@property (nonatomic, strong) PPWebSocket *webSocket;
+@property (atomic) BOOL webSocketConnected;
+@property (nonatomic) NSTimeInterval webSocketReconnectDelay;
+
+// Seconds a message sent over the WebSocket waits for its acknowledgement before it goes out again over HTTP
+@property (nonatomic) NSTimeInterval webSocketAcknowledgementTimeout;
+
+// Sequence number of the message waiting for its acknowledgement over the WebSocket, only touched on the sender queue
+@property (nonatomic, strong) NSString *webSocketSequenceNumber;
+
 @end
 
 @implementation PPDeviceProxy
@@ -92,6 +145,7 @@ __strong static PPDeviceProxy *_currentProxy = nil;
         
         _currentProxy.authToken = authToken;
         _currentProxy.server = server;
+        [_currentProxy openOutboundQueueForLocationId:locationId];
     }
 #ifdef DEBUG
 #ifdef DEBUG_MODELS
@@ -117,6 +171,7 @@ __strong static PPDeviceProxy *_currentProxy = nil;
         [UICKeyChainStore keyChainStore][[NSString stringWithFormat:@"proxy.%li.host", (long)proxy.localDevice.device.locationId]] = proxy.server.host;
         [UICKeyChainStore keyChainStore][[NSString stringWithFormat:@"proxy.%li.port", (long)proxy.localDevice.device.locationId]] = [NSString stringWithFormat:@"%li", (long)proxy.server.port];
         [UICKeyChainStore keyChainStore][[NSString stringWithFormat:@"proxy.%li.useSsl", (long)proxy.localDevice.device.locationId]] = [NSString stringWithFormat:@"%li", (long)proxy.server.ssl];
+        [proxy openOutboundQueueForLocationId:proxy.localDevice.device.locationId];
     }
     else {
         [UICKeyChainStore keyChainStore][[NSString stringWithFormat:@"proxy.%li.authToken", (long)proxy.localDevice.device.locationId]] = nil;
@@ -163,7 +218,20 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 		_proVideoQueryInProgress = NO;
 		_persistentTimeout = HTTP_DEFAULT_PERSISTENT_CONNECTION_TIMEOUT;
 		self.proxyNetworkOperationLock = [[NSLock alloc] init];
+        _commandResponses = [[PPDeviceProxyPendingQueue alloc] init];
+        _pendingMeasurements = [[PPDeviceProxyPendingQueue alloc] init];
+        _pendingAlerts = [[PPDeviceProxyPendingQueue alloc] init];
+        _unwrittenOutbound = [[PPDeviceProxyPendingQueue alloc] init];
+        atomic_init(&_outboundWriteScheduled, false);
+        
+        // The only consumer of the pending queues, and the owner of the reliability buffer
+        _senderQueue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.PPDeviceProxy.sender", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(_senderQueue, [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground]);
         _postFileRetryInterval = PROXY_DEFAULT_POST_FILE_RETRY_INTERVAL;
+        _measurementCoalescingInterval = PROXY_DEFAULT_MEASUREMENT_COALESCING_INTERVAL;
+        _maximumMeasurementBatchSize = PROXY_DEFAULT_MAXIMUM_MEASUREMENT_BATCH_SIZE;
+        _maximumFileFragmentsInFlight = PROXY_DEFAULT_FILE_FRAGMENTS_IN_FLIGHT;
+        _webSocketAcknowledgementTimeout = HTTP_TIMEOUT_WITH_ACTIVE_CAMERA;
 	}
 
 	return self;
@@ -258,15 +326,13 @@ __strong static PPDeviceProxy *_currentProxy = nil;
     _cleanConnection = cleanConnection;
     
     if(_cleanConnection == YES) {
-        if([_pendingMeasurements count]) {
-            [_pendingMeasurements removeAllObjects];
-        }
-        if([_pendingAlerts count]) {
-            [_pendingAlerts removeAllObjects];
-        }
-        if([_commandResponses count]) {
-            [_commandResponses removeAllObjects];
-        }
+        dispatch_async(_senderQueue, ^{
+            [self.pendingMeasurements removeAllObjects];
+            [self.pendingAlerts removeAllObjects];
+            [self.commandResponses removeAllObjects];
+            [self.unwrittenOutbound removeAllObjects];
+            [self.outboundQueue removeAllRecords];
+        });
         _listeningToCommands = NO;
         [self drainProxyQueue];
     }
@@ -400,30 +466,46 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 }
 
 - (void)sendMeasurements:(NSArray *)measurements {
-    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1.0 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
-        for(PPDeviceMeasurement *measurement in measurements) {
-            @try{
-                [self.pendingMeasurements addObject:measurement];
-            }
-            @catch (NSException *e) {
-#ifdef DEBUG
-                NSLog(@"%s - Error adding measurementEl to pending measurements: %@", __PRETTY_FUNCTION__, e);
-#endif
-            }
+    for(PPDeviceMeasurement *measurement in measurements) {
+        [self enqueueOutbound:measurement type:PPDeviceProxyReliabilityBufferTypeMeasurement];
+    }
+    
+    // The flush schedule is only changed from the main queue
+    dispatch_async(dispatch_get_main_queue(), ^{
+        NSInteger batchSize = MAX(1, self.maximumMeasurementBatchSize);
+        if((batchSize > 1 && self.pendingMeasurements.count >= batchSize) || self.measurementCoalescingInterval <= 0) {
+            [self flushPendingMeasurements];
         }
-		[self cancelCurrentCommandRequest];
-		[self drainProxyQueue];
-	});
+        else if(!self.measurementFlushScheduled) {
+            self.measurementFlushScheduled = YES;
+            NSUInteger generation = self.measurementFlushGeneration;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.measurementCoalescingInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                // Skip if a full batch already went out
+                if(generation == self.measurementFlushGeneration) {
+                    [self flushPendingMeasurements];
+                }
+            });
+        }
+    });
+}
+
+- (void)flushPendingMeasurements {
+    self.measurementFlushScheduled = NO;
+    self.measurementFlushGeneration++;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+        [self cancelLongPollRequest];
+        [self drainProxyQueue];
+    });
 }
 
 - (void)sendAlert:(PPDeviceMeasurementsAlert *)alert {
-	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1.0 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
 #ifdef DEBUG
-		NSLog(@"%s", __PRETTY_FUNCTION__);
+    NSLog(@"%s", __PRETTY_FUNCTION__);
 #endif
-        [self.pendingAlerts addObject:alert];
-        
-		[self cancelCurrentCommandRequest];
+    [self enqueueOutbound:alert type:PPDeviceProxyReliabilityBufferTypeAlert];
+    
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1.0 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+		[self cancelLongPollRequest];
 		[self drainProxyQueue];
 	});
 }
@@ -498,13 +580,24 @@ __strong static PPDeviceProxy *_currentProxy = nil;
         [self sendFileOrFileFragment:(fileRef) ? (PPFileId)fileRef.integerValue : PPFileIdNone replacementFileId:(replacementFileId) ? (PPFileId)replacementFileId.integerValue : PPFileIdNone deviceId:device.deviceId proxyId:self.localDevice.device.deviceId fileExtension:extension expectedSize:(PPFileSize)expectedTotalBytes duration:(PPFileDuration)totalDuration rotate:(PPFileRotate)degrees type:mediaType thumbnail:(PPFileThumbnail)isThumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)fragmentIndex contentType:contentType data:data callback:^(NSString *status, PPFile *fileFragment, PPFileTotalFileSpace totalFileSpace, PPFileUsedFileSpace usedFileSpace, PPFileTwitterShare twitterShare, NSString *twitterAccount, NSString *contentUrl, PPFileStoragePolicy storagePolicy, NSDictionary *uploadHeaders, NSError *error) {
            
             if(error) {
-                // Keep trying
+                // Keep trying while the retry policy allows it, starting from postFileRetryInterval
+                NSTimeInterval delay = RETRY_POLICY_NO_RETRY;
+                if(attempt < FILE_UPLOAD_ATTEMPT_LIMIT) {
+                    delay = [[PPRetryPolicy sharedPolicy] retryDelayForHost:[[PPCloudEngine sharedAppEngine] getBaseURL].host baseDelay:wself.postFileRetryInterval];
+                }
+                if(delay == RETRY_POLICY_NO_RETRY) {
+#ifdef DEBUG
+                    NSLog(@"PPDeviceProxy sendFile: Error sending; giving up: %@", error);
+#endif
+                    callback(PPFileIdNone, PPFileFragmentsNone, PPFileUsedFileSpaceNone, PPFileTotalFileSpaceNone, PPFileFilesActionNone, PPFileThumbnailNone, PPFileTwitterShareNone, error);
+                    return;
+                }
 #ifdef DEBUG
-                NSLog(@"PPDeviceProxy sendFile: Error sending; keep trying: %@", error);
+                NSLog(@"PPDeviceProxy sendFile: Error sending; retry in %.1fs: %@", delay, error);
 #endif
                 
-                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(wself.postFileRetryInterval * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
-                    [wself sendFile:data fileType:mediaType isThumbnail:isThumbnail rotation:degrees totalDuration:totalDuration fromDevice:device incomplete:incomplete fragmentIndex:fragmentIndex expectedTotalBytes:expectedTotalBytes fileRef:fileRef replacementFileId:replacementFileId attempt:attempt callback:callback];
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+                    [wself sendFile:data fileType:mediaType isThumbnail:isThumbnail rotation:degrees totalDuration:totalDuration fromDevice:device incomplete:incomplete fragmentIndex:fragmentIndex expectedTotalBytes:expectedTotalBytes fileRef:fileRef replacementFileId:replacementFileId attempt:attempt + 1 callback:callback];
                 });
                 return;
              }
@@ -521,6 +614,49 @@ __strong static PPDeviceProxy *_currentProxy = nil;
     });
 }
 
+- (PPDeviceProxyFileUpload *)sendFile:(NSData *)data fileType:(PPFileFileType)fileType rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device replacementFileId:(NSString *)replacementFileId acknowledgment:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback {
+    PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:data proxyId:self.localDevice.device.deviceId authToken:_authToken];
+    [self startFileUpload:upload fileType:fileType rotation:degrees totalDuration:totalDuration fromDevice:device replacementFileId:replacementFileId acknowledgment:acknowledgmentBlock callback:callback];
+    return upload;
+}
+
+- (PPDeviceProxyFileUpload *)sendFileAtURL:(NSURL *)fileURL fileType:(PPFileFileType)fileType rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device replacementFileId:(NSString *)replacementFileId acknowledgment:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback {
+    PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithFileURL:fileURL proxyId:self.localDevice.device.deviceId authToken:_authToken];
+    [self startFileUpload:upload fileType:fileType rotation:degrees totalDuration:totalDuration fromDevice:device replacementFileId:replacementFileId acknowledgment:acknowledgmentBlock callback:callback];
+    return upload;
+}
+
+- (void)startFileUpload:(PPDeviceProxyFileUpload *)upload fileType:(PPFileFileType)fileType rotation:(NSInteger)degrees totalDuration:(NSInteger)totalDuration fromDevice:(PPDevice *)device replacementFileId:(NSString *)replacementFileId acknowledgment:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback {
+    upload.fileExtension = @"";
+    upload.contentType = @"";
+    if(fileType == PPFileFileTypeVideo) {
+        upload.fileExtension = @"mp4";
+        upload.contentType = @"video/mp4";
+    }
+    else if(fileType == PPFileFileTypeImage) {
+        upload.fileExtension = @"jpg";
+        upload.contentType = @"image/jpeg";
+    }
+    else if(fileType == PPFileFileTypeAudio) {
+        upload.fileExtension = @"m4a";
+        upload.contentType = @"audio/mpeg";
+    }
+    upload.type = fileType;
+    upload.deviceId = device.deviceId;
+    upload.duration = (PPFileDuration)totalDuration;
+    upload.rotate = (PPFileRotate)degrees;
+    upload.replacementFileId = (replacementFileId) ? (PPFileId)replacementFileId.integerValue : PPFileIdNone;
+    upload.maximumFragmentsInFlight = _maximumFileFragmentsInFlight;
+    upload.retryInterval = _postFileRetryInterval;
+    
+    __weak typeof(self)wself = self;
+    [upload startWithAcknowledgmentBlock:acknowledgmentBlock callback:^(PPFileId fileId, PPFileFragments totalFragments, PPFileUsedFileSpace usedSpace, PPFileTotalFileSpace totalSpace, PPFileFilesAction action, PPFileThumbnail thumbnail, PPFileTwitterShare twitterShare, NSError *error) {
+        if(!error) {
+            [wself trackRecording:totalDuration];
+        }
+        callback(fileId, totalFragments, usedSpace, totalSpace, action, thumbnail, twitterShare, error);
+    }];
+}
 
 - (void)sendFileOrFileFragment:(PPFileId)fileId replacementFileId:(PPFileId)replacementFileId deviceId:(NSString *)deviceId proxyId:(NSString *)proxyId fileExtension:(NSString *)fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)fileDuration rotate:(PPFileRotate)rotate type:(PPFileFileType)type thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)fragmentIndex contentType:(NSString *)contentType data:(NSData *)data callback:(PPFileManagementFragmentBlock)callback {
     
@@ -586,6 +722,18 @@ __strong static PPDeviceProxy *_currentProxy = nil;
     [_proxyNetworkOperationLock unlock];
 }
 
+/**
+ * Cancel the long poll so queued elements go out right away.
+ * A POST in flight is left alone, the next round picks up whatever was queued meanwhile.
+ */
+- (void)cancelLongPollRequest {
+    [_proxyNetworkOperationLock lock];
+    if(_proxyNetworkOperation && _proxyNetworkOperationIsLongPoll) {
+        [_proxyNetworkOperation cancel];
+    }
+    [_proxyNetworkOperationLock unlock];
+}
+
 - (void)listenToCommands:(BOOL)listen {
 	if(_listeningToCommands && listen) {
 		return;
@@ -593,12 +741,31 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 	_listeningToCommands = listen;
 	if(_listeningToCommands == NO) {
 		[self cancelCurrentCommandRequest];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self closeWebSocket:NO];
+        });
 		return;
 	}
 
+    // Long poll until the WebSocket connects
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self connectWebSocket];
+    });
 	[self drainProxyQueue];
 }
 
+- (void)setTransport:(PPDeviceProxyTransport)transport {
+    _transport = transport;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if(transport == PPDeviceProxyTransportWebSocket) {
+            [self connectWebSocket];
+        }
+        else {
+            [self closeWebSocket:NO];
+        }
+    });
+}
+
 - (void)drainProxyQueue {
 	if(self.drainingProxyQueue) {
 		return;
@@ -611,188 +778,77 @@ __strong static PPDeviceProxy *_currentProxy = nil;
     });
 }
 
+/**
+ * Request body carrying command responses, measurements and alerts. Everything carried is kept in the reliability buffer until acknowledged.
+ * Must be called on the sender queue.
+ */
+- (NSDictionary *)outboundJSON:(NSString *)seqNumber responses:(NSArray *)responses measurements:(NSArray *)measurements alerts:(NSArray *)alerts {
+    NSMutableDictionary *JSON = [[NSMutableDictionary alloc] initWithCapacity:0];
+    [JSON setValue:seqNumber forKey:@"seq"];
+    PPDevice *device = self.localDevice.device;
+    [JSON setValue:device.deviceId forKey:@"proxyId"];
+    
+    NSMutableArray *responseDicts = [[NSMutableArray alloc] initWithCapacity:responses.count];
+    for(PPDeviceProxyOutboundElement *response in responses) {
+        [self addObjectToReliabilityBuffer:response];
+        [responseDicts addObject:[PPDeviceProxy dictionaryForCommandResponse:response.element]];
+    }
+    if ([responseDicts count] > 0) {
+        [JSON setValue:responseDicts forKey:@"responses"];
+    }
+    
+    NSMutableArray *measurementDicts = [[NSMutableArray alloc] initWithCapacity:measurements.count];
+    for(PPDeviceProxyOutboundElement *measurement in measurements) {
+        [self addObjectToReliabilityBuffer:measurement];
+        [measurementDicts addObject:[PPDeviceProxy dictionaryForMeasurement:measurement.element]];
+        
+        if(self.delegate) {
+            if([self.delegate respondsToSelector:@selector(willSendMeasurement:measurement:)]) {
+                [self.delegate willSendMeasurement:seqNumber measurement:measurement.element];
+            }
+        }
+    }
+    if ([measurementDicts count] > 0) {
+        [JSON setValue:measurementDicts forKey:@"measures"];
+    }
+    
+    NSMutableArray *alertDicts = [[NSMutableArray alloc] initWithCapacity:alerts.count];
+    for(PPDeviceProxyOutboundElement *alert in alerts) {
+        [self addObjectToReliabilityBuffer:alert];
+        [alertDicts addObject:[PPDeviceProxy dictionaryForAlert:alert.element]];
+    }
+    if ([alertDicts count] > 0) {
+        [JSON setValue:alertDicts forKey:@"alerts"];
+    }
+    return JSON;
+}
+
 - (void)doPersistentConnection {
 	__weak PPDeviceProxy *weakSelf = self;
 //    if(_localDevice.device == nil) {
 //        _localDevice.device = [PPDevices localDeviceForLocation:[[PPUserAccounts currentUser] currentLocation] userId:[PPUserAccounts currentUser].userId];
 //    }
-	dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.proxy", DISPATCH_QUEUE_SERIAL);
-	dispatch_async(queue, ^{
-		if(weakSelf.listeningToCommands || weakSelf.commandResponses.count || weakSelf.pendingMeasurements.count || weakSelf.pendingAlerts.count) {
-            if(weakSelf.commandResponses.count || weakSelf.pendingMeasurements.count || weakSelf.pendingAlerts.count) {
-                NSMutableDictionary *JSON = [[NSMutableDictionary alloc] initWithCapacity:0];
-                NSString *seqNumber = [PPDeviceProxy uniqueSequenceNumber];
-                [JSON setValue:seqNumber forKey:@"seq"];
-                PPDevice *device = weakSelf.localDevice.device;
-                [JSON setValue:device.deviceId forKey:@"proxyId"];
-                NSMutableArray *responses = [[NSMutableArray alloc] initWithCapacity:0];
-                for(PPDeviceCommand *response in [weakSelf.commandResponses copy]) {
-                    [weakSelf addObjectToReliabilityBuffer:[response copy] type:PPDeviceProxyReliabilityBufferTypeCommandResponses];
-                    
-                    NSMutableDictionary *commandDict = [[NSMutableDictionary alloc] initWithCapacity:2];
-                    if(response.commandId != PPDeviceCommandIdNone) {
-                        [commandDict setValue:@(response.commandId).stringValue forKey:@"commandId"];
-                    }
-                    if(response.deviceId) {
-                        [commandDict setValue:response.deviceId forKey:@"deviceId"];
-                    }
-                    if(response.typeId != PPDeviceTypeIdNone) {
-                        [commandDict setValue:@(response.typeId).stringValue forKey:@"deviceType"];
-                    }
-                    if(response.creationDate) {
-                        [commandDict setValue:[PPNSDate apiFriendStringFromDate:response.creationDate] forKey:@"creationDate"];
-                    }
-                    
-                    if(response.type != PPDeviceCommandTypeNone) {
-                        [commandDict setValue:@(response.commandId).stringValue forKey:@"commandId"];
-                    }
-                    
-                    if(response.result != PPDeviceCommandResultNone) {
-                        [commandDict setValue:@(response.result).stringValue forKey:@"result"];
-                    }
-                    
-                    if(response.parameters) {
-                        NSMutableArray *paramsArray = [[NSMutableArray alloc] initWithCapacity:0];
-                        
-                        for(PPDeviceParameter *param in response.parameters) {
-                            NSMutableDictionary *paramDict = [[NSMutableDictionary alloc] initWithCapacity:3];
-                            if(param.name) {
-                                [paramDict setValue:param.name forKey:@"name"];
-                            }
-                            if(param.value) {
-                                [paramDict setValue:param.value forKey:@"value"];
-                            }
-                            if(param.index) {
-                                [paramDict setValue:param.index forKey:@"index"];
-                            }
-                            [paramsArray addObject:paramDict];
-                        }
-                        if([paramsArray count]) {
-                            [commandDict setValue:paramsArray forKey:@"measures"];
-                        }
-                    }
-                    
-                    [responses addObject:commandDict];
-                }
-                if ([responses count] > 0) {
-                    [JSON setValue:responses forKey:@"responses"];
-                }
-				
-				weakSelf.commandResponses = [[NSMutableArray alloc] initWithCapacity:3];
-
-				// Only send one measurement at a time, so the server records each one.
-				// Otherwise, if we send 2 parameters at once, the server will only pay attention to one,
-				// when both might be needed to run rules.
-                
-                NSMutableArray *measurements = [[NSMutableArray alloc] initWithCapacity:0];
-                for(int i = 0; i < [weakSelf.pendingMeasurements count]; i++) {
-                    @try {
-                        if([weakSelf.pendingMeasurements objectAtIndex:i] != nil) {
-                            PPDeviceMeasurement *measurement = [weakSelf.pendingMeasurements objectAtIndex:i];
-                            [weakSelf addObjectToReliabilityBuffer:[measurement copy] type:PPDeviceProxyReliabilityBufferTypeMeasurement];
-                            
-                            NSMutableDictionary *measurementDict = [[NSMutableDictionary alloc] initWithCapacity:2];
-                            [measurementDict setValue:measurement.deviceId forKey:@"deviceId"];
-                            
-                            if (measurement.lastMeasureDate != nil) {
-                                [measurementDict setValue:[NSString stringWithFormat:@"%li", (long)measurement.lastMeasureDate.timeIntervalSince1970 * 1000] forKey:@"timestamp"];
-                            }
-                            
-                            NSMutableArray *paramsArray = [[NSMutableArray alloc] initWithCapacity:0];
-                            
-                            for(PPDeviceParameter *param in measurement.parameters) {
-                                NSMutableDictionary *paramDict = [[NSMutableDictionary alloc] initWithCapacity:3];
-                                if(param.name) {
-                                    [paramDict setValue:param.name forKey:@"name"];
-                                }
-                                if(param.value) {
-                                    [paramDict setValue:param.value forKey:@"value"];
-                                }
-                                if(param.index) {
-                                    [paramDict setValue:param.index forKey:@"index"];
-                                }
-                                [paramsArray addObject:paramDict];
-                            }
-                            [measurementDict setValue:paramsArray forKey:@"params"];
-                            
-                            [measurements addObject:measurementDict];
-                            
-                            if(weakSelf.delegate) {
-                                if([weakSelf.delegate respondsToSelector:@selector(willSendMeasurement:measurement:)]) {
-                                    [weakSelf.delegate willSendMeasurement:seqNumber measurement:measurement];
-                                }
-                            }
-                        }
-                        [weakSelf.pendingMeasurements removeObjectAtIndex:i];
-                    }
-                    @catch (NSException *e) {
-#ifdef DEBUG
-                        NSLog(@"%s - Error adding pending measurement to root: %@", __PRETTY_FUNCTION__, e);
-#endif
-                    }
-					break;
-				}
-                if ([measurements count] > 0) {
-                    [JSON setValue:measurements forKey:@"measures"];
-                }
-                
-                NSMutableArray *alerts = [[NSMutableArray alloc] initWithCapacity:0];
-                for(int i = 0; i < [weakSelf.pendingAlerts count]; i++) {
-                    @try {
-                        if([weakSelf.pendingAlerts objectAtIndex:i] != nil) {
-                            PPDeviceMeasurementsAlert *alert = [weakSelf.pendingAlerts objectAtIndex:i];
-                            [weakSelf addObjectToReliabilityBuffer:[alert copy] type:PPDeviceProxyReliabilityBufferTypeAlert];
-                            
-                            NSMutableDictionary *alertDict = [[NSMutableDictionary alloc] initWithCapacity:2];
-                            
-                            if(alert.deviceId) {
-                                [alertDict setValue:alert.deviceId forKey:@"deviceId"];
-                            }
-                            if(alert.alertType) {
-                                [alertDict setValue:alert.alertType forKey:@"alertType"];
-                            }
-                            if(alert.alertId != PPDeviceMeasurementsAlertIdNone) {
-                                [alertDict setValue:@(alert.alertId).stringValue forKey:@"alertId"];
-                            }
-                            
-                            if(alert.receivingDate) {
-                                [alertDict setValue:@(floor(alert.receivingDate.timeIntervalSince1970)).stringValue forKey:@"timestamp"];
-                            }
-                            
-                            if(alert.params) {
-                                NSMutableArray *paramsArray = [[NSMutableArray alloc] initWithCapacity:0];
-                                
-                                for(PPDeviceParameter *param in alert.params) {
-                                    NSMutableDictionary *paramDict = [[NSMutableDictionary alloc] initWithCapacity:3];
-                                    if(param.name) {
-                                        [paramDict setValue:param.name forKey:@"name"];
-                                    }
-                                    if(param.value) {
-                                        [paramDict setValue:param.value forKey:@"value"];
-                                    }
-                                    if(param.index) {
-                                        [paramDict setValue:param.index forKey:@"index"];
-                                    }
-                                    [paramsArray addObject:paramDict];
-                                }
-                                
-                                [alertDict setValue:paramsArray forKey:@"params"];
-                            }
-                            
-                            [alerts addObject:alertDict];
-                        }
-                        [weakSelf.pendingAlerts removeObjectAtIndex:i];
-                    }
-                    @catch (NSException *e) {
-#ifdef DEBUG
-                        NSLog(@"%s - Error adding pending alert to root: %@", __PRETTY_FUNCTION__, e);
-#endif
-                    }
-                    break;
-                }
-                if ([alerts count] > 0) {
-                    [JSON setValue:alerts forKey:@"alerts"];
-                }
+	dispatch_queue_t senderQueue = _senderQueue;
+	dispatch_async(senderQueue, ^{
+		// Take everything this request carries. Elements dropped from the full outbound queue are skipped.
+		NSArray *responses = [weakSelf dequeueOutbound:weakSelf.commandResponses maximumCount:NSUIntegerMax];
+		
+		// Every measurement is its own entry with its own timestamp, so the server records each one.
+		// Parameters are never merged across measurements, otherwise the server would only pay attention to one
+		// when both might be needed to run rules. Batches are taken oldest first.
+		NSArray *measurements = [weakSelf dequeueOutbound:weakSelf.pendingMeasurements maximumCount:MAX(1, weakSelf.maximumMeasurementBatchSize)];
+		NSArray *alerts = [weakSelf dequeueOutbound:weakSelf.pendingAlerts maximumCount:1];
+		
+		// Commands are pushed over the WebSocket, so it only has to carry what is queued
+		if(weakSelf.webSocketConnected) {
+			[weakSelf sendOverWebSocket:responses measurements:measurements alerts:alerts];
+			return;
+		}
+		
+		if(weakSelf.listeningToCommands || responses.count || measurements.count || alerts.count) {
+            BOOL longPoll = !(responses.count || measurements.count || alerts.count);
+            if(!longPoll) {
+                NSDictionary *JSON = [weakSelf outboundJSON:[PPDeviceProxy uniqueSequenceNumber] responses:responses measurements:measurements alerts:alerts];
 				
 				// Measurements and responses should go through quickly no matter what. Make it happen or die quickly.
 				NSInteger timeout = HTTP_TIMEOUT_WITH_ACTIVE_CAMERA;
@@ -831,7 +887,9 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 				[weakSelf.commandsNetWrapper setTimeoutInterval:timeout];
 			}
 			[weakSelf.commandsNetWrapper setValue:[NSString stringWithFormat:@"esp token=%@", self.authToken] forHTTPHeaderField:HTTP_HEADER_PPC_AUTHORIZATION];
-            weakSelf.proxyNetworkOperation = [[PPCloudEngine sharedProxyEngine] operationWithRequest:weakSelf.commandsNetWrapper success:^(NSData *responseData) {
+            NSString *host = weakSelf.commandsNetWrapper.URL.host;
+            weakSelf.deviceIORequests++;
+            PPHTTPOperation *operation = [[PPCloudEngine sharedProxyEngine] operationWithRequest:weakSelf.commandsNetWrapper success:^(NSData *responseData) {
 #ifdef DEBUG
                 NSLog(@"%s SUCCESS: %@", __PRETTY_FUNCTION__, [[NSString alloc] initWithData:responseData encoding:NSUTF8StringEncoding]);
 #endif
@@ -839,7 +897,7 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 				weakSelf.proxyNetworkOperation = nil;
 				[weakSelf.proxyNetworkOperationLock unlock];
 				
-				dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+				dispatch_async(senderQueue, ^{
 					[weakSelf.outstandingCommands removeAllObjects];
 					
 					
@@ -847,9 +905,11 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 					
 					NSError *error = nil;
                     NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([weakSelf class]) error:&error];
-                    if(!error && root) {
+                    
+                    // A cancelled request also lands here with no body. Only a server answer confirms what was sent.
+                    if(responseData.length > 0 && !error && root) {
 						// Successfully contacted the server, continue to process the results
-						[weakSelf.reliabilityBuffer removeAllObjects];
+						[weakSelf acknowledgeReliabilityBuffer];
 						dispatch_async(dispatch_get_main_queue(), ^{
                             [weakSelf processServerResponse:root];
                             [weakSelf doPersistentConnection];
@@ -857,21 +917,8 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 						
 					}
 					else {
-						// If sending, there was an h2s error. Pull our elements out of our reliability buffer and try sending them again.
-                        for(NSString *bufferKey in weakSelf.reliabilityBuffer.allKeys) {
-                            for(NSObject *element in [weakSelf.reliabilityBuffer objectForKey:bufferKey]) {
-                                if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeCommandResponses).stringValue]) {
-                                    [weakSelf.commandResponses insertObject:(PPDeviceCommand *)element atIndex:0];
-                                }
-                                else if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeMeasurement).stringValue]) {
-                                    [weakSelf.pendingMeasurements insertObject:(PPDeviceMeasurement *)element atIndex:0];
-                                }
-                                else if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeAlert).stringValue]) {
-                                    [weakSelf.pendingAlerts insertObject:(PPDeviceMeasurementsAlert *)element atIndex:0];
-                                }
-                            }
-						}
-                        [weakSelf.reliabilityBuffer removeAllObjects];
+						// If sending, there was an h2s error. Pull our elements out of our reliability buffer, in order, and try sending them again.
+						[weakSelf requeueReliabilityBuffer];
                         dispatch_async(dispatch_get_main_queue(), ^{
                             [weakSelf doPersistentConnection];
                         });
@@ -883,33 +930,26 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 				weakSelf.proxyNetworkOperation = nil;
 				[weakSelf.proxyNetworkOperationLock unlock];
 				
-                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+                // Back off with jitter, and wait out an open circuit, so devices don't reconnect in lockstep
+                NSTimeInterval delay = [[PPRetryPolicy sharedPolicy] reconnectDelayForHost:host baseDelay:1];
+                dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), senderQueue, ^{
 #ifdef DEBUG
 					NSLog(@"%s command listener - request error: %@", __PRETTY_FUNCTION__, error);
 #endif
 					
-					// If sending, there was an h2s error. Pull our elements out of our reliability buffer and try sending them again.
-                    for(NSString *bufferKey in weakSelf.reliabilityBuffer.allKeys) {
-                        for(NSObject *element in [weakSelf.reliabilityBuffer objectForKey:bufferKey]) {
-                            if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeCommandResponses).stringValue]) {
-                                [weakSelf.commandResponses insertObject:(PPDeviceCommand *)element atIndex:0];
-                            }
-                            else if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeMeasurement).stringValue]) {
-                                [weakSelf.pendingMeasurements insertObject:(PPDeviceMeasurement *)element atIndex:0];
-                            }
-                            else if([bufferKey isEqualToString:@(PPDeviceProxyReliabilityBufferTypeAlert).stringValue]) {
-                                [weakSelf.pendingAlerts insertObject:(PPDeviceMeasurementsAlert *)element atIndex:0];
-                            }
-                        }
-                    }
-                    [weakSelf.reliabilityBuffer removeAllObjects];
+					// If sending, there was an h2s error. Pull our elements out of our reliability buffer, in order, and try sending them again.
+					[weakSelf requeueReliabilityBuffer];
 					
-                    dispatch_sync(dispatch_get_main_queue(), ^{
+                    dispatch_async(dispatch_get_main_queue(), ^{
                         [weakSelf doPersistentConnection];
                     });
 				});
 			}];
-			
+            
+            [weakSelf.proxyNetworkOperationLock lock];
+            weakSelf.proxyNetworkOperation = operation;
+            weakSelf.proxyNetworkOperationIsLongPoll = longPoll;
+            [weakSelf.proxyNetworkOperationLock unlock];
 		}
 		else {
 			weakSelf.drainingProxyQueue = NO;
@@ -926,7 +966,7 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 - (void)cleanProxyConnection {
     __weak PPDeviceProxy *weakSelf = self;
 
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.proxy", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
     dispatch_async(queue, ^{
         NSInteger timeout = 0;
 
@@ -1063,11 +1103,11 @@ __strong static PPDeviceProxy *_currentProxy = nil;
     
     PPDeviceCommand *responseCommand = [[PPDeviceCommand alloc] initWithCommandId:command.commandId deviceId:nil creationDate:nil typeId:PPDeviceTypeIdNone parameters:nil type:PPDeviceCommandTypeNone result:(PPDeviceCommandResult)1 commandTimeout:PPDeviceCommandTimeoutNone comment:nil];
     
-    [self.commandResponses addObject:responseCommand];
+    [self enqueueOutbound:responseCommand type:PPDeviceProxyReliabilityBufferTypeCommandResponses];
     
     if(returnElements.count > 0) {
         PPDeviceCommand *returnCommand = [[PPDeviceCommand alloc] initWithCommandId:command.commandId deviceId:command.deviceId creationDate:command.creationDate typeId:command.typeId parameters:returnElements type:command.type result:PPDeviceCommandResultNone commandTimeout:PPDeviceCommandTimeoutNone comment:nil];
-        [self.commandResponses addObject:returnCommand];
+        [self enqueueOutbound:returnCommand type:PPDeviceProxyReliabilityBufferTypeCommandResponses];
     }
 }
 
@@ -1079,14 +1119,6 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 	return _commandBlocks;
 }
 
-- (NSMutableArray *)commandResponses {
-	if(_commandResponses == nil) {
-		_commandResponses = [[NSMutableArray alloc] initWithCapacity:3];
-	}
-
-	return _commandResponses;
-}
-
 - (NSMutableArray *)outstandingCommands {
 	if(_outstandingCommands == nil) {
 		_outstandingCommands = [[NSMutableArray alloc] initWithCapacity:3];
@@ -1095,22 +1127,6 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 	return _outstandingCommands;
 }
 
-- (NSMutableArray *)pendingMeasurements {
-	if(_pendingMeasurements == nil) {
-		_pendingMeasurements = [[NSMutableArray alloc] initWithCapacity:3];
-	}
-
-	return _pendingMeasurements;
-}
-
-- (NSMutableArray *)pendingAlerts {
-    if(_pendingAlerts == nil) {
-        _pendingAlerts = [[NSMutableArray alloc] initWithCapacity:3];
-    }
-    
-    return _pendingAlerts;
-}
-
 - (NSMutableDictionary *)reliabilityBuffer {
 	if(_reliabilityBuffer == nil) {
 		_reliabilityBuffer = [[NSMutableDictionary alloc] initWithCapacity:3];
@@ -1119,12 +1135,462 @@ __strong static PPDeviceProxy *_currentProxy = nil;
 	return _reliabilityBuffer;
 }
 
-- (void)addObjectToReliabilityBuffer:(NSDictionary *)object type:(PPDeviceProxyReliabilityBufferType)type {
-    NSMutableArray *buffer = [_reliabilityBuffer objectForKey:@(type).stringValue];
+- (void)addObjectToReliabilityBuffer:(PPDeviceProxyOutboundElement *)outbound {
+    // Buffer a copy of what was sent, under the same outbound queue record
+    PPDeviceProxyOutboundElement *buffered = [[PPDeviceProxyOutboundElement alloc] init];
+    buffered.element = [outbound.element copy];
+    buffered.type = outbound.type;
+    buffered.recordId = outbound.recordId;
+    buffered.written = outbound.written;
+    
+    NSMutableArray *buffer = [self.reliabilityBuffer objectForKey:@(outbound.type).stringValue];
     if(buffer == nil) {
         buffer = [[NSMutableArray alloc] initWithCapacity:3];
+        [self.reliabilityBuffer setObject:buffer forKey:@(outbound.type).stringValue];
+    }
+    [buffer addObject:buffered];
+}
+
+- (void)acknowledgeReliabilityBuffer {
+    NSMutableArray *recordIds = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSString *bufferKey in self.reliabilityBuffer.allKeys) {
+        for(PPDeviceProxyOutboundElement *outbound in [self.reliabilityBuffer objectForKey:bufferKey]) {
+            if(outbound.recordId != PPDeviceProxyQueueRecordIdNone) {
+                [recordIds addObject:@(outbound.recordId)];
+            }
+        }
+    }
+    [self.reliabilityBuffer removeAllObjects];
+    
+    if(recordIds.count) {
+        [self.outboundQueue acknowledgeRecords:recordIds];
+    }
+}
+
+- (void)requeueReliabilityBuffer {
+    for(NSString *bufferKey in self.reliabilityBuffer.allKeys) {
+        [[self pendingQueueForType:(PPDeviceProxyReliabilityBufferType)bufferKey.integerValue] requeueObjects:[self.reliabilityBuffer objectForKey:bufferKey]];
+    }
+    [self.reliabilityBuffer removeAllObjects];
+}
+
+#pragma mark - WebSocket
+
+- (void)connectWebSocket {
+    if(self.webSocket || self.transport != PPDeviceProxyTransportWebSocket || !self.listeningToCommands) {
+        return;
+    }
+    PPDevice *device = self.localDevice.device;
+    NSString *URLString = [NSString stringWithFormat:@"%@?id=%@", [PPUrl deviceIOWebSocketURLString:self.server], device.deviceId];
+    self.webSocket = [self deviceIOWebSocketWithURL:URLString];
+    self.webSocket.HTTPHeaders = @{HTTP_HEADER_PPC_AUTHORIZATION: [NSString stringWithFormat:@"esp token=%@", self.authToken]};
+    self.deviceIORequests++;
+    [self.webSocket connect];
+}
+
+/**
+ * WebSocket to the DeviceIO endpoint, not connected yet
+ */
+- (PPWebSocket *)deviceIOWebSocketWithURL:(NSString *)URLString {
+    return [[PPWebSocket alloc] initWithURL:URLString resourceEndpoint:PPWebSocketResourceEndpointDeviceIO sessionId:nil delegate:self];
+}
+
+/**
+ * Drop the WebSocket and hand everything back to the long poll
+ *
+ * @param reconnect BOOL Try the WebSocket again after a jittered delay
+ */
+- (void)closeWebSocket:(BOOL)reconnect {
+    [self.webSocket disconnect];
+    self.webSocket = nil;
+    self.webSocketConnected = NO;
+    
+    __weak PPDeviceProxy *weakSelf = self;
+    dispatch_async(_senderQueue, ^{
+        if(weakSelf.webSocketSequenceNumber) {
+            // The unacknowledged message goes out again over HTTP
+            weakSelf.webSocketSequenceNumber = nil;
+            [weakSelf requeueReliabilityBuffer];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf doPersistentConnection];
+            });
+        }
+        else if(weakSelf.listeningToCommands) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf drainProxyQueue];
+            });
+        }
+    });
+    
+    if(reconnect) {
+        self.webSocketReconnectDelay = [[PPRetryPolicy sharedPolicy] delayAfter:self.webSocketReconnectDelay baseDelay:1];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.webSocketReconnectDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [weakSelf connectWebSocket];
+        });
+    }
+}
+
+/**
+ * Send what doPersistentConnection dequeued as one message. Must be called on the sender queue.
+ * Only one message waits for its acknowledgement at a time, like a request, so the reliability buffer holds a single message.
+ */
+- (void)sendOverWebSocket:(NSArray *)responses measurements:(NSArray *)measurements alerts:(NSArray *)alerts {
+    if(!(responses.count || measurements.count || alerts.count)) {
+        self.drainingProxyQueue = NO;
+        return;
+    }
+    
+    NSString *seqNumber = [PPDeviceProxy uniqueSequenceNumber];
+    NSDictionary *JSON = [self outboundJSON:seqNumber responses:responses measurements:measurements alerts:alerts];
+    NSString *message = [[NSString alloc] initWithData:[NSJSONSerialization dataWithJSONObject:JSON options:0 error:nil] encoding:NSUTF8StringEncoding];
+    self.webSocketSequenceNumber = seqNumber;
+    
+    __weak PPDeviceProxy *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if(!message || ![weakSelf.webSocket send:message]) {
+            [weakSelf closeWebSocket:YES];
+        }
+    });
+    
+    // Measurements and responses should go through quickly no matter what, as over HTTP
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.webSocketAcknowledgementTimeout * NSEC_PER_SEC)), _senderQueue, ^{
+        if([seqNumber isEqualToString:weakSelf.webSocketSequenceNumber]) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf closeWebSocket:YES];
+            });
+        }
+    });
+}
+
+#pragma mark - PPWebSocketDelegate
+
+- (void)websocketDidConnect:(SRWebSocket *)session {
+#ifdef DEBUG
+    NSLog(@"%s", __PRETTY_FUNCTION__);
+#endif
+    self.webSocketConnected = YES;
+    self.webSocketReconnectDelay = 0;
+    
+    // An idle long poll is cancelled so the next round goes over the WebSocket. A POST in flight completes first.
+    [self cancelLongPollRequest];
+    [self drainProxyQueue];
+}
+
+- (void)websocketBroken {
+    [self closeWebSocket:YES];
+}
+
+- (void)websocketBroken:(NSInteger)code reason:(NSString *)reason {
+#ifdef DEBUG
+    NSLog(@"%s code=%li reason=%@", __PRETTY_FUNCTION__, (long)code, reason);
+#endif
+    [self closeWebSocket:YES];
+}
+
+- (void)websocket:(SRWebSocket *)webSocket didReceiveMessage:(id)message {
+    NSData *data = [message isKindOfClass:[NSString class]] ? [(NSString *)message dataUsingEncoding:NSUTF8StringEncoding] : message;
+    
+    __weak PPDeviceProxy *weakSelf = self;
+    dispatch_async(_senderQueue, ^{
+        NSError *error = nil;
+        NSDictionary *root = [PPBaseModel processJSONResponse:data originatingClass:NSStringFromClass([weakSelf class]) error:&error];
+        if(error || !root) {
+            return;
+        }
+        
+        // Messages are commands pushed by the server, or the acknowledgement of what we sent
+        NSString *seq = [root objectForKey:@"seq"];
+        BOOL acknowledged = (seq && [seq isEqualToString:weakSelf.webSocketSequenceNumber]);
+        if(acknowledged) {
+            weakSelf.webSocketSequenceNumber = nil;
+            [weakSelf.outstandingCommands removeAllObjects];
+            [weakSelf acknowledgeReliabilityBuffer];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf processServerResponse:root];
+            if(acknowledged) {
+                [weakSelf doPersistentConnection];
+            }
+            else {
+                // Send the responses to pushed commands, unless a message is already waiting for its acknowledgement
+                [weakSelf drainProxyQueue];
+            }
+        });
+    });
+}
+
+#pragma mark - Outbound queue
+
+- (void)openOutboundQueueForLocationId:(PPLocationId)locationId {
+    if(_outboundQueue || locationId == PPLocationIdNone) {
+        return;
+    }
+    self.outboundQueue = [PPDeviceProxyQueue queueForLocationId:locationId];
+    
+    // Anything the server never acknowledged goes out again, in its original order, on the next connection
+    [_outboundQueue replayRecordsUsingBlock:^(PPDeviceProxyQueueRecordId recordId, PPDeviceProxyReliabilityBufferType type, NSDictionary *record) {
+        PPDeviceProxyOutboundElement *outbound = [[PPDeviceProxyOutboundElement alloc] init];
+        outbound.element = [PPDeviceProxy outboundElementForDictionary:record type:type];
+        outbound.type = type;
+        outbound.recordId = recordId;
+        outbound.written = YES;
+        if(outbound.element) {
+            [[self pendingQueueForType:type] enqueue:outbound];
+        }
+    }];
+}
+
+- (PPDeviceProxyPendingQueue *)pendingQueueForType:(PPDeviceProxyReliabilityBufferType)type {
+    switch(type) {
+        case PPDeviceProxyReliabilityBufferTypeCommandResponses:
+            return self.commandResponses;
+        case PPDeviceProxyReliabilityBufferTypeMeasurement:
+            return self.pendingMeasurements;
+        case PPDeviceProxyReliabilityBufferTypeAlert:
+            return self.pendingAlerts;
+        default:
+            return nil;
+    }
+}
+
+/**
+ * Safe from any thread, and lock-free.
+ * The record is written on the sender queue, together with everything else enqueued meanwhile, and always before the element is sent.
+ */
+- (void)enqueueOutbound:(id)element type:(PPDeviceProxyReliabilityBufferType)type {
+    BOOL write = (_outboundQueue != nil);
+    PPDeviceProxyOutboundElement *outbound = [[PPDeviceProxyOutboundElement alloc] init];
+    outbound.element = element;
+    outbound.type = type;
+    outbound.recordId = PPDeviceProxyQueueRecordIdNone;
+    outbound.written = !write;
+    
+    // Unwritten first, so the sender queue finds the element there whenever it dequeues it
+    if(write) {
+        [_unwrittenOutbound enqueue:outbound];
+    }
+    [[self pendingQueueForType:type] enqueue:outbound];
+    
+    if(write && !atomic_exchange(&_outboundWriteScheduled, true)) {
+        __weak PPDeviceProxy *weakSelf = self;
+        dispatch_async(_senderQueue, ^{
+            [weakSelf writeOutbound];
+        });
+    }
+}
+
+/**
+ * Sender queue only. Write the records of every element enqueued so far with a single write, and assign their record IDs.
+ */
+- (void)writeOutbound {
+    atomic_store(&_outboundWriteScheduled, false);
+    NSArray *elements = [_unwrittenOutbound dequeueObjects:NSUIntegerMax];
+    if(elements.count == 0) {
+        return;
+    }
+    
+    NSMutableArray *records = [[NSMutableArray alloc] initWithCapacity:elements.count];
+    NSMutableArray *types = [[NSMutableArray alloc] initWithCapacity:elements.count];
+    for(PPDeviceProxyOutboundElement *outbound in elements) {
+        [records addObject:[PPDeviceProxy dictionaryForOutboundElement:outbound.element type:outbound.type]];
+        [types addObject:@(outbound.type)];
+    }
+    
+    PPDeviceProxyQueueRecordId firstRecordId = [_outboundQueue appendRecords:records types:types];
+    [elements enumerateObjectsUsingBlock:^(PPDeviceProxyOutboundElement *outbound, NSUInteger i, BOOL *stop) {
+        outbound.recordId = (firstRecordId == PPDeviceProxyQueueRecordIdNone) ? PPDeviceProxyQueueRecordIdNone : firstRecordId + (PPDeviceProxyQueueRecordId)i;
+        outbound.written = YES;
+    }];
+}
+
+/**
+ * Sender queue only. Elements whose records were dropped to respect the disk limit of the outbound queue are dropped too.
+ */
+- (NSArray *)dequeueOutbound:(PPDeviceProxyPendingQueue *)queue maximumCount:(NSUInteger)maximumCount {
+    NSMutableArray *elements = [[NSMutableArray alloc] initWithCapacity:0];
+    while(elements.count < maximumCount) {
+        PPDeviceProxyOutboundElement *outbound = [queue dequeue];
+        if(outbound == nil) {
+            break;
+        }
+        if(!outbound.written) {
+            [self writeOutbound];
+        }
+        if(outbound.recordId != PPDeviceProxyQueueRecordIdNone && outbound.recordId < _outboundQueue.firstRecordId) {
+            continue;
+        }
+        [elements addObject:outbound];
+    }
+    return elements;
+}
+
+#pragma mark - Outbound serialization
+
++ (NSArray *)dictionariesForParameters:(NSArray *)parameters {
+    NSMutableArray *paramsArray = [[NSMutableArray alloc] initWithCapacity:0];
+    for(PPDeviceParameter *param in parameters) {
+        NSMutableDictionary *paramDict = [[NSMutableDictionary alloc] initWithCapacity:3];
+        if(param.name) {
+            [paramDict setValue:param.name forKey:@"name"];
+        }
+        if(param.value) {
+            [paramDict setValue:param.value forKey:@"value"];
+        }
+        if(param.index) {
+            [paramDict setValue:param.index forKey:@"index"];
+        }
+        [paramsArray addObject:paramDict];
+    }
+    return paramsArray;
+}
+
++ (NSArray *)parametersForDictionaries:(NSArray *)paramsArray {
+    NSMutableArray *parameters = [[NSMutableArray alloc] initWithCapacity:paramsArray.count];
+    for(NSDictionary *paramDict in paramsArray) {
+        [parameters addObject:[PPDeviceParameter initWithDictionary:paramDict]];
+    }
+    return parameters;
+}
+
++ (NSDictionary *)dictionaryForCommandResponse:(PPDeviceCommand *)response {
+    NSMutableDictionary *commandDict = [[NSMutableDictionary alloc] initWithCapacity:2];
+    if(response.commandId != PPDeviceCommandIdNone) {
+        [commandDict setValue:@(response.commandId).stringValue forKey:@"commandId"];
+    }
+    if(response.deviceId) {
+        [commandDict setValue:response.deviceId forKey:@"deviceId"];
+    }
+    if(response.typeId != PPDeviceTypeIdNone) {
+        [commandDict setValue:@(response.typeId).stringValue forKey:@"deviceType"];
+    }
+    if(response.creationDate) {
+        [commandDict setValue:[PPNSDate apiFriendStringFromDate:response.creationDate] forKey:@"creationDate"];
+    }
+    
+    if(response.type != PPDeviceCommandTypeNone) {
+        [commandDict setValue:@(response.commandId).stringValue forKey:@"commandId"];
+    }
+    
+    if(response.result != PPDeviceCommandResultNone) {
+        [commandDict setValue:@(response.result).stringValue forKey:@"result"];
+    }
+    
+    if(response.parameters) {
+        NSArray *paramsArray = [PPDeviceProxy dictionariesForParameters:response.parameters];
+        if([paramsArray count]) {
+            [commandDict setValue:paramsArray forKey:@"measures"];
+        }
+    }
+    return commandDict;
+}
+
++ (PPDeviceCommand *)commandResponseForDictionary:(NSDictionary *)commandDict {
+    PPDeviceCommandId commandId = PPDeviceCommandIdNone;
+    if([commandDict objectForKey:@"commandId"]) {
+        commandId = (PPDeviceCommandId)((NSString *)[commandDict objectForKey:@"commandId"]).integerValue;
+    }
+    PPDeviceTypeId typeId = PPDeviceTypeIdNone;
+    if([commandDict objectForKey:@"deviceType"]) {
+        typeId = (PPDeviceTypeId)((NSString *)[commandDict objectForKey:@"deviceType"]).integerValue;
+    }
+    NSDate *creationDate;
+    if([commandDict objectForKey:@"creationDate"]) {
+        creationDate = [PPNSDate parseDateTime:[commandDict objectForKey:@"creationDate"]];
+    }
+    PPDeviceCommandResult result = PPDeviceCommandResultNone;
+    if([commandDict objectForKey:@"result"]) {
+        result = (PPDeviceCommandResult)((NSString *)[commandDict objectForKey:@"result"]).integerValue;
+    }
+    NSArray *parameters;
+    if([commandDict objectForKey:@"measures"]) {
+        parameters = [PPDeviceProxy parametersForDictionaries:[commandDict objectForKey:@"measures"]];
+    }
+    return [[PPDeviceCommand alloc] initWithCommandId:commandId deviceId:[commandDict objectForKey:@"deviceId"] creationDate:creationDate typeId:typeId parameters:parameters type:PPDeviceCommandTypeNone result:result commandTimeout:PPDeviceCommandTimeoutNone comment:nil];
+}
+
++ (NSDictionary *)dictionaryForMeasurement:(PPDeviceMeasurement *)measurement {
+    NSMutableDictionary *measurementDict = [[NSMutableDictionary alloc] initWithCapacity:2];
+    [measurementDict setValue:measurement.deviceId forKey:@"deviceId"];
+    
+    if (measurement.lastMeasureDate != nil) {
+        [measurementDict setValue:[NSString stringWithFormat:@"%li", (long)measurement.lastMeasureDate.timeIntervalSince1970 * 1000] forKey:@"timestamp"];
+    }
+    
+    [measurementDict setValue:[PPDeviceProxy dictionariesForParameters:measurement.parameters] forKey:@"params"];
+    return measurementDict;
+}
+
++ (PPDeviceMeasurement *)measurementForDictionary:(NSDictionary *)measurementDict {
+    NSDate *lastMeasureDate;
+    if([measurementDict objectForKey:@"timestamp"]) {
+        lastMeasureDate = [NSDate dateWithTimeIntervalSince1970:((NSString *)[measurementDict objectForKey:@"timestamp"]).doubleValue / 1000];
+    }
+    return [[PPDeviceMeasurement alloc] initWithDeviceId:[measurementDict objectForKey:@"deviceId"] lastDataReceivedDate:lastMeasureDate lastMeasureDate:lastMeasureDate params:[PPDeviceProxy parametersForDictionaries:[measurementDict objectForKey:@"params"]]];
+}
+
++ (NSDictionary *)dictionaryForAlert:(PPDeviceMeasurementsAlert *)alert {
+    NSMutableDictionary *alertDict = [[NSMutableDictionary alloc] initWithCapacity:2];
+    
+    if(alert.deviceId) {
+        [alertDict setValue:alert.deviceId forKey:@"deviceId"];
+    }
+    if(alert.alertType) {
+        [alertDict setValue:alert.alertType forKey:@"alertType"];
+    }
+    if(alert.alertId != PPDeviceMeasurementsAlertIdNone) {
+        [alertDict setValue:@(alert.alertId).stringValue forKey:@"alertId"];
+    }
+    
+    if(alert.receivingDate) {
+        [alertDict setValue:@(floor(alert.receivingDate.timeIntervalSince1970)).stringValue forKey:@"timestamp"];
+    }
+    
+    if(alert.params) {
+        [alertDict setValue:[PPDeviceProxy dictionariesForParameters:alert.params] forKey:@"params"];
+    }
+    return alertDict;
+}
+
++ (PPDeviceMeasurementsAlert *)alertForDictionary:(NSDictionary *)alertDict {
+    PPDeviceMeasurementsAlertId alertId = PPDeviceMeasurementsAlertIdNone;
+    if([alertDict objectForKey:@"alertId"]) {
+        alertId = (PPDeviceMeasurementsAlertId)((NSString *)[alertDict objectForKey:@"alertId"]).integerValue;
+    }
+    NSDate *receivingDate;
+    if([alertDict objectForKey:@"timestamp"]) {
+        receivingDate = [NSDate dateWithTimeIntervalSince1970:((NSString *)[alertDict objectForKey:@"timestamp"]).doubleValue];
+    }
+    NSArray *params;
+    if([alertDict objectForKey:@"params"]) {
+        params = [PPDeviceProxy parametersForDictionaries:[alertDict objectForKey:@"params"]];
+    }
+    return [[PPDeviceMeasurementsAlert alloc] initWithAlertId:alertId deviceId:[alertDict objectForKey:@"deviceId"] alertType:[alertDict objectForKey:@"alertType"] receivingDate:receivingDate params:params];
+}
+
++ (NSDictionary *)dictionaryForOutboundElement:(id)element type:(PPDeviceProxyReliabilityBufferType)type {
+    switch(type) {
+        case PPDeviceProxyReliabilityBufferTypeCommandResponses:
+            return [PPDeviceProxy dictionaryForCommandResponse:element];
+        case PPDeviceProxyReliabilityBufferTypeMeasurement:
+            return [PPDeviceProxy dictionaryForMeasurement:element];
+        case PPDeviceProxyReliabilityBufferTypeAlert:
+            return [PPDeviceProxy dictionaryForAlert:element];
+        default:
+            return @{};
+    }
+}
+
++ (id)outboundElementForDictionary:(NSDictionary *)dictionary type:(PPDeviceProxyReliabilityBufferType)type {
+    switch(type) {
+        case PPDeviceProxyReliabilityBufferTypeCommandResponses:
+            return [PPDeviceProxy commandResponseForDictionary:dictionary];
+        case PPDeviceProxyReliabilityBufferTypeMeasurement:
+            return [PPDeviceProxy measurementForDictionary:dictionary];
+        case PPDeviceProxyReliabilityBufferTypeAlert:
+            return [PPDeviceProxy alertForDictionary:dictionary];
+        default:
+            return nil;
     }
-    [buffer addObject:object];
 }
 
 
@@ -0,0 +1,99 @@
+//
+//  PPDeviceProxyFileUpload.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPBaseModel.h"
+
+/**
+ * Uploads a whole file through a proxy as a pipeline of fragments.
+ * The first fragment creates the file. Up to maximumFragmentsInFlight of the following fragments are then sent at once, and the fragment that completes the file is sent after all others are acknowledged.
+ * Fragment sizes follow the measured throughput, in multiples of the 10 KB storage write size.
+ * A failed fragment is retried on its own; the fragments already acknowledged are not sent again.
+ */
+@interface PPDeviceProxyFileUpload : NSObject
+
+/**
+ * @param data Required NSData Complete file content
+ * @param proxyId Required NSString Device ID of the proxy the file is uploaded through
+ * @param authToken Required NSString Proxy authentication token
+ */
+- (id _Nonnull )initWithData:(NSData * _Nonnull )data proxyId:(NSString * _Nonnull )proxyId authToken:(NSString * _Nonnull )authToken;
+
+/**
+ * @param fileURL Required NSURL Local file. Only the fragments in flight are held in memory.
+ * @param proxyId Required NSString Device ID of the proxy the file is uploaded through
+ * @param authToken Required NSString Proxy authentication token
+ */
+- (id _Nonnull )initWithFileURL:(NSURL * _Nonnull )fileURL proxyId:(NSString * _Nonnull )proxyId authToken:(NSString * _Nonnull )authToken;
+
+#pragma mark - File
+
+@property (nonatomic, strong) NSString * _Nullable deviceId;
+@property (nonatomic, strong) NSString * _Nonnull fileExtension;
+@property (nonatomic, strong) NSString * _Nonnull contentType;
+@property (nonatomic) PPFileFileType type;
+@property (nonatomic) PPFileDuration duration;
+@property (nonatomic) PPFileRotate rotate;
+@property (nonatomic) PPFileId replacementFileId;
+
+/**
+ * Total size of the file in bytes
+ */
+@property (nonatomic, readonly) unsigned long long length;
+
+#pragma mark - Pipeline
+
+/**
+ * Maximum number of fragments uploading at once. Default is 4; 1 sends one fragment at a time.
+ */
+@property (nonatomic) NSInteger maximumFragmentsInFlight;
+
+/**
+ * Size of the first fragment in bytes. Default is 250 KB.
+ */
+@property (nonatomic) NSUInteger fragmentSize;
+
+/**
+ * Bounds for adapted fragment sizes in bytes. Defaults are 50 KB and 2000 KB.
+ */
+@property (nonatomic) NSUInteger minimumFragmentSize;
+@property (nonatomic) NSUInteger maximumFragmentSize;
+
+/**
+ * Each fragment is sized to take about this long at the measured throughput. Default is 2 seconds; 0 keeps fragmentSize for every fragment.
+ */
+@property (nonatomic) NSTimeInterval targetFragmentDuration;
+
+/**
+ * Shortest time to wait before a failed fragment is sent again. Later retries back off with jitter through PPRetryPolicy. Default is PROXY_DEFAULT_POST_FILE_RETRY_INTERVAL.
+ */
+@property (nonatomic) NSTimeInterval retryInterval;
+
+/**
+ * Number of times a fragment is sent again before the upload fails. Default is FILE_UPLOAD_ATTEMPT_LIMIT.
+ */
+@property (nonatomic) NSInteger attemptLimit;
+
+/**
+ * Throughput of one fragment request in bytes per second, averaged over recent fragments
+ */
+@property (atomic, readonly) double throughput;
+
+/**
+ * Start the upload.
+ *
+ * @param acknowledgmentBlock PPFileAcknowledgmentBlock Called for each acknowledged fragment, in fragment order
+ * @param callback Required PPFileAcknowledgmentBlock Called once, with the acknowledgement of the fragment that completed the file or with the error that stopped the upload
+ */
+- (void)startWithAcknowledgmentBlock:(PPFileAcknowledgmentBlock _Nullable )acknowledgmentBlock callback:(PPFileAcknowledgmentBlock _Nonnull )callback;
+
+/**
+ * Stop sending fragments. Fragments already in flight are not reported.
+ * The callback is called with an NSURLErrorCancelled error, unless the upload already finished.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,292 @@
+//
+//  PPDeviceProxyFileUpload.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPDeviceProxyFileUpload.h"
+#import "PPFileManagement.h"
+#import "PPCloudEngine.h"
+#import "PPRetryPolicy.h"
+
+@interface PPDeviceProxyFileUpload ()
+
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong) NSURL *fileURL;
+@property (nonatomic, strong) NSFileHandle *fileHandle;
+@property (nonatomic, strong) NSString *proxyId;
+@property (nonatomic, strong) NSString *authToken;
+@property (nonatomic) unsigned long long length;
+@property (atomic) double throughput;
+
+// Pipeline state, only touched on the upload queue
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic) PPFileId fileId;
+@property (nonatomic) unsigned long long nextOffset;
+@property (nonatomic) PPFileFragmentIndex nextIndex;
+@property (nonatomic) NSInteger fragmentsInFlight;
+@property (nonatomic) NSUInteger nextFragmentSize;
+@property (nonatomic) BOOL finalFragmentSent;
+@property (nonatomic) BOOL finished;
+@property (nonatomic) PPFileFragmentIndex nextAcknowledgedIndex;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, dispatch_block_t> *acknowledgments;
+@property (nonatomic, copy) PPFileAcknowledgmentBlock acknowledgmentBlock;
+@property (nonatomic, copy) PPFileAcknowledgmentBlock callback;
+
+@end
+
+@implementation PPDeviceProxyFileUpload
+
+- (id)initWithProxyId:(NSString *)proxyId authToken:(NSString *)authToken {
+    self = [super init];
+    if(self) {
+        _proxyId = proxyId;
+        _authToken = authToken;
+        _type = PPFileFileTypeNone;
+        _duration = PPFileDurationNone;
+        _rotate = PPFileRotateNone;
+        _replacementFileId = PPFileIdNone;
+        _maximumFragmentsInFlight = PROXY_DEFAULT_FILE_FRAGMENTS_IN_FLIGHT;
+        _fragmentSize = PROXY_DEFAULT_FILE_FRAGMENT_SIZE;
+        _minimumFragmentSize = PROXY_DEFAULT_MINIMUM_FILE_FRAGMENT_SIZE;
+        _maximumFragmentSize = PROXY_DEFAULT_MAXIMUM_FILE_FRAGMENT_SIZE;
+        _targetFragmentDuration = PROXY_DEFAULT_FILE_FRAGMENT_DURATION;
+        _retryInterval = PROXY_DEFAULT_POST_FILE_RETRY_INTERVAL;
+        _attemptLimit = FILE_UPLOAD_ATTEMPT_LIMIT;
+        _fileId = PPFileIdNone;
+        _acknowledgments = [[NSMutableDictionary alloc] initWithCapacity:0];
+        _queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.PPDeviceProxyFileUpload", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(_queue, [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk]);
+    }
+    return self;
+}
+
+- (id)initWithData:(NSData *)data proxyId:(NSString *)proxyId authToken:(NSString *)authToken {
+    self = [self initWithProxyId:proxyId authToken:authToken];
+    if(self) {
+        _data = data;
+        _length = data.length;
+    }
+    return self;
+}
+
+- (id)initWithFileURL:(NSURL *)fileURL proxyId:(NSString *)proxyId authToken:(NSString *)authToken {
+    self = [self initWithProxyId:proxyId authToken:authToken];
+    if(self) {
+        _fileURL = fileURL;
+        NSNumber *fileSize;
+        if([fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil] && fileSize) {
+            _length = fileSize.unsignedLongLongValue;
+        }
+    }
+    return self;
+}
+
+- (void)startWithAcknowledgmentBlock:(PPFileAcknowledgmentBlock)acknowledgmentBlock callback:(PPFileAcknowledgmentBlock)callback {
+    NSAssert1(callback != nil, @"%s missing callback", __FUNCTION__);
+    NSAssert1(_fileExtension != nil, @"%s missing fileExtension", __FUNCTION__);
+    NSAssert1(_contentType != nil, @"%s missing contentType", __FUNCTION__);
+
+    dispatch_async(_queue, ^{
+        self.acknowledgmentBlock = acknowledgmentBlock;
+        self.callback = callback;
+
+        if(self.fileURL) {
+            self.fileHandle = [NSFileHandle fileHandleForReadingFromURL:self.fileURL error:nil];
+        }
+        if(self.length == 0 || (self.fileURL && !self.fileHandle)) {
+            [self finishWithError:[PPBaseModel resultCodeToNSError:10017 originatingClass:NSStringFromClass([self class])]];
+            return;
+        }
+
+        // The first fragment creates the file, so the rest wait for its ID
+        self.nextFragmentSize = [self alignedFragmentSize:self.fragmentSize];
+        [self sendNextFragment];
+    });
+}
+
+- (void)cancel {
+    dispatch_async(_queue, ^{
+        if(!self.finished) {
+            [self finishWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+        }
+    });
+}
+
+#pragma mark - Pipeline
+
+/**
+ * Round down to the storage write size, within the configured bounds
+ */
+- (NSUInteger)alignedFragmentSize:(double)size {
+    double minimum = MAX(PROXY_FILE_FRAGMENT_SIZE_UNIT, _minimumFragmentSize);
+    double maximum = MAX(minimum, _maximumFragmentSize);
+    size = MIN(MAX(size, minimum), maximum);
+    return (NSUInteger)(size / PROXY_FILE_FRAGMENT_SIZE_UNIT) * PROXY_FILE_FRAGMENT_SIZE_UNIT;
+}
+
+- (void)fillPipeline {
+    if(_finished || _fileId == PPFileIdNone) {
+        return;
+    }
+    while(!_finalFragmentSent && _fragmentsInFlight < MAX(1, _maximumFragmentsInFlight) && _nextOffset < _length) {
+        // The fragment that completes the file must not overtake the others
+        if(_length - _nextOffset <= _nextFragmentSize && _fragmentsInFlight > 0) {
+            break;
+        }
+        [self sendNextFragment];
+    }
+}
+
+- (void)sendNextFragment {
+    unsigned long long offset = _nextOffset;
+    NSUInteger length = (NSUInteger)MIN((unsigned long long)_nextFragmentSize, _length - offset);
+    BOOL final = (offset + length == _length);
+    PPFileFragmentIndex index = _nextIndex;
+
+    _nextOffset += length;
+    _nextIndex++;
+    _finalFragmentSent = final;
+    _fragmentsInFlight++;
+    [self sendFragment:index offset:offset length:length final:final attempt:0];
+}
+
+- (NSData *)readOffset:(unsigned long long)offset length:(NSUInteger)length {
+    if(_data) {
+        return [_data subdataWithRange:NSMakeRange((NSUInteger)offset, length)];
+    }
+    @try {
+        [_fileHandle seekToFileOffset:offset];
+        return [_fileHandle readDataOfLength:length];
+    }
+    @catch (NSException *exception) {
+        return nil;
+    }
+}
+
+- (void)sendFragment:(PPFileFragmentIndex)index offset:(unsigned long long)offset length:(NSUInteger)length final:(BOOL)final attempt:(NSInteger)attempt {
+    if(_finished) {
+        return;
+    }
+    NSData *data = [self readOffset:offset length:length];
+    if(data.length != length) {
+        [self finishWithError:[PPBaseModel resultCodeToNSError:10017 originatingClass:NSStringFromClass([self class])]];
+        return;
+    }
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    PPFileManagementFragmentBlock fragmentCallback = ^(NSString *status, PPFile *fileFragment, PPFileTotalFileSpace totalFileSpace, PPFileUsedFileSpace usedFileSpace, PPFileTwitterShare twitterShare, NSString *twitterAccount, NSString *contentUrl, PPFileStoragePolicy storagePolicy, NSDictionary *uploadHeaders, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if(self.finished) {
+                return;
+            }
+            if(error || (index == 0 && fileFragment.fileId == PPFileIdNone)) {
+                NSTimeInterval delay = RETRY_POLICY_NO_RETRY;
+                if(attempt < self.attemptLimit) {
+                    delay = [[PPRetryPolicy sharedPolicy] retryDelayForHost:[[PPCloudEngine sharedAppEngine] getBaseURL].host baseDelay:self.retryInterval];
+                }
+                if(delay != RETRY_POLICY_NO_RETRY) {
+#ifdef DEBUG
+                    NSLog(@"PPDeviceProxyFileUpload: Error sending fragment %li; retry in %.1fs: %@", (long)index, delay, error);
+#endif
+                    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+                        [self sendFragment:index offset:offset length:length final:final attempt:attempt + 1];
+                    });
+                }
+                else {
+                    [self finishWithError:error ?: [PPBaseModel resultCodeToNSError:10041 originatingClass:NSStringFromClass([self class])]];
+                }
+                return;
+            }
+
+            self.fragmentsInFlight--;
+            [self measureFragment:length duration:CFAbsoluteTimeGetCurrent() - startTime];
+            if(index == 0) {
+                self.fileId = fileFragment.fileId;
+            }
+
+            PPFileId fileId = self.fileId;
+            PPFileAcknowledgmentBlock acknowledgmentBlock = self.acknowledgmentBlock;
+            PPFileAcknowledgmentBlock callback = self.callback;
+            [self.acknowledgments setObject:^{
+                if(acknowledgmentBlock) {
+                    acknowledgmentBlock(fileId, fileFragment.fragments, usedFileSpace, totalFileSpace, fileFragment.filesAction, fileFragment.thumbnail, twitterShare, nil);
+                }
+                if(final) {
+                    callback(fileId, fileFragment.fragments, usedFileSpace, totalFileSpace, fileFragment.filesAction, fileFragment.thumbnail, twitterShare, nil);
+                }
+            } forKey:@(index)];
+            [self deliverAcknowledgments];
+
+            if(final) {
+                self.finished = YES;
+                [self.fileHandle closeFile];
+                self.fileHandle = nil;
+                return;
+            }
+            [self fillPipeline];
+        });
+    };
+
+    PPFileIncomplete incomplete = final ? PPFileIncompleteFalse : PPFileIncompleteTrue;
+    if(index == 0) {
+        [PPFileManagement uploadNewFile:_proxyId deviceId:_deviceId fileExtension:_fileExtension expectedSize:(PPFileSize)_length duration:_duration rotate:_rotate fileId:_replacementFileId thumbnail:PPFileThumbnailNone incomplete:incomplete type:_type contentType:_contentType authorizationType:PPFileManagementAuthorizationTypeDeviceAuthenticationToken token:_authToken sessionId:nil data:data uploadUrl:PPFileUploadUrlNone progressBlock:nil callback:fragmentCallback];
+    }
+    else {
+        [PPFileManagement uploadFileFragment:_fileId proxyId:_proxyId fileExtension:_fileExtension thumbnail:PPFileThumbnailNone incomplete:incomplete index:index contentType:_contentType authorizationType:PPFileManagementAuthorizationTypeDeviceAuthenticationToken token:_authToken sessionId:nil data:data callback:fragmentCallback];
+    }
+}
+
+/**
+ * Size the next fragments to take about targetFragmentDuration at the recent throughput.
+ * On a high-latency link a small fragment spends most of its time waiting, so its measured throughput is low and the fragments grow.
+ */
+- (void)measureFragment:(NSUInteger)length duration:(CFAbsoluteTime)duration {
+    if(duration <= 0 || _targetFragmentDuration <= 0) {
+        return;
+    }
+    double sample = length / duration;
+    double throughput = self.throughput;
+    throughput = (throughput > 0) ? (throughput * 0.5 + sample * 0.5) : sample;
+    self.throughput = throughput;
+    _nextFragmentSize = [self alignedFragmentSize:throughput * _targetFragmentDuration];
+}
+
+/**
+ * Report acknowledgements in fragment order, holding back any that arrived early
+ */
+- (void)deliverAcknowledgments {
+    NSMutableArray *blocks = [[NSMutableArray alloc] initWithCapacity:_acknowledgments.count];
+    dispatch_block_t block;
+    while((block = [_acknowledgments objectForKey:@(_nextAcknowledgedIndex)])) {
+        [blocks addObject:block];
+        [_acknowledgments removeObjectForKey:@(_nextAcknowledgedIndex)];
+        _nextAcknowledgedIndex++;
+    }
+    if(blocks.count) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for(dispatch_block_t block in blocks) {
+                block();
+            }
+        });
+    }
+}
+
+- (void)finishWithError:(NSError *)error {
+    _finished = YES;
+    [_acknowledgments removeAllObjects];
+    [_fileHandle closeFile];
+    _fileHandle = nil;
+
+    // Not started yet, there is nobody to tell
+    PPFileAcknowledgmentBlock callback = _callback;
+    if(!callback) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        callback(PPFileIdNone, PPFileFragmentsNone, PPFileUsedFileSpaceNone, PPFileTotalFileSpaceNone, PPFileFilesActionNone, PPFileThumbnailNone, PPFileTwitterShareNone, error);
+    });
+}
+
+@end
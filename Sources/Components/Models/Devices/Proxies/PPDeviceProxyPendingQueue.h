@@ -0,0 +1,63 @@
+//
+//  PPDeviceProxyPendingQueue.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Lock-free FIFO queue with many producers and a single consumer.
+ * Any thread may enqueue. Dequeue, requeue and removal must only be called by the one consumer at a time.
+ * An object is visible to the consumer once the enqueue that added it has returned.
+ */
+@interface PPDeviceProxyPendingQueue : NSObject
+
+/**
+ * Approximate number of queued objects
+ */
+@property (atomic, readonly) NSUInteger count;
+
+#pragma mark - Producers
+
+/**
+ * Add an object at the end. Safe from any thread.
+ *
+ * @param object Required Object to add
+ */
+- (void)enqueue:(id _Nonnull )object;
+
+/**
+ * Add objects at the end, next to each other and in order. Safe from any thread.
+ *
+ * @param objects Required NSArray Objects to add
+ */
+- (void)enqueueObjects:(NSArray * _Nonnull )objects;
+
+#pragma mark - Consumer
+
+/**
+ * @return Oldest object, nil if there is none
+ */
+- (id _Nullable )dequeue;
+
+/**
+ * @param maximumCount NSUInteger Maximum number of objects
+ * @return NSArray Oldest objects, in order
+ */
+- (NSArray * _Nonnull )dequeueObjects:(NSUInteger)maximumCount;
+
+/**
+ * Put objects that were dequeued back at the front, in order.
+ *
+ * @param objects Required NSArray Objects to put back
+ */
+- (void)requeueObjects:(NSArray * _Nonnull )objects;
+
+/**
+ * Remove every object
+ */
+- (void)removeAllObjects;
+
+@end
@@ -0,0 +1,142 @@
+//
+//  PPDeviceProxyPendingQueue.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPDeviceProxyPendingQueue.h"
+#import <stdatomic.h>
+
+/**
+ * Intrusive MPSC list (Vyukov). Producers swap the head and then link the previous head to their node.
+ * The consumer owns the tail, which is always an already consumed node.
+ */
+typedef struct PPDeviceProxyPendingQueueNode {
+    _Atomic(struct PPDeviceProxyPendingQueueNode *) next;
+    void *object;
+} PPDeviceProxyPendingQueueNode;
+
+static PPDeviceProxyPendingQueueNode *PPDeviceProxyPendingQueueNodeCreate(id object) {
+    PPDeviceProxyPendingQueueNode *node = malloc(sizeof(PPDeviceProxyPendingQueueNode));
+    atomic_init(&node->next, NULL);
+    node->object = object ? (void *)CFBridgingRetain(object) : NULL;
+    return node;
+}
+
+@interface PPDeviceProxyPendingQueue () {
+    _Atomic(PPDeviceProxyPendingQueueNode *) _head;
+    PPDeviceProxyPendingQueueNode *_tail;
+    atomic_long _count;
+
+    // Requeued objects, only touched by the consumer
+    NSMutableArray *_front;
+}
+@end
+
+@implementation PPDeviceProxyPendingQueue
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        PPDeviceProxyPendingQueueNode *stub = PPDeviceProxyPendingQueueNodeCreate(nil);
+        atomic_init(&_head, stub);
+        _tail = stub;
+        atomic_init(&_count, 0);
+        _front = [[NSMutableArray alloc] initWithCapacity:0];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    while([self dequeue]) {
+    }
+    free(_tail);
+}
+
+- (NSUInteger)count {
+    long count = atomic_load_explicit(&_count, memory_order_relaxed);
+    return count > 0 ? (NSUInteger)count : 0;
+}
+
+#pragma mark - Producers
+
+- (void)enqueue:(id)object {
+    [self enqueueObjects:@[object]];
+}
+
+- (void)enqueueObjects:(NSArray *)objects {
+    if(objects.count == 0) {
+        return;
+    }
+
+    // Link the new nodes privately, then publish them with one swap so they stay together
+    PPDeviceProxyPendingQueueNode *first = NULL;
+    PPDeviceProxyPendingQueueNode *last = NULL;
+    for(id object in objects) {
+        PPDeviceProxyPendingQueueNode *node = PPDeviceProxyPendingQueueNodeCreate(object);
+        if(last) {
+            atomic_store_explicit(&last->next, node, memory_order_relaxed);
+        }
+        else {
+            first = node;
+        }
+        last = node;
+    }
+
+    atomic_fetch_add_explicit(&_count, (long)objects.count, memory_order_relaxed);
+    PPDeviceProxyPendingQueueNode *previous = atomic_exchange_explicit(&_head, last, memory_order_acq_rel);
+    atomic_store_explicit(&previous->next, first, memory_order_release);
+}
+
+#pragma mark - Consumer
+
+- (id)dequeue {
+    if(_front.count) {
+        id object = _front.firstObject;
+        [_front removeObjectAtIndex:0];
+        atomic_fetch_sub_explicit(&_count, 1, memory_order_relaxed);
+        return object;
+    }
+
+    // A producer between its swap and its link hides the nodes after it until it finishes
+    PPDeviceProxyPendingQueueNode *tail = _tail;
+    PPDeviceProxyPendingQueueNode *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if(next == NULL) {
+        return nil;
+    }
+
+    _tail = next;
+    id object = CFBridgingRelease(next->object);
+    next->object = NULL;
+    free(tail);
+    atomic_fetch_sub_explicit(&_count, 1, memory_order_relaxed);
+    return object;
+}
+
+- (NSArray *)dequeueObjects:(NSUInteger)maximumCount {
+    NSMutableArray *objects = [[NSMutableArray alloc] initWithCapacity:MIN(maximumCount, self.count)];
+    while(objects.count < maximumCount) {
+        id object = [self dequeue];
+        if(object == nil) {
+            break;
+        }
+        [objects addObject:object];
+    }
+    return objects;
+}
+
+- (void)requeueObjects:(NSArray *)objects {
+    if(objects.count == 0) {
+        return;
+    }
+    [_front insertObjects:objects atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, objects.count)]];
+    atomic_fetch_add_explicit(&_count, (long)objects.count, memory_order_relaxed);
+}
+
+- (void)removeAllObjects {
+    while([self dequeue]) {
+    }
+}
+
+@end
@@ -0,0 +1,83 @@
+//
+//  PPDeviceProxyQueue.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPBaseModel.h"
+
+/**
+ * Append-only, segmented outbound queue for proxy command responses, measurements and alerts.
+ * Each record is written to disk before it is sent, so it survives the app being terminated, and is replayed when the proxy is restored.
+ * Records are acknowledged once the server accepts the request that carried them. Segments are deleted when all of their records are acknowledged.
+ */
+@interface PPDeviceProxyQueue : NSObject
+
+/**
+ * Queue for a proxy location. Queues live in the application support directory.
+ *
+ * @param locationId Required PPLocationId Location the proxy belongs to
+ */
++ (PPDeviceProxyQueue * _Nonnull )queueForLocationId:(PPLocationId)locationId;
+
+- (id _Nonnull )initWithDirectoryURL:(NSURL * _Nonnull )directoryURL;
+
+/**
+ * A new segment is started when the current one reaches this size in bytes. Default is 256 KB.
+ */
+@property (atomic) unsigned long long maximumSegmentSize;
+
+/**
+ * Maximum disk usage in bytes. The oldest segments are dropped first, even if they hold unacknowledged records. Default is 5 MB.
+ */
+@property (atomic) unsigned long long maximumDiskSize;
+
+/**
+ * Current disk usage in bytes
+ */
+@property (atomic, readonly) unsigned long long diskSize;
+
+/**
+ * Records older than this were dropped to respect maximumDiskSize
+ */
+@property (atomic, readonly) PPDeviceProxyQueueRecordId firstRecordId;
+
+/**
+ * Append a record.
+ *
+ * @param record Required NSDictionary JSON object to store
+ * @param type PPDeviceProxyReliabilityBufferType Kind of element
+ * @return PPDeviceProxyQueueRecordId Record ID, PPDeviceProxyQueueRecordIdNone if the record could not be written
+ */
+- (PPDeviceProxyQueueRecordId)appendRecord:(NSDictionary * _Nonnull )record type:(PPDeviceProxyReliabilityBufferType)type;
+
+/**
+ * Append records with a single write.
+ *
+ * @param records Required NSArray NSDictionary JSON objects to store
+ * @param types Required NSArray NSNumber PPDeviceProxyReliabilityBufferType of each record
+ * @return PPDeviceProxyQueueRecordId ID of the first record, the others follow in order. PPDeviceProxyQueueRecordIdNone if the records could not be written
+ */
+- (PPDeviceProxyQueueRecordId)appendRecords:(NSArray * _Nonnull )records types:(NSArray * _Nonnull )types;
+
+/**
+ * Acknowledge records the server accepted.
+ *
+ * @param recordIds Required NSArray NSNumber record IDs
+ */
+- (void)acknowledgeRecords:(NSArray * _Nonnull )recordIds;
+
+/**
+ * Unacknowledged records in the order they were appended
+ *
+ * @param block Required Called with each record
+ */
+- (void)replayRecordsUsingBlock:(void (^ _Nonnull )(PPDeviceProxyQueueRecordId recordId, PPDeviceProxyReliabilityBufferType type, NSDictionary * _Nonnull record))block;
+
+/**
+ * Remove every record
+ */
+- (void)removeAllRecords;
+
+@end
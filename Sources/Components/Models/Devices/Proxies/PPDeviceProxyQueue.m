@@ -0,0 +1,424 @@
+//
+//  PPDeviceProxyQueue.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPDeviceProxyQueue.h"
+
+#define PROXY_QUEUE_DEFAULT_MAXIMUM_SEGMENT_SIZE (256 * 1024)
+#define PROXY_QUEUE_DEFAULT_MAXIMUM_DISK_SIZE (5 * 1024 * 1024)
+
+static NSString *kSegmentExtension = @"log";
+static NSString *kRecordIdKey = @"i";
+static NSString *kRecordTypeKey = @"t";
+static NSString *kRecordDataKey = @"d";
+static NSString *kRecordAcknowledgedKey = @"a";
+
+/**
+ * Record framing, native byte order:
+ * header, JSON payload[length]
+ * The payload is either a data record {i, t, d} or an acknowledgement {a: [record IDs]}.
+ */
+typedef struct {
+    uint32_t length;
+    uint32_t checksum;
+} PPDeviceProxyQueueRecordHeader;
+
+/**
+ * FNV-1a, enough to detect a torn or corrupt record
+ */
+static uint32_t PPDeviceProxyQueueChecksum(const uint8_t *bytes, NSUInteger length) {
+    uint32_t hash = 2166136261u;
+    for(NSUInteger i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * One segment file and the records in it that still wait for an acknowledgement
+ */
+@interface PPDeviceProxyQueueSegment : NSObject
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic) PPDeviceProxyQueueRecordId firstRecordId;
+@property (nonatomic) unsigned long long size;
+@property (nonatomic, strong) NSMutableIndexSet *liveRecordIds;
+
+// A failed write could not be cut off, nothing more is appended to this segment
+@property (nonatomic) BOOL sealed;
+@end
+
+@implementation PPDeviceProxyQueueSegment
+@end
+
+@interface PPDeviceProxyQueue ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSMutableArray *segments;
+@property (nonatomic, strong) NSFileHandle *activeHandle;
+@property (nonatomic) PPDeviceProxyQueueRecordId nextRecordId;
+@property (atomic, readwrite) PPDeviceProxyQueueRecordId firstRecordId;
+@property (nonatomic, strong) NSLock *lock;
+@end
+
+@implementation PPDeviceProxyQueue
+
++ (PPDeviceProxyQueue *)queueForLocationId:(PPLocationId)locationId {
+    static NSMutableDictionary *_queues = nil;
+    static NSLock *_queuesLock = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _queues = [[NSMutableDictionary alloc] initWithCapacity:1];
+        _queuesLock = [[NSLock alloc] init];
+    });
+
+    [_queuesLock lock];
+    PPDeviceProxyQueue *queue = [_queues objectForKey:@(locationId)];
+    if(!queue) {
+        // Not the caches directory, which the system may purge while records are waiting to be sent
+        NSURL *supportURL = [[NSFileManager defaultManager] URLForDirectory:NSApplicationSupportDirectory inDomain:NSUserDomainMask appropriateForURL:nil create:YES error:nil];
+        NSURL *directoryURL = [[supportURL URLByAppendingPathComponent:@"com.peoplepowerco.lib.Peoplepower.ProxyQueue" isDirectory:YES] URLByAppendingPathComponent:@(locationId).stringValue isDirectory:YES];
+        queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+        [_queues setObject:queue forKey:@(locationId)];
+    }
+    [_queuesLock unlock];
+    return queue;
+}
+
+- (id)initWithDirectoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if(self) {
+        self.maximumSegmentSize = PROXY_QUEUE_DEFAULT_MAXIMUM_SEGMENT_SIZE;
+        self.maximumDiskSize = PROXY_QUEUE_DEFAULT_MAXIMUM_DISK_SIZE;
+        self.directoryURL = directoryURL;
+        self.segments = [[NSMutableArray alloc] initWithCapacity:1];
+        self.nextRecordId = 0;
+        self.firstRecordId = 0;
+        self.lock = [[NSLock alloc] init];
+
+        [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        [directoryURL setResourceValue:@YES forKey:NSURLIsExcludedFromBackupKey error:nil];
+        [self loadSegments];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_activeHandle closeFile];
+}
+
+- (unsigned long long)diskSize {
+    [_lock lock];
+    unsigned long long size = 0;
+    for(PPDeviceProxyQueueSegment *segment in _segments) {
+        size += segment.size;
+    }
+    [_lock unlock];
+    return size;
+}
+
+#pragma mark - Segments
+
+/**
+ * Payload of the record at an offset, nil if there is no complete and intact record there
+ *
+ * @param length Set to the length of the record, header included
+ */
+static NSDictionary *PPDeviceProxyQueuePayloadAtOffset(NSData *data, NSUInteger offset, NSUInteger *length) {
+    const uint8_t *bytes = data.bytes;
+    PPDeviceProxyQueueRecordHeader header;
+    memcpy(&header, bytes + offset, sizeof(header));
+    NSUInteger payloadOffset = offset + sizeof(header);
+    if(header.length == 0 || payloadOffset + header.length > data.length || bytes[payloadOffset] != '{') {
+        return nil;
+    }
+    if(PPDeviceProxyQueueChecksum(bytes + payloadOffset, header.length) != header.checksum) {
+        return nil;
+    }
+    NSDictionary *payload = [NSJSONSerialization JSONObjectWithData:[data subdataWithRange:NSMakeRange(payloadOffset, header.length)] options:0 error:nil];
+    if(![payload isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    *length = sizeof(header) + header.length;
+    return payload;
+}
+
+/**
+ * Walk the intact records of a segment.
+ * A corrupt record in the middle is skipped by looking for the next record that checks out, so the records after it survive.
+ *
+ * @return NSUInteger Length of the segment up to the end of its last intact record
+ */
+- (NSUInteger)readSegment:(NSURL *)url usingBlock:(void (^)(NSDictionary *payload))block {
+    NSData *data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:nil];
+    NSUInteger offset = 0;
+    NSUInteger validLength = 0;
+    while(offset + sizeof(PPDeviceProxyQueueRecordHeader) <= data.length) {
+        NSUInteger length = 0;
+        NSDictionary *payload = PPDeviceProxyQueuePayloadAtOffset(data, offset, &length);
+        if(!payload) {
+            offset++;
+            continue;
+        }
+        block(payload);
+        offset += length;
+        validLength = offset;
+    }
+    return validLength;
+}
+
+- (void)loadSegments {
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_directoryURL includingPropertiesForKeys:nil options:NSDirectoryEnumerationSkipsHiddenFiles error:nil];
+    files = [[files filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"pathExtension == %@", kSegmentExtension]] sortedArrayUsingComparator:^NSComparisonResult(NSURL *url1, NSURL *url2) {
+        return [url1.lastPathComponent compare:url2.lastPathComponent];
+    }];
+
+    BOOL firstSegment = YES;
+    for(NSURL *url in files) {
+        PPDeviceProxyQueueSegment *segment = [[PPDeviceProxyQueueSegment alloc] init];
+        segment.url = url;
+        segment.firstRecordId = (PPDeviceProxyQueueRecordId)[url.lastPathComponent.stringByDeletingPathExtension longLongValue];
+        segment.liveRecordIds = [[NSMutableIndexSet alloc] init];
+        if(firstSegment) {
+            self.firstRecordId = segment.firstRecordId;
+            firstSegment = NO;
+        }
+
+        NSUInteger validLength = [self readSegment:url usingBlock:^(NSDictionary *payload) {
+            NSNumber *recordId = [payload objectForKey:kRecordIdKey];
+            if(recordId) {
+                [segment.liveRecordIds addIndex:recordId.unsignedIntegerValue];
+                self.nextRecordId = MAX(self.nextRecordId, recordId.integerValue + 1);
+            }
+            for(NSNumber *acknowledgedId in [payload objectForKey:kRecordAcknowledgedKey]) {
+                [self removeLiveRecordId:acknowledgedId.unsignedIntegerValue];
+                [segment.liveRecordIds removeIndex:acknowledgedId.unsignedIntegerValue];
+            }
+        }];
+
+        // Drop a record torn by a crash at the end of the segment
+        NSNumber *fileSize;
+        [url getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil];
+        if(validLength < fileSize.unsignedLongLongValue) {
+            NSFileHandle *handle = [NSFileHandle fileHandleForWritingToURL:url error:nil];
+            [handle truncateFileAtOffset:validLength];
+            [handle closeFile];
+        }
+        segment.size = validLength;
+        self.nextRecordId = MAX(self.nextRecordId, segment.firstRecordId);
+        [_segments addObject:segment];
+    }
+
+    [self compact];
+}
+
+- (void)removeLiveRecordId:(NSUInteger)recordId {
+    for(PPDeviceProxyQueueSegment *segment in _segments) {
+        if([segment.liveRecordIds containsIndex:recordId]) {
+            [segment.liveRecordIds removeIndex:recordId];
+            return;
+        }
+    }
+}
+
+- (PPDeviceProxyQueueSegment *)writableSegment {
+    PPDeviceProxyQueueSegment *segment = _segments.lastObject;
+    if(segment && !segment.sealed && segment.size < self.maximumSegmentSize) {
+        if(!_activeHandle) {
+            self.activeHandle = [NSFileHandle fileHandleForWritingToURL:segment.url error:nil];
+            [_activeHandle seekToEndOfFile];
+        }
+        return segment;
+    }
+
+    [_activeHandle closeFile];
+    self.activeHandle = nil;
+
+    // A segment sealed before its first record is replaced by the new one, which has the same name
+    if(segment && segment.size == 0) {
+        [_segments removeLastObject];
+    }
+
+    segment = [[PPDeviceProxyQueueSegment alloc] init];
+    segment.url = [_directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@"%020lld.%@", (long long)_nextRecordId, kSegmentExtension]];
+    segment.firstRecordId = _nextRecordId;
+    segment.liveRecordIds = [[NSMutableIndexSet alloc] init];
+    if(![[NSFileManager defaultManager] createFileAtPath:segment.url.path contents:nil attributes:nil]) {
+        return nil;
+    }
+    self.activeHandle = [NSFileHandle fileHandleForWritingToURL:segment.url error:nil];
+    if(!_activeHandle) {
+        return nil;
+    }
+    [_segments addObject:segment];
+    return segment;
+}
+
+- (BOOL)writePayloads:(NSArray *)payloads segment:(PPDeviceProxyQueueSegment *)segment {
+    NSMutableData *recordData = [[NSMutableData alloc] initWithCapacity:0];
+    for(NSDictionary *payload in payloads) {
+        NSData *payloadData = [NSJSONSerialization dataWithJSONObject:payload options:0 error:nil];
+        if(!payloadData) {
+            return NO;
+        }
+
+        PPDeviceProxyQueueRecordHeader header;
+        header.length = (uint32_t)payloadData.length;
+        header.checksum = PPDeviceProxyQueueChecksum(payloadData.bytes, payloadData.length);
+        [recordData appendBytes:&header length:sizeof(header)];
+        [recordData appendData:payloadData];
+    }
+
+    // One write for the whole group, so a crash leaves at most a torn record at the end
+    @try {
+        [_activeHandle writeData:recordData];
+    }
+    @catch (NSException *e) {
+#ifdef DEBUG
+        NSLog(@"%s - Error writing proxy queue record: %@", __PRETTY_FUNCTION__, e);
+#endif
+        // Cut off whatever part of the record reached the file, so the next record follows the last complete one
+        @try {
+            [_activeHandle truncateFileAtOffset:segment.size];
+        }
+        @catch (NSException *truncateException) {
+            [_activeHandle closeFile];
+            self.activeHandle = nil;
+            segment.sealed = YES;
+        }
+        return NO;
+    }
+    segment.size += recordData.length;
+    return YES;
+}
+
+/**
+ * Delete acknowledged segments from the front, so acknowledgements in later segments are never needed for earlier ones.
+ * Then drop the oldest segments while over the disk limit.
+ */
+- (void)compact {
+    while(_segments.count > 0) {
+        PPDeviceProxyQueueSegment *segment = _segments.firstObject;
+        if(segment.liveRecordIds.count > 0) {
+            break;
+        }
+        [self removeFirstSegment];
+    }
+
+    unsigned long long size = 0;
+    for(PPDeviceProxyQueueSegment *segment in _segments) {
+        size += segment.size;
+    }
+    while(size > self.maximumDiskSize && _segments.count > 1) {
+        size -= ((PPDeviceProxyQueueSegment *)_segments.firstObject).size;
+        [self removeFirstSegment];
+    }
+}
+
+- (void)removeFirstSegment {
+    PPDeviceProxyQueueSegment *segment = _segments.firstObject;
+    if(segment == _segments.lastObject) {
+        [_activeHandle closeFile];
+        self.activeHandle = nil;
+    }
+    [[NSFileManager defaultManager] removeItemAtURL:segment.url error:nil];
+    [_segments removeObjectAtIndex:0];
+
+    PPDeviceProxyQueueSegment *nextSegment = _segments.firstObject;
+    self.firstRecordId = nextSegment ? nextSegment.firstRecordId : _nextRecordId;
+}
+
+#pragma mark - Records
+
+- (PPDeviceProxyQueueRecordId)appendRecord:(NSDictionary *)record type:(PPDeviceProxyReliabilityBufferType)type {
+    return [self appendRecords:@[record] types:@[@(type)]];
+}
+
+- (PPDeviceProxyQueueRecordId)appendRecords:(NSArray *)records types:(NSArray *)types {
+    if(records.count == 0 || records.count != types.count) {
+        return PPDeviceProxyQueueRecordIdNone;
+    }
+
+    [_lock lock];
+    PPDeviceProxyQueueRecordId recordId = PPDeviceProxyQueueRecordIdNone;
+    PPDeviceProxyQueueSegment *segment = [self writableSegment];
+    NSMutableArray *payloads = [[NSMutableArray alloc] initWithCapacity:records.count];
+    for(NSUInteger i = 0; i < records.count; i++) {
+        [payloads addObject:@{kRecordIdKey: @(_nextRecordId + i), kRecordTypeKey: [types objectAtIndex:i], kRecordDataKey: [records objectAtIndex:i]}];
+    }
+    if(segment && [self writePayloads:payloads segment:segment]) {
+        recordId = _nextRecordId;
+        self.nextRecordId = _nextRecordId + records.count;
+        [segment.liveRecordIds addIndexesInRange:NSMakeRange((NSUInteger)recordId, records.count)];
+        [self compact];
+    }
+    [_lock unlock];
+    return recordId;
+}
+
+- (void)acknowledgeRecords:(NSArray *)recordIds {
+    [_lock lock];
+    NSMutableArray *acknowledged = [[NSMutableArray alloc] initWithCapacity:recordIds.count];
+    for(NSNumber *recordId in recordIds) {
+        if(recordId.integerValue >= _firstRecordId) {
+            [self removeLiveRecordId:recordId.unsignedIntegerValue];
+            [acknowledged addObject:recordId];
+        }
+    }
+
+    if(acknowledged.count) {
+        BOOL empty = YES;
+        for(PPDeviceProxyQueueSegment *segment in _segments) {
+            if(segment.liveRecordIds.count) {
+                empty = NO;
+                break;
+            }
+        }
+
+        if(empty) {
+            // Nothing left to replay, every segment can go
+            [self compact];
+        }
+        else {
+            PPDeviceProxyQueueSegment *segment = [self writableSegment];
+            if(segment) {
+                [self writePayloads:@[@{kRecordAcknowledgedKey: acknowledged}] segment:segment];
+            }
+            [self compact];
+        }
+    }
+    [_lock unlock];
+}
+
+- (void)replayRecordsUsingBlock:(void (^)(PPDeviceProxyQueueRecordId, PPDeviceProxyReliabilityBufferType, NSDictionary *))block {
+    [_lock lock];
+    NSMutableArray *urls = [[NSMutableArray alloc] initWithCapacity:_segments.count];
+    NSMutableIndexSet *liveRecordIds = [[NSMutableIndexSet alloc] init];
+    for(PPDeviceProxyQueueSegment *segment in _segments) {
+        [urls addObject:segment.url];
+        [liveRecordIds addIndexes:segment.liveRecordIds];
+    }
+    [_lock unlock];
+
+    for(NSURL *url in urls) {
+        [self readSegment:url usingBlock:^(NSDictionary *payload) {
+            NSNumber *recordId = [payload objectForKey:kRecordIdKey];
+            NSDictionary *record = [payload objectForKey:kRecordDataKey];
+            if(recordId && [record isKindOfClass:[NSDictionary class]] && [liveRecordIds containsIndex:recordId.unsignedIntegerValue]) {
+                block((PPDeviceProxyQueueRecordId)recordId.integerValue, (PPDeviceProxyReliabilityBufferType)((NSNumber *)[payload objectForKey:kRecordTypeKey]).integerValue, record);
+            }
+        }];
+    }
+}
+
+- (void)removeAllRecords {
+    [_lock lock];
+    while(_segments.count > 0) {
+        [self removeFirstSegment];
+    }
+    [_lock unlock];
+}
+
+@end
@@ -11,7 +11,7 @@
 /** Notification that the websocket connected */
 - (void)websocketDidConnect:(SRWebSocket * _Nonnull )session;
 
-/** Notification that the websocket broke.  If you want to recreate it, you have to renew your sessionId and start over from the beginning */
+/** Notification that the websocket broke.  If you want to recreate it, you have to renew your sessionId and start over from the beginning.  With autoReconnect, only sent when the server refuses the session */
 - (void)websocketBroken;
 
 /** Web socket received a message */
@@ -20,6 +20,9 @@
 @optional
 /** Notification that the websocket broke with additional status messaging.  If implemented, will override "websocketBroken" */
 - (void)websocketBroken:(NSInteger)code reason:(NSString *)reason;
+
+/** With autoReconnect, notification that the first data event arrived after a reconnect, with the seconds it took since the reconnect started */
+- (void)websocket:(SRWebSocket * _Nonnull )webSocket didResumeAfter:(NSTimeInterval)latency;
 @end
 
 @interface PPWebSocket : PPBaseModel <SRWebSocketDelegate>
@@ -27,6 +30,11 @@
 @property (nonatomic, strong) SRWebSocket * _Nullable webSocket;
 @property (nonatomic, strong) NSString * _Nullable sessionId;
 
+/**
+ * Headers sent with the opening handshake, e.g. the PPCAuthorization header of a device
+ */
+@property (nonatomic, strong) NSDictionary * _Nullable HTTPHeaders;
+
 /**
  * Initialize the websocket
  * @param URL NSString The URL to connect to
@@ -41,11 +49,53 @@
  */
 - (void)connect;
 
+/**
+ * Reconnect by itself when the connection breaks, instead of telling the delegate it broke. Default is NO.
+ * Reconnects back off with jitter through PPRetryPolicy. After each reconnect the socket declares its session again and,
+ * once the server accepts it, sends every subscription made with subscribe: again, asking to resume after lastEventId.
+ * Camera and viewer endpoints, and the default endpoint without a sessionId, get no answer and send them as soon as the connection opens.
+ * The delegate is only told the websocket broke when the server refuses the session, which then has to be renewed.
+ */
+@property (nonatomic) BOOL autoReconnect;
+
+/**
+ * Smallest delay before reconnecting, in seconds. Default is WEBSOCKET_DEFAULT_RECONNECT_BASE_DELAY.
+ */
+@property (nonatomic) NSTimeInterval reconnectBaseDelay;
+
+/**
+ * Subscriptions made with subscribe: and not unsubscribed, sent again after each reconnect
+ */
+@property (nonatomic, strong, readonly) NSArray * _Nonnull subscriptions;
+
+/**
+ * ID of the last data event received, sent back as "lastEventId" with each subscription after a reconnect.
+ * Servers that can't resume ignore it and send new events only.
+ */
+@property (atomic, strong, readonly) NSString * _Nullable lastEventId;
+
+/**
+ * Number of reconnects started
+ */
+@property (atomic, readonly) NSUInteger reconnects;
+
+/**
+ * Seconds from the start of the last reconnect until the first data event after it, or 0 before the first reconnect
+ */
+@property (atomic, readonly) NSTimeInterval reconnectLatency;
+
 /**
  * Disconnecting will kill the websocket and prevent it from attempting to auto-respawn
  */
 - (void)disconnect;
 
+/**
+ * Send a message as is
+ * @param message NSString Message to send
+ * @return NO if the websocket is not open
+ */
+- (BOOL)send:(NSString * _Nonnull )message;
+
 /**
  * Send a ping to the server
  */
@@ -89,16 +139,82 @@
  * Currently supported subscription types:
  * 1 - narratives
  * 2 - organization narratives
+ *
+ * The subscription is kept in subscriptions. With autoReconnect, it is sent once the session is accepted, or the connection opens when there is no session to declare, and again after each reconnect.
  */
 - (void)subscribe:(NSDictionary * _Nonnull )subscriptionData;
 - (void)subscribe:(NSDictionary * _Nonnull )subscriptionData uuid:(NSString * _Nullable __autoreleasing *)uuid;
 
 /**
  * Unsubscribe
+ * Removes the subscriptions of this type from subscriptions.
  */
 - (void)unsubscribe:(NSInteger)type;
 - (void)unsubscribe:(NSInteger)type uuid:(NSString * _Nullable * _Nullable )uuid;
 
+#pragma mark - Message pipeline
+
+/**
+ * Once a handler is added, received messages are decoded once on a background queue and routed by goal and subscription type.
+ * Each handler gets its messages in batches on its own queue. While a handler is still busy with a batch, new messages wait for the next one,
+ * replacing waiting messages with the same coalescing key, and the oldest are dropped beyond maximumPendingMessages.
+ * Messages no handler claims, and messages that are not JSON, still go to the delegate on the main thread.
+ */
+
+/**
+ * Seconds to gather messages into one batch before calling a handler. Default is WEBSOCKET_DEFAULT_BATCH_INTERVAL; 0 delivers as soon as the handler is free.
+ */
+@property (atomic) NSTimeInterval batchInterval;
+
+/**
+ * Messages waiting for one handler before the oldest are dropped. Default is WEBSOCKET_DEFAULT_MAXIMUM_PENDING_MESSAGES.
+ */
+@property (atomic) NSUInteger maximumPendingMessages;
+
+/**
+ * Number of messages decoded by the pipeline
+ */
+@property (atomic, readonly) NSUInteger decodedMessages;
+
+/**
+ * Number of messages delivered to handlers
+ */
+@property (atomic, readonly) NSUInteger deliveredMessages;
+
+/**
+ * Number of waiting messages replaced by a newer message with the same coalescing key
+ */
+@property (atomic, readonly) NSUInteger coalescedMessages;
+
+/**
+ * Number of waiting messages dropped because a handler fell behind
+ */
+@property (atomic, readonly) NSUInteger droppedMessages;
+
+/**
+ * Reset decoded, delivered, coalesced and dropped messages, reconnects and reconnect latency
+ */
+- (void)resetStatistics;
+
+/**
+ * Add a handler for received messages.
+ *
+ * @param goal PPWebSocketGoal Goal of the messages, e.g. PPWebSocketGoalData
+ * @param type PPWebSocketType Subscription type of the messages, or PPWebSocketTypeAny
+ * @param queue dispatch_queue_t Queue the handler is called on. Default is the main queue.
+ * @param coalescingKeyBlock PPWebSocketCoalescingKeyBlock Key of a message, e.g. the narrative ID. A waiting message is replaced by a newer one with the same key.
+ * @param block Required PPWebSocketMessagesBlock Called with each batch of decoded messages, in the order they arrived
+ * @return Handler to pass to removeHandler:
+ */
+- (id _Nonnull )addHandlerForGoal:(PPWebSocketGoal)goal type:(PPWebSocketType)type queue:(dispatch_queue_t _Nullable )queue coalescingKeyBlock:(PPWebSocketCoalescingKeyBlock _Nullable )coalescingKeyBlock block:(PPWebSocketMessagesBlock _Nonnull )block;
+
+/**
+ * Stop calling a handler. Messages waiting for it are discarded.
+ *
+ * @param handler Required Handler returned by addHandlerForGoal:type:queue:coalescingKeyBlock:block:
+ */
+- (void)removeHandler:(id _Nonnull )handler;
+
 #pragma mark - PPBaseModel overrides
 
 + (NSError * _Nullable )resultCodeToNSError:(NSInteger)resultCode argument:(NSString * _Nullable )argument;
@@ -6,11 +6,59 @@
 //
 
 #import "PPWebSocket.h"
+#import "PPRetryPolicy.h"
+
+/**
+ * Message waiting for a handler, with the key a newer message replaces it by
+ */
+@interface PPWebSocketPendingMessage : NSObject
+@property (nonatomic, strong) id key;
+@property (nonatomic, strong) NSDictionary *message;
+@end
+
+@implementation PPWebSocketPendingMessage
+@end
+
+/**
+ * Handler of routed messages. Its pending messages are only touched on the pipeline queue.
+ */
+@interface PPWebSocketHandler : NSObject
+@property (nonatomic) PPWebSocketGoal goal;
+@property (nonatomic) PPWebSocketType type;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, copy) PPWebSocketCoalescingKeyBlock coalescingKeyBlock;
+@property (nonatomic, copy) PPWebSocketMessagesBlock block;
+@property (nonatomic, strong) NSMutableArray *pending;
+@property (nonatomic, strong) NSMutableDictionary *pendingByKey;
+@property (nonatomic) BOOL scheduled;
+@property (atomic) BOOL removed;
+@end
+
+@implementation PPWebSocketHandler
+@end
 
 @interface PPWebSocket ()
 @property (nonatomic, strong) NSString *connectURL;
 @property (nonatomic, weak, readwrite) NSObject<PPWebSocketDelegate> *delegate;
 @property (nonatomic) PPWebSocketResourceEndpoint resourceEndpoint;
+
+@property (atomic, readwrite) NSUInteger decodedMessages;
+@property (atomic, readwrite) NSUInteger deliveredMessages;
+@property (atomic, readwrite) NSUInteger coalescedMessages;
+@property (atomic, readwrite) NSUInteger droppedMessages;
+
+@property (nonatomic, strong) dispatch_queue_t pipelineQueue;
+@property (atomic, strong) NSArray *handlers;
+
+@property (nonatomic, strong, readwrite) NSArray *subscriptions;
+@property (atomic, strong, readwrite) NSString *lastEventId;
+@property (atomic, readwrite) NSUInteger reconnects;
+@property (atomic, readwrite) NSTimeInterval reconnectLatency;
+@property (nonatomic) NSTimeInterval reconnectDelay;
+@property (nonatomic) NSUInteger connectionGeneration;
+@property (atomic, strong) NSDate *reconnectStartedAt;
+@property (atomic, strong) NSString *authenticationId;
+@property (atomic) BOOL authenticated;
 @end
 
 @implementation PPWebSocket
@@ -21,6 +69,12 @@
         _resourceEndpoint = resourceEndpoint;
 		_sessionId = sessionId;
 		_delegate = delegate;
+        _batchInterval = WEBSOCKET_DEFAULT_BATCH_INTERVAL;
+        _maximumPendingMessages = WEBSOCKET_DEFAULT_MAXIMUM_PENDING_MESSAGES;
+        _pipelineQueue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.websocket.pipeline", DISPATCH_QUEUE_SERIAL);
+        _handlers = @[];
+        _reconnectBaseDelay = WEBSOCKET_DEFAULT_RECONNECT_BASE_DELAY;
+        _subscriptions = @[];
         
         switch (resourceEndpoint) {
             case PPWebSocketResourceEndpointCamera:
@@ -40,11 +94,27 @@
 
 -(void)connect {
 	[self disconnect];
-    
+    [self open];
+}
+
+/**
+ * Open a new connection, keeping the delegate and subscriptions
+ */
+- (void)open {
 #ifdef DEBUG
     NSLog(@"%s URL=%@", __PRETTY_FUNCTION__, _connectURL);
 #endif
-	self.webSocket = [[SRWebSocket alloc] initWithURL:[NSURL URLWithString:_connectURL]];
+    if(_webSocket) {
+        _webSocket.delegate = nil;
+        [_webSocket close];
+    }
+    self.authenticated = NO;
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:_connectURL]];
+    for(NSString *field in _HTTPHeaders) {
+        [request setValue:[_HTTPHeaders objectForKey:field] forHTTPHeaderField:field];
+    }
+	self.webSocket = [[SRWebSocket alloc] initWithURLRequest:request];
     _webSocket.delegate = self;
     [_webSocket open];
 }
@@ -60,6 +130,10 @@
 #ifdef DEBUG
     NSLog(@"%s", __PRETTY_FUNCTION__);
 #endif
+    // Cancel any scheduled reconnect
+    _connectionGeneration++;
+    _reconnectDelay = 0;
+    self.reconnectStartedAt = nil;
 	if(_webSocket) {
 		_delegate = nil;
 		_webSocket.delegate = nil;
@@ -68,6 +142,89 @@
     }
 }
 
+/**
+ * Open a new connection after a jittered delay that grows with each failed attempt
+ */
+- (void)scheduleReconnect {
+    self.authenticated = NO;
+    _reconnectDelay = [[PPRetryPolicy sharedPolicy] delayAfter:_reconnectDelay baseDelay:_reconnectBaseDelay];
+    NSUInteger generation = ++_connectionGeneration;
+#ifdef DEBUG
+    NSLog(@"%s delay=%f", __PRETTY_FUNCTION__, _reconnectDelay);
+#endif
+    
+    __weak PPWebSocket *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_reconnectDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        PPWebSocket *strongSelf = weakSelf;
+        if(!strongSelf || !strongSelf.delegate || strongSelf.connectionGeneration != generation) {
+            return;
+        }
+        dispatch_sync(strongSelf.pipelineQueue, ^{
+            strongSelf.reconnects++;
+        });
+        strongSelf.reconnectStartedAt = [NSDate date];
+        [strongSelf open];
+    });
+}
+
+/**
+ * The server answered the session declaration. Send the subscriptions again, resuming after the last event.
+ */
+- (void)sessionDeclared:(NSInteger)resultCode reason:(NSString *)reason {
+    if(!_autoReconnect || !_delegate) {
+        return;
+    }
+    if(resultCode > 0) {
+        // Reconnecting won't help until the delegate renews the session
+        NSObject<PPWebSocketDelegate> *delegate = _delegate;
+        [self disconnect];
+        if ([delegate respondsToSelector:@selector(websocketBroken:reason:)]) {
+            [delegate websocketBroken:resultCode reason:reason];
+        }
+        else {
+            [delegate websocketBroken];
+        }
+        return;
+    }
+    
+    self.authenticated = YES;
+    _reconnectDelay = 0;
+    [self resendSubscriptions];
+}
+
+/**
+ * Only the default endpoint with a session declares it and waits for the server's answer. Camera and viewer endpoints never get one.
+ */
+- (BOOL)declaresSession {
+    return _resourceEndpoint == PPWebSocketResourceEndpointDefault && _sessionId;
+}
+
+/**
+ * Send every subscription again, resuming after the last event
+ */
+- (void)resendSubscriptions {
+    NSString *lastEventId = self.lastEventId;
+    for(NSDictionary *subscription in _subscriptions) {
+        NSMutableDictionary *resumed = [subscription mutableCopy];
+        if(lastEventId) {
+            [resumed setObject:lastEventId forKey:@"lastEventId"];
+        }
+        NSString *uuid;
+        [self sendSubscription:resumed uuid:&uuid];
+    }
+}
+
+/**
+ * Send a message as is
+ */
+- (BOOL)send:(NSString *)message {
+    if (_webSocket.readyState != SR_OPEN) {
+        return NO;
+    }
+    [_webSocket send:message];
+    return YES;
+}
+
 /**
  * Send a ping to the server
  */
@@ -132,6 +289,7 @@
                 @"key": self.sessionId,
                 @"goal": @(PPWebSocketGoalAuth),
             };
+            self.authenticationId = *uuid;
             break;
         }
     }
@@ -255,6 +413,17 @@
     [self subscribe:subscription uuid:&uuid];
 }
 - (void)subscribe:(NSDictionary *)subscription uuid:(NSString * _Nullable __autoreleasing *)uuid {
+    if(![_subscriptions containsObject:subscription]) {
+        self.subscriptions = [_subscriptions arrayByAddingObject:subscription];
+    }
+    
+    // Sent once the server accepts the session
+    if(_autoReconnect && [self declaresSession] && !self.authenticated) {
+        return;
+    }
+    [self sendSubscription:subscription uuid:uuid];
+}
+- (void)sendSubscription:(NSDictionary *)subscription uuid:(NSString * _Nullable __autoreleasing *)uuid {
     NSDictionary *data;
     switch (_resourceEndpoint) {
         case PPWebSocketResourceEndpointCamera:
@@ -298,6 +467,15 @@
     [self unsubscribe:type uuid:&uuid];
 }
 - (void)unsubscribe:(NSInteger)type uuid:(NSString * _Nullable __autoreleasing *)uuid {
+    NSMutableArray *subscriptions = [[NSMutableArray alloc] initWithCapacity:_subscriptions.count];
+    for(NSDictionary *subscription in _subscriptions) {
+        id subscriptionType = [subscription objectForKey:@"type"] ? [subscription objectForKey:@"type"] : [subscription objectForKey:@"id"];
+        if([subscriptionType integerValue] != type) {
+            [subscriptions addObject:subscription];
+        }
+    }
+    self.subscriptions = subscriptions;
+    
     NSDictionary *data;
     switch (_resourceEndpoint) {
         case PPWebSocketResourceEndpointCamera:
@@ -351,12 +529,23 @@
 	
 	if(self.delegate) {
         switch (_resourceEndpoint) {
+            case PPWebSocketResourceEndpointDefault:
+                if(_autoReconnect && _sessionId) {
+                    [self declareConnected];
+                }
+                break;
             case PPWebSocketResourceEndpointCamera:
             case PPWebSocketResourceEndpointViewer:
                 [self declareConnected];
             default:
                 break;
         }
+        
+        // Without a session answer to wait for, the connection is up as soon as it opens
+        if(_autoReconnect && ![self declaresSession]) {
+            _reconnectDelay = 0;
+            [self resendSubscriptions];
+        }
 		[_delegate websocketDidConnect:webSocket];
 	}
 	else {
@@ -370,6 +559,10 @@
 #endif
 	
 	_webSocket.delegate = nil;
+    if(_autoReconnect && _delegate) {
+        [self scheduleReconnect];
+        return;
+    }
 	if(_delegate) {
         if ([_delegate respondsToSelector:@selector(websocketBroken:reason:)]) {
             [_delegate websocketBroken:error.code reason:error.description];
@@ -386,6 +579,10 @@
 #endif
 	
 	_webSocket.delegate = nil;
+    if(_autoReconnect && _delegate) {
+        [self scheduleReconnect];
+        return;
+    }
 	if(_delegate) {
         if ([_delegate respondsToSelector:@selector(websocketBroken:reason:)]) {
             [_delegate websocketBroken:code reason:reason];
@@ -401,11 +598,218 @@
 #ifdef DEBUG
     NSLog(@"%s message=%@",__PRETTY_FUNCTION__, message);
 #endif
+    if(self.handlers.count > 0 || _autoReconnect) {
+        dispatch_async(_pipelineQueue, ^{
+            [self routeMessage:message webSocket:webSocket];
+        });
+        return;
+    }
 	if(_delegate) {
 		[_delegate websocket:webSocket didReceiveMessage:message];
 	}
 }
 
+#pragma mark - Message pipeline
+
+/**
+ * Counters are only changed on the pipeline queue, so a reset can't interleave with an increment
+ */
+- (void)resetStatistics {
+    dispatch_sync(_pipelineQueue, ^{
+        self.decodedMessages = 0;
+        self.deliveredMessages = 0;
+        self.coalescedMessages = 0;
+        self.droppedMessages = 0;
+        self.reconnects = 0;
+        self.reconnectLatency = 0;
+    });
+}
+
+- (id)addHandlerForGoal:(PPWebSocketGoal)goal type:(PPWebSocketType)type queue:(dispatch_queue_t)queue coalescingKeyBlock:(PPWebSocketCoalescingKeyBlock)coalescingKeyBlock block:(PPWebSocketMessagesBlock)block {
+    PPWebSocketHandler *handler = [[PPWebSocketHandler alloc] init];
+    handler.goal = goal;
+    handler.type = type;
+    handler.queue = queue ? queue : dispatch_get_main_queue();
+    handler.coalescingKeyBlock = coalescingKeyBlock;
+    handler.block = block;
+    handler.pending = [[NSMutableArray alloc] initWithCapacity:0];
+    handler.pendingByKey = [[NSMutableDictionary alloc] initWithCapacity:0];
+    
+    @synchronized(self) {
+        self.handlers = [self.handlers arrayByAddingObject:handler];
+    }
+    return handler;
+}
+
+- (void)removeHandler:(id)handler {
+    ((PPWebSocketHandler *)handler).removed = YES;
+    @synchronized(self) {
+        NSMutableArray *handlers = [self.handlers mutableCopy];
+        [handlers removeObjectIdenticalTo:handler];
+        self.handlers = handlers;
+    }
+}
+
+/**
+ * Decode a received message and hand it to every matching handler. Runs on the pipeline queue.
+ */
+- (void)routeMessage:(id)message webSocket:(SRWebSocket *)webSocket {
+    NSData *data = [message isKindOfClass:[NSString class]] ? [(NSString *)message dataUsingEncoding:NSUTF8StringEncoding] : message;
+    NSDictionary *json = nil;
+    if([data isKindOfClass:[NSData class]] && data.length > 0) {
+        @try {
+            json = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+        } @catch (NSException *exception) {
+            json = nil;
+        }
+    }
+    
+    BOOL claimed = NO;
+    if([json isKindOfClass:[NSDictionary class]]) {
+        self.decodedMessages++;
+        [self followSession:json];
+        PPWebSocketGoal goal = [[json objectForKey:@"goal"] integerValue];
+        PPWebSocketType type = [self typeOfMessage:json];
+        for(PPWebSocketHandler *handler in self.handlers) {
+            if(handler.goal == goal && (handler.type == PPWebSocketTypeAny || handler.type == type)) {
+                [self enqueueMessage:json handler:handler];
+                claimed = YES;
+            }
+        }
+    }
+    
+    if(!claimed) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self.delegate websocket:webSocket didReceiveMessage:message];
+        });
+    }
+}
+
+/**
+ * Keep track of the answer to the session declaration, the last data event and the first data event after a reconnect.
+ * Runs on the pipeline queue.
+ */
+- (void)followSession:(NSDictionary *)json {
+    PPWebSocketGoal goal = [[json objectForKey:@"goal"] integerValue];
+    id messageId = [json objectForKey:@"id"];
+    NSString *eventId = messageId ? [NSString stringWithFormat:@"%@", messageId] : nil;
+    
+    if(goal == PPWebSocketGoalAuth && eventId && [eventId isEqualToString:self.authenticationId]) {
+        NSInteger resultCode = [[json objectForKey:@"resultCode"] integerValue];
+        NSString *reason = [json objectForKey:@"resultCodeMessage"];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self sessionDeclared:resultCode reason:reason];
+        });
+    }
+    else if(goal == PPWebSocketGoalData) {
+        if(eventId) {
+            self.lastEventId = eventId;
+        }
+        
+        NSDate *reconnectStartedAt = self.reconnectStartedAt;
+        if(reconnectStartedAt) {
+            self.reconnectStartedAt = nil;
+            NSTimeInterval latency = -[reconnectStartedAt timeIntervalSinceNow];
+            self.reconnectLatency = latency;
+#ifdef DEBUG
+            NSLog(@"%s resumed after %f seconds", __PRETTY_FUNCTION__, latency);
+#endif
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if([self.delegate respondsToSelector:@selector(websocket:didResumeAfter:)]) {
+                    [self.delegate websocket:self.webSocket didResumeAfter:latency];
+                }
+            });
+        }
+    }
+}
+
+/**
+ * Subscription type of a message, from its own type or from the subscription it belongs to
+ */
+- (PPWebSocketType)typeOfMessage:(NSDictionary *)json {
+    id type = [json objectForKey:@"type"];
+    NSDictionary *subscription = [json objectForKey:@"subscription"];
+    if(!type && [subscription isKindOfClass:[NSDictionary class]]) {
+        type = [subscription objectForKey:@"type"];
+        if(!type) {
+            type = [subscription objectForKey:@"id"];
+        }
+    }
+    if([type isKindOfClass:[NSNumber class]] || [type isKindOfClass:[NSString class]]) {
+        return [type integerValue];
+    }
+    return PPWebSocketTypeAny;
+}
+
+- (void)enqueueMessage:(NSDictionary *)message handler:(PPWebSocketHandler *)handler {
+    id key = nil;
+    if(handler.coalescingKeyBlock) {
+        key = handler.coalescingKeyBlock(message);
+    }
+    
+    PPWebSocketPendingMessage *pending = key ? [handler.pendingByKey objectForKey:key] : nil;
+    if(pending) {
+        pending.message = message;
+        self.coalescedMessages++;
+    }
+    else {
+        // Drop the oldest waiting messages rather than let a slow handler hold on to everything
+        while(handler.pending.count > 0 && handler.pending.count >= MAX(1, self.maximumPendingMessages)) {
+            PPWebSocketPendingMessage *oldest = [handler.pending firstObject];
+            [handler.pending removeObjectAtIndex:0];
+            if(oldest.key) {
+                [handler.pendingByKey removeObjectForKey:oldest.key];
+            }
+            self.droppedMessages++;
+        }
+        
+        pending = [[PPWebSocketPendingMessage alloc] init];
+        pending.key = key;
+        pending.message = message;
+        [handler.pending addObject:pending];
+        if(key) {
+            [handler.pendingByKey setObject:pending forKey:key];
+        }
+    }
+    
+    [self scheduleHandler:handler];
+}
+
+/**
+ * Deliver the waiting messages after the batch interval, unless a batch is already scheduled or being handled.
+ * Runs on the pipeline queue.
+ */
+- (void)scheduleHandler:(PPWebSocketHandler *)handler {
+    if(handler.scheduled || handler.pending.count == 0) {
+        return;
+    }
+    handler.scheduled = YES;
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchInterval * NSEC_PER_SEC)), _pipelineQueue, ^{
+        NSMutableArray *messages = [[NSMutableArray alloc] initWithCapacity:handler.pending.count];
+        for(PPWebSocketPendingMessage *pending in handler.pending) {
+            [messages addObject:pending.message];
+        }
+        [handler.pending removeAllObjects];
+        [handler.pendingByKey removeAllObjects];
+        if(!handler.removed) {
+            self.deliveredMessages += messages.count;
+        }
+        
+        dispatch_async(handler.queue, ^{
+            if(!handler.removed) {
+                handler.block(messages);
+            }
+            
+            // Messages that arrived while the handler was busy make up the next batch
+            dispatch_async(self.pipelineQueue, ^{
+                handler.scheduled = NO;
+                [self scheduleHandler:handler];
+            });
+        });
+    });
+}
+
 #pragma mark - PPBaseModel
 
 + (NSError *)resultCodeToNSError:(NSInteger)resultCode argument:(NSString *)argument {
@@ -188,9 +188,9 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
     if(version) {
         [requestString appendFormat:@"version=%@&", version];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.dynamicuis.getDynamicUI()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -209,7 +209,7 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(screens, error);
@@ -219,7 +219,7 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -261,9 +261,9 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
     if(userId != PPUserIdNone) {
         [requestString appendFormat:@"userId=%li", (long)userId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.dynamicuis.getLocationTotals()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -282,7 +282,7 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
                 [totals setValue:[root objectForKey:@"friendsTotal"] forKey:[NSString stringWithFormat:@"%lu",(long)PPDynamicUILocationTotalsTypeFriends]];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(totals, error);
@@ -292,7 +292,7 @@ __strong static NSMutableDictionary*_sharedScreens = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
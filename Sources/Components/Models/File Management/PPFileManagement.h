@@ -122,6 +122,26 @@
  **/
 + (void)uploadNewFile:(NSString * _Nonnull )proxyId deviceId:(NSString * _Nullable )deviceId fileExtension:(NSString * _Nonnull )fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId data:(NSData * _Nonnull )data uploadUrl:(PPFileUploadUrl)uploadUrl progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPFileManagementFragmentBlock _Nonnull )callback;;
 
+/**
+ * Upload a new file, reading its content from disk as it is sent.
+ * The file is never loaded into memory, so this is preferred for large videos. Content-Length is taken from the file size.
+ * Progress reports the bytes actually sent.
+ *
+ * @param fileURL Required NSURL Local file to upload
+ * See uploadNewFile:deviceId:fileExtension:expectedSize:duration:rotate:fileId:thumbnail:incomplete:type:contentType:authorizationType:token:sessionId:data:uploadUrl:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadNewFile:(NSString * _Nonnull )proxyId deviceId:(NSString * _Nullable )deviceId fileExtension:(NSString * _Nonnull )fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId fileURL:(NSURL * _Nonnull )fileURL progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPFileManagementFragmentBlock _Nonnull )callback;
+
+/**
+ * Upload a new file, reading its content from a stream as it is sent.
+ * Progress reports the bytes actually sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the content
+ * @param length PPFileSize Number of bytes the stream provides. If unknown, the content is sent with chunked transfer encoding.
+ * See uploadNewFile:deviceId:fileExtension:expectedSize:duration:rotate:fileId:thumbnail:incomplete:type:contentType:authorizationType:token:sessionId:data:uploadUrl:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadNewFile:(NSString * _Nonnull )proxyId deviceId:(NSString * _Nullable )deviceId fileExtension:(NSString * _Nonnull )fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId inputStream:(NSInputStream * _Nonnull )inputStream length:(PPFileSize)length progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPFileManagementFragmentBlock _Nonnull )callback;
+
 /**
  * Get Files
  * Return a list of the user's files, and any files that have been shared with this user by other users.
@@ -188,6 +208,26 @@
  **/
 + (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString * _Nonnull )proxyId fileExtension:(NSString * _Nonnull )fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId data:(NSData * _Nonnull )data callback:(PPFileManagementFragmentBlock _Nonnull )callback;
 
+/**
+ * Upload File Fragment or a Thumbnail, reading its content from disk as it is sent.
+ * Content-Length is taken from the file size.
+ *
+ * @param fileURL Required NSURL Local file holding the fragment
+ * @param progressBlock PPFileManagementProgressBlock Fragment upload progress block, reporting the bytes actually sent
+ * See uploadFileFragment:proxyId:fileExtension:thumbnail:incomplete:index:contentType:authorizationType:token:sessionId:data:callback: for the other parameters
+ **/
++ (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString * _Nonnull )proxyId fileExtension:(NSString * _Nonnull )fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId fileURL:(NSURL * _Nonnull )fileURL progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPFileManagementFragmentBlock _Nonnull )callback;
+
+/**
+ * Upload File Fragment or a Thumbnail, reading its content from a stream as it is sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the fragment
+ * @param length PPFileSize Number of bytes the stream provides. If unknown, the content is sent with chunked transfer encoding.
+ * @param progressBlock PPFileManagementProgressBlock Fragment upload progress block, reporting the bytes actually sent
+ * See uploadFileFragment:proxyId:fileExtension:thumbnail:incomplete:index:contentType:authorizationType:token:sessionId:data:callback: for the other parameters
+ **/
++ (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString * _Nonnull )proxyId fileExtension:(NSString * _Nonnull )fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString * _Nonnull )contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString * _Nullable )token sessionId:(NSString * _Nullable )sessionId inputStream:(NSInputStream * _Nonnull )inputStream length:(PPFileSize)length progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPFileManagementFragmentBlock _Nonnull )callback;
+
 /**
  * Download File
  * The Range HTTP Header is optional, and will only return a chunk of the total content. If used, it is recommended to select a range that is a multiple of 10240 bytes.
@@ -369,6 +409,24 @@
  * @param callback PPErrorBlock Error callback block
  **/
 + (void)uploadS3File:(PPFileFileType)type contentType:(NSString *)contentType data:(NSData *)data contentUrl:(NSString *)contentUrl uploadHeaders:(NSDictionary *)uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock)callback;
+
+/**
+ * Upload a file directly to Amazon S3, reading its content from disk as it is sent.
+ * The file is never loaded into memory. Content-Length is taken from the file size.
+ *
+ * @param fileURL Required NSURL Local file to upload
+ * See uploadS3File:contentType:data:contentUrl:uploadHeaders:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadS3File:(PPFileFileType)type contentType:(NSString * _Nonnull )contentType fileURL:(NSURL * _Nonnull )fileURL contentUrl:(NSString * _Nonnull )contentUrl uploadHeaders:(NSDictionary * _Nonnull )uploadHeaders progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPErrorBlock _Nonnull )callback;
+
+/**
+ * Upload a file directly to Amazon S3, reading its content from a stream as it is sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the content
+ * @param length Required PPFileSize Number of bytes the stream provides. Presigned S3 uploads do not accept chunked transfer encoding.
+ * See uploadS3File:contentType:data:contentUrl:uploadHeaders:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadS3File:(PPFileFileType)type contentType:(NSString * _Nonnull )contentType inputStream:(NSInputStream * _Nonnull )inputStream length:(PPFileSize)length contentUrl:(NSString * _Nonnull )contentUrl uploadHeaders:(NSDictionary * _Nonnull )uploadHeaders progressBlock:(PPFileManagementProgressBlock _Nullable )progressBlock callback:(PPErrorBlock _Nonnull )callback;
 + (void)uploadS3File:(PPFile * _Nonnull )file contentUrl:(NSString * _Nonnull )contentUrl uploadHeaders:(NSDictionary * _Nonnull )uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock _Nonnull )callback __attribute__((deprecated));
 
 #pragma mark - Helper methods
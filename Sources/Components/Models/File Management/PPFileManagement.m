@@ -9,6 +9,7 @@
 #import "PPFileManagement.h"
 #import "PPCloudEngine.h"
 #import "PPCurlDebug.h"
+#import "PPRetryPolicy.h"
 
 @implementation PPFileManagement
 
@@ -260,6 +261,34 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
  * @param callback PPFileManagementFragmentBlock File fragment block containing file reference, used and total file space, twitter share status, twitter account (if any), storage policy, and uploadHeaders
  **/
 + (void)uploadNewFile:(NSString *)proxyId deviceId:(NSString *)deviceId fileExtension:(NSString *)fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId data:(NSData *)data uploadUrl:(PPFileUploadUrl)uploadUrl progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
+    [PPFileManagement uploadNewFile:proxyId deviceId:deviceId fileExtension:fileExtension expectedSize:expectedSize duration:duration rotate:rotate fileId:fileId thumbnail:thumbnail incomplete:incomplete type:type contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:data fileURL:nil inputStream:nil length:PPFileSizeNone uploadUrl:uploadUrl progressBlock:progressBlock callback:callback];
+}
+
+/**
+ * Upload a new file, reading its content from disk as it is sent.
+ * The file is never loaded into memory, so this is preferred for large videos. Content-Length is taken from the file size.
+ *
+ * @param fileURL Required NSURL Local file to upload
+ * See uploadNewFile:deviceId:fileExtension:expectedSize:duration:rotate:fileId:thumbnail:incomplete:type:contentType:authorizationType:token:sessionId:data:uploadUrl:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadNewFile:(NSString *)proxyId deviceId:(NSString *)deviceId fileExtension:(NSString *)fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId fileURL:(NSURL *)fileURL progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
+    NSAssert1(fileURL != nil, @"%s missing fileURL", __FUNCTION__);
+    [PPFileManagement uploadNewFile:proxyId deviceId:deviceId fileExtension:fileExtension expectedSize:expectedSize duration:duration rotate:rotate fileId:fileId thumbnail:thumbnail incomplete:incomplete type:type contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:nil fileURL:fileURL inputStream:nil length:PPFileSizeNone uploadUrl:PPFileUploadUrlNone progressBlock:progressBlock callback:callback];
+}
+
+/**
+ * Upload a new file, reading its content from a stream as it is sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the content
+ * @param length PPFileSize Number of bytes the stream provides. If unknown, the content is sent with chunked transfer encoding.
+ * See uploadNewFile:deviceId:fileExtension:expectedSize:duration:rotate:fileId:thumbnail:incomplete:type:contentType:authorizationType:token:sessionId:data:uploadUrl:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadNewFile:(NSString *)proxyId deviceId:(NSString *)deviceId fileExtension:(NSString *)fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId inputStream:(NSInputStream *)inputStream length:(PPFileSize)length progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
+    NSAssert1(inputStream != nil, @"%s missing inputStream", __FUNCTION__);
+    [PPFileManagement uploadNewFile:proxyId deviceId:deviceId fileExtension:fileExtension expectedSize:expectedSize duration:duration rotate:rotate fileId:fileId thumbnail:thumbnail incomplete:incomplete type:type contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:nil fileURL:nil inputStream:inputStream length:length uploadUrl:PPFileUploadUrlNone progressBlock:progressBlock callback:callback];
+}
+
++ (void)uploadNewFile:(NSString *)proxyId deviceId:(NSString *)deviceId fileExtension:(NSString *)fileExtension expectedSize:(PPFileSize)expectedSize duration:(PPFileDuration)duration rotate:(PPFileRotate)rotate fileId:(PPFileId)fileId thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete type:(PPFileFileType)type contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId data:(NSData *)data fileURL:(NSURL *)fileURL inputStream:(NSInputStream *)inputStream length:(PPFileSize)length uploadUrl:(PPFileUploadUrl)uploadUrl progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
     NSAssert1(proxyId != nil, @"%s missing proxyId", __FUNCTION__);
     NSAssert1(fileExtension != nil, @"%s missing fileExtension", __FUNCTION__);
     NSAssert1(contentType != nil, @"%s missing contentType", __FUNCTION__);
@@ -314,19 +343,20 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     }
     [request setValue:nil forHTTPHeaderField:HTTP_HEADER_API_KEY];
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
-    if(uploadUrl != PPFileUploadUrlTrue) {
-        [request setHTTPBody:data];
-        [request setValue:[NSString stringWithFormat:@"%li", (long)data.length] forHTTPHeaderField:HTTP_HEADER_CONTENT_LENGTH];
+    if(uploadUrl == PPFileUploadUrlTrue) {
+        data = nil;
+        fileURL = nil;
+        inputStream = nil;
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.uploadNewFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
-    [cloudEngine operationWithRequest:request progressBlock:^(NSProgress *progress) {
+    [PPFileManagement uploadRequest:request cloudEngine:cloudEngine data:data fileURL:fileURL inputStream:inputStream length:length progressBlock:^(NSProgress *progress) {
         
         dispatch_async(queue, ^{
         
-            PPLogAPI(@"> %s %@", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL), progress);
+            PPLogAPI(@"> %s %@", __PRETTY_FUNCTION__, progress);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if(progressBlock) {
@@ -374,7 +404,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(status, file, totalFilesSpace, usedFilesSpace, twitterShare, twitterAccount, contentUrl, storagePolicy, uploadHeaders, error);
@@ -384,7 +414,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, PPFileTotalFileSpaceNone, PPFileUsedFileSpaceNone, PPFileTwitterShareNone, nil, nil, PPFileStoragePolicyNone, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -440,29 +470,30 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(searchTag) {
         [requestString appendFormat:@"searchTag=%@&", searchTag];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
             
             NSError *error = nil;
-            NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
+            NSMutableArray *files = [[NSMutableArray alloc] initWithCapacity:0];
+            NSDictionary *root = [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) streamingKey:@"files" element:^(id fileDict) {
+                PPFile *file = [PPFile initWithDictionary:fileDict];
+                [files addObject:file];
+            } error:&error];
             
-            NSMutableArray *files;
             PPFileTotalFileSpace totalFilesSpace = PPFileTotalFileSpaceNone;
             PPFileUsedFileSpace usedFilesSpace = PPFileUsedFileSpaceNone;
             NSString *tempKey;
             NSDate *tempKeyExpire;
             
-            if(!error) {
-                files = [[NSMutableArray alloc] initWithCapacity:0];
-                for(NSDictionary *fileDict in [root objectForKey:@"files"]) {
-                    PPFile *file = [PPFile initWithDictionary:fileDict];
-                    [files addObject:file];
-                }
+            if(error) {
+                files = nil;
+            }
+            else {
                 if([root objectForKey:@"totalFilesSpace"]) {
                     totalFilesSpace = (PPFileTotalFileSpace)((NSString *)[root objectForKey:@"totalFilesSpace"]).integerValue;
                 }
@@ -479,7 +510,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                     }
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(files, totalFilesSpace, usedFilesSpace, tempKey, tempKeyExpire, error);
@@ -489,7 +520,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, PPFileTotalFileSpaceNone, PPFileUsedFileSpaceNone, nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -515,9 +546,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.deleteAllFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
@@ -525,7 +556,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -535,7 +566,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -584,9 +615,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(deviceDescription) {
         [requestString appendFormat:@"deviceDescription=%@&", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:deviceDescription]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getLastNFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -616,7 +647,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                     }
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(files, tempKey, tempKeyExpire, error);
@@ -626,7 +657,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -656,6 +687,37 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
  * @param callback PPFileManagementFragmentBlock File fragment block containing file reference, used and total file space, twitter share status, and twitter account (if any)
  **/
 + (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString *)proxyId fileExtension:(NSString *)fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId data:(NSData *)data callback:(PPFileManagementFragmentBlock)callback {
+    NSAssert1(data != nil, @"%s missing data", __FUNCTION__);
+    [PPFileManagement uploadFileFragment:fileId proxyId:proxyId fileExtension:fileExtension thumbnail:thumbnail incomplete:incomplete index:index contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:data fileURL:nil inputStream:nil length:PPFileSizeNone progressBlock:nil callback:callback];
+}
+
+/**
+ * Upload File Fragment or a Thumbnail, reading its content from disk as it is sent.
+ * Content-Length is taken from the file size.
+ *
+ * @param fileURL Required NSURL Local file holding the fragment
+ * @param progressBlock PPFileManagementProgressBlock Fragment upload progress block
+ * See uploadFileFragment:proxyId:fileExtension:thumbnail:incomplete:index:contentType:authorizationType:token:sessionId:data:callback: for the other parameters
+ **/
++ (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString *)proxyId fileExtension:(NSString *)fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId fileURL:(NSURL *)fileURL progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
+    NSAssert1(fileURL != nil, @"%s missing fileURL", __FUNCTION__);
+    [PPFileManagement uploadFileFragment:fileId proxyId:proxyId fileExtension:fileExtension thumbnail:thumbnail incomplete:incomplete index:index contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:nil fileURL:fileURL inputStream:nil length:PPFileSizeNone progressBlock:progressBlock callback:callback];
+}
+
+/**
+ * Upload File Fragment or a Thumbnail, reading its content from a stream as it is sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the fragment
+ * @param length PPFileSize Number of bytes the stream provides. If unknown, the content is sent with chunked transfer encoding.
+ * @param progressBlock PPFileManagementProgressBlock Fragment upload progress block
+ * See uploadFileFragment:proxyId:fileExtension:thumbnail:incomplete:index:contentType:authorizationType:token:sessionId:data:callback: for the other parameters
+ **/
++ (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString *)proxyId fileExtension:(NSString *)fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId inputStream:(NSInputStream *)inputStream length:(PPFileSize)length progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
+    NSAssert1(inputStream != nil, @"%s missing inputStream", __FUNCTION__);
+    [PPFileManagement uploadFileFragment:fileId proxyId:proxyId fileExtension:fileExtension thumbnail:thumbnail incomplete:incomplete index:index contentType:contentType authorizationType:authorizationType token:token sessionId:sessionId data:nil fileURL:nil inputStream:inputStream length:length progressBlock:progressBlock callback:callback];
+}
+
++ (void)uploadFileFragment:(PPFileId)fileId proxyId:(NSString *)proxyId fileExtension:(NSString *)fileExtension thumbnail:(PPFileThumbnail)thumbnail incomplete:(PPFileIncomplete)incomplete index:(PPFileFragmentIndex)index contentType:(NSString *)contentType authorizationType:(PPFileManagementAuthorizationType)authorizationType token:(NSString *)token sessionId:(NSString *)sessionId data:(NSData *)data fileURL:(NSURL *)fileURL inputStream:(NSInputStream *)inputStream length:(PPFileSize)length progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPFileManagementFragmentBlock)callback {
     NSAssert1(fileId != PPFileIdNone, @"%s missing fileId", __FUNCTION__);
     NSAssert1(proxyId != nil, @"%s missing proxyId", __FUNCTION__);
     NSAssert1(fileExtension != nil, @"%s missing fileExtension", __FUNCTION__);
@@ -689,14 +751,21 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     }
     [request setValue:nil forHTTPHeaderField:HTTP_HEADER_API_KEY];
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
-    [request setHTTPBody:data];
-    [request setValue:[NSString stringWithFormat:@"%li", (long)data.length] forHTTPHeaderField:HTTP_HEADER_CONTENT_LENGTH];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.uploadFileFragment()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    void (^progressHandler)(NSProgress *progress) = nil;
+    if(progressBlock) {
+        progressHandler = ^(NSProgress *progress) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                progressBlock(progress);
+            });
+        };
+    }
+    
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
-    [cloudEngine operationWithRequest:request success:^(NSData *responseData) {
+    [PPFileManagement uploadRequest:request cloudEngine:cloudEngine data:data fileURL:fileURL inputStream:inputStream length:length progressBlock:progressHandler success:^(NSData *responseData, NSObject *response) {
         
         dispatch_async(queue, ^{
             
@@ -735,7 +804,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(status, file, totalFilesSpace, usedFilesSpace, twitterShare, twitterAccount, contentUrl, storagePolicy, uploadHeaders, error);
@@ -745,7 +814,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, PPFileTotalFileSpaceNone, PPFileUsedFileSpaceNone, PPFileTwitterShareNone, nil, nil, PPFileStoragePolicyNone, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -808,9 +877,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(range.location != 0 && range.length != 0) {
         [request setValue:[NSString stringWithFormat:@"bytes=%li-%li", (long)range.location, (long)range.length] forHTTPHeaderField:HTTP_HEADER_RANGE];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.downloadFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [cloudEngine operationWithRequestIncludingResponse:request success:^(NSData *responseData, NSObject *response) {
         
@@ -837,7 +906,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                 contentDisposition = [responseHeaders objectForKey:@"Content-Disposition"];
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(responseData, contentType, contentRange, acceptRanges, contentDisposition, statusCode, error);
@@ -847,7 +916,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, nil, nil, -1, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -880,9 +949,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(expiration != PPFileURLExpirationNone) {
         [requestString appendFormat:@"expiration=%@&", (expiration) ? @"true" : @"false"];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getDownloadURL()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -903,7 +972,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(contentUrl, thumbnailUrl, error);
@@ -913,7 +982,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -964,9 +1033,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     NSError *error;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAppEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.updateFileAttribute()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] operationWithRequest:request success:^(NSData *responseData) {
         
@@ -974,7 +1043,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -984,7 +1053,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1007,9 +1076,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.deleteFile()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
@@ -1017,7 +1086,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1027,7 +1096,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1089,9 +1158,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(endDate) {
         [requestString appendFormat:@"endDate=%@&", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:[PPNSDate apiFriendStringFromDate:endDate]]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getAggregatedListOfFiles()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -1144,7 +1213,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(fileSummaries, totalFilesSpace, usedFilesSpace, responseStartDate, responseEndDate, filesCount, error);
@@ -1154,7 +1223,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, PPFileTotalFileSpaceNone, PPFileUsedFileSpaceNone, nil, nil, PPFileCountNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1182,9 +1251,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getListOfFileDevices()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] GET:requestString success:^(NSData *responseData) {
         
@@ -1202,7 +1271,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                     [fileDevices addObject:device];
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(fileDevices, error);
@@ -1212,7 +1281,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1252,9 +1321,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         cloudEngine = [[PPCloudEngine alloc] initSingleton:PPCloudEngineTypeApp];
     }
     NSMutableURLRequest *request = [[cloudEngine getRequestSerializer] requestWithMethod:@"GET" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.getFileInformation()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [cloudEngine operationWithRequest:request success:^(NSData *responseData) {
         
@@ -1280,7 +1349,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
                     }
                 }
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(file, tempKey, tempKeyExpire, error);
@@ -1290,7 +1359,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, nil, nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1323,9 +1392,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.applyTag()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] PUT:requestString success:^(NSData *responseData) {
         
@@ -1333,7 +1402,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1343,7 +1412,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1372,9 +1441,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     if(locationId != PPLocationIdNone) {
         [requestString appendFormat:@"locationId=%li&", (long)locationId];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.deleteTag()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [[PPCloudEngine sharedAppEngine] DELETE:requestString success:^(NSData *responseData) {
         
@@ -1382,7 +1451,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1392,7 +1461,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1430,9 +1499,9 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         cloudEngine = [[PPCloudEngine alloc] initSingleton:PPCloudEngineTypeApp];
     }
     NSMutableURLRequest *request = [[cloudEngine getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:requestString relativeToURL:[[PPCloudEngine sharedAppEngine] getBaseURL]].absoluteString parameters:nil error:&error];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.reportAbuse()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
     [cloudEngine operationWithRequest:request success:^(NSData *responseData) {
         
@@ -1440,7 +1509,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
             
             NSError *error = nil;
             [PPBaseModel processJSONResponse:responseData originatingClass:NSStringFromClass([self class]) error:&error];
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1450,7 +1519,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback([PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"Error domain:%@, code:%ld, userInfo:%@", error.domain, (long)error.code, error.userInfo]]);
@@ -1474,9 +1543,38 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
  * @param callback PPErrorBlock Error callback block
  **/
 + (void)uploadS3File:(PPFileFileType)type contentType:(NSString *)contentType data:(NSData *)data contentUrl:(NSString *)contentUrl uploadHeaders:(NSDictionary *)uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock)callback {
+    NSAssert1(data != nil, @"%s missing data", __FUNCTION__);
+    [PPFileManagement uploadS3File:type contentType:contentType data:data fileURL:nil inputStream:nil length:PPFileSizeNone contentUrl:contentUrl uploadHeaders:uploadHeaders progressBlock:progressBlock callback:callback];
+}
+
+/**
+ * Upload a file directly to Amazon S3, reading its content from disk as it is sent.
+ * The file is never loaded into memory. Content-Length is taken from the file size.
+ *
+ * @param fileURL Required NSURL Local file to upload
+ * See uploadS3File:contentType:data:contentUrl:uploadHeaders:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadS3File:(PPFileFileType)type contentType:(NSString *)contentType fileURL:(NSURL *)fileURL contentUrl:(NSString *)contentUrl uploadHeaders:(NSDictionary *)uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock)callback {
+    NSAssert1(fileURL != nil, @"%s missing fileURL", __FUNCTION__);
+    [PPFileManagement uploadS3File:type contentType:contentType data:nil fileURL:fileURL inputStream:nil length:PPFileSizeNone contentUrl:contentUrl uploadHeaders:uploadHeaders progressBlock:progressBlock callback:callback];
+}
+
+/**
+ * Upload a file directly to Amazon S3, reading its content from a stream as it is sent.
+ *
+ * @param inputStream Required NSInputStream Unopened stream providing the content
+ * @param length Required PPFileSize Number of bytes the stream provides. Presigned S3 uploads do not accept chunked transfer encoding.
+ * See uploadS3File:contentType:data:contentUrl:uploadHeaders:progressBlock:callback: for the other parameters
+ **/
++ (void)uploadS3File:(PPFileFileType)type contentType:(NSString *)contentType inputStream:(NSInputStream *)inputStream length:(PPFileSize)length contentUrl:(NSString *)contentUrl uploadHeaders:(NSDictionary *)uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock)callback {
+    NSAssert1(inputStream != nil, @"%s missing inputStream", __FUNCTION__);
+    NSAssert1(length != PPFileSizeNone, @"%s missing length", __FUNCTION__);
+    [PPFileManagement uploadS3File:type contentType:contentType data:nil fileURL:nil inputStream:inputStream length:length contentUrl:contentUrl uploadHeaders:uploadHeaders progressBlock:progressBlock callback:callback];
+}
+
++ (void)uploadS3File:(PPFileFileType)type contentType:(NSString *)contentType data:(NSData *)data fileURL:(NSURL *)fileURL inputStream:(NSInputStream *)inputStream length:(PPFileSize)length contentUrl:(NSString *)contentUrl uploadHeaders:(NSDictionary *)uploadHeaders progressBlock:(PPFileManagementProgressBlock)progressBlock callback:(PPErrorBlock)callback {
     NSAssert1(type != PPFileFileTypeNone, @"%s missing file type", __FUNCTION__);
     NSAssert1(contentType != nil, @"%s missing conteType", __FUNCTION__);
-    NSAssert1(data != nil, @"%s missing data", __FUNCTION__);
     NSAssert1(contentUrl != nil, @"%s missing contentUrl", __FUNCTION__);
     NSAssert1(uploadHeaders != nil, @"%s missing uploadHeaders", __FUNCTION__);
     NSError *error;
@@ -1487,17 +1585,15 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         [request setValue:[uploadHeaders valueForKey:key] forHTTPHeaderField:key];
     }
     [request setValue:contentType forHTTPHeaderField:HTTP_HEADER_CONTENT_TYPE];
-    [request setHTTPBody:data];
-    [request setValue:[NSString stringWithFormat:@"%li", (long)data.length] forHTTPHeaderField:HTTP_HEADER_CONTENT_LENGTH];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.filemanagement.uploadS3File()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
         
-    [cloudEngine operationWithRequest:request progressBlock:^(NSProgress *progress) {
+    [PPFileManagement uploadRequest:request cloudEngine:cloudEngine data:data fileURL:fileURL inputStream:inputStream length:length progressBlock:^(NSProgress *progress) {
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"> %s %@", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL), progress);
+            PPLogAPI(@"> %s %@", __PRETTY_FUNCTION__, progress);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if(progressBlock) {
@@ -1510,7 +1606,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
 #warning Need to include error handling
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil);
@@ -1521,7 +1617,7 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
         
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(error);
@@ -1548,6 +1644,68 @@ __strong static NSMutableDictionary*_sharedFiles = nil;
     [PPFileManagement uploadS3File:file.type contentType:contentType data:file.data contentUrl:contentUrl uploadHeaders:uploadHeaders progressBlock:progressBlock callback:callback];
 }
 
+#pragma mark - Upload content
+
+/**
+ * Start an upload with its content taken from memory, a file or a stream. Only one of data, fileURL and inputStream is used.
+ * Files and streams are read by the URL session as the bytes are sent, so the content is never held in memory.
+ * Without content or a progress block, the request is sent as a plain data task.
+ *
+ * @param request Required NSMutableURLRequest Request with its headers already set
+ * @param cloudEngine Required PPCloudEngine Engine to run the request on
+ * @param data NSData Content held in memory
+ * @param fileURL NSURL Local file holding the content
+ * @param inputStream NSInputStream Unopened stream providing the content
+ * @param length PPFileSize Content-Length of the file or stream, if known
+ * @param progressBlock Upload progress block
+ * @param success Success block
+ * @param failure Failure block
+ **/
++ (PPHTTPOperation *)uploadRequest:(NSMutableURLRequest *)request cloudEngine:(PPCloudEngine *)cloudEngine data:(NSData *)data fileURL:(NSURL *)fileURL inputStream:(NSInputStream *)inputStream length:(PPFileSize)length progressBlock:(void (^)(NSProgress *progress))progressBlock success:(void (^)(NSData *responseData, NSObject *response))success failure:(void (^)(NSError *error))failure {
+    // Don't push content at a host whose circuit is open
+    if(![[PPRetryPolicy sharedPolicy] allowsRequestToHost:request.URL.host]) {
+        PPLogAPI(@"> %s circuit open for %@", __PRETTY_FUNCTION__, request.URL.host);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            failure([PPBaseModel resultCodeToNSError:10041 originatingClass:NSStringFromClass([self class])]);
+        });
+        return nil;
+    }
+    
+    if(fileURL) {
+        NSNumber *fileSize;
+        if(length == PPFileSizeNone && [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil] && fileSize) {
+            length = fileSize.longLongValue;
+        }
+    }
+    else if(inputStream) {
+        [request setHTTPBodyStream:inputStream];
+    }
+    else if(data) {
+        [request setHTTPBody:data];
+        length = (PPFileSize)data.length;
+    }
+    if(length != PPFileSizeNone) {
+        [request setValue:[NSString stringWithFormat:@"%lli", length] forHTTPHeaderField:HTTP_HEADER_CONTENT_LENGTH];
+    }
+    
+    PPHTTPOperation *operation;
+    if(fileURL) {
+        operation = [cloudEngine operationWithRequest:request fromFile:fileURL progressBlock:progressBlock success:success failure:failure];
+    }
+    else if(!inputStream && !progressBlock) {
+        operation = [cloudEngine operationWithRequestIncludingResponse:request success:success failure:failure];
+    }
+    else {
+        operation = [cloudEngine operationWithRequest:request progressBlock:progressBlock success:success failure:failure];
+    }
+    
+    // Nothing was sent, so this can't be the probe of a half-open circuit
+    if(!operation) {
+        [[PPRetryPolicy sharedPolicy] cancelProbeForHost:request.URL.host];
+    }
+    return operation;
+}
+
 #pragma mark - Helper methods
 
 /**
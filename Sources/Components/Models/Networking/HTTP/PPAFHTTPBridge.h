@@ -16,6 +16,11 @@
 @property (nonatomic, strong) PPAFHTTPSessionManager *ios7Manager;
 //@property (nonatomic, strong) PPAFHTTPRequestOperationManager *ios6Manager;
 
+/**
+ * Engine type requests are recorded under in PPHTTPMetrics
+ */
+@property (nonatomic) PPCloudEngineType engineType;
+
 /**
  * Constructor
  * @param baseURL NSURL Base url
@@ -96,6 +101,18 @@
                                   success:(void (^)(NSData *responseData, NSObject *response))success
                                   failure:(void (^)(NSError *error))failure;
 
+/**
+ * Perform an operation that uploads the content of a file to the server.
+ * The file is read as it is sent, so it is never loaded into memory.
+ * Progress follows the bytes actually sent.
+ * Includes response object.
+ */
+- (PPHTTPOperation *)operationWithRequest:(NSURLRequest *)request
+                                 fromFile:(NSURL *)fileURL
+                            progressBlock:(void (^)(NSProgress *progress))progressBlock
+                                  success:(void (^)(NSData *responseData, NSObject *response))success
+                                  failure:(void (^)(NSError *error))failure;
+
 /**
  * GET
  * @param URLString NSString the full URL
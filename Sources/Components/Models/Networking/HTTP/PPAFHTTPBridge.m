@@ -7,6 +7,9 @@
 
 #import "PPAFHTTPBridge.h"
 #import "PPCurlDebug.h"
+#import "PPHTTPCache.h"
+#import "PPRetryPolicy.h"
+#import "PPHTTPMetrics.h"
 
 //#import "PPAFHTTPRequestOperationManager.h"
 #import "PPAFHTTPSessionManager.h"
@@ -28,6 +31,21 @@
         _ios7Manager.responseSerializer = [AFHTTPResponseSerializer serializer];
         _ios7Manager.securityPolicy.allowInvalidCertificates = YES;
         _ios7Manager.securityPolicy.validatesDomainName = NO;
+        
+        // Every completed request feeds the circuit breaker of its host
+        [_ios7Manager setTaskDidCompleteBlock:^(NSURLSession * _Nonnull session, NSURLSessionTask * _Nonnull task, NSError * _Nullable error) {
+            [[PPRetryPolicy sharedPolicy] recordRequest:task.originalRequest response:task.response error:error];
+        }];
+        
+        // Timing and size of every request, when enabled
+        __weak PPAFHTTPBridge *weakSelf = self;
+        [_ios7Manager setTaskDidFinishCollectingMetricsBlock:^(NSURLSession * _Nonnull session, NSURLSessionTask * _Nonnull task, NSURLSessionTaskMetrics * _Nullable metrics) {
+            PPHTTPMetrics *httpMetrics = [PPHTTPMetrics sharedMetrics];
+            if(httpMetrics.enabled) {
+                PPAFHTTPBridge *strongSelf = weakSelf;
+                [httpMetrics recordTask:task metrics:metrics engineType:strongSelf ? strongSelf.engineType : PPCloudEngineTypeDefault baseURL:strongSelf.ios7Manager.baseURL];
+            }
+        }];
 	}
 	return self;
 }
@@ -143,6 +161,7 @@
 								  failure:(void (^)(NSError *error))failure {
 	if(_ios7Manager) {
 		NSURLSessionTask *task = [_ios7Manager dataTaskWithRequest:request uploadProgress:nil downloadProgress:nil completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
 			if(error && error.code != NSURLErrorCancelled) {
 				failure(error);
 			}
@@ -178,6 +197,7 @@
                                   failure:(void (^)(NSError *error))failure {
     if(_ios7Manager) {
         NSURLSessionDataTask *task = [_ios7Manager dataTaskWithRequest:request uploadProgress:nil downloadProgress:nil completionHandler:^(NSURLResponse *response, id responseObject, NSError *error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
             if(error && error.code != NSURLErrorCancelled) {
                 failure(error);
             }
@@ -219,8 +239,11 @@
         
         if([request.HTTPMethod isEqualToString:@"PUT"] || [request.HTTPMethod isEqualToString:@"POST"]) {
             task = (NSURLSessionTask *)[_ios7Manager uploadTaskWithStreamedRequest:request progress:^(NSProgress * _Nonnull uploadProgress) {
-                progressBlock(uploadProgress);
+                if(progressBlock) {
+                    progressBlock(uploadProgress);
+                }
             } completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+                [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
                 if(error && error.code != NSURLErrorCancelled) {
                     failure(error);
                 }
@@ -231,11 +254,14 @@
         }
         else if([request.HTTPMethod isEqualToString:@"GET"]) {
             task = (NSURLSessionTask *)[_ios7Manager downloadTaskWithRequest:request progress:^(NSProgress * _Nonnull downloadProgress) {
-                progressBlock(downloadProgress);
+                if(progressBlock) {
+                    progressBlock(downloadProgress);
+                }
             } destination:^NSURL * _Nonnull(NSURL * _Nonnull targetPath, NSURLResponse * _Nonnull response) {
                 NSURL *documentsDirectoryURL = [[NSFileManager defaultManager] URLForDirectory:NSDocumentDirectory inDomain:NSUserDomainMask appropriateForURL:nil create:NO error:nil];
                 return [documentsDirectoryURL URLByAppendingPathComponent:[response suggestedFilename]];
             } completionHandler:^(NSURLResponse * _Nonnull response, NSURL * _Nullable filePath, NSError * _Nullable error) {
+                [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
                 if(error && error.code != NSURLErrorCancelled) {
                     failure(error);
                 }
@@ -246,10 +272,15 @@
         }
         else {
             task = (NSURLSessionTask *)[_ios7Manager dataTaskWithRequest:request uploadProgress:^(NSProgress * _Nonnull uploadProgress) {
-                progressBlock(uploadProgress);
+                if(progressBlock) {
+                    progressBlock(uploadProgress);
+                }
             } downloadProgress:^(NSProgress * _Nonnull downloadProgress) {
-                progressBlock(downloadProgress);
+                if(progressBlock) {
+                    progressBlock(downloadProgress);
+                }
             } completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+                [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
                 if(error && error.code != NSURLErrorCancelled) {
                     failure(error);
                 }
@@ -289,6 +320,39 @@
     }
 }
 
+/**
+ * Perform an operation that uploads the content of a file to the server.
+ * Includes response object.
+ */
+- (PPHTTPOperation *)operationWithRequest:(NSURLRequest *)request
+                                 fromFile:(NSURL *)fileURL
+                            progressBlock:(void (^)(NSProgress *progress))progressBlock
+                                  success:(void (^)(NSData *responseData, NSObject *response))success
+                                  failure:(void (^)(NSError *error))failure {
+    if(_ios7Manager) {
+        NSURLSessionUploadTask *task = [_ios7Manager uploadTaskWithRequest:request fromFile:fileURL progress:^(NSProgress * _Nonnull uploadProgress) {
+            if(progressBlock) {
+                progressBlock(uploadProgress);
+            }
+        } completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
+            if(error && error.code != NSURLErrorCancelled) {
+                failure(error);
+            }
+            else {
+                success(responseObject, response);
+            }
+        }];
+        
+        [task resume];
+        
+        return [[PPHTTPOperation alloc] initWithNSURLSessionTask:task];
+    }
+    else {
+        return nil;
+    }
+}
+
 /**
  * GET
  * @param URLString The full URL
@@ -299,9 +363,15 @@
 				 success:(void (^)(NSData *responseData))success
 				 failure:(void (^)(NSError *error))failure {
 	if(_ios7Manager) {
+        if([[PPHTTPCache sharedCache] shouldCacheURLString:URLString]) {
+            return [self conditionalGET:URLString success:success failure:failure];
+        }
+        
         NSURLSessionDataTask *task = [_ios7Manager GET:URLString parameters:nil headers:nil progress:nil success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             success(responseObject);
         } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             if(error.code == NSURLErrorCancelled) {
                 success(nil);
             }
@@ -333,6 +403,98 @@
 }
 
 
+/**
+ * GET with If-None-Match / If-Modified-Since validators from the HTTP cache.
+ * A 304 Not Modified is answered with the cached body. If the body was evicted after the validators were sent,
+ * the request is sent again without them.
+ * @param URLString The full URL
+ * @param success Success block
+ * @param failure Failure block
+ */
+- (PPHTTPOperation *)conditionalGET:(NSString *)URLString
+                            success:(void (^)(NSData *responseData))success
+                            failure:(void (^)(NSError *error))failure {
+    NSError *serializationError = nil;
+    NSString *absoluteURLString = [[NSURL URLWithString:URLString relativeToURL:_ios7Manager.baseURL] absoluteString];
+    NSMutableURLRequest *request = [_ios7Manager.requestSerializer requestWithMethod:@"GET" URLString:absoluteURLString parameters:nil error:&serializationError];
+    if(serializationError) {
+        failure(serializationError);
+        return nil;
+    }
+    
+    PPHTTPCache *cache = [PPHTTPCache sharedCache];
+    [cache prepareConditionalRequest:request];
+    
+    // The operation cancels whichever task is in flight, the first request or the refetch
+    NSObject *taskLock = [[NSObject alloc] init];
+    __block NSURLSessionTask *currentTask = nil;
+    __block BOOL cancelled = NO;
+    PPHTTPOperation *operation = [[PPHTTPOperation alloc] initWithCancellationHandler:^{
+        @synchronized(taskLock) {
+            cancelled = YES;
+            [currentTask cancel];
+        }
+    }];
+    
+    void (^completion)(NSURLRequest *, NSHTTPURLResponse *, id, NSError *) = ^(NSURLRequest *sentRequest, NSHTTPURLResponse *httpResponse, id responseObject, NSError *error) {
+        if(error) {
+            if(error.code == NSURLErrorCancelled) {
+                success(nil);
+            }
+            else {
+                failure(error);
+            }
+            return;
+        }
+        
+        if(httpResponse) {
+            [cache storeData:responseObject response:httpResponse request:sentRequest];
+        }
+        success(responseObject);
+    };
+    
+    NSURLSessionDataTask *task = [_ios7Manager dataTaskWithRequest:request uploadProgress:nil downloadProgress:nil completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+        [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
+        NSHTTPURLResponse *httpResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+        
+        // AFHTTPResponseSerializer rejects 304, check it before the error
+        if(httpResponse.statusCode == 304) {
+            NSData *cachedData = [cache notModifiedDataForRequest:request];
+            if(cachedData) {
+                success(cachedData);
+                return;
+            }
+            
+            // The cached body was evicted after the validators were sent, ask for the full body
+            NSMutableURLRequest *refetchRequest = request.mutableCopy;
+            [refetchRequest setValue:nil forHTTPHeaderField:@"If-None-Match"];
+            [refetchRequest setValue:nil forHTTPHeaderField:@"If-Modified-Since"];
+            NSURLSessionDataTask *refetchTask = [self->_ios7Manager dataTaskWithRequest:refetchRequest uploadProgress:nil downloadProgress:nil completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+                [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:response];
+                completion(refetchRequest, [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil, responseObject, error);
+            }];
+            @synchronized(taskLock) {
+                currentTask = refetchTask;
+                if(cancelled) {
+                    [refetchTask cancel];
+                }
+            }
+            [refetchTask resume];
+            return;
+        }
+        
+        completion(request, httpResponse, responseObject, error);
+    }];
+    
+    @synchronized(taskLock) {
+        currentTask = task;
+    }
+    [task resume];
+    
+    return operation;
+}
+
+
 /**
  * POST
  * @param URLString The full URL
@@ -344,8 +506,10 @@
 				  failure:(void (^)(NSError *error))failure {
 	if(_ios7Manager) {
         NSURLSessionDataTask *task = [_ios7Manager POST:URLString parameters:nil headers:nil progress:nil success:^(NSURLSessionDataTask * _Nonnull task, id  _Nullable responseObject) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             success(responseObject);
         } failure:^(NSURLSessionDataTask * _Nullable task, NSError * _Nonnull error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             if(error.code == NSURLErrorCancelled) {
                 success(nil);
             }
@@ -389,9 +553,11 @@
 				 failure:(void (^)(NSError *error))failure {
 	if(_ios7Manager) {
         NSURLSessionDataTask *task = [_ios7Manager PUT:URLString parameters:nil headers:nil success:^(NSURLSessionDataTask *task, id responseObject) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
 			success(responseObject);
 			
 		} failure:^(NSURLSessionDataTask *task, NSError *error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             if(error.code == NSURLErrorCancelled) {
                 success(nil);
             }
@@ -430,9 +596,11 @@
 					failure:(void (^)(NSError *error))failure {
 	if(_ios7Manager) {
         NSURLSessionDataTask *task = [_ios7Manager DELETE:URLString parameters:nil headers:nil success:^(NSURLSessionDataTask *task, id responseObject) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
 			success(responseObject);
 			
 		} failure:^(NSURLSessionDataTask *task, NSError *error) {
+            [[PPHTTPMetrics sharedMetrics] recordCallbackForResponse:task.response];
             if(error.code == NSURLErrorCancelled) {
                 success(nil);
             }
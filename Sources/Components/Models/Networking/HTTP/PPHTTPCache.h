@@ -0,0 +1,131 @@
+//
+//  PPHTTPCache.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Opt-in conditional request cache for read-mostly GET endpoints.
+ * Validated responses are stored on disk and revalidated with If-None-Match / If-Modified-Since.
+ * A 304 Not Modified is answered from the cache, including the previously parsed JSON.
+ */
+@interface PPHTTPCache : NSObject
+
++ (PPHTTPCache * _Nonnull )sharedCache;
+
+/**
+ * Caching is disabled by default
+ */
+@property (atomic) BOOL enabled;
+
+/**
+ * Maximum disk usage in bytes. Oldest entries are evicted first. Default is 10 MB.
+ */
+@property (atomic) unsigned long long maximumDiskSize;
+
+#pragma mark - Statistics
+
+/**
+ * Number of cacheable requests answered with 304 Not Modified
+ */
+@property (atomic, readonly) NSUInteger hits;
+
+/**
+ * Number of cacheable requests that returned a full body
+ */
+@property (atomic, readonly) NSUInteger misses;
+
+/**
+ * Response body bytes that did not have to be downloaded thanks to a 304
+ */
+@property (atomic, readonly) unsigned long long bytesSaved;
+
+/**
+ * @return double Hits divided by total cacheable requests, 0 if there were none
+ */
+- (double)hitRate;
+
+/**
+ * Reset hits, misses and bytes saved
+ */
+- (void)resetStatistics;
+
+#pragma mark - Routes
+
+/**
+ * Enable caching for a route, relative to the cloud engine base URL and without query, e.g. "deviceTypes".
+ * Catalog endpoints (deviceTypes, devicemodels, stories, countries, appstore/search) are registered by default.
+ *
+ * @param route Required NSString Route
+ */
+- (void)addCacheableRoute:(NSString * _Nonnull )route;
+
+/**
+ * @param URLString NSString Request URL relative to the engine base URL
+ * @return YES if caching is enabled and the route is cacheable
+ */
+- (BOOL)shouldCacheURLString:(NSString * _Nullable )URLString;
+
+#pragma mark - Requests
+
+/**
+ * Add validators from a stored response to the request.
+ *
+ * @param request Required NSMutableURLRequest GET request
+ */
+- (void)prepareConditionalRequest:(NSMutableURLRequest * _Nonnull )request;
+
+/**
+ * Cached body for a request that was answered with 304 Not Modified.
+ * Counts as a hit.
+ *
+ * @param request Required NSURLRequest Original request
+ * @return NSData Cached body, nil if nothing is stored
+ */
+- (NSData * _Nullable )notModifiedDataForRequest:(NSURLRequest * _Nonnull )request;
+
+/**
+ * Store a validated response. Responses without ETag or Last-Modified are not stored.
+ * Counts as a miss.
+ *
+ * @param data NSData Response body
+ * @param response Required NSHTTPURLResponse Response
+ * @param request Required NSURLRequest Original request
+ */
+- (void)storeData:(NSData * _Nullable )data response:(NSHTTPURLResponse * _Nonnull )response request:(NSURLRequest * _Nonnull )request;
+
+/**
+ * Remove every stored response
+ */
+- (void)removeAllCachedResponses;
+
+#pragma mark - Parsed responses
+
+/**
+ * Previously parsed JSON for a body handed out by this cache
+ *
+ * @param data NSData Response body
+ * @return NSDictionary Parsed JSON, nil if the body did not come from the cache or was never parsed
+ */
+- (NSDictionary * _Nullable )parsedObjectForData:(NSData * _Nullable )data;
+
+/**
+ * Remember the parsed JSON for a body handed out by this cache. Other bodies are ignored.
+ *
+ * @param parsedObject NSDictionary Immutable parsed JSON
+ * @param data NSData Response body
+ */
+- (void)setParsedObject:(NSDictionary * _Nullable )parsedObject forData:(NSData * _Nullable )data;
+
+/**
+ * Allow the parsed JSON of a body delivered to several callbacks to be reused, as for cached bodies.
+ * Works whether or not the cache is enabled.
+ *
+ * @param data Required NSData Shared response body
+ */
+- (void)shareParsedObjectForData:(NSData * _Nonnull )data;
+
+@end
@@ -0,0 +1,306 @@
+//
+//  PPHTTPCache.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPHTTPCache.h"
+#import <CommonCrypto/CommonDigest.h>
+
+#define HTTP_CACHE_DEFAULT_MAXIMUM_DISK_SIZE (10 * 1024 * 1024)
+
+static NSString *kCacheEntryETagKey = @"ETag";
+static NSString *kCacheEntryLastModifiedKey = @"Last-Modified";
+
+@interface PPHTTPCache ()
+@property (atomic, readwrite) NSUInteger hits;
+@property (atomic, readwrite) NSUInteger misses;
+@property (atomic, readwrite) unsigned long long bytesSaved;
+
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSMutableSet *routes;
+@property (nonatomic, strong) NSCache *dataCache;
+@property (nonatomic, strong) NSCache *validatorCache;
+@property (nonatomic, strong) NSMapTable *parsedObjects;
+@property (nonatomic, strong) NSHashTable *handedOut;
+@property (nonatomic, strong) NSLock *lock;
+@property (nonatomic, strong) dispatch_queue_t diskQueue;
+@end
+
+@implementation PPHTTPCache
+
++ (PPHTTPCache *)sharedCache {
+    static PPHTTPCache *_sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedCache = [[PPHTTPCache alloc] init];
+    });
+    return _sharedCache;
+}
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        self.enabled = NO;
+        self.maximumDiskSize = HTTP_CACHE_DEFAULT_MAXIMUM_DISK_SIZE;
+
+        NSURL *cachesURL = [[NSFileManager defaultManager] URLForDirectory:NSCachesDirectory inDomain:NSUserDomainMask appropriateForURL:nil create:YES error:nil];
+        self.directoryURL = [cachesURL URLByAppendingPathComponent:@"com.peoplepowerco.lib.Peoplepower.HTTPCache" isDirectory:YES];
+        [[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+        self.routes = [[NSMutableSet alloc] initWithArray:@[@"deviceTypes", @"devicemodels", @"stories", @"countries", @"appstore/search"]];
+        self.dataCache = [[NSCache alloc] init];
+        self.validatorCache = [[NSCache alloc] init];
+        self.parsedObjects = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        self.handedOut = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality];
+        self.lock = [[NSLock alloc] init];
+        self.diskQueue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.httpCache", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+    }
+    return self;
+}
+
+#pragma mark - Statistics
+
+- (double)hitRate {
+    NSUInteger total = self.hits + self.misses;
+    if(total == 0) {
+        return 0;
+    }
+    return (double)self.hits / (double)total;
+}
+
+- (void)resetStatistics {
+    [_lock lock];
+    self.hits = 0;
+    self.misses = 0;
+    self.bytesSaved = 0;
+    [_lock unlock];
+}
+
+#pragma mark - Routes
+
+- (void)addCacheableRoute:(NSString *)route {
+    [_lock lock];
+    [_routes addObject:route];
+    [_lock unlock];
+}
+
+- (BOOL)shouldCacheURLString:(NSString *)URLString {
+    if(!self.enabled || URLString == nil) {
+        return NO;
+    }
+    NSString *route = [[URLString componentsSeparatedByString:@"?"] firstObject];
+    [_lock lock];
+    BOOL cacheable = [_routes containsObject:route];
+    [_lock unlock];
+    return cacheable;
+}
+
+#pragma mark - Requests
+
+- (NSString *)keyForRequest:(NSURLRequest *)request {
+    // Responses are user specific, include the session
+    NSString *identity = [NSString stringWithFormat:@"%@|%@", request.URL.absoluteString, [request valueForHTTPHeaderField:HTTP_HEADER_API_KEY] ?: @""];
+    NSData *identityData = [identity dataUsingEncoding:NSUTF8StringEncoding];
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(identityData.bytes, (CC_LONG)identityData.length, digest);
+
+    NSMutableString *key = [[NSMutableString alloc] initWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for(NSInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [key appendFormat:@"%02x", digest[i]];
+    }
+    return key;
+}
+
+- (NSURL *)dataURLForKey:(NSString *)key {
+    return [_directoryURL URLByAppendingPathComponent:[key stringByAppendingPathExtension:@"data"]];
+}
+
+- (NSURL *)validatorsURLForKey:(NSString *)key {
+    return [_directoryURL URLByAppendingPathComponent:[key stringByAppendingPathExtension:@"plist"]];
+}
+
+- (NSDictionary *)validatorsForKey:(NSString *)key {
+    NSDictionary *validators = [_validatorCache objectForKey:key];
+    if(!validators) {
+        validators = [NSDictionary dictionaryWithContentsOfURL:[self validatorsURLForKey:key]];
+        if(validators) {
+            [_validatorCache setObject:validators forKey:key];
+        }
+    }
+    return validators;
+}
+
+- (void)prepareConditionalRequest:(NSMutableURLRequest *)request {
+    // Validation is handled here, keep the URL loading system from answering on our behalf
+    request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+
+    NSString *key = [self keyForRequest:request];
+    NSDictionary *validators = [self validatorsForKey:key];
+    if(!validators) {
+        return;
+    }
+
+    // Only revalidate if the body is still on disk
+    if([_dataCache objectForKey:key] == nil && ![[NSFileManager defaultManager] fileExistsAtPath:[self dataURLForKey:key].path]) {
+        return;
+    }
+
+    if([validators objectForKey:kCacheEntryETagKey]) {
+        [request setValue:[validators objectForKey:kCacheEntryETagKey] forHTTPHeaderField:@"If-None-Match"];
+    }
+    if([validators objectForKey:kCacheEntryLastModifiedKey]) {
+        [request setValue:[validators objectForKey:kCacheEntryLastModifiedKey] forHTTPHeaderField:@"If-Modified-Since"];
+    }
+}
+
+- (NSData *)notModifiedDataForRequest:(NSURLRequest *)request {
+    NSString *key = [self keyForRequest:request];
+    NSData *data = [_dataCache objectForKey:key];
+    if(!data) {
+        data = [NSData dataWithContentsOfURL:[self dataURLForKey:key] options:NSDataReadingMappedIfSafe error:nil];
+        if(data) {
+            [_dataCache setObject:data forKey:key cost:data.length];
+        }
+    }
+
+    if(data) {
+        [_lock lock];
+        self.hits++;
+        self.bytesSaved += data.length;
+        [_handedOut addObject:data];
+        [_lock unlock];
+
+        // Touch the entry so eviction keeps recently used responses
+        NSURL *dataURL = [self dataURLForKey:key];
+        dispatch_async(_diskQueue, ^{
+            [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:dataURL.path error:nil];
+        });
+    }
+    return data;
+}
+
+- (void)storeData:(NSData *)data response:(NSHTTPURLResponse *)response request:(NSURLRequest *)request {
+    [_lock lock];
+    self.misses++;
+    [_lock unlock];
+
+    if(data == nil || response.statusCode != 200) {
+        return;
+    }
+
+    NSMutableDictionary *validators = [[NSMutableDictionary alloc] initWithCapacity:2];
+    NSDictionary *headers = response.allHeaderFields;
+    for(NSString *field in headers) {
+        if([field caseInsensitiveCompare:kCacheEntryETagKey] == NSOrderedSame) {
+            [validators setObject:[headers objectForKey:field] forKey:kCacheEntryETagKey];
+        }
+        else if([field caseInsensitiveCompare:kCacheEntryLastModifiedKey] == NSOrderedSame) {
+            [validators setObject:[headers objectForKey:field] forKey:kCacheEntryLastModifiedKey];
+        }
+    }
+
+    NSString *key = [self keyForRequest:request];
+    if([validators count] == 0) {
+        [_validatorCache removeObjectForKey:key];
+        [_dataCache removeObjectForKey:key];
+        return;
+    }
+
+    NSData *stored = [data copy];
+    [_validatorCache setObject:validators forKey:key];
+    [_dataCache setObject:stored forKey:key cost:stored.length];
+
+    __weak PPHTTPCache *weakSelf = self;
+    dispatch_async(_diskQueue, ^{
+        [stored writeToURL:[weakSelf dataURLForKey:key] atomically:YES];
+        [validators writeToURL:[weakSelf validatorsURLForKey:key] atomically:YES];
+        [weakSelf trimToMaximumDiskSize];
+    });
+}
+
+- (void)trimToMaximumDiskSize {
+    NSArray *keys = @[NSURLFileSizeKey, NSURLContentModificationDateKey];
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:_directoryURL includingPropertiesForKeys:keys options:NSDirectoryEnumerationSkipsHiddenFiles error:nil];
+
+    unsigned long long totalSize = 0;
+    NSMutableArray *bodies = [[NSMutableArray alloc] initWithCapacity:files.count];
+    for(NSURL *file in files) {
+        NSDictionary *values = [file resourceValuesForKeys:keys error:nil];
+        totalSize += [[values objectForKey:NSURLFileSizeKey] unsignedLongLongValue];
+        if([file.pathExtension isEqualToString:@"data"]) {
+            [bodies addObject:@{@"url": file, @"date": [values objectForKey:NSURLContentModificationDateKey] ?: [NSDate distantPast], @"size": [values objectForKey:NSURLFileSizeKey] ?: @0}];
+        }
+    }
+
+    if(totalSize <= self.maximumDiskSize) {
+        return;
+    }
+
+    [bodies sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        return [[a objectForKey:@"date"] compare:[b objectForKey:@"date"]];
+    }];
+
+    for(NSDictionary *body in bodies) {
+        if(totalSize <= self.maximumDiskSize) {
+            break;
+        }
+        NSURL *dataURL = [body objectForKey:@"url"];
+        NSString *key = [dataURL.lastPathComponent stringByDeletingPathExtension];
+        [[NSFileManager defaultManager] removeItemAtURL:dataURL error:nil];
+        [[NSFileManager defaultManager] removeItemAtURL:[self validatorsURLForKey:key] error:nil];
+        [_dataCache removeObjectForKey:key];
+        [_validatorCache removeObjectForKey:key];
+        totalSize -= [[body objectForKey:@"size"] unsignedLongLongValue];
+    }
+}
+
+- (void)removeAllCachedResponses {
+    [_dataCache removeAllObjects];
+    [_validatorCache removeAllObjects];
+    [_lock lock];
+    [_parsedObjects removeAllObjects];
+    [_handedOut removeAllObjects];
+    [_lock unlock];
+
+    NSURL *directoryURL = _directoryURL;
+    dispatch_sync(_diskQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtURL:directoryURL error:nil];
+        [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+    });
+}
+
+#pragma mark - Parsed responses
+
+- (NSDictionary *)parsedObjectForData:(NSData *)data {
+    if(data == nil) {
+        return nil;
+    }
+    [_lock lock];
+    NSDictionary *parsedObject = [_parsedObjects objectForKey:data];
+    [_lock unlock];
+    return parsedObject;
+}
+
+- (void)setParsedObject:(NSDictionary *)parsedObject forData:(NSData *)data {
+    if(data == nil || parsedObject == nil) {
+        return;
+    }
+
+    // Only bodies we handed out are stable enough to key on
+    [_lock lock];
+    if([_handedOut containsObject:data]) {
+        [_parsedObjects setObject:parsedObject forKey:data];
+    }
+    [_lock unlock];
+}
+
+- (void)shareParsedObjectForData:(NSData *)data {
+    [_lock lock];
+    [_handedOut addObject:data];
+    [_lock unlock];
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  PPHTTPMetrics.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Opt-in per-endpoint instrumentation of cloud requests.
+ * Requests are grouped by cloud engine type and route template, the path below the engine base URL with IDs replaced by {id}, e.g. "devices/{id}/parameters".
+ * Each route keeps log-linear histograms, about 12% precision like an HDR histogram, of DNS, connect, time to first byte and total time,
+ * request and response body bytes and the delay between the end of the request and its callback, and counts responses by status code.
+ * Parse time in processJSONResponse is kept per originating class.
+ * Disabled by default. While disabled, every request only checks the flag.
+ */
+@interface PPHTTPMetrics : NSObject
+
++ (PPHTTPMetrics * _Nonnull )sharedMetrics;
+
+/**
+ * Recording is disabled by default
+ */
+@property (atomic) BOOL enabled;
+
+/**
+ * Everything recorded so far. Times are in milliseconds.
+ * "routes" lists, for each engine type and route, "requests", "statusCodes" and the histograms "dns", "connect", "ttfb", "total", "requestBytes", "responseBytes" and "callbackLag".
+ * "parse" lists, for each originating class, the histograms "time" and "bytes".
+ * Each histogram has "count", "min", "mean", "p50", "p90", "p99", "max" and "buckets", pairs of bucket value and count.
+ *
+ * @return NSDictionary Snapshot that can be serialized as JSON
+ */
+- (NSDictionary * _Nonnull )snapshot;
+
+/**
+ * @return NSData Snapshot as JSON
+ */
+- (NSData * _Nullable )exportJSON;
+
+/**
+ * Forget everything recorded
+ */
+- (void)reset;
+
+/**
+ * @param path NSString URL path below the engine base URL, e.g. "devices/ABC123/parameters"
+ * @return NSString Route template, e.g. "devices/{id}/parameters"
+ */
++ (NSString * _Nonnull )routeTemplateForPath:(NSString * _Nullable )path;
+
+#pragma mark - Recording
+
+/**
+ * Record the timing and size of a completed request. Cancelled requests are ignored.
+ *
+ * @param task Required NSURLSessionTask Completed task
+ * @param metrics NSURLSessionTaskMetrics Metrics collected by the session
+ * @param engineType PPCloudEngineType Engine the request was sent by
+ * @param baseURL NSURL Engine base URL, stripped from the route
+ */
+- (void)recordTask:(NSURLSessionTask * _Nonnull )task metrics:(NSURLSessionTaskMetrics * _Nullable )metrics engineType:(PPCloudEngineType)engineType baseURL:(NSURL * _Nullable )baseURL;
+
+/**
+ * Record the callback of a request recorded with recordTask:metrics:engineType:baseURL:.
+ *
+ * @param response NSURLResponse Response handed to the callback
+ */
+- (void)recordCallbackForResponse:(NSURLResponse * _Nullable )response;
+
+/**
+ * Record the time spent parsing a response.
+ *
+ * @param duration NSTimeInterval Parse time in seconds
+ * @param bytes NSUInteger Size of the response body
+ * @param originatingClass NSString Class that requested the parse
+ */
+- (void)recordParseTime:(NSTimeInterval)duration bytes:(NSUInteger)bytes originatingClass:(NSString * _Nullable )originatingClass;
+
+@end
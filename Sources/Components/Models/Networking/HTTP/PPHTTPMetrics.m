@@ -0,0 +1,373 @@
+//
+//  PPHTTPMetrics.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPHTTPMetrics.h"
+
+/**
+ * Log-linear buckets: values below 8 have their own bucket, larger values share 8 buckets per power of two.
+ * Values above 2^40 land in the last bucket.
+ */
+#define HISTOGRAM_SUB_BUCKET_BITS 3
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_MAXIMUM_SHIFT 37
+#define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS * (HISTOGRAM_MAXIMUM_SHIFT + 2))
+
+static NSUInteger PPHistogramIndex(uint64_t value) {
+    if(value < HISTOGRAM_SUB_BUCKETS) {
+        return (NSUInteger)value;
+    }
+    NSUInteger shift = (63 - __builtin_clzll(value)) - HISTOGRAM_SUB_BUCKET_BITS;
+    if(shift > HISTOGRAM_MAXIMUM_SHIFT) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    NSUInteger subBucket = (NSUInteger)((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+    return HISTOGRAM_SUB_BUCKETS + shift * HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+/**
+ * Middle of the values counted in a bucket
+ */
+static double PPHistogramValue(NSUInteger index) {
+    if(index < HISTOGRAM_SUB_BUCKETS) {
+        return index;
+    }
+    NSUInteger shift = (index - HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS;
+    NSUInteger subBucket = (index - HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS;
+    uint64_t lowest = (uint64_t)(HISTOGRAM_SUB_BUCKETS + subBucket) << shift;
+    return lowest + ((1ULL << shift) - 1) / 2.0;
+}
+
+/**
+ * Counts of recorded values. Only touched while holding the metrics lock.
+ */
+@interface PPHTTPMetricsHistogram : NSObject {
+    uint32_t _counts[HISTOGRAM_BUCKETS];
+}
+@property (nonatomic) uint64_t count;
+@property (nonatomic) uint64_t minimum;
+@property (nonatomic) uint64_t maximum;
+@property (nonatomic) double sum;
+@end
+
+@implementation PPHTTPMetricsHistogram
+
+- (void)recordValue:(uint64_t)value {
+    _counts[PPHistogramIndex(value)]++;
+    _minimum = (_count == 0) ? value : MIN(_minimum, value);
+    _maximum = MAX(_maximum, value);
+    _count++;
+    _sum += value;
+}
+
+- (double)valueAtPercentile:(double)percentile {
+    uint64_t target = MAX(1, (uint64_t)ceil(_count * percentile / 100.0));
+    uint64_t seen = 0;
+    for(NSUInteger i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += _counts[i];
+        if(seen >= target) {
+            return MIN(MAX(PPHistogramValue(i), _minimum), _maximum);
+        }
+    }
+    return _maximum;
+}
+
+/**
+ * @param scale double Multiplier from recorded values to reported values
+ */
+- (NSDictionary *)summaryWithScale:(double)scale {
+    if(_count == 0) {
+        return @{@"count": @0};
+    }
+    NSMutableArray *buckets = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSUInteger i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if(_counts[i] > 0) {
+            [buckets addObject:@[@(PPHistogramValue(i) * scale), @(_counts[i])]];
+        }
+    }
+    return @{
+        @"count": @(_count),
+        @"min": @(_minimum * scale),
+        @"mean": @(_sum / _count * scale),
+        @"p50": @([self valueAtPercentile:50] * scale),
+        @"p90": @([self valueAtPercentile:90] * scale),
+        @"p99": @([self valueAtPercentile:99] * scale),
+        @"max": @(_maximum * scale),
+        @"buckets": buckets
+    };
+}
+
+@end
+
+/**
+ * Histograms of one route of one engine
+ */
+@interface PPHTTPMetricsRoute : NSObject
+@property (nonatomic) PPCloudEngineType engineType;
+@property (nonatomic, strong) NSString *method;
+@property (nonatomic, strong) NSString *route;
+@property (nonatomic) NSUInteger requests;
+@property (nonatomic, strong) NSMutableDictionary *statusCodes;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *dns;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *connect;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *ttfb;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *total;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *requestBytes;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *responseBytes;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *callbackLag;
+@end
+
+@implementation PPHTTPMetricsRoute
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        self.statusCodes = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.dns = [[PPHTTPMetricsHistogram alloc] init];
+        self.connect = [[PPHTTPMetricsHistogram alloc] init];
+        self.ttfb = [[PPHTTPMetricsHistogram alloc] init];
+        self.total = [[PPHTTPMetricsHistogram alloc] init];
+        self.requestBytes = [[PPHTTPMetricsHistogram alloc] init];
+        self.responseBytes = [[PPHTTPMetricsHistogram alloc] init];
+        self.callbackLag = [[PPHTTPMetricsHistogram alloc] init];
+    }
+    return self;
+}
+
+@end
+
+/**
+ * Histograms of the responses parsed for one class
+ */
+@interface PPHTTPMetricsParser : NSObject
+@property (nonatomic, strong) PPHTTPMetricsHistogram *time;
+@property (nonatomic, strong) PPHTTPMetricsHistogram *bytes;
+@end
+
+@implementation PPHTTPMetricsParser
+@end
+
+@interface PPHTTPMetrics ()
+@property (nonatomic, strong) NSMutableDictionary *routes;
+@property (nonatomic, strong) NSMutableDictionary *parsers;
+
+/**
+ * Route and completion time of requests whose callback has not run yet, by response
+ */
+@property (nonatomic, strong) NSMapTable *pendingCallbacks;
+@property (nonatomic, strong) NSLock *lock;
+@end
+
+@implementation PPHTTPMetrics
+
++ (PPHTTPMetrics *)sharedMetrics {
+    static PPHTTPMetrics *_sharedMetrics = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedMetrics = [[PPHTTPMetrics alloc] init];
+    });
+    return _sharedMetrics;
+}
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        self.routes = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.parsers = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.pendingCallbacks = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        self.lock = [[NSLock alloc] init];
+    }
+    return self;
+}
+
+- (void)reset {
+    [_lock lock];
+    [_routes removeAllObjects];
+    [_parsers removeAllObjects];
+    [_pendingCallbacks removeAllObjects];
+    [_lock unlock];
+}
+
++ (NSString *)routeTemplateForPath:(NSString *)path {
+    NSCharacterSet *identifierCharacters = [NSCharacterSet characterSetWithCharactersInString:@"0123456789@:."];
+    NSMutableArray *components = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSString *component in [path componentsSeparatedByString:@"/"]) {
+        if(component.length == 0) {
+            continue;
+        }
+        if([component rangeOfCharacterFromSet:identifierCharacters].location != NSNotFound || component.length > 32) {
+            [components addObject:@"{id}"];
+        }
+        else {
+            [components addObject:component];
+        }
+    }
+    return [components componentsJoinedByString:@"/"];
+}
+
+#pragma mark - Snapshot
+
+- (NSDictionary *)snapshot {
+    NSMutableArray *routes = [[NSMutableArray alloc] initWithCapacity:0];
+    NSMutableArray *parsers = [[NSMutableArray alloc] initWithCapacity:0];
+    
+    [_lock lock];
+    NSArray *routeKeys = [[_routes allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    for(NSString *key in routeKeys) {
+        PPHTTPMetricsRoute *route = [_routes objectForKey:key];
+        [routes addObject:@{
+            @"engineType": @(route.engineType),
+            @"method": route.method,
+            @"route": route.route,
+            @"requests": @(route.requests),
+            @"statusCodes": [route.statusCodes copy],
+            @"dns": [route.dns summaryWithScale:0.001],
+            @"connect": [route.connect summaryWithScale:0.001],
+            @"ttfb": [route.ttfb summaryWithScale:0.001],
+            @"total": [route.total summaryWithScale:0.001],
+            @"requestBytes": [route.requestBytes summaryWithScale:1],
+            @"responseBytes": [route.responseBytes summaryWithScale:1],
+            @"callbackLag": [route.callbackLag summaryWithScale:0.001]
+        }];
+    }
+    NSArray *parserKeys = [[_parsers allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    for(NSString *key in parserKeys) {
+        PPHTTPMetricsParser *parser = [_parsers objectForKey:key];
+        [parsers addObject:@{
+            @"class": key,
+            @"time": [parser.time summaryWithScale:0.001],
+            @"bytes": [parser.bytes summaryWithScale:1]
+        }];
+    }
+    [_lock unlock];
+    
+    return @{
+        @"enabled": @(self.enabled),
+        @"routes": routes,
+        @"parse": parsers
+    };
+}
+
+- (NSData *)exportJSON {
+    return [NSJSONSerialization dataWithJSONObject:[self snapshot] options:NSJSONWritingPrettyPrinted error:nil];
+}
+
+#pragma mark - Recording
+
+/**
+ * Must be called while holding the lock
+ */
+- (PPHTTPMetricsRoute *)routeForEngineType:(PPCloudEngineType)engineType method:(NSString *)method route:(NSString *)route {
+    NSString *key = [NSString stringWithFormat:@"%ld %@ %@", (long)engineType, method, route];
+    PPHTTPMetricsRoute *entry = [_routes objectForKey:key];
+    if(!entry) {
+        // Unexpected path shapes must not grow the table forever
+        if(_routes.count >= HTTP_METRICS_MAXIMUM_ROUTES && ![route isEqualToString:@"{other}"]) {
+            return [self routeForEngineType:engineType method:@"*" route:@"{other}"];
+        }
+        entry = [[PPHTTPMetricsRoute alloc] init];
+        entry.engineType = engineType;
+        entry.method = method;
+        entry.route = route;
+        [_routes setObject:entry forKey:key];
+    }
+    return entry;
+}
+
+static uint64_t PPMicroseconds(NSDate *start, NSDate *end) {
+    return (uint64_t)MAX(0, [end timeIntervalSinceDate:start] * 1000000.0);
+}
+
+- (void)recordTask:(NSURLSessionTask *)task metrics:(NSURLSessionTaskMetrics *)metrics engineType:(PPCloudEngineType)engineType baseURL:(NSURL *)baseURL {
+    if(!self.enabled) {
+        return;
+    }
+    NSError *error = task.error;
+    if([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled) {
+        return;
+    }
+    
+    NSURLRequest *request = task.originalRequest;
+    NSString *path = request.URL.path;
+    NSString *basePath = baseURL.path;
+    if(basePath.length > 0 && [path hasPrefix:basePath]) {
+        path = [path substringFromIndex:basePath.length];
+    }
+    NSString *routeTemplate = [PPHTTPMetrics routeTemplateForPath:path];
+    
+    NSString *statusCode;
+    if([task.response isKindOfClass:[NSHTTPURLResponse class]]) {
+        statusCode = [NSString stringWithFormat:@"%ld", (long)((NSHTTPURLResponse *)task.response).statusCode];
+    }
+    else {
+        statusCode = [NSString stringWithFormat:@"%ld", (long)error.code];
+    }
+    
+    NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+    
+    [_lock lock];
+    PPHTTPMetricsRoute *route = [self routeForEngineType:engineType method:request.HTTPMethod ?: @"GET" route:routeTemplate];
+    route.requests++;
+    [route.statusCodes setObject:@([[route.statusCodes objectForKey:statusCode] integerValue] + 1) forKey:statusCode];
+    
+    // Reused connections skip DNS and connect
+    if(transaction.domainLookupStartDate && transaction.domainLookupEndDate) {
+        [route.dns recordValue:PPMicroseconds(transaction.domainLookupStartDate, transaction.domainLookupEndDate)];
+    }
+    if(transaction.connectStartDate && transaction.connectEndDate) {
+        [route.connect recordValue:PPMicroseconds(transaction.connectStartDate, transaction.connectEndDate)];
+    }
+    if(transaction.requestStartDate && transaction.responseStartDate) {
+        [route.ttfb recordValue:PPMicroseconds(transaction.requestStartDate, transaction.responseStartDate)];
+    }
+    if(metrics.taskInterval) {
+        [route.total recordValue:(uint64_t)(metrics.taskInterval.duration * 1000000.0)];
+    }
+    [route.requestBytes recordValue:(uint64_t)MAX(0, task.countOfBytesSent)];
+    [route.responseBytes recordValue:(uint64_t)MAX(0, task.countOfBytesReceived)];
+    
+    if(task.response) {
+        [_pendingCallbacks setObject:@[route, @(CFAbsoluteTimeGetCurrent())] forKey:task.response];
+    }
+    [_lock unlock];
+}
+
+- (void)recordCallbackForResponse:(NSURLResponse *)response {
+    if(!self.enabled || !response) {
+        return;
+    }
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    
+    [_lock lock];
+    NSArray *pending = [_pendingCallbacks objectForKey:response];
+    if(pending) {
+        [_pendingCallbacks removeObjectForKey:response];
+        PPHTTPMetricsRoute *route = [pending firstObject];
+        [route.callbackLag recordValue:(uint64_t)MAX(0, (now - [[pending lastObject] doubleValue]) * 1000000.0)];
+    }
+    [_lock unlock];
+}
+
+- (void)recordParseTime:(NSTimeInterval)duration bytes:(NSUInteger)bytes originatingClass:(NSString *)originatingClass {
+    if(!self.enabled) {
+        return;
+    }
+    NSString *key = originatingClass ?: @"PPBaseModel";
+    
+    [_lock lock];
+    PPHTTPMetricsParser *parser = [_parsers objectForKey:key];
+    if(!parser) {
+        parser = [[PPHTTPMetricsParser alloc] init];
+        parser.time = [[PPHTTPMetricsHistogram alloc] init];
+        parser.bytes = [[PPHTTPMetricsHistogram alloc] init];
+        [_parsers setObject:parser forKey:key];
+    }
+    [parser.time recordValue:(uint64_t)MAX(0, duration * 1000000.0)];
+    [parser.bytes recordValue:bytes];
+    [_lock unlock];
+}
+
+@end
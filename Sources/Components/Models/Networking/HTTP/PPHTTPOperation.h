@@ -15,6 +15,12 @@
  */
 - (id) initWithNSURLSessionTask:(NSURLSessionTask *)task;
 
+/**
+ * Constructor for operations that do not own a task, such as a caller attached to a shared request
+ * @param cancellationHandler Block called on cancel
+ */
+- (id) initWithCancellationHandler:(void (^)(void))cancellationHandler;
+
 ///**
 // * iOS 6.x Constructor
 // * @param operation AFHTTPRequestOperation
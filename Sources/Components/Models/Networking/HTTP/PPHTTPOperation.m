@@ -9,6 +9,7 @@
 
 @interface PPHTTPOperation ()
 @property (nonatomic, strong) NSURLSessionTask *task;
+@property (nonatomic, copy) void (^cancellationHandler)(void);
 //@property (nonatomic, strong) AFHTTPRequestOperation *operation;
 @end
 
@@ -23,6 +24,14 @@
 	return self;
 }
 
+- (id) initWithCancellationHandler:(void (^)(void))cancellationHandler {
+    self = [super init];
+    if(self) {
+        self.cancellationHandler = cancellationHandler;
+    }
+    return self;
+}
+
 //- (id) initWithAFHTTPRequestOperation:(AFHTTPRequestOperation *)operation {
 //    self = [super init];
 //    if(self) {
@@ -36,6 +45,9 @@
 	if(_task) {
 		[_task cancel];
 	}
+    else if(_cancellationHandler) {
+        _cancellationHandler();
+    }
 	else {
 //        [_operation cancel];
 	}
@@ -0,0 +1,173 @@
+//
+//  PPRetryPolicy.h
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Shared retry decisions for requests to the same host.
+ * Delays use decorrelated jitter, so clients that failed together do not retry together.
+ * Each host has a circuit breaker: after failureThreshold consecutive failures the circuit opens and retries are refused for openInterval,
+ * then a single probe request is allowed through to decide whether it closes again.
+ * Each host also has a retry budget. Every retry spends one token and every success earns back budgetRatio tokens,
+ * so retries stay a fraction of the successful traffic when the server is degraded.
+ */
+@interface PPRetryPolicy : NSObject
+
++ (PPRetryPolicy * _Nonnull )sharedPolicy;
+
+/**
+ * Smallest retry delay in seconds, used when the caller does not provide its own. Default is 1 second.
+ */
+@property (atomic) NSTimeInterval baseDelay;
+
+/**
+ * Largest retry delay in seconds. Default is 300 seconds.
+ */
+@property (atomic) NSTimeInterval maximumDelay;
+
+/**
+ * Consecutive failures that open the circuit of a host. Default is 5.
+ */
+@property (atomic) NSInteger failureThreshold;
+
+/**
+ * Time an open circuit refuses requests before allowing a probe. Default is 30 seconds.
+ */
+@property (atomic) NSTimeInterval openInterval;
+
+/**
+ * Time a half-open circuit waits for its probe before letting another request through. Default is 60 seconds.
+ */
+@property (atomic) NSTimeInterval probeInterval;
+
+/**
+ * Retry tokens earned by each successful request. Default is 0.1, about one retry for every ten successes.
+ */
+@property (atomic) double budgetRatio;
+
+/**
+ * Retry tokens a host starts with and can save up. Default is 10.
+ */
+@property (atomic) double maximumBudget;
+
+/**
+ * Called with each retry, refused retry and circuit change, on the thread that caused it
+ */
+@property (atomic, copy) PPRetryPolicyEventBlock _Nullable eventBlock;
+
+#pragma mark - Statistics
+
+/**
+ * Number of retries scheduled
+ */
+@property (atomic, readonly) NSUInteger retries;
+
+/**
+ * Number of retries refused because the circuit was open or the budget was spent
+ */
+@property (atomic, readonly) NSUInteger deniedRetries;
+
+/**
+ * Number of times a circuit opened
+ */
+@property (atomic, readonly) NSUInteger openedCircuits;
+
+/**
+ * Number of requests refused by an open circuit
+ */
+@property (atomic, readonly) NSUInteger rejectedRequests;
+
+/**
+ * Reset retries, denied retries, opened circuits and rejected requests
+ */
+- (void)resetStatistics;
+
+/**
+ * Forget the circuit, budget and backoff of every host
+ */
+- (void)reset;
+
+#pragma mark - Circuit Breaker
+
+/**
+ * @param host NSString Host name
+ * @return PPRetryPolicyCircuitState Current circuit state of the host
+ */
+- (PPRetryPolicyCircuitState)circuitStateForHost:(NSString * _Nullable )host;
+
+/**
+ * Ask before sending a request that may be refused.
+ * When the open interval has passed, the first caller is allowed through as the probe and the others are refused until it completes,
+ * is cancelled or takes longer than probeInterval.
+ *
+ * @param host NSString Host name
+ * @return YES if the request should be sent
+ */
+- (BOOL)allowsRequestToHost:(NSString * _Nullable )host;
+
+/**
+ * Release the probe allowed by allowsRequestToHost: when it is cancelled or never sent, so the next request can probe.
+ *
+ * @param host NSString Host name
+ */
+- (void)cancelProbeForHost:(NSString * _Nullable )host;
+
+/**
+ * Record a response from the host. Closes the circuit, resets the backoff and earns retry budget.
+ *
+ * @param host NSString Host name
+ */
+- (void)recordSuccessForHost:(NSString * _Nullable )host;
+
+/**
+ * Record a failed request to the host. May open the circuit.
+ *
+ * @param host NSString Host name
+ */
+- (void)recordFailureForHost:(NSString * _Nullable )host;
+
+/**
+ * Record the outcome of a completed request.
+ * Transport errors, 5xx and 429 responses are failures, cancelled requests only release the probe and everything else is a success.
+ *
+ * @param request Required NSURLRequest Request that completed
+ * @param response NSURLResponse Response, if any
+ * @param error NSError Transport error, if any
+ */
+- (void)recordRequest:(NSURLRequest * _Nonnull )request response:(NSURLResponse * _Nullable )response error:(NSError * _Nullable )error;
+
+#pragma mark - Backoff
+
+/**
+ * Delay before retrying a failed request, spending one retry token.
+ *
+ * @param host NSString Host name
+ * @param baseDelay NSTimeInterval Smallest delay for this kind of request, 0 for the policy baseDelay
+ * @return NSTimeInterval Delay in seconds, or RETRY_POLICY_NO_RETRY if the circuit is open or the budget is spent
+ */
+- (NSTimeInterval)retryDelayForHost:(NSString * _Nullable )host baseDelay:(NSTimeInterval)baseDelay;
+
+/**
+ * Delay before reconnecting a connection that must stay up, such as a long poll.
+ * Never refused and does not spend budget, but waits out an open circuit.
+ *
+ * @param host NSString Host name
+ * @param baseDelay NSTimeInterval Smallest delay for this kind of request, 0 for the policy baseDelay
+ * @return NSTimeInterval Delay in seconds
+ */
+- (NSTimeInterval)reconnectDelayForHost:(NSString * _Nullable )host baseDelay:(NSTimeInterval)baseDelay;
+
+/**
+ * Decorrelated jitter for callers that keep their own backoff, without touching any host.
+ *
+ * @param previousDelay NSTimeInterval Previous delay, 0 for the first retry
+ * @param baseDelay NSTimeInterval Smallest delay, 0 for the policy baseDelay
+ * @return NSTimeInterval Random delay between the base and three times the previous delay, at most maximumDelay
+ */
+- (NSTimeInterval)delayAfter:(NSTimeInterval)previousDelay baseDelay:(NSTimeInterval)baseDelay;
+
+@end
@@ -0,0 +1,292 @@
+//
+//  PPRetryPolicy.m
+//  Peoplepower
+//
+//  Copyright (c) 2023 People Power Company. All rights reserved.
+//
+
+#import "PPRetryPolicy.h"
+
+/**
+ * Circuit, backoff and budget of one host. Only touched while holding the policy lock.
+ */
+@interface PPRetryPolicyHost : NSObject
+@property (nonatomic) PPRetryPolicyCircuitState state;
+@property (nonatomic) NSInteger consecutiveFailures;
+@property (nonatomic, strong) NSDate *openUntil;
+@property (nonatomic) BOOL probing;
+@property (nonatomic, strong) NSDate *probeUntil;
+@property (nonatomic) NSTimeInterval lastDelay;
+@property (nonatomic) double budget;
+@end
+
+@implementation PPRetryPolicyHost
+@end
+
+@interface PPRetryPolicy ()
+@property (atomic, readwrite) NSUInteger retries;
+@property (atomic, readwrite) NSUInteger deniedRetries;
+@property (atomic, readwrite) NSUInteger openedCircuits;
+@property (atomic, readwrite) NSUInteger rejectedRequests;
+
+@property (nonatomic, strong) NSMutableDictionary *hosts;
+@property (nonatomic, strong) NSLock *lock;
+@end
+
+@implementation PPRetryPolicy
+
++ (PPRetryPolicy *)sharedPolicy {
+    static PPRetryPolicy *_sharedPolicy = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedPolicy = [[PPRetryPolicy alloc] init];
+    });
+    return _sharedPolicy;
+}
+
+- (id)init {
+    self = [super init];
+    if(self) {
+        self.baseDelay = RETRY_POLICY_DEFAULT_BASE_DELAY;
+        self.maximumDelay = RETRY_POLICY_DEFAULT_MAXIMUM_DELAY;
+        self.failureThreshold = RETRY_POLICY_DEFAULT_FAILURE_THRESHOLD;
+        self.openInterval = RETRY_POLICY_DEFAULT_OPEN_INTERVAL;
+        self.probeInterval = RETRY_POLICY_DEFAULT_PROBE_INTERVAL;
+        self.budgetRatio = RETRY_POLICY_DEFAULT_BUDGET_RATIO;
+        self.maximumBudget = RETRY_POLICY_DEFAULT_MAXIMUM_BUDGET;
+
+        self.hosts = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.lock = [[NSLock alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Statistics
+
+- (void)resetStatistics {
+    [_lock lock];
+    self.retries = 0;
+    self.deniedRetries = 0;
+    self.openedCircuits = 0;
+    self.rejectedRequests = 0;
+    [_lock unlock];
+}
+
+- (void)reset {
+    [_lock lock];
+    [_hosts removeAllObjects];
+    [_lock unlock];
+}
+
+- (void)emitEvent:(PPRetryPolicyEvent)event host:(NSString *)host delay:(NSTimeInterval)delay {
+    PPRetryPolicyEventBlock eventBlock = self.eventBlock;
+    if(eventBlock) {
+        eventBlock(event, host, delay);
+    }
+}
+
+#pragma mark - Circuit Breaker
+
+/**
+ * Must be called while holding the lock
+ */
+- (PPRetryPolicyHost *)stateForHost:(NSString *)host {
+    PPRetryPolicyHost *state = [_hosts objectForKey:host];
+    if(!state) {
+        state = [[PPRetryPolicyHost alloc] init];
+        state.state = PPRetryPolicyCircuitStateClosed;
+        state.budget = self.maximumBudget;
+        [_hosts setObject:state forKey:host];
+    }
+
+    // An open circuit becomes half-open once its interval has passed
+    if(state.state == PPRetryPolicyCircuitStateOpen && [state.openUntil timeIntervalSinceNow] <= 0) {
+        state.state = PPRetryPolicyCircuitStateHalfOpen;
+        state.probing = NO;
+    }
+    
+    // A probe that never reported back doesn't hold the circuit half-open forever
+    if(state.probing && [state.probeUntil timeIntervalSinceNow] <= 0) {
+        state.probing = NO;
+    }
+    return state;
+}
+
+- (PPRetryPolicyCircuitState)circuitStateForHost:(NSString *)host {
+    if(!host) {
+        return PPRetryPolicyCircuitStateClosed;
+    }
+    [_lock lock];
+    PPRetryPolicyCircuitState circuitState = [self stateForHost:host].state;
+    [_lock unlock];
+    return circuitState;
+}
+
+- (BOOL)allowsRequestToHost:(NSString *)host {
+    if(!host) {
+        return YES;
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    BOOL allowed = YES;
+    if(state.state == PPRetryPolicyCircuitStateOpen || (state.state == PPRetryPolicyCircuitStateHalfOpen && state.probing)) {
+        allowed = NO;
+        self.rejectedRequests++;
+    }
+    else if(state.state == PPRetryPolicyCircuitStateHalfOpen) {
+        state.probing = YES;
+        state.probeUntil = [NSDate dateWithTimeIntervalSinceNow:self.probeInterval];
+    }
+    [_lock unlock];
+    return allowed;
+}
+
+- (void)cancelProbeForHost:(NSString *)host {
+    if(!host) {
+        return;
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    if(state.state == PPRetryPolicyCircuitStateHalfOpen) {
+        state.probing = NO;
+    }
+    [_lock unlock];
+}
+
+- (void)recordSuccessForHost:(NSString *)host {
+    if(!host) {
+        return;
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    BOOL closed = (state.state != PPRetryPolicyCircuitStateClosed);
+    state.state = PPRetryPolicyCircuitStateClosed;
+    state.probing = NO;
+    state.consecutiveFailures = 0;
+    state.lastDelay = 0;
+    state.budget = MIN(self.maximumBudget, state.budget + self.budgetRatio);
+    [_lock unlock];
+
+    if(closed) {
+        PPLogAPI(@"Circuit closed for %@", host);
+        [self emitEvent:PPRetryPolicyEventCircuitClosed host:host delay:0];
+    }
+}
+
+- (void)recordFailureForHost:(NSString *)host {
+    if(!host) {
+        return;
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    state.consecutiveFailures++;
+    NSInteger failures = state.consecutiveFailures;
+
+    // A failed probe opens the circuit again right away
+    BOOL opened = NO;
+    if(state.state == PPRetryPolicyCircuitStateHalfOpen || (state.state == PPRetryPolicyCircuitStateClosed && state.consecutiveFailures >= MAX(1, self.failureThreshold))) {
+        state.state = PPRetryPolicyCircuitStateOpen;
+        state.probing = NO;
+        state.openUntil = [NSDate dateWithTimeIntervalSinceNow:self.openInterval];
+        self.openedCircuits++;
+        opened = YES;
+    }
+    [_lock unlock];
+
+    if(opened) {
+        PPLogAPI(@"Circuit opened for %@ after %ld failures", host, (long)failures);
+        [self emitEvent:PPRetryPolicyEventCircuitOpened host:host delay:self.openInterval];
+    }
+}
+
+- (void)recordRequest:(NSURLRequest *)request response:(NSURLResponse *)response error:(NSError *)error {
+    NSString *host = request.URL.host;
+    if(!host) {
+        return;
+    }
+    if([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled) {
+        [self cancelProbeForHost:host];
+        return;
+    }
+
+    NSInteger statusCode = 0;
+    if([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        statusCode = ((NSHTTPURLResponse *)response).statusCode;
+    }
+
+    if(statusCode >= 500 || statusCode == 429 || (error && [error.domain isEqualToString:NSURLErrorDomain])) {
+        [self recordFailureForHost:host];
+    }
+    else if(statusCode > 0) {
+        [self recordSuccessForHost:host];
+    }
+}
+
+#pragma mark - Backoff
+
+/**
+ * Decorrelated jitter: a random delay between the base and three times the previous delay
+ */
+- (NSTimeInterval)delayAfter:(NSTimeInterval)previousDelay baseDelay:(NSTimeInterval)baseDelay {
+    if(baseDelay <= 0) {
+        baseDelay = self.baseDelay;
+    }
+    NSTimeInterval upper = MAX(baseDelay, previousDelay) * 3;
+    double random = (double)arc4random() / (double)UINT32_MAX;
+    return MIN(self.maximumDelay, baseDelay + random * (upper - baseDelay));
+}
+
+/**
+ * Must be called while holding the lock
+ */
+- (NSTimeInterval)nextDelayForState:(PPRetryPolicyHost *)state baseDelay:(NSTimeInterval)baseDelay {
+    state.lastDelay = [self delayAfter:state.lastDelay baseDelay:baseDelay];
+    return state.lastDelay;
+}
+
+- (NSTimeInterval)retryDelayForHost:(NSString *)host baseDelay:(NSTimeInterval)baseDelay {
+    if(!host) {
+        return MAX(baseDelay, self.baseDelay);
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    NSTimeInterval delay = RETRY_POLICY_NO_RETRY;
+    if(state.state != PPRetryPolicyCircuitStateOpen && state.budget >= 1) {
+        state.budget -= 1;
+        delay = [self nextDelayForState:state baseDelay:baseDelay];
+        self.retries++;
+    }
+    else {
+        self.deniedRetries++;
+    }
+    [_lock unlock];
+
+    if(delay == RETRY_POLICY_NO_RETRY) {
+        PPLogAPI(@"Retry to %@ denied", host);
+        [self emitEvent:PPRetryPolicyEventRetryDenied host:host delay:0];
+    }
+    else {
+        [self emitEvent:PPRetryPolicyEventRetry host:host delay:delay];
+    }
+    return delay;
+}
+
+- (NSTimeInterval)reconnectDelayForHost:(NSString *)host baseDelay:(NSTimeInterval)baseDelay {
+    if(!host) {
+        return MAX(baseDelay, self.baseDelay);
+    }
+    [_lock lock];
+    PPRetryPolicyHost *state = [self stateForHost:host];
+    NSTimeInterval delay = [self nextDelayForState:state baseDelay:baseDelay];
+    if(state.state == PPRetryPolicyCircuitStateOpen) {
+        // Reconnect after the circuit half-opens, spread by the jittered delay
+        delay += [state.openUntil timeIntervalSinceNow];
+    }
+    self.retries++;
+    [_lock unlock];
+
+    [self emitEvent:PPRetryPolicyEventRetry host:host delay:delay];
+    return delay;
+}
+
+@end
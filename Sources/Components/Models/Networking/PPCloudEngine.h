@@ -21,6 +21,22 @@
 
 + (void)setSessionKey:(NSString *)sessionKey;
 
+/**
+ * Revalidate read-mostly catalog GETs with ETag / Last-Modified instead of downloading them again.
+ * Disabled by default. See PPHTTPCache for routes and statistics.
+ *
+ * @param enabled BOOL YES to enable the conditional request cache
+ */
++ (void)setHTTPCacheEnabled:(BOOL)enabled;
+
+/**
+ * Record per-route latency, size and status histograms of cloud requests.
+ * Disabled by default. See PPHTTPMetrics for the snapshot.
+ *
+ * @param enabled BOOL YES to enable request metrics
+ */
++ (void)setHTTPMetricsEnabled:(BOOL)enabled;
+
 - (id)initSingleton:(PPCloudEngineType)type;
 
 @end
@@ -8,6 +8,36 @@
 #import "PPCloudEngine.h"
 #import "PPCurlDebug.h"
 #import "PPAFHTTPBridge.h"
+#import "PPHTTPCache.h"
+#import "PPHTTPMetrics.h"
+
+/**
+ * One caller attached to an in-flight GET
+ */
+@interface PPCloudEngineWaiter : NSObject
+@property (nonatomic, copy) void (^success)(NSData *responseData);
+@property (nonatomic, copy) void (^failure)(NSError *error);
+@end
+
+@implementation PPCloudEngineWaiter
+@end
+
+/**
+ * In-flight GET shared by every identical request
+ */
+@interface PPCloudEngineFlight : NSObject
+@property (nonatomic, strong) PPHTTPOperation *operation;
+@property (nonatomic, strong) NSMutableArray *waiters;
+
+// Every caller left before the operation was attached, cancel it once it is
+@property (nonatomic) BOOL cancelled;
+@end
+
+@implementation PPCloudEngineFlight
+@end
+
+@interface PPCloudEngine ()
+@end
 
 @implementation PPCloudEngine
 
@@ -20,6 +50,9 @@ __strong static PPCloudEngine *_sharedProxyObject = nil;
 __strong static PPCloudEngine *_sharedStreamingObject = nil;
 __strong static PPCloudEngine *_sharedReportObject = nil;
 
+static NSMutableDictionary *_flights = nil;
+static NSLock *_flightsLock = nil;
+
 + (PPCloudEngine *)sharedDefaultEngine {
 	if(_sharedDefaultObject == nil || [_sharedDefaultObject getBaseURL].absoluteString == nil || [[_sharedDefaultObject getBaseURL].absoluteString rangeOfString:[PPUrl appAPIServerURLString]].location == NSNotFound) {
         _sharedDefaultObject = [[self alloc] initSingleton:PPCloudEngineTypeDefault];
@@ -90,6 +123,14 @@ __strong static PPCloudEngine *_sharedReportObject = nil;
     [[PPCloudEngine sharedAdminEngine] setValue:sessionKey forHTTPHeaderField:HTTP_HEADER_API_KEY];
 }
 
++ (void)setHTTPCacheEnabled:(BOOL)enabled {
+    [PPHTTPCache sharedCache].enabled = enabled;
+}
+
++ (void)setHTTPMetricsEnabled:(BOOL)enabled {
+    [PPHTTPMetrics sharedMetrics].enabled = enabled;
+}
+
 - (id)initSingleton:(PPCloudEngineType)type {
     NSString *urlString;
     switch (type) {
@@ -121,6 +162,7 @@ __strong static PPCloudEngine *_sharedReportObject = nil;
     
     self = [super initWithBaseURL:[NSURL URLWithString:urlString]];
 	if(self) {
+        self.engineType = type;
 		[self setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
         
         NSString *userAgent = [((AFHTTPSessionManager *)self.ios7Manager).requestSerializer valueForHTTPHeaderField:@"User-Agent"];
@@ -135,11 +177,138 @@ __strong static PPCloudEngine *_sharedReportObject = nil;
 	return self;
 }
 
+#pragma mark - Single-flight
+
+/**
+ * GET. Identical requests already in flight on the same engine type with the same session key share one task.
+ * Every caller receives the response. Cancelling a caller only detaches it, the task is cancelled when no caller is left.
+ * @param URLString The full URL
+ * @param success Success block
+ * @param failure Failure block
+ */
+- (PPHTTPOperation *)GET:(NSString *)URLString
+                 success:(void (^)(NSData *responseData))success
+                 failure:(void (^)(NSError *error))failure {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _flights = [[NSMutableDictionary alloc] init];
+        _flightsLock = [[NSLock alloc] init];
+    });
+    
+    NSString *sessionKey = [[self getRequestSerializer] valueForHTTPHeaderField:HTTP_HEADER_API_KEY];
+    NSString *key = [NSString stringWithFormat:@"%ld|%@|%@", (long)self.engineType, URLString, sessionKey ?: @""];
+    
+    PPCloudEngineWaiter *waiter = [[PPCloudEngineWaiter alloc] init];
+    waiter.success = success;
+    waiter.failure = failure;
+    
+    [_flightsLock lock];
+    PPCloudEngineFlight *flight = [_flights objectForKey:key];
+    BOOL joined = (flight != nil);
+    if(!joined) {
+        flight = [[PPCloudEngineFlight alloc] init];
+        flight.waiters = [[NSMutableArray alloc] initWithObjects:waiter, nil];
+        [_flights setObject:flight forKey:key];
+    }
+    else {
+        [flight.waiters addObject:waiter];
+    }
+    [_flightsLock unlock];
+    
+    if(!joined) {
+        PPHTTPOperation *operation = [super GET:URLString success:^(NSData *responseData) {
+            [PPCloudEngine completeFlight:flight key:key responseData:responseData error:nil];
+        } failure:^(NSError *error) {
+            [PPCloudEngine completeFlight:flight key:key responseData:nil error:error];
+        }];
+        
+        if(!operation) {
+            // No task was created, fail whoever joined meanwhile instead of leaving them attached to nothing
+            [PPCloudEngine completeFlight:flight key:key responseData:nil error:[PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class])]];
+            return nil;
+        }
+        
+        [_flightsLock lock];
+        flight.operation = operation;
+        BOOL cancelled = flight.cancelled;
+        [_flightsLock unlock];
+        
+        if(cancelled) {
+            [operation cancel];
+        }
+    }
+    else {
+        PPLogAPI(@"> %s joined in-flight GET %@", __PRETTY_FUNCTION__, URLString);
+    }
+    
+    __weak PPCloudEngineWaiter *weakWaiter = waiter;
+    return [[PPHTTPOperation alloc] initWithCancellationHandler:^{
+        [PPCloudEngine cancelWaiter:weakWaiter flight:flight key:key];
+    }];
+}
+
++ (void)completeFlight:(PPCloudEngineFlight *)flight key:(NSString *)key responseData:(NSData *)responseData error:(NSError *)error {
+    [_flightsLock lock];
+    if([_flights objectForKey:key] == flight) {
+        [_flights removeObjectForKey:key];
+    }
+    NSArray *waiters = [flight.waiters copy];
+    [flight.waiters removeAllObjects];
+    [_flightsLock unlock];
+    
+    // One body for every caller, so it only has to be parsed once
+    if(responseData && waiters.count > 1) {
+        [[PPHTTPCache sharedCache] shareParsedObjectForData:responseData];
+    }
+    
+    for(PPCloudEngineWaiter *waiter in waiters) {
+        if(error) {
+            waiter.failure(error);
+        }
+        else {
+            waiter.success(responseData);
+        }
+    }
+}
+
++ (void)cancelWaiter:(PPCloudEngineWaiter *)waiter flight:(PPCloudEngineFlight *)flight key:(NSString *)key {
+    if(!waiter) {
+        return;
+    }
+    
+    [_flightsLock lock];
+    if(![flight.waiters containsObject:waiter]) {
+        // Already completed or cancelled
+        [_flightsLock unlock];
+        return;
+    }
+    [flight.waiters removeObject:waiter];
+    
+    PPHTTPOperation *operation = nil;
+    if(flight.waiters.count == 0) {
+        if([_flights objectForKey:key] == flight) {
+            [_flights removeObjectForKey:key];
+        }
+        operation = flight.operation;
+        flight.cancelled = YES;
+    }
+    [_flightsLock unlock];
+    
+    [operation cancel];
+    
+    // Cancelled requests complete with no data, as they do without sharing
+    void (^success)(NSData *responseData) = waiter.success;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        success(nil);
+    });
+}
+
 #pragma mark - Encoding
 
 - (id)copyWithZone:(NSZone *)zone {
     PPCloudEngine *cloudEngine = [[PPCloudEngine allocWithZone:zone] init];
     cloudEngine.ios7Manager = self.ios7Manager;
+    cloudEngine.engineType = self.engineType;
     return cloudEngine;
 }
 
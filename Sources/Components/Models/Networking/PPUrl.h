@@ -26,6 +26,7 @@
 + (NSString *)webappServerURLString;
 + (NSString *)streamingServerURLString:(PPCloudConnectivityServer *)server;
 + (NSString *)deviceIOServerURLString:(PPCloudConnectivityServer *)server;
++ (NSString *)deviceIOWebSocketURLString:(PPCloudConnectivityServer *)server;
 
 #pragma mark - Webapp endpoints
 
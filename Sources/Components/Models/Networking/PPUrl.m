@@ -174,6 +174,16 @@
     return serverURLString;
 }
 
+/**
+ * The device server accepts a WebSocket upgrade on the same endpoint as the HTTP path
+ */
++ (NSString *)deviceIOWebSocketURLString:(PPCloudConnectivityServer *)server {
+    NSURLComponents *components = [NSURLComponents componentsWithString:[PPUrl deviceIOServerURLString:server]];
+    components.scheme = [components.scheme isEqualToString:@"https"] ? @"wss" : @"ws";
+    
+    return components.string;
+}
+
 #pragma mark - Webapp endpoints
 
 + (NSString *)feedbackURL {
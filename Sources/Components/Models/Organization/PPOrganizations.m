@@ -63,9 +63,9 @@ __strong static PPOrganizations *_sharedObject = nil;
     
     // Create a custom admin cloud engine.  API key is not needed
     PPCloudEngine *adminEngine = [[PPCloudEngine alloc] initSingleton:PPCloudEngineTypeAdmin];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.organizations.getOrganizations()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [adminEngine GET:components.string success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -83,7 +83,7 @@ __strong static PPOrganizations *_sharedObject = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(organizations, error);
@@ -92,7 +92,7 @@ __strong static PPOrganizations *_sharedObject = nil;
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -135,10 +135,10 @@ __strong static PPOrganizations *_sharedObject = nil;
     if(billsStartDate) {
         [request appendFormat:@"startDate=%@&", [PPNSString stringByAddingURIPercentEscapesUsingEncoding:NSUTF8StringEncoding toString:[PPNSDate apiFriendStringFromDate:billsStartDate]]];
     }
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.organizations.getGroups()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     [[PPCloudEngine sharedAdminEngine] setCompleteionQueue:queue];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAdminEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -156,7 +156,7 @@ __strong static PPOrganizations *_sharedObject = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(groups, error);
@@ -165,7 +165,7 @@ __strong static PPOrganizations *_sharedObject = nil;
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -215,9 +215,9 @@ __strong static PPOrganizations *_sharedObject = nil;
     NSMutableURLRequest *request = [[[PPCloudEngine sharedAdminEngine] getRequestSerializer] requestWithMethod:@"PUT" URLString:[NSURL URLWithString:urlString relativeToURL:[[PPCloudEngine sharedAdminEngine] getBaseURL]].absoluteString parameters:nil error:&error];
     
     [request setHTTPBody:[JSONString dataUsingEncoding:NSUTF8StringEncoding]];
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.organizations.joinOrganization()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAdminEngine] operationWithRequest:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -230,7 +230,7 @@ __strong static PPOrganizations *_sharedObject = nil;
             if(!error) {
                 newStatus = (PPOrganizationStatus)((NSString *)[root objectForKey:@"status"]).integerValue;
             }
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(newStatus, error);
@@ -238,7 +238,7 @@ __strong static PPOrganizations *_sharedObject = nil;
         });
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(PPOrganizationStatusNone, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
@@ -258,10 +258,10 @@ __strong static PPOrganizations *_sharedObject = nil;
 + (void)listObjectsAndProperties:(PPOrganizationId)organizationId callback:(PPOrganizationsObjectsAndPropertiesBlock)callback {
     NSString *request = [NSString stringWithFormat:@"organizations/%li/objects", (long)organizationId];
     
-    dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.organizations.listObjectsAndProperties()", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
     [[PPCloudEngine sharedAdminEngine] setCompleteionQueue:queue];
     
-    PPLogAPI(@"> %s", dispatch_queue_get_label(queue));
+    PPLogAPI(@"> %s", __PRETTY_FUNCTION__);
     [[PPCloudEngine sharedAdminEngine] GET:request success:^(NSData *responseData) {
         
         dispatch_async(queue, ^{
@@ -279,7 +279,7 @@ __strong static PPOrganizations *_sharedObject = nil;
                 }
             }
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(objectsAndProperties, error);
@@ -288,7 +288,7 @@ __strong static PPOrganizations *_sharedObject = nil;
     } failure:^(NSError *error) {
         dispatch_async(queue, ^{
             
-            PPLogAPI(@"< %s", dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL));
+            PPLogAPI(@"< %s", __PRETTY_FUNCTION__);
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 callback(nil, [PPBaseModel resultCodeToNSError:10003 originatingClass:NSStringFromClass([self class]) argument:[NSString stringWithFormat:@"%@", error.userInfo]]);
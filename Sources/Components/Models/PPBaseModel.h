@@ -27,7 +27,29 @@
 + (NSError * _Nullable )resultCodeToNSError:(NSInteger)resultCode originatingClass:(NSString * _Nullable )originatingClass;
 + (NSError * _Nullable )resultCodeToNSError:(NSInteger)resultCode originatingClass:(NSString * _Nullable )originatingClass argument:(NSString * _Nullable )argument;
 
+/**
+ * Shared response processing queue.
+ * Each lane is backed by a small, fixed pool of serial queues so API callbacks no longer create a queue per request.
+ *
+ * @param lane PPBaseModelResponseLane Lane to dispatch response processing on
+ * @return dispatch_queue_t Serial queue from the lane's pool
+ */
++ (dispatch_queue_t _Nonnull )responseQueue:(PPBaseModelResponseLane)lane;
+
 + (NSDictionary * _Nullable )processJSONResponse:(NSData * _Nullable )operation error:(NSError * _Nullable * _Nullable )error;
 + (NSDictionary * _Nullable )processJSONResponse:(NSData * _Nullable )operation originatingClass:(NSString * _Nullable )originatingClass error:(NSError * _Nullable * _Nullable)error;
 
+/**
+ * Streaming JSON response processing.
+ * The top level fields are decoded first so the resultCode is checked before any element is built. Elements of the array at streamingKey are then decoded one at a time, in place, and handed to the element block.
+ *
+ * @param responseData NSData Response body
+ * @param originatingClass NSString Class name used for error reporting
+ * @param streamingKey Required NSString Top level key of the array to stream, e.g. readings, devices or files
+ * @param element Required PPBaseModelJSONElementBlock Called on the calling queue for each array element, in order
+ * @param error NSError Set if the response could not be parsed or carries a non-zero resultCode
+ * @return NSDictionary Top level fields, excluding streamingKey even when its value is not an array
+ */
++ (NSDictionary * _Nullable )processJSONResponse:(NSData * _Nullable )responseData originatingClass:(NSString * _Nullable )originatingClass streamingKey:(NSString * _Nonnull )streamingKey element:(PPBaseModelJSONElementBlock _Nonnull )element error:(NSError * _Nullable * _Nullable)error;
+
 @end
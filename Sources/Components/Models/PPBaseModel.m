@@ -7,11 +7,21 @@
 
 #import "PPBaseModel.h"
 #import "PPCurlDebug.h"
+#import "PPHTTPCache.h"
+#import "PPHTTPMetrics.h"
+#import <stdatomic.h>
 
 PPBasicBlock _loginBlock;
 
 static NSString *kTrackingKey = @"com.peoplepowerco.lib.Peoplepower.trackingDisabled";
 
+#define RESPONSE_LANE_COUNT 3
+#define RESPONSE_LANE_MAX_WIDTH 8
+
+static dispatch_queue_t _responseQueues[RESPONSE_LANE_COUNT][RESPONSE_LANE_MAX_WIDTH];
+static NSUInteger _responseQueueWidths[RESPONSE_LANE_COUNT];
+static atomic_uint_fast32_t _responseQueueCursors[RESPONSE_LANE_COUNT];
+
 @implementation PPBaseModel
 
 + (NSBundle *)bundle {
@@ -546,30 +556,93 @@ static NSString *kTrackingKey = @"com.peoplepowerco.lib.Peoplepower.trackingDisa
 	return [NSError errorWithDomain:@"com.peoplepowerco.lib.Peoplepower" code:resultCode userInfo:errorDetail];
 }
 
++ (dispatch_queue_t)responseQueue:(PPBaseModelResponseLane)lane {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSUInteger processors = [[NSProcessInfo processInfo] activeProcessorCount];
+        
+        // Interactive parsing may run on every core, bulk parsing on up to half of them, and background stays narrow so neither starves the UI
+        _responseQueueWidths[PPBaseModelResponseLaneInteractive - 1] = MIN(MAX(processors, 2), RESPONSE_LANE_MAX_WIDTH);
+        _responseQueueWidths[PPBaseModelResponseLaneBackground - 1] = 2;
+        _responseQueueWidths[PPBaseModelResponseLaneBulk - 1] = MIN(MAX(processors / 2, 2), RESPONSE_LANE_MAX_WIDTH);
+        
+        const char *names[RESPONSE_LANE_COUNT] = {"interactive", "background", "bulk"};
+        dispatch_qos_class_t classes[RESPONSE_LANE_COUNT] = {QOS_CLASS_USER_INITIATED, QOS_CLASS_UTILITY, QOS_CLASS_UTILITY};
+        
+        for(NSInteger i = 0; i < RESPONSE_LANE_COUNT; i++) {
+            dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, classes[i], 0);
+            for(NSUInteger j = 0; j < _responseQueueWidths[i]; j++) {
+                NSString *label = [NSString stringWithFormat:@"com.peoplepowerco.lib.Peoplepower.response.%s.%lu", names[i], (unsigned long)j];
+                _responseQueues[i][j] = dispatch_queue_create(label.UTF8String, attributes);
+            }
+            atomic_init(&_responseQueueCursors[i], 0);
+        }
+    });
+    
+    NSInteger index = lane - 1;
+    if(index < 0 || index >= RESPONSE_LANE_COUNT) {
+        index = PPBaseModelResponseLaneInteractive - 1;
+    }
+    
+    // Round-robin across the lane's pool
+    uint_fast32_t cursor = atomic_fetch_add_explicit(&_responseQueueCursors[index], 1, memory_order_relaxed);
+    return _responseQueues[index][cursor % _responseQueueWidths[index]];
+}
+
 + (NSDictionary *)processJSONResponse:(NSData *)responseData error:(NSError **)error {
     return [PPBaseModel processJSONResponse:responseData originatingClass:nil error:error];
 }
 
 + (NSDictionary *)processJSONResponse:(NSData *)responseData originatingClass:(NSString *)originatingClass error:(NSError **)error {
-    NSString *responseString = [[NSString alloc] initWithData:responseData encoding:NSUTF8StringEncoding];
+    PPHTTPMetrics *metrics = [PPHTTPMetrics sharedMetrics];
+    if(!metrics.enabled) {
+        return [PPBaseModel parseJSONResponse:responseData originatingClass:originatingClass error:error];
+    }
     
-    if(responseString.length == 0) {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSDictionary *parsedObject = [PPBaseModel parseJSONResponse:responseData originatingClass:originatingClass error:error];
+    [metrics recordParseTime:CFAbsoluteTimeGetCurrent() - startTime bytes:responseData.length originatingClass:originatingClass];
+    return parsedObject;
+}
+
++ (NSDictionary *)parseJSONResponse:(NSData *)responseData originatingClass:(NSString *)originatingClass error:(NSError **)error {
+    // Check the body length directly rather than copying it into a string first
+    if(responseData.length == 0) {
         return @{};
     }
     
+    // Bodies revalidated with 304 Not Modified were already parsed
+    NSDictionary *cachedObject = [[PPHTTPCache sharedCache] parsedObjectForData:responseData];
+    if(cachedObject) {
+        return cachedObject;
+    }
+    
     NSError *parsingError = nil;
-    NSDictionary *parsedObject;
-    NSInteger resultCode = 0;
-    NSString *resultCodeMessage = nil;
-    parsedObject = [NSJSONSerialization JSONObjectWithData:responseData options:0 error:&parsingError];
+    NSDictionary *parsedObject = [NSJSONSerialization JSONObjectWithData:responseData options:0 error:&parsingError];
     
     if(parsingError) {
         *error = parsingError;
         return nil;
     }
     
-    resultCode = ((NSString *)[parsedObject objectForKey:@"resultCode"]).integerValue;
-    resultCodeMessage = ((NSString *)[parsedObject objectForKey:@"resultCodeMessage"]);
+    if(![PPBaseModel processResultCode:parsedObject originatingClass:originatingClass error:error]) {
+        return nil;
+    }
+    
+    PPLogAPI(@"%@", [PPCurlDebug responseToDescription:parsedObject]);
+    
+    [[PPHTTPCache sharedCache] setParsedObject:parsedObject forData:responseData];
+    
+    return parsedObject;
+}
+
+/**
+ * Translate the resultCode of a parsed response into an error.
+ * @return NO if the response carries an error
+ */
++ (BOOL)processResultCode:(NSDictionary *)parsedObject originatingClass:(NSString *)originatingClass error:(NSError **)error {
+    NSInteger resultCode = ((NSString *)[parsedObject objectForKey:@"resultCode"]).integerValue;
+    NSString *resultCodeMessage = ((NSString *)[parsedObject objectForKey:@"resultCodeMessage"]);
     
     if(resultCode > 0) {
         if(resultCode == 2) {
@@ -577,7 +650,7 @@ static NSString *kTrackingKey = @"com.peoplepowerco.lib.Peoplepower.trackingDisa
             
             // Ignore any argument
             *error = [PPBaseModel resultCodeToNSError:resultCode originatingClass:originatingClass];
-            return nil;
+            return NO;
         }
         else if((resultCode == 19
                  || resultCode == 44)
@@ -645,12 +718,212 @@ static NSString *kTrackingKey = @"com.peoplepowerco.lib.Peoplepower.trackingDisa
         else {
             *error = [PPBaseModel resultCodeToNSError:resultCode originatingClass:originatingClass];
         }
+        return NO;
+    }
+    
+    return YES;
+}
+
+#pragma mark - Streaming
+
+/**
+ * Skip JSON whitespace starting at index i.
+ */
+static NSUInteger PPJSONSkipWhitespace(const uint8_t *bytes, NSUInteger length, NSUInteger i) {
+    while(i < length && (bytes[i] == ' ' || bytes[i] == '\t' || bytes[i] == '\n' || bytes[i] == '\r')) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Find the end of the JSON value starting at index i without decoding it.
+ * @return Index one past the last byte of the value, or NSNotFound if the value is malformed or truncated
+ */
+static NSUInteger PPJSONValueEnd(const uint8_t *bytes, NSUInteger length, NSUInteger i) {
+    if(i >= length) {
+        return NSNotFound;
+    }
+    
+    uint8_t c = bytes[i];
+    if(c == '"' || c == '{' || c == '[') {
+        NSInteger depth = 0;
+        BOOL inString = NO;
+        for(; i < length; i++) {
+            c = bytes[i];
+            if(inString) {
+                if(c == '\\') {
+                    i++;
+                }
+                else if(c == '"') {
+                    inString = NO;
+                    if(depth == 0) {
+                        return i + 1;
+                    }
+                }
+            }
+            else if(c == '"') {
+                inString = YES;
+            }
+            else if(c == '{' || c == '[') {
+                depth++;
+            }
+            else if(c == '}' || c == ']') {
+                depth--;
+                if(depth == 0) {
+                    return i + 1;
+                }
+            }
+        }
+        return NSNotFound;
+    }
+    
+    // Number, true, false or null
+    NSUInteger start = i;
+    while(i < length && bytes[i] != ',' && bytes[i] != '}' && bytes[i] != ']' && bytes[i] != ' ' && bytes[i] != '\t' && bytes[i] != '\n' && bytes[i] != '\r') {
+        i++;
+    }
+    return i > start ? i : NSNotFound;
+}
+
+/**
+ * Decode a single JSON value in place. The returned object does not retain the response buffer.
+ */
+static id PPJSONDecodeRange(const uint8_t *bytes, NSRange range, NSError **error) {
+    NSData *slice = [[NSData alloc] initWithBytesNoCopy:(void *)(bytes + range.location) length:range.length freeWhenDone:NO];
+    return [NSJSONSerialization JSONObjectWithData:slice options:NSJSONReadingFragmentsAllowed error:error];
+}
+
++ (NSDictionary *)processJSONResponse:(NSData *)responseData originatingClass:(NSString *)originatingClass streamingKey:(NSString *)streamingKey element:(PPBaseModelJSONElementBlock)element error:(NSError **)error {
+    PPHTTPMetrics *metrics = [PPHTTPMetrics sharedMetrics];
+    if(!metrics.enabled) {
+        return [PPBaseModel parseJSONResponse:responseData originatingClass:originatingClass streamingKey:streamingKey element:element error:error];
+    }
+    
+    // Includes the time spent in the element block
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSDictionary *root = [PPBaseModel parseJSONResponse:responseData originatingClass:originatingClass streamingKey:streamingKey element:element error:error];
+    [metrics recordParseTime:CFAbsoluteTimeGetCurrent() - startTime bytes:responseData.length originatingClass:originatingClass];
+    return root;
+}
+
++ (NSDictionary *)parseJSONResponse:(NSData *)responseData originatingClass:(NSString *)originatingClass streamingKey:(NSString *)streamingKey element:(PPBaseModelJSONElementBlock)element error:(NSError **)error {
+    if(responseData.length == 0) {
+        return @{};
+    }
+    
+    const uint8_t *bytes = responseData.bytes;
+    NSUInteger length = responseData.length;
+    NSMutableDictionary *root = [[NSMutableDictionary alloc] initWithCapacity:4];
+    NSRange streamingRange = NSMakeRange(NSNotFound, 0);
+    BOOL malformed = NO;
+    
+    // Walk the top level object. Everything except the streamed array is decoded up front so resultCode is known before any element is built.
+    NSUInteger i = PPJSONSkipWhitespace(bytes, length, 0);
+    if(i >= length || bytes[i] != '{') {
+        malformed = YES;
+    }
+    else {
+        i = PPJSONSkipWhitespace(bytes, length, i + 1);
+        while(i < length && bytes[i] != '}') {
+            NSUInteger keyEnd = PPJSONValueEnd(bytes, length, i);
+            if(bytes[i] != '"' || keyEnd == NSNotFound) {
+                malformed = YES;
+                break;
+            }
+            NSString *key = PPJSONDecodeRange(bytes, NSMakeRange(i, keyEnd - i), nil);
+            
+            i = PPJSONSkipWhitespace(bytes, length, keyEnd);
+            if(i >= length || bytes[i] != ':' || key == nil) {
+                malformed = YES;
+                break;
+            }
+            i = PPJSONSkipWhitespace(bytes, length, i + 1);
+            
+            NSUInteger valueEnd = PPJSONValueEnd(bytes, length, i);
+            if(valueEnd == NSNotFound) {
+                malformed = YES;
+                break;
+            }
+            
+            if([key isEqualToString:streamingKey]) {
+                // Only an array is streamed. Anything else, e.g. null, has no elements and is left out of root like the array would be.
+                if(bytes[i] == '[') {
+                    streamingRange = NSMakeRange(i, valueEnd - i);
+                }
+            }
+            else {
+                NSError *parsingError = nil;
+                id value = PPJSONDecodeRange(bytes, NSMakeRange(i, valueEnd - i), &parsingError);
+                if(parsingError) {
+                    *error = parsingError;
+                    return nil;
+                }
+                [root setObject:value forKey:key];
+            }
+            
+            i = PPJSONSkipWhitespace(bytes, length, valueEnd);
+            if(i < length && bytes[i] == ',') {
+                i = PPJSONSkipWhitespace(bytes, length, i + 1);
+            }
+            else if(i >= length || bytes[i] != '}') {
+                malformed = YES;
+                break;
+            }
+        }
+    }
+    
+    if(malformed) {
+        // Let the regular parser report the problem, or handle anything the scanner does not understand
+        NSDictionary *parsedObject = [PPBaseModel parseJSONResponse:responseData originatingClass:originatingClass error:error];
+        if(!parsedObject) {
+            return nil;
+        }
+        NSMutableDictionary *remaining = parsedObject.mutableCopy;
+        id elements = [remaining objectForKey:streamingKey];
+        if([elements isKindOfClass:[NSArray class]]) {
+            for(id elementObject in elements) {
+                element(elementObject);
+            }
+        }
+        [remaining removeObjectForKey:streamingKey];
+        return remaining;
+    }
+    
+    if(![PPBaseModel processResultCode:root originatingClass:originatingClass error:error]) {
         return nil;
     }
     
-    PPLogAPI(@"%@", [PPCurlDebug responseToDescription:parsedObject]);
+    PPLogAPI(@"%@", [PPCurlDebug responseToDescription:root]);
     
-    return parsedObject;
+    if(streamingRange.location != NSNotFound) {
+        NSUInteger arrayEnd = NSMaxRange(streamingRange) - 1;
+        i = PPJSONSkipWhitespace(bytes, length, streamingRange.location + 1);
+        while(i < arrayEnd) {
+            NSUInteger elementEnd = PPJSONValueEnd(bytes, length, i);
+            if(elementEnd == NSNotFound || elementEnd > arrayEnd) {
+                break;
+            }
+            
+            // Only one element tree is alive at a time
+            @autoreleasepool {
+                NSError *parsingError = nil;
+                id elementObject = PPJSONDecodeRange(bytes, NSMakeRange(i, elementEnd - i), &parsingError);
+                if(parsingError) {
+                    *error = parsingError;
+                    return nil;
+                }
+                element(elementObject);
+            }
+            
+            i = PPJSONSkipWhitespace(bytes, length, elementEnd);
+            if(i < arrayEnd && bytes[i] == ',') {
+                i = PPJSONSkipWhitespace(bytes, length, i + 1);
+            }
+        }
+    }
+    
+    return root;
 }
 
 @end
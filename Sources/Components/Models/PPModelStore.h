@@ -0,0 +1,113 @@
+//
+//  PPModelStore.h
+//  Peoplepower
+//
+//  Copyright © 2023 People Power Company. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Persistent per-user record store for the shared model caches.
+ * Each record is archived with NSKeyedArchiver into its own file, so an upsert rewrites that record only,
+ * instead of the whole cache being archived into NSUserDefaults on every change.
+ * The records of a user are read on first access. Changes are visible right away and written in batches
+ * on a background queue after flushInterval.
+ */
+@interface PPModelStore : NSObject
+
+/**
+ * Store shared across the application, e.g. "notificationSubscriptions"
+ *
+ * @param name Required NSString Store name, also the name of its directory
+ */
++ (PPModelStore * _Nonnull )sharedStoreNamed:(NSString * _Nonnull )name;
+
+/**
+ * @param name Required NSString Store name
+ * @param directoryURL Required NSURL Directory holding one subdirectory per user
+ */
+- (id _Nonnull )initWithName:(NSString * _Nonnull )name directoryURL:(NSURL * _Nonnull )directoryURL;
+
+@property (nonatomic, strong, readonly) NSString * _Nonnull name;
+
+/**
+ * Seconds changes are gathered before they are written. Default is MODEL_STORE_DEFAULT_FLUSH_INTERVAL.
+ */
+@property (atomic) NSTimeInterval flushInterval;
+
+#pragma mark - Records
+
+/**
+ * @param key Required NSString Record key
+ * @param userId Required PPUserId User the record belongs to
+ * @return Record, or nil
+ */
+- (id _Nullable )objectForKey:(NSString * _Nonnull )key userId:(PPUserId)userId;
+
+/**
+ * @param userId Required PPUserId User the records belong to
+ * @return NSDictionary Every record of the user by key
+ */
+- (NSDictionary * _Nonnull )objectsForUser:(PPUserId)userId;
+
+/**
+ * @param userId Required PPUserId User the records belong to
+ * @return NSArray Every record of the user, in the order each key was first set
+ */
+- (NSArray * _Nonnull )orderedObjectsForUser:(PPUserId)userId;
+
+/**
+ * Insert or replace a record. It is archived right away. A replaced record keeps its place in orderedObjectsForUser:.
+ *
+ * @param object Required NSCoding object to store
+ * @param key Required NSString Record key
+ * @param userId Required PPUserId User the record belongs to
+ */
+- (void)setObject:(id<NSCoding> _Nonnull )object forKey:(NSString * _Nonnull )key userId:(PPUserId)userId;
+
+/**
+ * Write a record again after it was changed in place.
+ * The record is archived right away, so it may be changed again before the write.
+ *
+ * @param key Required NSString Record key
+ * @param userId Required PPUserId User the record belongs to
+ */
+- (void)touchObjectForKey:(NSString * _Nonnull )key userId:(PPUserId)userId;
+
+- (void)removeObjectForKey:(NSString * _Nonnull )key userId:(PPUserId)userId;
+- (void)removeAllObjectsForUser:(PPUserId)userId;
+
+/**
+ * Write pending changes now and wait until they are on disk
+ */
+- (void)flush;
+
+#pragma mark - Statistics
+
+/**
+ * Number of batches written
+ */
+@property (atomic, readonly) NSUInteger flushes;
+
+/**
+ * Number of records written
+ */
+@property (atomic, readonly) NSUInteger recordsWritten;
+
+/**
+ * Number of record files removed
+ */
+@property (atomic, readonly) NSUInteger recordsRemoved;
+
+/**
+ * Bytes written to disk, to compare with archiving the whole cache on every change
+ */
+@property (atomic, readonly) unsigned long long bytesWritten;
+
+/**
+ * Reset flushes, records written and removed and bytes written
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,364 @@
+//
+//  PPModelStore.m
+//  Peoplepower
+//
+//  Copyright © 2023 People Power Company. All rights reserved.
+//
+
+#import "PPModelStore.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString *kRecordKeyKey = @"key";
+static NSString *kRecordObjectKey = @"object";
+static NSString *kRecordSequenceKey = @"sequence";
+
+@interface PPModelStore ()
+@property (atomic, readwrite) NSUInteger flushes;
+@property (atomic, readwrite) NSUInteger recordsWritten;
+@property (atomic, readwrite) NSUInteger recordsRemoved;
+@property (atomic, readwrite) unsigned long long bytesWritten;
+
+@property (nonatomic, strong, readwrite) NSString *name;
+@property (nonatomic, strong) NSURL *directoryURL;
+
+// User ID -> (key -> record), for the users read so far
+@property (nonatomic, strong) NSMutableDictionary *users;
+
+// User ID -> (key -> NSNumber order the record was first set in), for the users read so far
+@property (nonatomic, strong) NSMutableDictionary *sequences;
+@property (nonatomic) long long nextSequence;
+
+// User ID -> (key -> archived record to write, or NSNull to remove)
+@property (nonatomic, strong) NSMutableDictionary *pending;
+
+// Users whose records are all removed before pending changes are written
+@property (nonatomic, strong) NSMutableSet *clearedUsers;
+
+@property (nonatomic) BOOL flushScheduled;
+@property (nonatomic, strong) NSLock *lock;
+@property (nonatomic, strong) dispatch_queue_t diskQueue;
+@end
+
+@implementation PPModelStore
+
++ (PPModelStore *)sharedStoreNamed:(NSString *)name {
+    static NSMutableDictionary *_sharedStores = nil;
+    static NSURL *_sharedDirectoryURL = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedStores = [[NSMutableDictionary alloc] initWithCapacity:0];
+        NSURL *applicationSupportURL = [[NSFileManager defaultManager] URLForDirectory:NSApplicationSupportDirectory inDomain:NSUserDomainMask appropriateForURL:nil create:YES error:nil];
+        _sharedDirectoryURL = [applicationSupportURL URLByAppendingPathComponent:@"com.peoplepowerco.lib.Peoplepower.ModelStore" isDirectory:YES];
+    });
+    
+    PPModelStore *store;
+    @synchronized(_sharedStores) {
+        store = [_sharedStores objectForKey:name];
+        if(!store) {
+            store = [[PPModelStore alloc] initWithName:name directoryURL:[_sharedDirectoryURL URLByAppendingPathComponent:name isDirectory:YES]];
+            [_sharedStores setObject:store forKey:name];
+        }
+    }
+    return store;
+}
+
+- (id)initWithName:(NSString *)name directoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if(self) {
+        self.name = name;
+        self.directoryURL = directoryURL;
+        self.flushInterval = MODEL_STORE_DEFAULT_FLUSH_INTERVAL;
+        self.users = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.sequences = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.pending = [[NSMutableDictionary alloc] initWithCapacity:0];
+        self.clearedUsers = [[NSMutableSet alloc] initWithCapacity:0];
+        self.lock = [[NSLock alloc] init];
+        NSString *label = [NSString stringWithFormat:@"com.peoplepowerco.lib.Peoplepower.modelStore.%@", name];
+        self.diskQueue = dispatch_queue_create(label.UTF8String, dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+    }
+    return self;
+}
+
+#pragma mark - Files
+
+- (NSString *)userKey:(PPUserId)userId {
+    return [NSString stringWithFormat:@"%li", (long)userId];
+}
+
+- (NSURL *)userDirectoryURL:(NSString *)userKey {
+    return [_directoryURL URLByAppendingPathComponent:userKey isDirectory:YES];
+}
+
+- (NSURL *)recordURLForKey:(NSString *)key userKey:(NSString *)userKey {
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(keyData.bytes, (CC_LONG)keyData.length, digest);
+    
+    NSMutableString *fileName = [[NSMutableString alloc] initWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for(NSInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [fileName appendFormat:@"%02x", digest[i]];
+    }
+    return [[self userDirectoryURL:userKey] URLByAppendingPathComponent:[fileName stringByAppendingPathExtension:@"record"]];
+}
+
+/**
+ * Records of a user, read from disk on first access.
+ * Must be called while holding the lock.
+ */
+- (NSMutableDictionary *)recordsForUserKey:(NSString *)userKey {
+    NSMutableDictionary *records = [_users objectForKey:userKey];
+    if(records) {
+        return records;
+    }
+    
+    records = [[NSMutableDictionary alloc] initWithCapacity:0];
+    NSMutableDictionary *sequences = [[NSMutableDictionary alloc] initWithCapacity:0];
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:[self userDirectoryURL:userKey] includingPropertiesForKeys:nil options:NSDirectoryEnumerationSkipsHiddenFiles error:nil];
+    for(NSURL *fileURL in files) {
+        if(![fileURL.pathExtension isEqualToString:@"record"]) {
+            continue;
+        }
+        NSData *data = [NSData dataWithContentsOfURL:fileURL];
+        if(!data) {
+            continue;
+        }
+        @try {
+            NSError *error = nil;
+            NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:data error:&error];
+            if(!unarchiver) {
+                [NSException raise:NSInvalidUnarchiveOperationException format:@"%@", error];
+            }
+            unarchiver.requiresSecureCoding = NO;
+            NSDictionary *record = [unarchiver decodeObjectForKey:NSKeyedArchiveRootObjectKey];
+            [unarchiver finishDecoding];
+            NSString *key = [record objectForKey:kRecordKeyKey];
+            id object = [record objectForKey:kRecordObjectKey];
+            NSNumber *sequence = [record objectForKey:kRecordSequenceKey];
+            if(key && object) {
+                [records setObject:object forKey:key];
+                if(sequence) {
+                    [sequences setObject:sequence forKey:key];
+                    _nextSequence = MAX(_nextSequence, sequence.longLongValue + 1);
+                }
+            }
+        }
+        @catch (NSException *exception) {
+            // A record of a class that no longer decodes is dropped
+            NSLog(@"%s Dropping %@: %@", __PRETTY_FUNCTION__, fileURL.lastPathComponent, exception);
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        }
+    }
+    
+    // Records written without an order go after the others
+    for(NSString *key in [records.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        if(![sequences objectForKey:key]) {
+            [sequences setObject:@(_nextSequence++) forKey:key];
+        }
+    }
+    [_users setObject:records forKey:userKey];
+    [_sequences setObject:sequences forKey:userKey];
+    return records;
+}
+
+#pragma mark - Records
+
+- (id)objectForKey:(NSString *)key userId:(PPUserId)userId {
+    [_lock lock];
+    id object = [[self recordsForUserKey:[self userKey:userId]] objectForKey:key];
+    [_lock unlock];
+    return object;
+}
+
+- (NSDictionary *)objectsForUser:(PPUserId)userId {
+    [_lock lock];
+    NSDictionary *objects = [[self recordsForUserKey:[self userKey:userId]] copy];
+    [_lock unlock];
+    return objects;
+}
+
+- (NSArray *)orderedObjectsForUser:(PPUserId)userId {
+    NSString *userKey = [self userKey:userId];
+    [_lock lock];
+    NSDictionary *records = [self recordsForUserKey:userKey];
+    NSDictionary *sequences = [_sequences objectForKey:userKey];
+    NSArray *keys = [records.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSString *key1, NSString *key2) {
+        return [[sequences objectForKey:key1] compare:[sequences objectForKey:key2]];
+    }];
+    NSArray *objects = [records objectsForKeys:keys notFoundMarker:[NSNull null]];
+    [_lock unlock];
+    return objects;
+}
+
+- (void)setObject:(id<NSCoding>)object forKey:(NSString *)key userId:(PPUserId)userId {
+    NSString *userKey = [self userKey:userId];
+    [_lock lock];
+    [[self recordsForUserKey:userKey] setObject:object forKey:key];
+    
+    // A replaced record keeps its place
+    NSMutableDictionary *sequences = [_sequences objectForKey:userKey];
+    if(![sequences objectForKey:key]) {
+        [sequences setObject:@(_nextSequence++) forKey:key];
+    }
+    [self queueRecordForKey:key userKey:userKey];
+    [_lock unlock];
+}
+
+- (void)touchObjectForKey:(NSString *)key userId:(PPUserId)userId {
+    NSString *userKey = [self userKey:userId];
+    [_lock lock];
+    if([[self recordsForUserKey:userKey] objectForKey:key]) {
+        [self queueRecordForKey:key userKey:userKey];
+    }
+    [_lock unlock];
+}
+
+- (void)removeObjectForKey:(NSString *)key userId:(PPUserId)userId {
+    NSString *userKey = [self userKey:userId];
+    [_lock lock];
+    NSMutableDictionary *records = [self recordsForUserKey:userKey];
+    if([records objectForKey:key]) {
+        [records removeObjectForKey:key];
+        [[_sequences objectForKey:userKey] removeObjectForKey:key];
+        [self pendingForUserKey:userKey][key] = [NSNull null];
+        [self scheduleFlush];
+    }
+    [_lock unlock];
+}
+
+- (void)removeAllObjectsForUser:(PPUserId)userId {
+    NSString *userKey = [self userKey:userId];
+    [_lock lock];
+    [_users setObject:[[NSMutableDictionary alloc] initWithCapacity:0] forKey:userKey];
+    [_sequences setObject:[[NSMutableDictionary alloc] initWithCapacity:0] forKey:userKey];
+    [_pending removeObjectForKey:userKey];
+    [_clearedUsers addObject:userKey];
+    [self scheduleFlush];
+    [_lock unlock];
+}
+
+#pragma mark - Flush
+
+/**
+ * Must be called while holding the lock
+ */
+- (NSMutableDictionary *)pendingForUserKey:(NSString *)userKey {
+    NSMutableDictionary *pending = [_pending objectForKey:userKey];
+    if(!pending) {
+        pending = [[NSMutableDictionary alloc] initWithCapacity:0];
+        [_pending setObject:pending forKey:userKey];
+    }
+    return pending;
+}
+
+/**
+ * Archive a record as it is now, so later changes made in place aren't written halfway.
+ * Must be called while holding the lock.
+ */
+- (void)queueRecordForKey:(NSString *)key userKey:(NSString *)userKey {
+    id object = [[_users objectForKey:userKey] objectForKey:key];
+    NSNumber *sequence = [[_sequences objectForKey:userKey] objectForKey:key];
+    
+    NSError *error;
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:@{kRecordKeyKey: key, kRecordObjectKey: object, kRecordSequenceKey: sequence} requiringSecureCoding:NO error:&error];
+    if(!data) {
+        NSLog(@"%s Unable to archive %@: %@", __PRETTY_FUNCTION__, key, error);
+        return;
+    }
+    [self pendingForUserKey:userKey][key] = data;
+    [self scheduleFlush];
+}
+
+/**
+ * Must be called while holding the lock
+ */
+- (void)scheduleFlush {
+    if(_flushScheduled) {
+        return;
+    }
+    _flushScheduled = YES;
+    
+    __weak PPModelStore *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.flushInterval * NSEC_PER_SEC)), _diskQueue, ^{
+        [weakSelf writePending];
+    });
+}
+
+- (void)flush {
+    dispatch_sync(_diskQueue, ^{
+        [self writePending];
+    });
+}
+
+/**
+ * Runs on the disk queue
+ */
+- (void)writePending {
+    [_lock lock];
+    NSDictionary *pending = _pending;
+    NSSet *clearedUsers = _clearedUsers;
+    self.pending = [[NSMutableDictionary alloc] initWithCapacity:0];
+    self.clearedUsers = [[NSMutableSet alloc] initWithCapacity:0];
+    _flushScheduled = NO;
+    [_lock unlock];
+    
+    if(pending.count == 0 && clearedUsers.count == 0) {
+        return;
+    }
+    
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if(pending.count > 0) {
+        // Records are downloaded again after a restore, so they stay out of backups
+        [fileManager createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        [_directoryURL setResourceValue:@YES forKey:NSURLIsExcludedFromBackupKey error:nil];
+    }
+    NSUInteger recordsWritten = 0;
+    NSUInteger recordsRemoved = 0;
+    unsigned long long bytesWritten = 0;
+    
+    for(NSString *userKey in clearedUsers) {
+        NSArray *files = [fileManager contentsOfDirectoryAtURL:[self userDirectoryURL:userKey] includingPropertiesForKeys:nil options:0 error:nil];
+        if([fileManager removeItemAtURL:[self userDirectoryURL:userKey] error:nil]) {
+            recordsRemoved += files.count;
+        }
+    }
+    
+    for(NSString *userKey in pending) {
+        [fileManager createDirectoryAtURL:[self userDirectoryURL:userKey] withIntermediateDirectories:YES attributes:nil error:nil];
+        NSDictionary *changes = [pending objectForKey:userKey];
+        for(NSString *key in changes) {
+            NSData *data = [changes objectForKey:key];
+            NSURL *recordURL = [self recordURLForKey:key userKey:userKey];
+            if((id)data == [NSNull null]) {
+                if([fileManager removeItemAtURL:recordURL error:nil]) {
+                    recordsRemoved++;
+                }
+                continue;
+            }
+            if([data writeToURL:recordURL atomically:YES]) {
+                recordsWritten++;
+                bytesWritten += data.length;
+            }
+        }
+    }
+    
+    [_lock lock];
+    self.flushes++;
+    self.recordsWritten += recordsWritten;
+    self.recordsRemoved += recordsRemoved;
+    self.bytesWritten += bytesWritten;
+    [_lock unlock];
+}
+
+#pragma mark - Statistics
+
+- (void)resetStatistics {
+    [_lock lock];
+    self.flushes = 0;
+    self.recordsWritten = 0;
+    self.recordsRemoved = 0;
+    self.bytesWritten = 0;
+    [_lock unlock];
+}
+
+@end
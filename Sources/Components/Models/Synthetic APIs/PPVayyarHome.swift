@@ -36,8 +36,8 @@ import Foundation
                                           callback: @escaping (([PPVayyarRoom]?, Error?) -> (Void))) {
         let stateName = "vayyar_room"
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.synthetic.vayyarHome.getRoomBoundaries()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         PPUserAccounts.getState(locationId, name: stateName) { stateData, error in
             queue.async {
                 guard error == nil,
@@ -56,7 +56,7 @@ import Foundation
                     rooms.append(PPVayyarRoom.initWithDeviceId(deviceId, data: data))
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(rooms, nil)
@@ -101,8 +101,8 @@ import Foundation
                                           callback: @escaping (([PPVayyarSubregion]?, Error?) -> (Void))) {
         let stateName = "vayyar_subregions"
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.synthetic.vayyarHome.getSubregions()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         PPUserAccounts.getState(locationId, name: stateName) { stateData, error in
             queue.async {
                 guard error == nil,
@@ -125,7 +125,7 @@ import Foundation
                     }
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(subregions, nil)
@@ -171,8 +171,8 @@ import Foundation
                                                    callback: @escaping (([PPVayyarSubregionBehavior]?, Error?) -> (Void))) {
         let stateName = "vayyar_subregion_behaviors"
         
-        let queue = DispatchQueue(label: "com.peoplepowerco.lib.Peoplepower.synthetic.vayyarHome.getSubregionBehaviors()")
-        PPLogAPIs(#file, message: "> \(queue.label)")
+        let queue = PPBaseModel.responseQueue(.interactive)
+        PPLogAPIs(#file, message: "> \(#function)")
         PPUserAccounts.getState(locationId, name: stateName) { stateData, error in
             queue.async {
                 guard error == nil,
@@ -187,7 +187,7 @@ import Foundation
                     behaviors.append(PPVayyarSubregionBehavior.initWithData(data))
                 }
                 
-                PPLogAPIs(#file, message: "< \(queue.label)")
+                PPLogAPIs(#file, message: "< \(#function)")
                 
                 DispatchQueue.main.async {
                     callback(behaviors, nil)
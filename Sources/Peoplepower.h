@@ -32,6 +32,7 @@ FOUNDATION_EXPORT const unsigned char PeoplepowerVersionString[];
 #pragma mark - Models -
 
 #import <Peoplepower/PPBaseModel.h>
+#import <Peoplepower/PPModelStore.h>
 
 #pragma mark Cloud Connectivity
 
@@ -53,6 +54,9 @@ FOUNDATION_EXPORT const unsigned char PeoplepowerVersionString[];
 #import <Peoplepower/PPDevices.h>
 #if !TARGET_OS_WATCH
 #import <Peoplepower/PPDeviceProxy.h>
+#import <Peoplepower/PPDeviceProxyQueue.h>
+#import <Peoplepower/PPDeviceProxyPendingQueue.h>
+#import <Peoplepower/PPDeviceProxyFileUpload.h>
 #endif
 #pragma mark Device Measurements
 
@@ -149,6 +153,9 @@ FOUNDATION_EXPORT const unsigned char PeoplepowerVersionString[];
 #import <AFNetworking/AFURLResponseSerialization.h>
 #import <Peoplepower/PPUrl.h>
 #import <Peoplepower/PPCloudEngine.h>
+#import <Peoplepower/PPHTTPCache.h>
+#import <Peoplepower/PPRetryPolicy.h>
+#import <Peoplepower/PPHTTPMetrics.h>
 #import <Peoplepower/PPVersion.h>
 
 #pragma mark - Synthetic
@@ -8,6 +8,7 @@
 
 #import <XCTest/XCTest.h>
 #import <Peoplepower/PPBaseModel.h>
+#import <Peoplepower/PPDeviceMeasurementsReading.h>
 
 @interface PPTCBaseModel : XCTestCase
 
@@ -81,4 +82,183 @@
     }
 }
 
+#pragma mark - Response queues
+
+static NSInteger const kResponseQueueBenchmarkRequests = 500;
+
+- (void)testResponseQueueLanes {
+    dispatch_queue_t interactive = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
+    dispatch_queue_t background = [PPBaseModel responseQueue:PPBaseModelResponseLaneBackground];
+    dispatch_queue_t bulk = [PPBaseModel responseQueue:PPBaseModelResponseLaneBulk];
+    XCTAssertNotNil(interactive);
+    XCTAssertNotNil(background);
+    XCTAssertNotNil(bulk);
+
+    // Lanes are bounded pools, not per-call queues
+    NSMutableSet *queues = [NSMutableSet set];
+    for(NSInteger i = 0; i < 100; i++) {
+        [queues addObject:[PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive]];
+    }
+    XCTAssertLessThanOrEqual(queues.count, 8);
+
+    // Bulk responses such as history windows parse side by side
+    NSMutableSet *bulkQueues = [NSMutableSet setWithObject:bulk];
+    for(NSInteger i = 0; i < 100; i++) {
+        [bulkQueues addObject:[PPBaseModel responseQueue:PPBaseModelResponseLaneBulk]];
+    }
+    XCTAssertGreaterThanOrEqual(bulkQueues.count, 2);
+    XCTAssertLessThanOrEqual(bulkQueues.count, 8);
+}
+
+/**
+ * Baseline: one serial queue per request, as the model APIs used to do.
+ */
+- (void)testPerformanceResponseQueuePerRequest {
+    NSData *responseData = [@"{\"resultCode\": 0, \"devices\": [{\"id\": \"device\", \"parameters\": []}]}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    [self measureBlock:^{
+        XCTestExpectation *expectation = [self expectationWithDescription:@"callbacks"];
+        expectation.expectedFulfillmentCount = kResponseQueueBenchmarkRequests;
+        for(NSInteger i = 0; i < kResponseQueueBenchmarkRequests; i++) {
+            dispatch_queue_t queue = dispatch_queue_create("com.peoplepowerco.lib.Peoplepower.tests.responseQueuePerRequest()", DISPATCH_QUEUE_SERIAL);
+            dispatch_async(queue, ^{
+                NSError *error = nil;
+                [PPBaseModel processJSONResponse:responseData error:&error];
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    [expectation fulfill];
+                });
+            });
+        }
+        [self waitForExpectationsWithTimeout:30 handler:nil];
+    }];
+}
+
+/**
+ * Shared interactive lane, as the model APIs do now.
+ */
+- (void)testPerformanceResponseQueueShared {
+    NSData *responseData = [@"{\"resultCode\": 0, \"devices\": [{\"id\": \"device\", \"parameters\": []}]}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    [self measureBlock:^{
+        XCTestExpectation *expectation = [self expectationWithDescription:@"callbacks"];
+        expectation.expectedFulfillmentCount = kResponseQueueBenchmarkRequests;
+        for(NSInteger i = 0; i < kResponseQueueBenchmarkRequests; i++) {
+            dispatch_queue_t queue = [PPBaseModel responseQueue:PPBaseModelResponseLaneInteractive];
+            dispatch_async(queue, ^{
+                NSError *error = nil;
+                [PPBaseModel processJSONResponse:responseData error:&error];
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    [expectation fulfill];
+                });
+            });
+        }
+        [self waitForExpectationsWithTimeout:30 handler:nil];
+    }];
+}
+
+#pragma mark - Streaming
+
+static NSInteger const kStreamingBenchmarkReadings = 20000;
+
+- (NSData *)historyResponseWithReadings:(NSInteger)count {
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:@"DeviceMeasurements-GetHistoryOfMeasurements-ResponseData" ofType:@"json"];
+    NSDictionary *fixture = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+    NSArray *readings = fixture[@"readings"];
+    NSMutableArray *scaled = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        [scaled addObject:readings[i % readings.count]];
+    }
+    return [NSJSONSerialization dataWithJSONObject:@{@"resultCode": @0, @"readings": scaled} options:0 error:nil];
+}
+
+- (void)testStreamingJSONResponse {
+    NSString *response = @"{\"readings\": [{\"deviceId\": \"a\", \"params\": [{\"name\": \"x]\", \"value\": \"}\\\"\"}]}, {\"deviceId\": \"b\"}], \"resultCode\": 0, \"tempKey\": \"key\"}";
+    NSMutableArray *elements = @[].mutableCopy;
+    NSError *error;
+    NSDictionary *root = [PPBaseModel processJSONResponse:[response dataUsingEncoding:NSUTF8StringEncoding] originatingClass:nil streamingKey:@"readings" element:^(id element) {
+        [elements addObject:element];
+    } error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(root[@"tempKey"], @"key");
+    XCTAssertNil(root[@"readings"]);
+    XCTAssertEqual(elements.count, 2);
+    XCTAssertEqualObjects(elements[0][@"params"][0][@"value"], @"}\"");
+    XCTAssertEqualObjects(elements[1][@"deviceId"], @"b");
+    
+    // resultCode is checked before any element is built, even when it trails the array
+    NSString *errorResponse = @"{\"readings\": [{\"deviceId\": \"a\"}], \"resultCode\": 7}";
+    [elements removeAllObjects];
+    root = [PPBaseModel processJSONResponse:[errorResponse dataUsingEncoding:NSUTF8StringEncoding] originatingClass:nil streamingKey:@"readings" element:^(id element) {
+        [elements addObject:element];
+    } error:&error];
+    XCTAssertNil(root);
+    XCTAssertNotNil(error);
+    XCTAssertEqual(elements.count, 0);
+    
+    // A streamingKey that is not an array is left out of root and streams nothing
+    NSString *nullResponse = @"{\"readings\": null, \"resultCode\": 0}";
+    root = [PPBaseModel processJSONResponse:[nullResponse dataUsingEncoding:NSUTF8StringEncoding] originatingClass:nil streamingKey:@"readings" element:^(id element) {
+        [elements addObject:element];
+    } error:&error];
+    XCTAssertNotNil(root);
+    XCTAssertNil(root[@"readings"]);
+    XCTAssertEqual(elements.count, 0);
+    
+    // Both paths agree on fixture data
+    NSData *responseData = [self historyResponseWithReadings:100];
+    NSDictionary *full = [PPBaseModel processJSONResponse:responseData error:&error];
+    [elements removeAllObjects];
+    [PPBaseModel processJSONResponse:responseData originatingClass:nil streamingKey:@"readings" element:^(id element) {
+        [elements addObject:element];
+    } error:&error];
+    XCTAssertEqualObjects(full[@"readings"], elements);
+}
+
+- (void)testTimeToFirstObject {
+    NSData *responseData = [self historyResponseWithReadings:kStreamingBenchmarkReadings];
+    
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    NSError *error;
+    NSDictionary *root = [PPBaseModel processJSONResponse:responseData error:&error];
+    [PPDeviceMeasurementsReading initWithDictionary:[root[@"readings"] firstObject]];
+    CFAbsoluteTime fullFirstObject = CFAbsoluteTimeGetCurrent() - start;
+    
+    start = CFAbsoluteTimeGetCurrent();
+    __block CFAbsoluteTime streamingFirstObject = 0;
+    [PPBaseModel processJSONResponse:responseData originatingClass:nil streamingKey:@"readings" element:^(id element) {
+        [PPDeviceMeasurementsReading initWithDictionary:element];
+        if(streamingFirstObject == 0) {
+            streamingFirstObject = CFAbsoluteTimeGetCurrent() - start;
+        }
+    } error:&error];
+    
+    NSLog(@"%s time to first object: full=%.2fms streaming=%.2fms", __PRETTY_FUNCTION__, fullFirstObject * 1000, streamingFirstObject * 1000);
+    XCTAssertGreaterThan(streamingFirstObject, 0);
+}
+
+- (void)testPerformanceJSONResponseFull {
+    NSData *responseData = [self historyResponseWithReadings:kStreamingBenchmarkReadings];
+    
+    [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:^{
+        NSError *error;
+        NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:0];
+        NSDictionary *root = [PPBaseModel processJSONResponse:responseData error:&error];
+        for(NSDictionary *readingDict in root[@"readings"]) {
+            [readings addObject:[PPDeviceMeasurementsReading initWithDictionary:readingDict]];
+        }
+    }];
+}
+
+- (void)testPerformanceJSONResponseStreaming {
+    NSData *responseData = [self historyResponseWithReadings:kStreamingBenchmarkReadings];
+    
+    [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:^{
+        NSError *error;
+        NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:0];
+        [PPBaseModel processJSONResponse:responseData originatingClass:nil streamingKey:@"readings" element:^(id readingDict) {
+            [readings addObject:[PPDeviceMeasurementsReading initWithDictionary:readingDict]];
+        } error:&error];
+    }];
+}
+
 @end
@@ -17,6 +17,7 @@
 #import <Peoplepower/PPSMSSubscriber.h>
 #import <Peoplepower/PPQuestions.h>
 #import <Peoplepower/PPNotifications.h>
+#import <Peoplepower/PPModelStore.h>
 #import <Peoplepower/PPCrowdFeedbacks.h>
 #import <Peoplepower/PPInAppMessaging.h>
 #import <Peoplepower/PPSMSGroupTexting.h>
@@ -757,4 +758,129 @@ static NSString *moduleName = @"UserCommunications";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+#pragma mark - Model store
+
+- (NSURL *)temporaryStoreDirectoryURL {
+    NSURL *directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString] isDirectory:YES];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:directoryURL error:nil];
+    }];
+    return directoryURL;
+}
+
+- (PPNotificationSubscription *)subscriptionWithType:(PPNotificationSubscriptionType)type {
+    return [[PPNotificationSubscription alloc] initWithType:type name:[NSString stringWithFormat:@"subscription-%li", (long)type] email:PPNotificationSubscriptionEmailEnabledTrue push:PPNotificationSubscriptionPushEnabledTrue sms:PPNotificationSubscriptionSMSEnabledFalse emailPeriod:PPNotificationSubscriptionEmailPeriodAllTheTime pushPeriod:PPNotificationSubscriptionPushPeriodAllTheTime smsPeriod:PPNotificationSubscriptionSMSPeriodAllTheTime];
+}
+
+- (void)testModelStore {
+    NSURL *directoryURL = [self temporaryStoreDirectoryURL];
+    PPModelStore *store = [[PPModelStore alloc] initWithName:@"test" directoryURL:directoryURL];
+    [store setObject:[self subscriptionWithType:1] forKey:@"a" userId:1];
+    [store setObject:[self subscriptionWithType:2] forKey:@"b" userId:1];
+    [store setObject:[self subscriptionWithType:3] forKey:@"a" userId:2];
+    [store setObject:[self subscriptionWithType:4] forKey:@"b" userId:1];
+    XCTAssertEqual(((PPNotificationSubscription *)[store objectForKey:@"b" userId:1]).type, 4);
+    
+    // Changes are batched, the replaced record is written once
+    [store flush];
+    XCTAssertEqual(store.flushes, 1);
+    XCTAssertEqual(store.recordsWritten, 3);
+    XCTAssertGreaterThan(store.bytesWritten, 0);
+    
+    // Records stay out of backups
+    NSNumber *excludedFromBackup = nil;
+    [[NSURL fileURLWithPath:directoryURL.path isDirectory:YES] getResourceValue:&excludedFromBackup forKey:NSURLIsExcludedFromBackupKey error:nil];
+    XCTAssertTrue(excludedFromBackup.boolValue);
+    
+    // Records are read back from disk on first access
+    PPModelStore *reopened = [[PPModelStore alloc] initWithName:@"test" directoryURL:directoryURL];
+    XCTAssertEqual([reopened objectsForUser:1].count, 2);
+    XCTAssertEqual(((PPNotificationSubscription *)[reopened objectForKey:@"a" userId:2]).type, 3);
+    XCTAssertEqualObjects(((PPNotificationSubscription *)[reopened objectForKey:@"b" userId:1]).name, @"subscription-4");
+    
+    [store removeObjectForKey:@"a" userId:1];
+    [store removeAllObjectsForUser:2];
+    XCTAssertNil([store objectForKey:@"a" userId:1]);
+    XCTAssertEqual([store objectsForUser:2].count, 0);
+    [store flush];
+    XCTAssertEqual(store.recordsRemoved, 2);
+    reopened = [[PPModelStore alloc] initWithName:@"test" directoryURL:directoryURL];
+    XCTAssertEqualObjects([reopened objectsForUser:1].allKeys, @[@"b"]);
+    XCTAssertEqual([reopened objectsForUser:2].count, 0);
+    
+    // Records keep the order they were first set in, and are written as they were when set
+    PPNotificationSubscription *subscription = [self subscriptionWithType:10];
+    [store setObject:subscription forKey:@"type.10" userId:3];
+    [store setObject:[self subscriptionWithType:2] forKey:@"type.2" userId:3];
+    subscription.name = @"changed";
+    [store flush];
+    reopened = [[PPModelStore alloc] initWithName:@"test" directoryURL:directoryURL];
+    NSArray *ordered = [reopened orderedObjectsForUser:3];
+    XCTAssertEqual(ordered.count, 2);
+    XCTAssertEqual(((PPNotificationSubscription *)ordered.firstObject).type, 10);
+    XCTAssertEqualObjects(((PPNotificationSubscription *)ordered.firstObject).name, @"subscription-10");
+}
+
+/**
+ * Bytes written while subscriptions are added one at a time,
+ * compared with archiving every user's subscriptions into NSUserDefaults on every change.
+ */
+- (void)testModelStoreWriteAmplification {
+    NSInteger const users = 10;
+    NSInteger const subscriptionsPerUser = 50;
+    PPModelStore *store = [[PPModelStore alloc] initWithName:@"test" directoryURL:[self temporaryStoreDirectoryURL]];
+    NSMutableDictionary *archivedSubscriptions = [[NSMutableDictionary alloc] initWithCapacity:0];
+    unsigned long long archiveBytesWritten = 0;
+    
+    for(NSInteger i = 0; i < subscriptionsPerUser; i++) {
+        for(PPUserId userId = 1; userId <= users; userId++) {
+            PPNotificationSubscription *subscription = [self subscriptionWithType:(PPNotificationSubscriptionType)(i + 1)];
+            
+            NSString *userIdKey = [NSString stringWithFormat:@"%li", (long)userId];
+            NSMutableArray *subscriptions = [archivedSubscriptions objectForKey:userIdKey] ?: [[NSMutableArray alloc] initWithCapacity:0];
+            [subscriptions addObject:subscription];
+            [archivedSubscriptions setObject:subscriptions forKey:userIdKey];
+            archiveBytesWritten += [NSKeyedArchiver archivedDataWithRootObject:archivedSubscriptions requiringSecureCoding:NO error:nil].length;
+            
+            [store setObject:subscription forKey:[NSString stringWithFormat:@"type.%li", (long)subscription.type] userId:userId];
+            
+            // One flush per change is the worst case for the store
+            [store flush];
+        }
+    }
+    
+    NSLog(@"%s archive=%llu bytes store=%llu bytes in %lu records, %.1fx less", __PRETTY_FUNCTION__, archiveBytesWritten, store.bytesWritten, (unsigned long)store.recordsWritten, (double)archiveBytesWritten / (double)store.bytesWritten);
+    XCTAssertEqual(store.recordsWritten, users * subscriptionsPerUser);
+    XCTAssertLessThan(store.bytesWritten * 10, archiveBytesWritten);
+}
+
+- (void)testSharedSubscriptions {
+    PPUserId userId = 987654321;
+    [[PPModelStore sharedStoreNamed:@"notificationSubscriptions"] removeAllObjectsForUser:userId];
+    
+    [PPNotifications addSubscriptions:@[[self subscriptionWithType:10], [self subscriptionWithType:2]] userId:userId];
+    XCTAssertEqual([PPNotifications sharedSubscriptionsForUser:userId].count, 2);
+    XCTAssertEqual(((PPNotificationSubscription *)[PPNotifications sharedSubscriptionsForUser:userId].firstObject).type, 10);
+    
+    // Existing subscriptions are synced in place
+    PPNotificationSubscription *update = [self subscriptionWithType:2];
+    update.push = PPNotificationSubscriptionPushEnabledFalse;
+    [PPNotifications addSubscriptions:@[update] userId:userId];
+    NSArray *subscriptions = [PPNotifications sharedSubscriptionsForUser:userId];
+    XCTAssertEqual(subscriptions.count, 2);
+    XCTAssertEqual(((PPNotificationSubscription *)subscriptions.lastObject).push, PPNotificationSubscriptionPushEnabledFalse);
+    
+    [PPNotifications removeSubscriptions:@[[self subscriptionWithType:10]] userId:userId];
+    XCTAssertEqual([PPNotifications sharedSubscriptionsForUser:userId].count, 1);
+    
+    PPNotificationToken *token = [[PPNotificationToken alloc] initWithToken:@"token" badges:PPNotificationSubscriptionSupportsBadgeIconsTrue];
+    [PPNotifications addNotificationToken:token userId:userId];
+    XCTAssertEqualObjects([PPNotifications sharedTokenForUser:userId].token, @"token");
+    [PPNotifications removeNotificaitonToken:token userId:userId];
+    XCTAssertNil([PPNotifications sharedTokenForUser:userId]);
+    
+    [[PPModelStore sharedStoreNamed:@"notificationSubscriptions"] removeAllObjectsForUser:userId];
+    [[PPModelStore sharedStoreNamed:@"notificationSubscriptions"] flush];
+}
+
 @end
@@ -9,6 +9,7 @@
 #import "PPBaseTestCase.h"
 #import <Peoplepower/PPBaseModel.h>
 #import <Peoplepower/PPDateUtilities.h>
+#import <Peoplepower/PPNSDate.h>
 
 @interface PPTCDateUtilities : PPBaseTestCase
 
@@ -278,4 +279,137 @@
     XCTAssertTrue(delta == 1);
 }
 
+#pragma mark - API dates
+
+static NSInteger const kDateBenchmarkRepeats = 50;
+
+/**
+ * Every date string in the device and measurement response fixtures
+ */
+- (NSArray *)fixtureDateStrings {
+    NSMutableArray *dateStrings = [[NSMutableArray alloc] initWithCapacity:0];
+    NSRegularExpression *expression = [NSRegularExpression regularExpressionWithPattern:@"^\\d{4}-\\d{2}-\\d{2}T" options:0 error:nil];
+    for(NSString *fixture in @[@"Devices-GetListOfDevices-ResponseData", @"Devices-GetDeviceById-ResponseData", @"DeviceMeasurements-GetHistoryOfMeasurements-ResponseData", @"DeviceMeasurements-GetCurrentMeasurements-ResponseData"]) {
+        NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:fixture ofType:@"json"];
+        NSMutableArray *objects = [[NSMutableArray alloc] initWithObjects:[NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil], nil];
+        while(objects.count) {
+            id object = objects.lastObject;
+            [objects removeLastObject];
+            if([object isKindOfClass:[NSDictionary class]]) {
+                [objects addObjectsFromArray:[object allValues]];
+            }
+            else if([object isKindOfClass:[NSArray class]]) {
+                [objects addObjectsFromArray:object];
+            }
+            else if([object isKindOfClass:[NSString class]] && [expression numberOfMatchesInString:object options:0 range:NSMakeRange(0, [object length])]) {
+                [dateStrings addObject:object];
+            }
+        }
+    }
+    return dateStrings;
+}
+
+/**
+ * Baseline: parseDateTime: as it was, with new formatters for every string.
+ */
+- (NSDate *)formatterParseDateTime:(NSString *)dateString {
+    NSDate *date = [[[NSISO8601DateFormatter alloc] init] dateFromString:dateString];
+    if (date == nil) {
+        NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
+        [dateFormatter setLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"]];
+        dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ";
+        date = [dateFormatter dateFromString:dateString];
+    }
+    return date;
+}
+
+/**
+ * Baseline: apiFriendStringFromDate: as it was, with a new formatter for every date.
+ */
+- (NSString *)formatterApiFriendStringFromDate:(NSDate *)date {
+    NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
+    [dateFormatter setLocale:[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"]];
+    dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZZZZZ";
+    return [dateFormatter stringFromDate:date];
+}
+
+- (void)testParseDateTime {
+    NSArray *dateStrings = [[self fixtureDateStrings] arrayByAddingObjectsFromArray:@[@"2023-11-14T22:13:20Z",
+                                                                                      @"2023-11-14T22:13:20.123-08:00",
+                                                                                      @"2024-02-29T23:59:59+05:30",
+                                                                                      @"2018-10-01T03:05:07",
+                                                                                      @"2023-02-29T00:00:00Z",
+                                                                                      @"not a date"]];
+    XCTAssertGreaterThan(dateStrings.count, 6);
+    for(NSString *dateString in dateStrings) {
+        NSDate *expected = [self formatterParseDateTime:dateString];
+        NSDate *date = [PPNSDate parseDateTime:dateString];
+        if(expected) {
+            XCTAssertEqualWithAccuracy(date.timeIntervalSince1970, expected.timeIntervalSince1970, 0.001, @"%@", dateString);
+        }
+        else {
+            XCTAssertNil(date, @"%@", dateString);
+        }
+    }
+    XCTAssertEqual([PPNSDate parseDateTime:@"1970-01-01T00:00:00Z"].timeIntervalSince1970, 0);
+    XCTAssertNil([PPNSDate parseDateTime:nil]);
+}
+
+- (void)testApiFriendStringFromDate {
+    NSTimeZone *defaultTimeZone = [NSTimeZone defaultTimeZone];
+    for(NSString *name in @[@"UTC", @"America/Los_Angeles", @"Asia/Kolkata", @"Australia/Lord_Howe"]) {
+        [NSTimeZone setDefaultTimeZone:[NSTimeZone timeZoneWithName:name]];
+        for(NSTimeInterval timeInterval = 0; timeInterval < 2000000000; timeInterval += 12345678.9) {
+            NSDate *date = [NSDate dateWithTimeIntervalSince1970:timeInterval];
+            XCTAssertEqualObjects([PPNSDate apiFriendStringFromDate:date], [self formatterApiFriendStringFromDate:date], @"%@", name);
+            XCTAssertEqualWithAccuracy([PPNSDate parseDateTime:[PPNSDate apiFriendStringFromDate:date]].timeIntervalSince1970, floor(timeInterval), 0.001);
+        }
+    }
+    [NSTimeZone setDefaultTimeZone:defaultTimeZone];
+}
+
+- (void)testPerformanceParseDateTime {
+    NSArray *dateStrings = [self fixtureDateStrings];
+    [self measureBlock:^{
+        for(NSInteger i = 0; i < kDateBenchmarkRepeats; i++) {
+            for(NSString *dateString in dateStrings) {
+                [PPNSDate parseDateTime:dateString];
+            }
+        }
+    }];
+}
+
+- (void)testPerformanceParseDateTimeFormatters {
+    NSArray *dateStrings = [self fixtureDateStrings];
+    [self measureBlock:^{
+        for(NSInteger i = 0; i < kDateBenchmarkRepeats; i++) {
+            for(NSString *dateString in dateStrings) {
+                [self formatterParseDateTime:dateString];
+            }
+        }
+    }];
+}
+
+- (void)testPerformanceApiFriendStringFromDate {
+    NSArray *dateStrings = [self fixtureDateStrings];
+    [self measureBlock:^{
+        for(NSInteger i = 0; i < kDateBenchmarkRepeats; i++) {
+            for(NSString *dateString in dateStrings) {
+                [PPNSDate apiFriendStringFromDate:[NSDate dateWithTimeIntervalSince1970:dateString.hash % 2000000000]];
+            }
+        }
+    }];
+}
+
+- (void)testPerformanceApiFriendStringFromDateFormatters {
+    NSArray *dateStrings = [self fixtureDateStrings];
+    [self measureBlock:^{
+        for(NSInteger i = 0; i < kDateBenchmarkRepeats; i++) {
+            for(NSString *dateString in dateStrings) {
+                [self formatterApiFriendStringFromDate:[NSDate dateWithTimeIntervalSince1970:dateString.hash % 2000000000]];
+            }
+        }
+    }];
+}
+
 @end
@@ -9,6 +9,9 @@
 #import "PPBaseTestCase.h"
 #import <Peoplepower/PPDevice.h>
 #import <Peoplepower/PPNSDate.h>
+#if !TARGET_OS_WATCH
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#endif
 
 static NSString *moduleName = @"DeviceMeasurements";
 
@@ -178,6 +181,85 @@ static NSString *moduleName = @"DeviceMeasurements";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+/**
+ * Get current measurements for multiple devices with one location-wide request
+ **/
+- (void)testGetCurrentMeasurementsForDevices {
+    NSString *methodName = @"GetMeasurementsWithSearchTerms";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/parameters" statusCode:200 headers:nil];
+    
+    NSArray *deviceIds = @[@"ea5101a8005f-10031-470", @"_TEST_NO_PARAMETERS_"];
+    __block NSInteger progressCount = 0;
+    [PPDeviceMeasurements getCurrentMeasurementsForDevices:deviceIds locationId:self.device.locationId userId:PPUserIdNone paramNames:self.parameterNames shared:PPDeviceSharedNone maxConcurrentRequests:PPDeviceMeasurementsMaxConcurrentRequestsNone progress:^(NSString * _Nonnull deviceId, NSArray * _Nullable measurements, NSError * _Nullable error) {
+        XCTAssertNil(error);
+        progressCount++;
+    } callback:^(NSDictionary * _Nonnull measurements, NSDictionary * _Nonnull errors) {
+        
+        XCTAssertEqual(errors.count, 0);
+        XCTAssertEqual(measurements.count, deviceIds.count);
+        XCTAssertEqual([measurements[@"ea5101a8005f-10031-470"] count], 1);
+        XCTAssertEqual([measurements[@"_TEST_NO_PARAMETERS_"] count], 0);
+        XCTAssertEqual(progressCount, deviceIds.count);
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
+/**
+ * Get current measurements for multiple devices per device when the location-wide request fails
+ **/
+- (void)testGetCurrentMeasurementsForDevicesFanOut {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetCurrentMeasurements";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/parameters" statusCode:500 headers:nil];
+    
+    NSInteger maxConcurrentRequests = 2;
+    __block NSInteger inFlight = 0;
+    __block NSInteger maxInFlight = 0;
+    NSLock *lock = [[NSLock alloc] init];
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:[NSString stringWithFormat:@"%@-%@-ResponseData", moduleName, methodName] ofType:@"json"];
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path hasSuffix:@"/parameters"] && [request.URL.path containsString:@"/cloud/json/devices/"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        [lock lock];
+        inFlight++;
+        maxInFlight = MAX(maxInFlight, inFlight);
+        [lock unlock];
+        
+        if([request.URL.path containsString:@"_TEST_FAILURE_"]) {
+            return [HTTPStubsResponse responseWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil]];
+        }
+        return [[HTTPStubsResponse responseWithFileAtPath:path statusCode:200 headers:nil] requestTime:0.1 responseTime:0];
+    }];
+    
+    NSMutableArray *deviceIds = @[@"_TEST_FAILURE_"].mutableCopy;
+    for(NSInteger i = 0; i < 6; i++) {
+        [deviceIds addObject:[NSString stringWithFormat:@"_TEST_%ld_", (long)i]];
+    }
+    [PPDeviceMeasurements getCurrentMeasurementsForDevices:deviceIds locationId:self.device.locationId userId:PPUserIdNone paramNames:nil shared:PPDeviceSharedNone maxConcurrentRequests:maxConcurrentRequests progress:^(NSString * _Nonnull deviceId, NSArray * _Nullable measurements, NSError * _Nullable error) {
+        [lock lock];
+        inFlight--;
+        [lock unlock];
+    } callback:^(NSDictionary * _Nonnull measurements, NSDictionary * _Nonnull errors) {
+        
+        XCTAssertEqual(measurements.count, deviceIds.count - 1);
+        XCTAssertEqual(errors.count, 1);
+        XCTAssertNotNil(errors[@"_TEST_FAILURE_"]);
+        XCTAssertLessThanOrEqual(maxInFlight, maxConcurrentRequests);
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+#endif
+}
+
 /**
 * Send Set Commands
 * This API allows to send commands to multiple devices simultaneously.
@@ -237,6 +319,173 @@ static NSString *moduleName = @"DeviceMeasurements";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+/**
+ * Get History of Measurements in time windows, delivered in time order
+ **/
+- (void)testGetHistoryOfMeasurementsInWindows {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetHistoryOfMeasurementsInWindows";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    // Two readings per window, newest first and with varying latency, so windows complete out of order
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path containsString:@"/parametersByDate/"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        NSDate *windowStartDate = [PPNSDate parseDateTime:request.URL.lastPathComponent];
+        NSMutableArray *readings = @[].mutableCopy;
+        for(NSInteger i = 1; i >= 0; i--) {
+            [readings addObject:@{@"deviceId": self.device.deviceId, @"timeStamp": [PPNSDate apiFriendStringFromDate:[windowStartDate dateByAddingTimeInterval:i * 60 * 60]], @"params": @[@{@"name": @"power", @"value": @"1"}]}];
+        }
+        return [[HTTPStubsResponse responseWithJSONObject:@{@"resultCode": @0, @"readings": readings} statusCode:200 headers:nil] requestTime:(arc4random_uniform(20) / 100.0) responseTime:0];
+    }];
+    
+    NSDate *startDate = [NSDate dateWithTimeIntervalSince1970:1600000000];
+    NSDate *endDate = [startDate dateByAddingTimeInterval:6 * 24 * 60 * 60];
+    NSMutableArray *allReadings = @[].mutableCopy;
+    [PPDeviceMeasurements getHistoryOfMeasurements:self.device.deviceId startDate:startDate endDate:endDate locationId:self.device.locationId userId:PPUserIdNone paramNames:nil index:nil interval:PPDeviceMeasurementsHistoryIntervalNone aggregation:PPDeviceMeasurementsHistoryAggregationNone reduceNoise:PPDeviceMeasurementsHistoryReduceNoiseNone windowInterval:24 * 60 * 60 maxConcurrentRequests:2 readings:^(NSArray * _Nullable readings, NSError * _Nullable error) {
+        [allReadings addObjectsFromArray:readings];
+    } callback:^(NSError * _Nullable error) {
+        
+        XCTAssertNil(error);
+        XCTAssertEqual(allReadings.count, 12);
+        for(NSInteger i = 1; i < allReadings.count; i++) {
+            XCTAssertEqual([((PPDeviceMeasurementsReading *)allReadings[i - 1]).timeStamp compare:((PPDeviceMeasurementsReading *)allReadings[i]).timeStamp], NSOrderedAscending);
+        }
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    // Nothing is delivered after cancellation
+    XCTestExpectation *cancelled = [[XCTestExpectation alloc] initWithDescription:@"cancelled"];
+    PPHTTPOperation *operation = [PPDeviceMeasurements getHistoryOfMeasurements:self.device.deviceId startDate:startDate endDate:endDate locationId:self.device.locationId userId:PPUserIdNone paramNames:nil index:nil interval:PPDeviceMeasurementsHistoryIntervalNone aggregation:PPDeviceMeasurementsHistoryAggregationNone reduceNoise:PPDeviceMeasurementsHistoryReduceNoiseNone windowInterval:24 * 60 * 60 maxConcurrentRequests:2 readings:^(NSArray * _Nullable readings, NSError * _Nullable error) {
+        XCTFail(@"Readings delivered after cancellation");
+    } callback:^(NSError * _Nullable error) {
+        XCTAssertNil(error);
+        [cancelled fulfill];
+    }];
+    [operation cancel];
+    [self waitForExpectations:@[cancelled] timeout:10.0];
+#endif
+}
+
+#pragma mark - Local Store
+
+static NSInteger const kMeasurementsStoreBenchmarkValues = 200000;
+
+- (NSArray *)readingsFromDate:(NSDate *)startDate count:(NSInteger)count interval:(NSTimeInterval)interval {
+    NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        NSDate *timeStamp = [startDate dateByAddingTimeInterval:i * interval];
+        [readings addObject:[[PPDeviceMeasurementsReading alloc] initWithDeviceId:self.device.deviceId timeStamp:timeStamp params:@[[[PPDeviceParameter alloc] initWithName:@"power" value:@(i).stringValue lastUpdateDate:timeStamp], [[PPDeviceParameter alloc] initWithName:@"status" value:@"ON" lastUpdateDate:timeStamp]]]];
+    }
+    return readings;
+}
+
+- (void)testMeasurementsStore {
+    PPDeviceMeasurementsStore *store = [PPDeviceMeasurementsStore storeForUserId:(PPUserId)-100];
+    [store removeAllValues];
+    
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceNow:-24 * 60 * 60];
+    NSArray *readings = [self readingsFromDate:startDate count:10000 interval:1];
+    
+    // Non-numeric values are skipped, values already stored are ignored
+    XCTAssertEqual([store addReadings:readings], 10000);
+    XCTAssertEqual([store addReadings:[readings subarrayWithRange:NSMakeRange(5000, 100)]], 0);
+    
+    __block double sum = 0;
+    NSUInteger scanned = [store enumerateValuesForDeviceId:self.device.deviceId paramName:@"power" index:nil startDate:[startDate dateByAddingTimeInterval:100] endDate:[startDate dateByAddingTimeInterval:199] usingBlock:^(int64_t timeStampMs, double value, BOOL *stop) {
+        sum += value;
+    }];
+    XCTAssertEqual(scanned, 100);
+    XCTAssertEqual(sum, (100 + 199) * 100 / 2);
+    
+    NSArray *stored = [store readingsForDeviceId:self.device.deviceId paramNames:@[@"power", @"status"] index:nil startDate:startDate endDate:[startDate dateByAddingTimeInterval:9]];
+    XCTAssertEqual(stored.count, 10);
+    XCTAssertEqualObjects(((PPDeviceParameter *)((PPDeviceMeasurementsReading *)stored[9]).params[0]).value, @"9");
+    
+    // Coverage drives the tail request
+    XCTAssertNil([store coveredEndDateForDeviceId:self.device.deviceId paramNames:@[@"power"] index:nil startDate:startDate]);
+    NSDate *endDate = [startDate dateByAddingTimeInterval:10000];
+    [store setCoveredRangeForDeviceId:self.device.deviceId paramNames:@[@"power"] index:nil startDate:startDate endDate:endDate];
+    XCTAssertEqualWithAccuracy([[store coveredEndDateForDeviceId:self.device.deviceId paramNames:@[@"power"] index:nil startDate:[startDate dateByAddingTimeInterval:60]] timeIntervalSinceDate:endDate], 0, 0.001);
+    
+    // A live value past the covered end does not hide the tail fetched afterwards
+    XCTAssertEqual([store addReadings:[self readingsFromDate:[startDate dateByAddingTimeInterval:20000] count:1 interval:1]], 1);
+    XCTAssertEqual([store addReadings:[self readingsFromDate:endDate count:100 interval:1]], 100);
+    scanned = [store enumerateValuesForDeviceId:self.device.deviceId paramName:@"power" index:nil startDate:endDate endDate:[startDate dateByAddingTimeInterval:20000] usingBlock:^(int64_t timeStampMs, double value, BOOL *stop) {}];
+    XCTAssertEqual(scanned, 101);
+
+    // Retention removes old blocks
+    store.retentionInterval = 60 * 60;
+    [store addReadings:[self readingsFromDate:[NSDate date] count:1 interval:1]];
+    scanned = [store enumerateValuesForDeviceId:self.device.deviceId paramName:@"power" index:nil startDate:startDate endDate:[NSDate dateWithTimeIntervalSinceNow:60] usingBlock:^(int64_t timeStampMs, double value, BOOL *stop) {}];
+    XCTAssertLessThan(scanned, 10001);
+    
+    [store removeAllValues];
+}
+
+- (void)testGetStoredHistoryOfMeasurements {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetStoredHistoryOfMeasurements";
+    [[PPDeviceMeasurementsStore storeForUserId:PPUserIdNone] removeAllValues];
+    
+    __block NSMutableArray *requestedStartDates = @[].mutableCopy;
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path containsString:@"/parametersByDate/"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        NSDate *windowStartDate = [PPNSDate parseDateTime:request.URL.lastPathComponent];
+        [requestedStartDates addObject:windowStartDate];
+        return [HTTPStubsResponse responseWithJSONObject:@{@"resultCode": @0, @"readings": @[@{@"deviceId": self.device.deviceId, @"timeStamp": [PPNSDate apiFriendStringFromDate:[windowStartDate dateByAddingTimeInterval:1]], @"params": @[@{@"name": @"power", @"value": @"42"}]}]} statusCode:200 headers:nil];
+    }];
+    
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceNow:-60 * 60];
+    NSDate *firstEndDate = [startDate dateByAddingTimeInterval:30 * 60];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    [PPDeviceMeasurements getStoredHistoryOfMeasurements:self.device.deviceId startDate:startDate endDate:firstEndDate locationId:self.device.locationId userId:PPUserIdNone paramNames:@[@"power"] index:nil callback:^(NSArray * _Nullable readings, NSError * _Nullable error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(readings.count, 1);
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    // Only the tail is requested, stored readings are still returned
+    expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    [PPDeviceMeasurements getStoredHistoryOfMeasurements:self.device.deviceId startDate:startDate endDate:nil locationId:self.device.locationId userId:PPUserIdNone paramNames:@[@"power"] index:nil callback:^(NSArray * _Nullable readings, NSError * _Nullable error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(readings.count, 2);
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    XCTAssertEqual(requestedStartDates.count, 2);
+    XCTAssertEqualWithAccuracy([requestedStartDates[1] timeIntervalSinceDate:firstEndDate], 0, 1);
+    
+    [[PPDeviceMeasurementsStore storeForUserId:PPUserIdNone] removeAllValues];
+#endif
+}
+
+- (void)testPerformanceMeasurementsStoreRangeScan {
+    PPDeviceMeasurementsStore *store = [PPDeviceMeasurementsStore storeForUserId:(PPUserId)-101];
+    [store removeAllValues];
+    
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceNow:-kMeasurementsStoreBenchmarkValues];
+    [store addReadings:[self readingsFromDate:startDate count:kMeasurementsStoreBenchmarkValues interval:1]];
+    NSDate *endDate = [NSDate date];
+    
+    [self measureBlock:^{
+        __block double sum = 0;
+        NSUInteger scanned = [store enumerateValuesForDeviceId:self.device.deviceId paramName:@"power" index:nil startDate:startDate endDate:endDate usingBlock:^(int64_t timeStampMs, double value, BOOL *stop) {
+            sum += value;
+        }];
+        XCTAssertEqual(scanned, kMeasurementsStoreBenchmarkValues);
+    }];
+    
+    [store removeAllValues];
+}
+
 #pragma mark - Get the Last N Measurements
 
 /**
@@ -9,6 +9,107 @@
 #import "PPBaseTestCase.h"
 #import <XCTest/XCTest.h>
 #import <Peoplepower/PPDeviceProxy.h>
+#import <Peoplepower/PPWebSocket.h>
+#if !TARGET_OS_WATCH
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#endif
+
+/**
+ * Stands in for the DeviceIO WebSocket. It connects right away and records what the proxy sends, the test plays the server.
+ */
+@interface PPTCDeviceIOWebSocket : PPWebSocket
+@property (nonatomic) BOOL connected;
+@property (nonatomic, strong) NSMutableArray *sentMessages;
+@property (nonatomic, copy) void (^sendBlock)(PPTCDeviceIOWebSocket *webSocket, NSDictionary *message);
+- (void)receive:(NSDictionary *)message;
+- (void)breakConnection;
+@end
+
+@interface PPWebSocket (PPTCDeviceProxy)
+- (NSObject<PPWebSocketDelegate> *)delegate;
+@end
+
+@implementation PPTCDeviceIOWebSocket
+
+- (id)initWithURL:(NSString *)URL resourceEndpoint:(PPWebSocketResourceEndpoint)resourceEndpoint sessionId:(NSString *)sessionId delegate:(NSObject<PPWebSocketDelegate> *)delegate {
+    self = [super initWithURL:URL resourceEndpoint:resourceEndpoint sessionId:sessionId delegate:delegate];
+    if(self) {
+        _sentMessages = [[NSMutableArray alloc] initWithCapacity:0];
+    }
+    return self;
+}
+
+- (void)connect {
+    self.connected = YES;
+    [self.delegate websocketDidConnect:self.webSocket];
+}
+
+- (void)disconnect {
+    self.connected = NO;
+}
+
+- (BOOL)send:(NSString *)message {
+    if(!self.connected) {
+        return NO;
+    }
+    NSDictionary *JSON = [NSJSONSerialization JSONObjectWithData:[message dataUsingEncoding:NSUTF8StringEncoding] options:0 error:nil];
+    [self.sentMessages addObject:JSON];
+    if(self.sendBlock) {
+        self.sendBlock(self, JSON);
+    }
+    return YES;
+}
+
+/**
+ * Deliver a message from the server
+ */
+- (void)receive:(NSDictionary *)message {
+    NSString *string = [[NSString alloc] initWithData:[NSJSONSerialization dataWithJSONObject:message options:0 error:nil] encoding:NSUTF8StringEncoding];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if(self.connected) {
+            [self.delegate websocket:self.webSocket didReceiveMessage:string];
+        }
+    });
+}
+
+/**
+ * Drop the connection from the server side
+ */
+- (void)breakConnection {
+    self.connected = NO;
+    [self.delegate websocketBroken];
+}
+
+@end
+
+/**
+ * Proxy that opens a PPTCDeviceIOWebSocket instead of a real WebSocket
+ */
+@interface PPTCDeviceIOProxy : PPDeviceProxy
+@property (nonatomic, strong) NSMutableArray *webSockets;
+@property (nonatomic, copy) void (^webSocketBlock)(PPTCDeviceIOWebSocket *webSocket);
+@end
+
+@interface PPDeviceProxy (PPTCDeviceProxy)
+@property (nonatomic) NSTimeInterval webSocketAcknowledgementTimeout;
+- (PPWebSocket *)deviceIOWebSocketWithURL:(NSString *)URLString;
+@end
+
+@implementation PPTCDeviceIOProxy
+
+- (PPWebSocket *)deviceIOWebSocketWithURL:(NSString *)URLString {
+    PPTCDeviceIOWebSocket *webSocket = [[PPTCDeviceIOWebSocket alloc] initWithURL:URLString resourceEndpoint:PPWebSocketResourceEndpointDeviceIO sessionId:nil delegate:self];
+    if(!_webSockets) {
+        _webSockets = [[NSMutableArray alloc] initWithCapacity:0];
+    }
+    [_webSockets addObject:webSocket];
+    if(self.webSocketBlock) {
+        self.webSocketBlock(webSocket);
+    }
+    return webSocket;
+}
+
+@end
 
 @interface PPTCDeviceProxy : PPBaseTestCase <PPDeviceProxyDelegate, PPDeviceProxyLocalDelegate>
 
@@ -18,6 +119,8 @@
 @property (nonatomic, strong) NSMutableDictionary *measurements;
 @property (nonatomic, strong) NSString *measurementSequenceNumber;
 @property (nonatomic, strong) NSString *measurementStatus;
+@property (nonatomic, strong) NSMutableArray *sentMeasurements;
+@property (nonatomic, strong) NSMutableArray *sentSequenceNumbers;
 
 @end
 
@@ -132,6 +235,9 @@
 
 - (void)tearDown {
     // Put teardown code here. This method is called after the invocation of each test method in the class.
+#if !TARGET_OS_WATCH
+    [HTTPStubs removeAllStubs];
+#endif
     [super tearDown];
 }
 
@@ -175,6 +281,56 @@
     XCTAssertTrue([_measurementStatus isEqualToString:@"ACK"]);
 }
 
+- (void)testSendMeasurementsBatched {
+    
+    _proxyExpectation = [[XCTestExpectation alloc] initWithDescription:@"proxy:turnOn"];
+    
+    [[PPDeviceProxy currentProxy] turnOn:self];
+    
+    [self waitForExpectations:@[_proxyExpectation] timeout:10.0];
+    
+    _measurementExpectation = [[XCTestExpectation alloc] initWithDescription:@"proxy:sendMeasurements"];
+    
+    NSDictionary *parametersArray = (NSDictionary *)[PPAppResources getPlistEntry:PLIST_KEY_TEST_DEVICE_MEASUREMENTS_PARAMETERS filename:PLIST_FILE_UNIT_TESTS];
+    
+    NSMutableArray *parameters = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *paramDict in parametersArray) {
+        PPDeviceParameter *param = [PPDeviceParameter initWithDictionary:paramDict];
+        [parameters addObject:param];
+    }
+    
+    [PPDeviceProxy currentProxy].maximumMeasurementBatchSize = 3;
+    [PPDeviceProxy currentProxy].measurementCoalescingInterval = 5.0;
+    
+    _measurementStatus = nil;
+    _sentMeasurements = [[NSMutableArray alloc] initWithCapacity:0];
+    _sentSequenceNumbers = [[NSMutableArray alloc] initWithCapacity:0];
+    
+    NSMutableArray *measurements = [[NSMutableArray alloc] initWithCapacity:0];
+    NSDate *now = [NSDate date];
+    for(NSInteger i = 0; i < 3; i++) {
+        NSDate *measureDate = [now dateByAddingTimeInterval:i - 3];
+        [measurements addObject:[[PPDeviceMeasurement alloc] initWithDeviceId:[PPDeviceProxy currentProxy].localDevice.device.deviceId lastDataReceivedDate:measureDate lastMeasureDate:measureDate params:parameters]];
+    }
+    
+    // A full batch goes out without waiting for the coalescing interval
+    [[PPDeviceProxy currentProxy] sendMeasurements:measurements];
+    
+    [self waitForExpectations:@[_measurementExpectation] timeout:4.0];
+    
+    XCTAssertTrue([_measurementStatus isEqualToString:@"ACK"]);
+    
+    // One request, oldest first, each measurement keeps its own timestamp
+    XCTAssertEqual(_sentMeasurements.count, 3);
+    XCTAssertEqual([NSSet setWithArray:_sentSequenceNumbers].count, 1);
+    for(NSInteger i = 0; i < _sentMeasurements.count; i++) {
+        XCTAssertEqualObjects(((PPDeviceMeasurement *)_sentMeasurements[i]).lastMeasureDate, ((PPDeviceMeasurement *)measurements[i]).lastMeasureDate);
+    }
+    
+    [PPDeviceProxy currentProxy].maximumMeasurementBatchSize = PROXY_DEFAULT_MAXIMUM_MEASUREMENT_BATCH_SIZE;
+    [PPDeviceProxy currentProxy].measurementCoalescingInterval = PROXY_DEFAULT_MEASUREMENT_COALESCING_INTERVAL;
+}
+
 - (void)testReceiveCommand {
     
     _proxyExpectation = [[XCTestExpectation alloc] initWithDescription:@"proxy:turnOn"];
@@ -206,6 +362,295 @@
     XCTAssertTrue([_measurementStatus isEqualToString:@"ACK"]);
 }
 
+#pragma mark - DeviceIO WebSocket
+
+#if !TARGET_OS_WATCH
+static NSString * const kDeviceIOTestHost = @"deviceio.test";
+static NSString * const kDeviceIOTestDeviceId = @"deviceio-test";
+static NSTimeInterval const kDeviceIOLongPollLatency = 5.0;
+static NSUInteger const kDeviceIOBenchmarkCommands = 10;
+
+/**
+ * Stub the device server. Long polls get the next of the given commands, or continue after kDeviceIOLongPollLatency when there is none left.
+ * Posts are acknowledged, and the command IDs of the responses they carry are passed to the acknowledgment block.
+ * Every request is recorded with its method and body.
+ */
+- (id<HTTPStubsDescriptor>)stubDeviceServerWithCommands:(NSMutableArray *)commands requests:(NSMutableArray *)requests acknowledgmentBlock:(void (^)(NSArray *commandIds))acknowledgmentBlock {
+    return [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.host isEqualToString:kDeviceIOTestHost];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        NSData *bodyData = request.OHHTTPStubs_HTTPBody;
+        NSDictionary *body = (bodyData.length > 0) ? [NSJSONSerialization JSONObjectWithData:bodyData options:0 error:nil] : @{};
+        @synchronized(requests) {
+            [requests addObject:@{@"method": request.HTTPMethod, @"body": body ?: @{}}];
+        }
+    
+        if([request.HTTPMethod isEqualToString:@"POST"]) {
+            if(acknowledgmentBlock) {
+                acknowledgmentBlock([self respondedCommandIds:@[body]]);
+            }
+            return [HTTPStubsResponse responseWithJSONObject:@{@"status": @"ACK", @"seq": [body objectForKey:@"seq"] ?: @""} statusCode:200 headers:nil];
+        }
+    
+        NSDictionary *command = nil;
+        @synchronized(commands) {
+            command = commands.firstObject;
+            if(command) {
+                [commands removeObjectAtIndex:0];
+            }
+        }
+        if(command) {
+            return [HTTPStubsResponse responseWithJSONObject:@{@"status": @"ACK", @"commands": @[command]} statusCode:200 headers:nil];
+        }
+        return [[HTTPStubsResponse responseWithJSONObject:@{@"status": @"CONT"} statusCode:200 headers:nil] requestTime:kDeviceIOLongPollLatency responseTime:0];
+    }];
+}
+
+- (PPTCDeviceIOProxy *)deviceIOProxyOverTransport:(PPDeviceProxyTransport)transport {
+    PPCloudConnectivityServer *server = [[PPCloudConnectivityServer alloc] initWithType:CLOUD_CONNECTIVITY_SERVER_TYPE_DEVICE_IO host:kDeviceIOTestHost path:@"/deviceio" port:(PPCloudConnectivityPort)443 altPort:PPCloudConnectivityPortNone ssl:PPCloudConnectivitySSLTrue altSsl:PPCloudConnectivitySSLNone brand:nil];
+    PPTCDeviceIOProxy *proxy = [[PPTCDeviceIOProxy alloc] initWithAuthToken:@"_TOKEN_" server:server localDevice:[[PPDeviceProxyLocal alloc] init]];
+    proxy.transport = transport;
+    [self addTeardownBlock:^{
+        [proxy stopCommandsForDeviceId:kDeviceIOTestDeviceId];
+    }];
+    return proxy;
+}
+
+- (NSDictionary *)deviceIOCommand:(NSInteger)commandId {
+    return @{@"commandId": @(commandId).stringValue, @"deviceId": kDeviceIOTestDeviceId, @"type": @(PPDeviceCommandTypeSet).stringValue, @"parameters": @[@{@"name": @"ppc.test", @"value": @(commandId).stringValue}]};
+}
+
+/**
+ * Command IDs of the responses carried by messages or request bodies
+ */
+- (NSArray *)respondedCommandIds:(NSArray *)messages {
+    NSMutableArray *commandIds = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *message in messages) {
+        for(NSDictionary *response in [message objectForKey:@"responses"]) {
+            [commandIds addObject:[response objectForKey:@"commandId"]];
+        }
+    }
+    return commandIds;
+}
+
+- (NSArray *)requestBodies:(NSArray *)requests method:(NSString *)method {
+    NSMutableArray *bodies = [[NSMutableArray alloc] initWithCapacity:0];
+    @synchronized(requests) {
+        for(NSDictionary *request in requests) {
+            if([[request objectForKey:@"method"] isEqualToString:method]) {
+                [bodies addObject:[request objectForKey:@"body"]];
+            }
+        }
+    }
+    return bodies;
+}
+
+/**
+ * Listen to commands, wait for the WebSocket to connect, then push a command and wait for its response. The response is left unacknowledged.
+ *
+ * @return PPTCDeviceIOWebSocket WebSocket the response went out over
+ */
+- (PPTCDeviceIOWebSocket *)sendUnacknowledgedResponseOverProxy:(PPTCDeviceIOProxy *)proxy {
+    XCTestExpectation *connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:connect"];
+    XCTestExpectation *sentExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:send"];
+    proxy.webSocketBlock = ^(PPTCDeviceIOWebSocket *webSocket) {
+        webSocket.sendBlock = ^(PPTCDeviceIOWebSocket *webSocket, NSDictionary *message) {
+            [sentExpectation fulfill];
+        };
+        [connectExpectation fulfill];
+    };
+    [proxy commandsForDeviceId:kDeviceIOTestDeviceId sendToBlock:^NSDictionary *(NSArray *parameters) {
+        return nil;
+    }];
+    [self waitForExpectations:@[connectExpectation] timeout:5.0];
+    proxy.webSocketBlock = nil;
+    
+    PPTCDeviceIOWebSocket *webSocket = proxy.webSockets.firstObject;
+    [webSocket receive:@{@"status": @"ACK", @"commands": @[[self deviceIOCommand:1]]}];
+    [self waitForExpectations:@[sentExpectation] timeout:5.0];
+    XCTAssertEqualObjects([self respondedCommandIds:webSocket.sentMessages], @[@"1"]);
+    return webSocket;
+}
+
+/**
+ * Commands pushed over the WebSocket are answered over it, one message waiting for its acknowledgement at a time, without HTTP requests
+ */
+- (void)testReceiveCommandOverWebSocket {
+    NSMutableArray *requests = [[NSMutableArray alloc] initWithCapacity:0];
+    [self stubDeviceServerWithCommands:nil requests:requests acknowledgmentBlock:nil];
+    PPTCDeviceIOProxy *proxy = [self deviceIOProxyOverTransport:PPDeviceProxyTransportWebSocket];
+    
+    __block XCTestExpectation *sentExpectation = nil;
+    XCTestExpectation *connectExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:connect"];
+    proxy.webSocketBlock = ^(PPTCDeviceIOWebSocket *webSocket) {
+        webSocket.sendBlock = ^(PPTCDeviceIOWebSocket *webSocket, NSDictionary *message) {
+            [sentExpectation fulfill];
+        };
+        [connectExpectation fulfill];
+    };
+    
+    NSMutableArray *commandIds = [[NSMutableArray alloc] initWithCapacity:0];
+    [proxy commandsForDeviceId:kDeviceIOTestDeviceId sendToBlock:^NSDictionary *(NSArray *parameters) {
+        [commandIds addObject:((PPDeviceParameter *)parameters.firstObject).value];
+        return nil;
+    }];
+    [self waitForExpectations:@[connectExpectation] timeout:5.0];
+    PPTCDeviceIOWebSocket *webSocket = proxy.webSockets.firstObject;
+    XCTAssertTrue(webSocket.connected);
+    
+    sentExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:send"];
+    [webSocket receive:@{@"status": @"ACK", @"commands": @[[self deviceIOCommand:1]]}];
+    [self waitForExpectations:@[sentExpectation] timeout:5.0];
+    XCTAssertEqualObjects(commandIds, @[@"1"]);
+    XCTAssertEqualObjects([self respondedCommandIds:webSocket.sentMessages], @[@"1"]);
+    
+    // The response to the next command waits until the first message is acknowledged
+    sentExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:send"];
+    sentExpectation.inverted = YES;
+    [webSocket receive:@{@"status": @"ACK", @"commands": @[[self deviceIOCommand:2]]}];
+    [self waitForExpectations:@[sentExpectation] timeout:1.0];
+    XCTAssertEqualObjects(commandIds, (@[@"1", @"2"]));
+    XCTAssertEqual(webSocket.sentMessages.count, 1);
+    
+    sentExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:send"];
+    [webSocket receive:@{@"status": @"ACK", @"seq": [webSocket.sentMessages.firstObject objectForKey:@"seq"]}];
+    [self waitForExpectations:@[sentExpectation] timeout:5.0];
+    XCTAssertEqual(webSocket.sentMessages.count, 2);
+    XCTAssertNotEqualObjects([webSocket.sentMessages[0] objectForKey:@"seq"], [webSocket.sentMessages[1] objectForKey:@"seq"]);
+    XCTAssertEqualObjects([self respondedCommandIds:webSocket.sentMessages], (@[@"1", @"2"]));
+    
+    // Only the WebSocket connection reached the device server
+    XCTAssertEqual(proxy.deviceIORequests, 1);
+    @synchronized(requests) {
+        XCTAssertEqual(requests.count, 0);
+    }
+}
+
+/**
+ * A message still waiting for its acknowledgement when the WebSocket breaks goes out again over HTTP, and the proxy long polls until the WebSocket reconnects
+ */
+- (void)testWebSocketRequeuesOnClose {
+    NSMutableArray *requests = [[NSMutableArray alloc] initWithCapacity:0];
+    XCTestExpectation *postExpectation = [[XCTestExpectation alloc] initWithDescription:@"deviceIO:post"];
+    [self stubDeviceServerWithCommands:nil requests:requests acknowledgmentBlock:^(NSArray *commandIds) {
+        if([commandIds containsObject:@"1"]) {
+            [postExpectation fulfill];
+        }
+    }];
+    PPTCDeviceIOProxy *proxy = [self deviceIOProxyOverTransport:PPDeviceProxyTransportWebSocket];
+    PPTCDeviceIOWebSocket *webSocket = [self sendUnacknowledgedResponseOverProxy:proxy];
+    
+    XCTestExpectation *reconnectExpectation = [[XCTestExpectation alloc] initWithDescription:@"webSocket:reconnect"];
+    proxy.webSocketBlock = ^(PPTCDeviceIOWebSocket *webSocket) {
+        [reconnectExpectation fulfill];
+    };
+    
+    [webSocket breakConnection];
+    [self waitForExpectations:@[postExpectation] timeout:5.0];
+    XCTAssertFalse(webSocket.connected);
+    
+    [self waitForExpectations:@[reconnectExpectation] timeout:10.0];
+    PPTCDeviceIOWebSocket *reconnectedWebSocket = proxy.webSockets.lastObject;
+    XCTAssertEqual(proxy.webSockets.count, 2);
+    XCTAssertTrue(reconnectedWebSocket.connected);
+    
+    // Acknowledged over HTTP, so it doesn't go out again over the new WebSocket
+    XCTAssertEqual(reconnectedWebSocket.sentMessages.count, 0);
+    XCTAssertEqualObjects([self respondedCommandIds:[self requestBodies:requests method:@"POST"]], @[@"1"]);
+    XCTAssertGreaterThan([self requestBodies:requests method:@"GET"].count, 0);
+}
+
+/**
+ * A message that isn't acknowledged in time goes out again over HTTP
+ */
+- (void)testWebSocketAcknowledgementTimeout {
+    XCTestExpectation *postExpectation = [[XCTestExpectation alloc] initWithDescription:@"deviceIO:post"];
+    [self stubDeviceServerWithCommands:nil requests:nil acknowledgmentBlock:^(NSArray *commandIds) {
+        if([commandIds containsObject:@"1"]) {
+            [postExpectation fulfill];
+        }
+    }];
+    PPTCDeviceIOProxy *proxy = [self deviceIOProxyOverTransport:PPDeviceProxyTransportWebSocket];
+    proxy.webSocketAcknowledgementTimeout = 0.5;
+    PPTCDeviceIOWebSocket *webSocket = [self sendUnacknowledgedResponseOverProxy:proxy];
+    
+    [self waitForExpectations:@[postExpectation] timeout:5.0];
+    XCTAssertFalse(webSocket.connected);
+    XCTAssertEqual(webSocket.sentMessages.count, 1);
+}
+
+/**
+ * Have the stubbed device server send commands to a proxy over the given transport, one after the other, and wait until every response is acknowledged.
+ *
+ * @return NSUInteger HTTP requests and WebSocket connections made to the device server
+ */
+- (NSUInteger)deviceServerRequestsForCommands:(NSUInteger)count overTransport:(PPDeviceProxyTransport)transport {
+    NSMutableArray *commands = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSUInteger i = 1; i <= count; i++) {
+        [commands addObject:[self deviceIOCommand:i]];
+    }
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"deviceIO:acknowledged"];
+    expectation.expectedFulfillmentCount = count;
+    void (^acknowledgmentBlock)(NSArray *) = ^(NSArray *commandIds) {
+        for(NSUInteger i = 0; i < commandIds.count; i++) {
+            [expectation fulfill];
+        }
+    };
+    
+    // Long polls pick the commands up. Over the WebSocket the server pushes the first one, then the next with each acknowledgement.
+    BOOL longPoll = (transport == PPDeviceProxyTransportLongPoll);
+    id<HTTPStubsDescriptor> stub = [self stubDeviceServerWithCommands:longPoll ? commands : nil requests:nil acknowledgmentBlock:acknowledgmentBlock];
+    PPTCDeviceIOProxy *proxy = [self deviceIOProxyOverTransport:transport];
+    if(!longPoll) {
+        proxy.webSocketBlock = ^(PPTCDeviceIOWebSocket *webSocket) {
+            webSocket.sendBlock = ^(PPTCDeviceIOWebSocket *webSocket, NSDictionary *message) {
+                NSMutableDictionary *acknowledgement = [@{@"status": @"ACK", @"seq": [message objectForKey:@"seq"]} mutableCopy];
+                if(commands.count > 0) {
+                    [acknowledgement setObject:@[commands.firstObject] forKey:@"commands"];
+                    [commands removeObjectAtIndex:0];
+                }
+                [webSocket receive:acknowledgement];
+                acknowledgmentBlock([self respondedCommandIds:@[message]]);
+            };
+            [webSocket receive:@{@"status": @"ACK", @"commands": @[commands.firstObject]}];
+            [commands removeObjectAtIndex:0];
+        };
+    }
+    
+    [proxy commandsForDeviceId:kDeviceIOTestDeviceId sendToBlock:^NSDictionary *(NSArray *parameters) {
+        return nil;
+    }];
+    [self waitForExpectations:@[expectation] timeout:30.0];
+    
+    NSUInteger requests = proxy.deviceIORequests;
+    [proxy stopCommandsForDeviceId:kDeviceIOTestDeviceId];
+    [HTTPStubs removeStub:stub];
+    return requests;
+}
+
+- (void)testPerformanceReceiveCommandWebSocket {
+    NSUInteger longPollRequests = [self deviceServerRequestsForCommands:kDeviceIOBenchmarkCommands overTransport:PPDeviceProxyTransportLongPoll];
+    
+    [self measureBlock:^{
+        // One connection carries every command and response
+        NSUInteger requests = [self deviceServerRequestsForCommands:kDeviceIOBenchmarkCommands overTransport:PPDeviceProxyTransportWebSocket];
+        XCTAssertEqual(requests, 1);
+        XCTAssertLessThan(requests, longPollRequests);
+    }];
+}
+
+/**
+ * Baseline: every command takes a long poll, and its response interrupts the long poll with a post
+ */
+- (void)testPerformanceReceiveCommandLongPoll {
+    [self measureBlock:^{
+        NSUInteger requests = [self deviceServerRequestsForCommands:kDeviceIOBenchmarkCommands overTransport:PPDeviceProxyTransportLongPoll];
+        XCTAssertGreaterThanOrEqual(requests, 2 * kDeviceIOBenchmarkCommands);
+    }];
+}
+#endif
+
 - (void)testMotionVideoAlert {
     
     _proxyExpectation = [[XCTestExpectation alloc] initWithDescription:@"proxy:turnOn"];
@@ -294,6 +739,404 @@
     [[PPDeviceProxy currentProxy] turnOff];
 }
 
+#pragma mark - Outbound queue
+
+static NSInteger const kOutboundQueueBenchmarkRecords = 5000;
+
+- (NSURL *)temporaryQueueDirectory {
+    NSURL *directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    [self addTeardownBlock:^{
+        [[NSFileManager defaultManager] removeItemAtURL:directoryURL error:nil];
+    }];
+    return directoryURL;
+}
+
+- (NSDictionary *)queueRecord:(NSInteger)i {
+    return @{@"deviceId": @"device", @"timestamp": @(1500000000000 + i).stringValue, @"params": @[@{@"name": @"power", @"value": @(i).stringValue}]};
+}
+
+- (NSArray *)replayedRecordIds:(PPDeviceProxyQueue *)queue {
+    NSMutableArray *recordIds = [[NSMutableArray alloc] initWithCapacity:0];
+    [queue replayRecordsUsingBlock:^(PPDeviceProxyQueueRecordId recordId, PPDeviceProxyReliabilityBufferType type, NSDictionary *record) {
+        XCTAssertEqual(type, PPDeviceProxyReliabilityBufferTypeMeasurement);
+        XCTAssertEqualObjects(record, [self queueRecord:recordId]);
+        [recordIds addObject:@(recordId)];
+    }];
+    return recordIds;
+}
+
+- (void)testOutboundQueue {
+    NSURL *directoryURL = [self temporaryQueueDirectory];
+    PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    queue.maximumSegmentSize = 512;
+    
+    for(NSInteger i = 0; i < 20; i++) {
+        XCTAssertEqual([queue appendRecord:[self queueRecord:i] type:PPDeviceProxyReliabilityBufferTypeMeasurement], i);
+    }
+    [queue acknowledgeRecords:@[@0, @1, @2, @5]];
+    
+    // Reopening replays what was not acknowledged, in order
+    queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    NSMutableArray *expected = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSInteger i = 3; i < 20; i++) {
+        if(i != 5) {
+            [expected addObject:@(i)];
+        }
+    }
+    XCTAssertEqualObjects([self replayedRecordIds:queue], expected);
+    XCTAssertEqual([queue appendRecord:[self queueRecord:20] type:PPDeviceProxyReliabilityBufferTypeMeasurement], 20);
+    
+    // A record torn by a crash is dropped, the ones before it survive
+    NSURL *lastSegment = [[[NSFileManager defaultManager] contentsOfDirectoryAtURL:directoryURL includingPropertiesForKeys:nil options:0 error:nil] sortedArrayUsingComparator:^NSComparisonResult(NSURL *url1, NSURL *url2) {
+        return [url1.lastPathComponent compare:url2.lastPathComponent];
+    }].lastObject;
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingToURL:lastSegment error:nil];
+    [handle seekToEndOfFile];
+    [handle writeData:[@"torn" dataUsingEncoding:NSUTF8StringEncoding]];
+    [handle closeFile];
+    queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    [expected addObject:@20];
+    XCTAssertEqualObjects([self replayedRecordIds:queue], expected);
+    
+    // Segments go away once everything in them is acknowledged
+    [queue acknowledgeRecords:expected];
+    XCTAssertEqual(queue.diskSize, 0);
+    queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    XCTAssertEqual([self replayedRecordIds:queue].count, 0);
+}
+
+- (void)testOutboundQueueCorruptRecord {
+    NSURL *directoryURL = [self temporaryQueueDirectory];
+    PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    for(NSInteger i = 0; i < 10; i++) {
+        [queue appendRecord:[self queueRecord:i] type:PPDeviceProxyReliabilityBufferTypeMeasurement];
+    }
+    queue = nil;
+    
+    // Every record is a length, a checksum and its payload
+    NSURL *segmentURL = [[[NSFileManager defaultManager] contentsOfDirectoryAtURL:directoryURL includingPropertiesForKeys:nil options:0 error:nil] firstObject];
+    NSMutableData *data = [NSMutableData dataWithContentsOfURL:segmentURL];
+    NSMutableArray *offsets = [[NSMutableArray alloc] initWithCapacity:10];
+    NSUInteger offset = 0;
+    while(offset < data.length) {
+        [offsets addObject:@(offset)];
+        uint32_t length;
+        [data getBytes:&length range:NSMakeRange(offset, sizeof(length))];
+        offset += 2 * sizeof(uint32_t) + length;
+    }
+    XCTAssertEqual(offsets.count, 10);
+    
+    // Flip a byte in the middle of record 4, and put half of record 7 in front of it, as a torn write would leave it
+    ((uint8_t *)data.mutableBytes)[[offsets[4] unsignedIntegerValue] + 2 * sizeof(uint32_t) + 4] ^= 0x01;
+    NSUInteger tornOffset = [offsets[7] unsignedIntegerValue];
+    NSData *torn = [data subdataWithRange:NSMakeRange(tornOffset, ([offsets[8] unsignedIntegerValue] - tornOffset) / 2)];
+    [data replaceBytesInRange:NSMakeRange(tornOffset, 0) withBytes:torn.bytes length:torn.length];
+    XCTAssertTrue([data writeToURL:segmentURL atomically:YES]);
+    
+    // Only the corrupt record is lost, the records after it survive and new records follow them
+    queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    NSArray *expected = @[@0, @1, @2, @3, @5, @6, @7, @8, @9];
+    XCTAssertEqualObjects([self replayedRecordIds:queue], expected);
+    XCTAssertEqual([queue appendRecord:[self queueRecord:10] type:PPDeviceProxyReliabilityBufferTypeMeasurement], 10);
+    
+    queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:directoryURL];
+    XCTAssertEqualObjects([self replayedRecordIds:queue], [expected arrayByAddingObject:@10]);
+}
+
+- (void)testOutboundQueueDiskLimit {
+    PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:[self temporaryQueueDirectory]];
+    queue.maximumSegmentSize = 1024;
+    queue.maximumDiskSize = 4096;
+    
+    for(NSInteger i = 0; i < 1000; i++) {
+        [queue appendRecord:[self queueRecord:i] type:PPDeviceProxyReliabilityBufferTypeMeasurement];
+    }
+    XCTAssertLessThanOrEqual(queue.diskSize, 4096 + 1024);
+    XCTAssertGreaterThan(queue.firstRecordId, 0);
+    
+    // Only the newest records are left
+    NSArray *recordIds = [self replayedRecordIds:queue];
+    XCTAssertEqualObjects(recordIds.firstObject, @(queue.firstRecordId));
+    XCTAssertEqualObjects(recordIds.lastObject, @999);
+}
+
+- (void)testPerformanceOutboundQueueAppend {
+    [self measureBlock:^{
+        PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:[self temporaryQueueDirectory]];
+        for(NSInteger i = 0; i < kOutboundQueueBenchmarkRecords; i++) {
+            [queue appendRecord:[self queueRecord:i] type:PPDeviceProxyReliabilityBufferTypeMeasurement];
+        }
+    }];
+}
+
+/**
+ * Records written in groups, as the proxy's sender queue does
+ */
+- (void)testPerformanceOutboundQueueAppendGrouped {
+    NSInteger groupSize = 50;
+    [self measureBlock:^{
+        PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:[self temporaryQueueDirectory]];
+        for(NSInteger i = 0; i < kOutboundQueueBenchmarkRecords; i += groupSize) {
+            NSMutableArray *records = [[NSMutableArray alloc] initWithCapacity:groupSize];
+            NSMutableArray *types = [[NSMutableArray alloc] initWithCapacity:groupSize];
+            for(NSInteger j = i; j < i + groupSize; j++) {
+                [records addObject:[self queueRecord:j]];
+                [types addObject:@(PPDeviceProxyReliabilityBufferTypeMeasurement)];
+            }
+            XCTAssertEqual([queue appendRecords:records types:types], i);
+        }
+    }];
+}
+
+- (void)testPerformanceOutboundQueueAcknowledge {
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        PPDeviceProxyQueue *queue = [[PPDeviceProxyQueue alloc] initWithDirectoryURL:[self temporaryQueueDirectory]];
+        for(NSInteger i = 0; i < kOutboundQueueBenchmarkRecords; i++) {
+            [queue appendRecord:[self queueRecord:i] type:PPDeviceProxyReliabilityBufferTypeMeasurement];
+        }
+        
+        // Acknowledged one request at a time, as the proxy does
+        [self startMeasuring];
+        for(NSInteger i = 0; i < kOutboundQueueBenchmarkRecords; i++) {
+            [queue acknowledgeRecords:@[@(i)]];
+        }
+        [self stopMeasuring];
+        XCTAssertEqual(queue.diskSize, 0);
+    }];
+}
+
+#pragma mark - Pending queue
+
+static NSInteger const kPendingQueueProducers = 16;
+static NSInteger const kPendingQueueObjectsPerProducer = 20000;
+
+- (void)testPendingQueueConcurrentProducers {
+    PPDeviceProxyPendingQueue *queue = [[PPDeviceProxyPendingQueue alloc] init];
+    NSInteger total = kPendingQueueProducers * kPendingQueueObjectsPerProducer;
+    
+    // Producers enqueue singles and batches from many threads while one consumer drains
+    dispatch_group_t producers = dispatch_group_create();
+    for(NSInteger producer = 0; producer < kPendingQueueProducers; producer++) {
+        dispatch_group_async(producers, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            NSInteger i = 0;
+            while(i < kPendingQueueObjectsPerProducer) {
+                if(i % 7 == 0 && i + 3 <= kPendingQueueObjectsPerProducer) {
+                    [queue enqueueObjects:@[@(producer * kPendingQueueObjectsPerProducer + i), @(producer * kPendingQueueObjectsPerProducer + i + 1), @(producer * kPendingQueueObjectsPerProducer + i + 2)]];
+                    i += 3;
+                }
+                else {
+                    [queue enqueue:@(producer * kPendingQueueObjectsPerProducer + i)];
+                    i++;
+                }
+            }
+        });
+    }
+    
+    NSMutableData *seen = [NSMutableData dataWithLength:total];
+    uint8_t *seenBytes = seen.mutableBytes;
+    NSInteger *lastSeen = calloc(kPendingQueueProducers, sizeof(NSInteger));
+    for(NSInteger producer = 0; producer < kPendingQueueProducers; producer++) {
+        lastSeen[producer] = -1;
+    }
+    
+    NSInteger received = 0;
+    NSInteger duplicates = 0;
+    NSInteger outOfOrder = 0;
+    NSInteger batches = 0;
+    while(received < total) {
+        NSArray *objects = [queue dequeueObjects:64];
+        if(objects.count == 0) {
+            if(dispatch_group_wait(producers, DISPATCH_TIME_NOW) == 0 && queue.count == 0) {
+                break;
+            }
+            continue;
+        }
+        
+        // Now and then a request fails and its elements go back in front
+        if(batches++ % 97 == 0) {
+            [queue requeueObjects:objects];
+            continue;
+        }
+        
+        for(NSNumber *object in objects) {
+            NSInteger value = object.integerValue;
+            NSInteger producer = value / kPendingQueueObjectsPerProducer;
+            if(seenBytes[value]) {
+                duplicates++;
+            }
+            seenBytes[value] = 1;
+            if(value <= lastSeen[producer]) {
+                outOfOrder++;
+            }
+            lastSeen[producer] = value;
+            received++;
+        }
+    }
+    free(lastSeen);
+    
+    XCTAssertEqual(dispatch_group_wait(producers, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(10 * NSEC_PER_SEC))), 0);
+    XCTAssertEqual(duplicates, 0);
+    XCTAssertEqual(outOfOrder, 0);
+    XCTAssertEqual(received, total);
+    XCTAssertNil([queue dequeue]);
+    XCTAssertEqual(queue.count, 0);
+}
+
+- (void)testPerformancePendingQueueConcurrentProducers {
+    [self measureBlock:^{
+        PPDeviceProxyPendingQueue *queue = [[PPDeviceProxyPendingQueue alloc] init];
+        dispatch_apply(kPendingQueueProducers, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t producer) {
+            for(NSInteger i = 0; i < kPendingQueueObjectsPerProducer; i++) {
+                [queue enqueue:@(i)];
+            }
+        });
+        while([queue dequeue]) {
+        }
+    }];
+}
+
+#pragma mark - File upload pipeline
+
+static NSTimeInterval const kFileUploadLatency = 0.05;
+static NSUInteger const kFileUploadLength = 2 * 1024 * 1024;
+
+/**
+ * Stub the file APIs as a server that takes kFileUploadLatency per request, or up to three times that to shuffle completions.
+ * Each response reports the fragment's position as its fragments count, so acknowledgements can be checked for order.
+ */
+- (void)stubFileUploadsRecordingRequests:(NSMutableArray *)requests {
+#if !TARGET_OS_WATCH
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path rangeOfString:@"/cloud/json/files"].location != NSNotFound;
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        NSURLComponents *components = [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:YES];
+        NSInteger index = 0;
+        for(NSURLQueryItem *item in components.queryItems) {
+            if([item.name isEqualToString:@"index"]) {
+                index = item.value.integerValue;
+            }
+        }
+        @synchronized(requests) {
+            [requests addObject:request.URL.query ?: @""];
+        }
+        return [[HTTPStubsResponse responseWithJSONObject:@{@"status": @"ACK", @"fileRef": @(12345), @"fragments": @(index + 1)} statusCode:200 headers:nil] requestTime:kFileUploadLatency * (1 + (index * 7) % 3) responseTime:0];
+    }];
+#endif
+}
+
+- (NSData *)fileUploadData {
+    NSMutableData *data = [[NSMutableData alloc] initWithLength:kFileUploadLength];
+    uint8_t *bytes = data.mutableBytes;
+    for(NSUInteger i = 0; i < data.length; i++) {
+        bytes[i] = (uint8_t)i;
+    }
+    return data;
+}
+
+- (void)uploadFile:(PPDeviceProxyFileUpload *)upload acknowledgments:(NSMutableArray *)acknowledgments {
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"FileUpload"];
+    upload.fileExtension = @"mp4";
+    upload.contentType = @"video/mp4";
+    upload.type = PPFileFileTypeVideo;
+    upload.retryInterval = 0;
+    [upload startWithAcknowledgmentBlock:^(PPFileId fileId, PPFileFragments totalFragments, PPFileUsedFileSpace usedSpace, PPFileTotalFileSpace totalSpace, PPFileFilesAction action, PPFileThumbnail thumbnail, PPFileTwitterShare twitterShare, NSError *error) {
+        [acknowledgments addObject:@(totalFragments)];
+    } callback:^(PPFileId fileId, PPFileFragments totalFragments, PPFileUsedFileSpace usedSpace, PPFileTotalFileSpace totalSpace, PPFileFilesAction action, PPFileThumbnail thumbnail, PPFileTwitterShare twitterShare, NSError *error) {
+        
+        XCTAssertNil(error);
+        XCTAssertEqual(fileId, 12345);
+        [expectation fulfill];
+        
+    }];
+    [self waitForExpectations:@[expectation] timeout:30.0];
+}
+
+- (void)testFileUploadPipeline {
+    NSMutableArray *requests = [[NSMutableArray alloc] initWithCapacity:0];
+    [self stubFileUploadsRecordingRequests:requests];
+    
+    NSMutableArray *acknowledgments = [[NSMutableArray alloc] initWithCapacity:0];
+    PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:[self fileUploadData] proxyId:@"proxy" authToken:@"_TOKEN_"];
+    upload.fragmentSize = 100 * 1024;
+    upload.targetFragmentDuration = 0;
+    [self uploadFile:upload acknowledgments:acknowledgments];
+    
+    // 2 MB in 100 KB fragments, acknowledged in fragment order whatever order they completed in
+    NSUInteger fragments = (kFileUploadLength + 102399) / 102400;
+    XCTAssertEqual(requests.count, fragments);
+    XCTAssertEqual(acknowledgments.count, fragments);
+    for(NSUInteger i = 0; i < acknowledgments.count; i++) {
+        XCTAssertEqualObjects(acknowledgments[i], @(i + 1));
+    }
+    
+    // Only the last request completes the file
+    for(NSUInteger i = 0; i < requests.count; i++) {
+        BOOL complete = [requests[i] rangeOfString:@"incomplete=false"].location != NSNotFound;
+        XCTAssertEqual(complete, i == requests.count - 1);
+    }
+}
+
+- (void)testFileUploadAdaptsFragmentSize {
+    NSMutableArray *requests = [[NSMutableArray alloc] initWithCapacity:0];
+    [self stubFileUploadsRecordingRequests:requests];
+    
+    PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:[self fileUploadData] proxyId:@"proxy" authToken:@"_TOKEN_"];
+    upload.fragmentSize = 50 * 1024;
+    [self uploadFile:upload acknowledgments:[[NSMutableArray alloc] initWithCapacity:0]];
+    
+    // Latency dominates, so the fragments grow and far fewer requests are needed than at the first size
+    XCTAssertGreaterThan(upload.throughput, 0);
+    XCTAssertLessThan(requests.count, kFileUploadLength / (50 * 1024) / 2);
+}
+
+- (void)testFileUploadCancel {
+    [self stubFileUploadsRecordingRequests:[[NSMutableArray alloc] initWithCapacity:0]];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"FileUploadCancel"];
+    expectation.assertForOverFulfill = YES;
+    PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:[self fileUploadData] proxyId:@"proxy" authToken:@"_TOKEN_"];
+    upload.fileExtension = @"mp4";
+    upload.contentType = @"video/mp4";
+    [upload startWithAcknowledgmentBlock:nil callback:^(PPFileId fileId, PPFileFragments totalFragments, PPFileUsedFileSpace usedSpace, PPFileTotalFileSpace totalSpace, PPFileFilesAction action, PPFileThumbnail thumbnail, PPFileTwitterShare twitterShare, NSError *error) {
+        XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [expectation fulfill];
+    }];
+    [upload cancel];
+    [upload cancel];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    // The fragment in flight when it was cancelled does not call back again
+    XCTestExpectation *settled = [[XCTestExpectation alloc] initWithDescription:@"settled"];
+    settled.inverted = YES;
+    [self waitForExpectations:@[settled] timeout:kFileUploadLatency * 4];
+}
+
+- (void)testPerformanceFileUploadPipelined {
+    [self stubFileUploadsRecordingRequests:[[NSMutableArray alloc] initWithCapacity:0]];
+    NSData *data = [self fileUploadData];
+    
+    [self measureBlock:^{
+        PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:data proxyId:@"proxy" authToken:@"_TOKEN_"];
+        [self uploadFile:upload acknowledgments:[[NSMutableArray alloc] initWithCapacity:0]];
+    }];
+}
+
+/**
+ * Baseline: one fixed size fragment at a time, as sendFile: does
+ */
+- (void)testPerformanceFileUploadSequential {
+    [self stubFileUploadsRecordingRequests:[[NSMutableArray alloc] initWithCapacity:0]];
+    NSData *data = [self fileUploadData];
+    
+    [self measureBlock:^{
+        PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:data proxyId:@"proxy" authToken:@"_TOKEN_"];
+        upload.maximumFragmentsInFlight = 1;
+        upload.targetFragmentDuration = 0;
+        [self uploadFile:upload acknowledgments:[[NSMutableArray alloc] initWithCapacity:0]];
+    }];
+}
+
 #pragma mark - PPDeviceProxyDelegate
 
 - (void)willSendMeasurement:(NSString *)sequenceNumber measurement:(PPDeviceMeasurement *)measurement {
@@ -304,7 +1147,9 @@
     }
     if(sequenceNumber) {
         [_measurements setObject:measurement forKey:sequenceNumber];
+        [_sentSequenceNumbers addObject:sequenceNumber];
     }
+    [_sentMeasurements addObject:measurement];
     
     _measurementStatus = nil;
 }
@@ -10,10 +10,31 @@
 #import <Peoplepower/PPDevice.h>
 #import <Peoplepower/PPLocation.h>
 #import <Peoplepower/PPDevices.h>
+#import <Peoplepower/PPDeviceCamera.h>
+#import <Peoplepower/PPDevicePictureFrame.h>
 #import <Peoplepower/PPLocationSpace.h>
+#import <Peoplepower/PPCloudEngine.h>
+#import <Peoplepower/PPDeviceFirmwareUpdateJob.h>
+#import <Peoplepower/PPDeviceFirmwareUpdateDownloadManager.h>
+#import <CommonCrypto/CommonDigest.h>
+#if !TARGET_OS_WATCH
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#endif
 
 static NSString *moduleName = @"Devices";
 
+@interface PPTCDevicesFirmwareDownloadDelegate : NSObject <PPDeviceFirmwareUpdateDownloadManagerDelegate>
+@property (nonatomic, copy) void (^completion)(NSError *error);
+@end
+
+@implementation PPTCDevicesFirmwareDownloadDelegate
+
+- (void)completedDownload:(PPDeviceFirmwareUpdateJob *)job error:(NSError *)error {
+    self.completion(error);
+}
+
+@end
+
 @interface PPTCDevices : PPBaseTestCase
 
 @property (strong, nonatomic) PPDevice *device;
@@ -109,6 +130,66 @@ static NSString *moduleName = @"Devices";
     
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
+
+/**
+ * Identical device list requests in flight at the same time share one network request.
+ **/
+- (void)testGetListOfDevicesForLocationCoalesced {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetListOfDevices";
+    NSInteger callers = 3;
+    
+    __block NSInteger networkRequests = 0;
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:[NSString stringWithFormat:@"%@-%@-ResponseData", moduleName, methodName] ofType:@"json"];
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path hasSuffix:@"/cloud/json/devices"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        @synchronized(self) {
+            networkRequests++;
+        }
+        return [[HTTPStubsResponse responseWithFileAtPath:path statusCode:200 headers:nil] requestTime:0.5 responseTime:0];
+    }];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    expectation.expectedFulfillmentCount = callers;
+    NSMutableArray *counts = [[NSMutableArray alloc] initWithCapacity:callers];
+    for(NSInteger i = 0; i < callers; i++) {
+        [PPDevices getListOfDevicesForLocationId:self.location.locationId userId:1 checkPersistent:true spaceId:1 spaceType:1 getTags:true prospect:true callback:^(NSArray * _Nullable devices, NSError * _Nullable error) {
+            XCTAssertNil(error);
+            [counts addObject:@(devices.count)];
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    @synchronized(self) {
+        XCTAssertEqual(networkRequests, 1);
+    }
+    XCTAssertEqual([[NSSet setWithArray:counts] count], 1);
+    
+    // Cancelling one caller does not cancel the shared request for the others
+    XCTestExpectation *cancelled = [[XCTestExpectation alloc] initWithDescription:@"cancelled"];
+    XCTestExpectation *completed = [[XCTestExpectation alloc] initWithDescription:@"completed"];
+    PPHTTPOperation *operation = [[PPCloudEngine sharedAppEngine] GET:@"devices?coalesced=true" success:^(NSData *responseData) {
+        XCTAssertNil(responseData);
+        [cancelled fulfill];
+    } failure:^(NSError *error) {
+        XCTFail(@"%@", error);
+    }];
+    [[PPCloudEngine sharedAppEngine] GET:@"devices?coalesced=true" success:^(NSData *responseData) {
+        XCTAssertNotNil(responseData);
+        [completed fulfill];
+    } failure:^(NSError *error) {
+        XCTFail(@"%@", error);
+    }];
+    [operation cancel];
+    [self waitForExpectations:@[cancelled, completed] timeout:10.0];
+    @synchronized(self) {
+        XCTAssertEqual(networkRequests, 2);
+    }
+#endif
+}
+
 /**
  * Delete Devices.
  * There are multiple ways to delete a device. This method is the most flexible, allowing multiple devices to be deleted simultaneously. Devices linked to a proxy will be removed from the proxy. Device linked to a hub will be removed from the hub.
@@ -469,6 +550,119 @@ static NSString *moduleName = @"Devices";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+- (void)testFirmwareDownloadResumes {
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"FirmwareDownload"];
+    
+    NSMutableData *image = [[NSMutableData alloc] initWithLength:300 * 1024];
+    uint8_t *bytes = image.mutableBytes;
+    for(NSUInteger i = 0; i < image.length; i++) {
+        bytes[i] = (uint8_t)(i * 31 + 7);
+    }
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(image.bytes, (CC_LONG)image.length, digest);
+    NSMutableString *checkSum = [[NSMutableString alloc] initWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for(NSInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [checkSum appendFormat:@"%02X", digest[i]];
+    }
+    
+    PPDeviceFirmwareUpdateJob *job = [[PPDeviceFirmwareUpdateJob alloc] initWithJobId:1 index:nil firmware:nil currentFirmware:nil status:PPDeviceFirmwareUpdateStatusNone url:@"https://firmware.example.com/ota/test-resume.img" checkSum:checkSum notificationDate:nil startDate:nil device:self.device];
+    NSString *localFilePath = [PPDeviceFirmwareUpdateDownloadManager localFilePathForJob:job];
+    NSString *partialFilePath = [localFilePath stringByAppendingPathExtension:@"part"];
+    [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+    
+    NSString *validatorFilePath = [partialFilePath stringByAppendingPathExtension:@"validator"];
+    
+    // An earlier attempt stopped a third of the way through
+    NSUInteger resumeOffset = 100 * 1024;
+    [[image subdataWithRange:NSMakeRange(0, resumeOffset)] writeToFile:partialFilePath atomically:YES];
+    [@"\"image-1\"" writeToFile:validatorFilePath atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertFalse([PPDeviceFirmwareUpdateDownloadManager downloadedJob:job]);
+    
+    __block NSString *requestedRange;
+    __block NSString *requestedValidator;
+#if !TARGET_OS_WATCH
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.host isEqualToString:@"firmware.example.com"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        requestedRange = [request valueForHTTPHeaderField:@"Range"];
+        requestedValidator = [request valueForHTTPHeaderField:@"If-Range"];
+        unsigned long long start = 0;
+        NSScanner *scanner = [NSScanner scannerWithString:requestedRange ?: @""];
+        if([scanner scanString:@"bytes=" intoString:nil] && [scanner scanUnsignedLongLong:&start]) {
+            NSDictionary *headers = @{@"Content-Range": [NSString stringWithFormat:@"bytes %llu-%lu/%lu", start, (unsigned long)image.length - 1, (unsigned long)image.length]};
+            return [HTTPStubsResponse responseWithData:[image subdataWithRange:NSMakeRange((NSUInteger)start, image.length - (NSUInteger)start)] statusCode:206 headers:headers];
+        }
+        return [HTTPStubsResponse responseWithData:image statusCode:200 headers:nil];
+    }];
+#endif
+    
+    PPTCDevicesFirmwareDownloadDelegate *delegate = [[PPTCDevicesFirmwareDownloadDelegate alloc] init];
+    delegate.completion = ^(NSError *error) {
+        
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(requestedRange, ([NSString stringWithFormat:@"bytes=%lu-", (unsigned long)resumeOffset]));
+        XCTAssertEqualObjects(requestedValidator, @"\"image-1\"");
+        XCTAssertTrue([PPDeviceFirmwareUpdateDownloadManager downloadedJob:job]);
+        XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:partialFilePath]);
+        XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:validatorFilePath]);
+        XCTAssertEqualObjects([NSData dataWithContentsOfFile:localFilePath], image);
+        [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+        [expectation fulfill];
+        
+    };
+    
+    PPDeviceFirmwareUpdateDownloadManager *downloadManager = [[PPDeviceFirmwareUpdateDownloadManager alloc] init];
+    downloadManager.delegate = delegate;
+    [downloadManager download:job tempKey:nil];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
+- (void)testFirmwareDownloadRestartsUnverifiedPartialFile {
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"FirmwareDownload"];
+    
+    NSData *image = [@"firmware image" dataUsingEncoding:NSUTF8StringEncoding];
+    PPDeviceFirmwareUpdateJob *job = [[PPDeviceFirmwareUpdateJob alloc] initWithJobId:1 index:nil firmware:nil currentFirmware:nil status:PPDeviceFirmwareUpdateStatusNone url:@"https://firmware.example.com/ota/test-restart.img" checkSum:nil notificationDate:nil startDate:nil device:self.device];
+    NSString *localFilePath = [PPDeviceFirmwareUpdateDownloadManager localFilePathForJob:job];
+    NSString *partialFilePath = [localFilePath stringByAppendingPathExtension:@"part"];
+    [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+    
+    // A partial file as long as a different image, with a validator but no checksum to confirm it
+    [[@"stale image!!!" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:partialFilePath atomically:YES];
+    [@"\"image-1\"" writeToFile:[partialFilePath stringByAppendingPathExtension:@"validator"] atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    
+    __block NSInteger requests = 0;
+#if !TARGET_OS_WATCH
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.host isEqualToString:@"firmware.example.com"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        requests++;
+        if([request valueForHTTPHeaderField:@"Range"]) {
+            NSDictionary *headers = @{@"Content-Range": [NSString stringWithFormat:@"bytes */%lu", (unsigned long)image.length]};
+            return [HTTPStubsResponse responseWithData:[NSData data] statusCode:416 headers:headers];
+        }
+        return [HTTPStubsResponse responseWithData:image statusCode:200 headers:@{@"ETag": @"\"image-2\""}];
+    }];
+#endif
+    
+    PPTCDevicesFirmwareDownloadDelegate *delegate = [[PPTCDevicesFirmwareDownloadDelegate alloc] init];
+    delegate.completion = ^(NSError *error) {
+        
+        XCTAssertNil(error);
+        XCTAssertEqual(requests, 2);
+        XCTAssertEqualObjects([NSData dataWithContentsOfFile:localFilePath], image);
+        [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+        [expectation fulfill];
+        
+    };
+    
+    PPDeviceFirmwareUpdateDownloadManager *downloadManager = [[PPDeviceFirmwareUpdateDownloadManager alloc] init];
+    downloadManager.delegate = delegate;
+    [downloadManager download:job tempKey:nil];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
 #pragma mark - Device Spaces
 
 /**
@@ -520,4 +714,337 @@ static NSString *moduleName = @"Devices";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+#pragma mark - Shared devices
+
+static NSInteger const kSharedDevicesBenchmarkDevices = 10000;
+static NSInteger const kSharedDevicesBenchmarkLocations = 100;
+
+- (NSArray *)sharedDevicesFixture:(NSInteger)count {
+    NSMutableArray *devices = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        [devices addObject:[PPDevice initWithDictionary:@{@"id": [NSString stringWithFormat:@"device-%li", (long)i], @"locationId": @(i % kSharedDevicesBenchmarkLocations)}]];
+    }
+    return devices;
+}
+
+- (void)testSharedDevices {
+    PPUserId userId = 1;
+    [PPDevices initializeSharedDevices];
+    
+    NSArray *devices = [self sharedDevicesFixture:10];
+    [PPDevices addDevices:devices userId:userId];
+    XCTAssertEqualObjects([PPDevices sharedDevicesForLocation:nil userId:userId], devices);
+    XCTAssertEqual([PPDevices sharedDevicesForLocation:nil userId:userId + 1].count, 0);
+    XCTAssertEqual([PPDevices sharedDeviceWithId:@"device-3" userId:userId], devices[3]);
+    
+    PPLocation *location = [[PPLocation alloc] init];
+    location.locationId = 3;
+    XCTAssertEqualObjects([PPDevices sharedDevicesForLocation:location userId:userId], @[devices[3]]);
+    
+    // Existing devices are synced in place, and follow their new location
+    PPDevice *moved = [PPDevice initWithDictionary:@{@"id": @"device-3", @"locationId": @(4), @"desc": @"Moved"}];
+    [PPDevices addDevices:@[moved] userId:userId];
+    XCTAssertEqual([PPDevices sharedDeviceWithId:@"device-3" userId:userId], devices[3]);
+    XCTAssertEqualObjects(((PPDevice *)devices[3]).name, @"Moved");
+    XCTAssertEqual([PPDevices sharedDevicesForLocation:location userId:userId].count, 0);
+    location.locationId = 4;
+    XCTAssertEqualObjects([PPDevices sharedDevicesForLocation:location userId:userId], (@[devices[4], devices[3]]));
+    
+    [PPDevices removeDevices:@[devices[4]] userId:userId];
+    XCTAssertEqualObjects([PPDevices sharedDevicesForLocation:location userId:userId], @[devices[3]]);
+    XCTAssertNil([PPDevices sharedDeviceWithId:@"device-4" userId:userId]);
+    XCTAssertEqual([PPDevices sharedDevicesForLocation:nil userId:userId].count, 9);
+}
+
+- (void)testPerformanceSharedDevices {
+    NSArray *devices = [self sharedDevicesFixture:kSharedDevicesBenchmarkDevices];
+    NSArray *updates = [self sharedDevicesFixture:kSharedDevicesBenchmarkDevices];
+    PPLocation *location = [[PPLocation alloc] init];
+    location.locationId = 1;
+    
+    [self measureBlock:^{
+        [PPDevices initializeSharedDevices];
+        [PPDevices addDevices:devices userId:1];
+        [PPDevices addDevices:updates userId:1];
+        for(PPDevice *device in updates) {
+            [PPDevices sharedDeviceWithId:device.deviceId userId:1];
+        }
+        for(NSInteger i = 0; i < kSharedDevicesBenchmarkLocations; i++) {
+            [PPDevices sharedDevicesForLocation:location userId:1];
+        }
+    }];
+}
+
+/**
+ * Baseline: the nested scans the shared devices used before they were indexed.
+ */
+- (void)testPerformanceSharedDevicesLinearScan {
+    NSArray *devices = [self sharedDevicesFixture:kSharedDevicesBenchmarkDevices];
+    NSArray *updates = [self sharedDevicesFixture:kSharedDevicesBenchmarkDevices];
+    
+    [self measureBlock:^{
+        NSMutableDictionary *sharedDevices = [[NSMutableDictionary alloc] initWithCapacity:0];
+        for(NSArray *added in @[devices, updates]) {
+            NSMutableArray *devicesArray = [sharedDevices objectForKey:[NSString stringWithFormat:@"%li", (long)1]];
+            if(!devicesArray) {
+                devicesArray = [[NSMutableArray alloc] initWithCapacity:0];
+            }
+            NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
+            for(PPDevice *device in added) {
+                BOOL found = NO;
+                for(PPDevice *sharedDevice in devicesArray) {
+                    if([sharedDevice isEqualToDevice:device]) {
+                        [sharedDevice sync:device];
+                        found = YES;
+                        break;
+                    }
+                }
+                if(!found) {
+                    [indexSet addIndex:[added indexOfObject:device]];
+                }
+            }
+            [devicesArray addObjectsFromArray:[added objectsAtIndexes:indexSet]];
+            [sharedDevices setObject:devicesArray forKey:[NSString stringWithFormat:@"%li", (long)1]];
+        }
+        for(PPDevice *device in updates) {
+            for(PPDevice *sharedDevice in [sharedDevices objectForKey:[NSString stringWithFormat:@"%li", (long)1]]) {
+                if([sharedDevice isEqualToDevice:device]) {
+                    break;
+                }
+            }
+        }
+        for(NSInteger i = 0; i < kSharedDevicesBenchmarkLocations; i++) {
+            NSMutableArray *locationDevices = [[NSMutableArray alloc] initWithCapacity:0];
+            for(NSString *userIdKey in sharedDevices.allKeys) {
+                for(PPDevice *sharedDevice in [sharedDevices objectForKey:userIdKey]) {
+                    if([userIdKey isEqualToString:[NSString stringWithFormat:@"%li", (long)1]] && sharedDevice.locationId == 1) {
+                        [locationDevices addObject:sharedDevice];
+                    }
+                }
+            }
+        }
+    }];
+}
+
+#pragma mark - Parameters
+
+static NSInteger const kParametersBenchmarkParameters = 500;
+
+- (void)testDeviceParameters {
+    PPDevice *device = [PPDevice initWithDictionary:@{@"id": @"device"}];
+    [device setParameter:@"power" value:@"1" index:nil lastUpdateDate:nil];
+    [device setParameter:@"power" value:@"2" index:@"1" lastUpdateDate:nil];
+    [device setParameter:@"power" value:@"3" index:@"2" lastUpdateDate:nil];
+    XCTAssertEqual(device.parameters.count, 3);
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:nil].value, @"1");
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:@"2"].value, @"3");
+    XCTAssertNil([device parameterWithName:@"power" index:@"3"]);
+    XCTAssertNil([device parameterWithName:@"energy" index:nil]);
+    
+    // Unchanged values keep their parameter object
+    PPDeviceParameter *param = [device parameterWithName:@"power" index:@"1"];
+    NSDate *date = [NSDate date];
+    [device applyParameters:@[[[PPDeviceParameter alloc] initWithName:@"power" index:@"1" value:@"2" lastUpdateDate:date]]];
+    XCTAssertEqual([device parameterWithName:@"power" index:@"1"], param);
+    XCTAssertEqualObjects(param.lastUpdateDate, date);
+    
+    [device applyParameterDictionaries:@[@{@"name": @"power", @"index": @"1", @"value": @"4"}, @{@"name": @"energy", @"value": @"5"}]];
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:@"1"].value, @"4");
+    XCTAssertEqualObjects([device parameterWithName:@"energy" index:nil].value, @"5");
+    
+    // Direct changes to the array are picked up
+    [device.parameters removeObjectAtIndex:0];
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:nil].value, @"4");
+    device.parameters = [@[[[PPDeviceParameter alloc] initWithName:@"power" index:nil value:@"6" lastUpdateDate:nil]] mutableCopy];
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:nil].value, @"6");
+    XCTAssertNil([device parameterWithName:@"energy" index:nil]);
+    
+    // Same count edits in place don't append duplicates
+    [device.parameters replaceObjectAtIndex:0 withObject:[[PPDeviceParameter alloc] initWithName:@"energy" index:nil value:@"7" lastUpdateDate:nil]];
+    [device setParameter:@"energy" value:@"8" index:nil lastUpdateDate:nil];
+    XCTAssertEqual(device.parameters.count, 1);
+    XCTAssertEqualObjects([device parameterWithName:@"energy" index:nil].value, @"8");
+    XCTAssertNil([device parameterWithName:@"power" index:nil]);
+    
+    // Parameters added to the array after a miss are found
+    [device.parameters addObject:[[PPDeviceParameter alloc] initWithName:@"power" index:@"1" value:@"9" lastUpdateDate:nil]];
+    XCTAssertEqualObjects([device parameterWithName:@"power" index:@"1"].value, @"9");
+    [device.parameters removeAllObjects];
+    XCTAssertNil([device parameterWithName:@"energy" index:nil]);
+}
+
+- (void)testPerformanceDeviceParameters {
+    NSMutableArray *parameterDicts = [[NSMutableArray alloc] initWithCapacity:kParametersBenchmarkParameters];
+    for(NSInteger i = 0; i < kParametersBenchmarkParameters; i++) {
+        [parameterDicts addObject:@{@"name": [NSString stringWithFormat:@"param%li", (long)(i / 10)], @"index": [NSString stringWithFormat:@"%li", (long)(i % 10)], @"value": @"0"}];
+    }
+    PPDevice *device = [PPDevice initWithDictionary:@{@"id": @"gateway", @"parameters": parameterDicts}];
+    
+    [self measureBlock:^{
+        for(NSInteger measurement = 0; measurement < 100; measurement++) {
+            for(NSDictionary *paramDict in parameterDicts) {
+                [device setParameter:paramDict[@"name"] value:(measurement % 2) ? @"1" : @"0" index:paramDict[@"index"] lastUpdateDate:nil];
+            }
+        }
+    }];
+}
+
+/**
+ * Lookups of parameters a device does not have, as the camera and picture frame accessors do
+ */
+- (void)testPerformanceDeviceParameterMisses {
+    NSMutableArray *parameterDicts = [[NSMutableArray alloc] initWithCapacity:kParametersBenchmarkParameters];
+    for(NSInteger i = 0; i < kParametersBenchmarkParameters; i++) {
+        [parameterDicts addObject:@{@"name": [NSString stringWithFormat:@"param%li", (long)i], @"value": @"0"}];
+    }
+    PPDevice *device = [PPDevice initWithDictionary:@{@"id": @"gateway", @"parameters": parameterDicts}];
+    
+    [self measureBlock:^{
+        for(NSInteger i = 0; i < 100000; i++) {
+            XCTAssertNil([device parameterWithName:@"missing" index:nil]);
+        }
+    }];
+}
+
+#pragma mark - Camera parameters
+
+/**
+ * Recorded camera parameter readings, oldest first
+ */
+- (NSArray *)cameraParameterStream {
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:[NSString stringWithFormat:@"%@-%@-ResponseData", moduleName, @"CameraParameterStream"] ofType:@"json"];
+    NSDictionary *stream = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+    return [stream objectForKey:@"readings"];
+}
+
+- (void)testCameraParameters {
+    PPDeviceCamera *camera = [PPDeviceCamera initWithDictionary:@{@"id": @"camera"}];
+    [camera setParameter:MOTION_STATUS value:@"2" index:nil lastUpdateDate:nil];
+    [camera setParameter:BATTERY_LEVEL value:@"42" index:nil lastUpdateDate:nil];
+    [camera setParameter:AVAILABLE_BYTES value:@"12884901888" index:nil lastUpdateDate:nil];
+    [camera setParameter:MODE value:@"AWAY" index:nil lastUpdateDate:nil];
+    [camera setParameter:@"ppc.signalStrength" value:@"-40" index:nil lastUpdateDate:nil];
+    XCTAssertEqual(camera.motionStatus, 2);
+    XCTAssertEqual(camera.batteryLevel, 42);
+    XCTAssertEqual(camera.availableBytes, 12884901888ULL);
+    XCTAssertEqualObjects(camera.mode, @"AWAY");
+    XCTAssertEqualObjects([camera parameterWithName:@"ppc.signalStrength" index:nil].value, @"-40");
+    
+    PPDevicePictureFrame *pictureFrame = [PPDevicePictureFrame initWithDictionary:@{@"id": @"pictureFrame"}];
+    [pictureFrame setParameter:ALERT_TITLE value:@"Hello" index:nil lastUpdateDate:nil];
+    [pictureFrame setParameter:BATTERY_LEVEL value:@"42" index:nil lastUpdateDate:nil];
+    XCTAssertEqualObjects(pictureFrame.alertTitle, @"Hello");
+    XCTAssertEqual(pictureFrame.batteryLevel, 42);
+}
+
+- (void)testPerformanceCameraParameterStream {
+    NSArray *readings = [self cameraParameterStream];
+    XCTAssertGreaterThan(readings.count, 0);
+    
+    [self measureBlock:^{
+        for(NSInteger replay = 0; replay < 10; replay++) {
+            PPDeviceCamera *camera = [PPDeviceCamera initWithDictionary:@{@"id": @"camera"}];
+            PPDevicePictureFrame *pictureFrame = [PPDevicePictureFrame initWithDictionary:@{@"id": @"pictureFrame"}];
+            for(NSDictionary *reading in readings) {
+                [camera applyParameterDictionaries:[reading objectForKey:@"params"]];
+                [pictureFrame applyParameterDictionaries:[reading objectForKey:@"params"]];
+            }
+        }
+    }];
+}
+
+#pragma mark - Lazy devices
+
+static NSInteger const kLazyDevicesBenchmarkDevices = 500;
+
+- (NSArray *)deviceListFixture:(NSInteger)count {
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:@"Devices-GetListOfDevices-ResponseData" ofType:@"json"];
+    NSDictionary *fixture = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+    NSArray *deviceDicts = [fixture objectForKey:@"devices"];
+    NSMutableArray *scaled = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        [scaled addObject:[deviceDicts objectAtIndex:i % deviceDicts.count]];
+    }
+    return scaled;
+}
+
+- (void)testLazyDevice {
+    for(NSDictionary *deviceDict in [self deviceListFixture:3]) {
+        PPDevice *eager = [PPDevice initWithDictionary:deviceDict lazy:NO];
+        PPDevice *lazy = [PPDevice initWithDictionary:deviceDict lazy:YES];
+        XCTAssertTrue(eager.isMaterialized);
+        XCTAssertFalse(lazy.isMaterialized);
+        XCTAssertEqualObjects(lazy.name, eager.name);
+        XCTAssertEqual(lazy.connected, eager.connected);
+        XCTAssertFalse(lazy.isMaterialized);
+        
+        XCTAssertEqual(lazy.parameters.count, eager.parameters.count);
+        for(PPDeviceParameter *parameter in eager.parameters) {
+            XCTAssertEqualObjects([lazy parameterWithName:parameter.name index:parameter.index].value, parameter.value);
+        }
+        XCTAssertEqual(lazy.typeAttributes.count, eager.typeAttributes.count);
+        XCTAssertEqual(lazy.properties.count, eager.properties.count);
+        XCTAssertEqual(lazy.spaces.count, eager.spaces.count);
+        XCTAssertEqualObjects(lazy.startDate, eager.startDate);
+        XCTAssertEqualObjects(lazy.lastDataReceivedDate, eager.lastDataReceivedDate);
+        XCTAssertEqualObjects(lazy.lastMeasureDate, eager.lastMeasureDate);
+        XCTAssertEqualObjects(lazy.lastConnectedDate, eager.lastConnectedDate);
+        XCTAssertTrue(lazy.isMaterialized);
+    }
+    
+    // A member set before it is read is not built from the dictionary
+    NSDictionary *deviceDict = [[self deviceListFixture:1] firstObject];
+    PPDevice *lazy = [PPDevice initWithDictionary:deviceDict lazy:YES];
+    lazy.parameters = [[NSMutableArray alloc] initWithCapacity:0];
+    XCTAssertEqual(lazy.parameters.count, 0);
+    XCTAssertNil([lazy parameterWithName:[[[deviceDict objectForKey:@"parameters"] firstObject] objectForKey:@"name"] index:nil]);
+    
+    // Concurrent first reads build each member once
+    lazy = [PPDevice initWithDictionary:deviceDict lazy:YES];
+    NSMutableArray *seen = [[NSMutableArray alloc] initWithCapacity:0];
+    NSLock *lock = [[NSLock alloc] init];
+    dispatch_apply(16, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        NSMutableArray *parameters = lazy.parameters;
+        [lock lock];
+        [seen addObject:parameters];
+        [lock unlock];
+    });
+    for(NSMutableArray *parameters in seen) {
+        XCTAssertEqual(parameters, seen.firstObject);
+    }
+    
+    [PPDevice setLazyMaterialization:YES];
+    XCTAssertFalse([PPDevice initWithDictionary:deviceDict].isMaterialized);
+    [PPDevice setLazyMaterialization:NO];
+    XCTAssertTrue([PPDevice initWithDictionary:deviceDict].isMaterialized);
+}
+
+- (void)measureDeviceListLazy:(BOOL)lazy {
+    NSArray *deviceDicts = [self deviceListFixture:kLazyDevicesBenchmarkDevices];
+    
+    __block NSUInteger shown = 0;
+    [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:^{
+        NSMutableArray *devices = [[NSMutableArray alloc] initWithCapacity:deviceDicts.count];
+        for(NSInteger replay = 0; replay < 10; replay++) {
+            [devices removeAllObjects];
+            for(NSDictionary *deviceDict in deviceDicts) {
+                PPDevice *device = [PPDevice initWithDictionary:deviceDict lazy:lazy];
+                [devices addObject:device];
+                
+                // What a device list shows
+                shown += device.name.length + device.icon.length + device.connected;
+            }
+        }
+    }];
+    XCTAssertGreaterThan(shown, 0);
+}
+
+- (void)testPerformanceDeviceListEager {
+    [self measureDeviceListLazy:NO];
+}
+
+- (void)testPerformanceDeviceListLazy {
+    [self measureDeviceListLazy:YES];
+}
+
 @end
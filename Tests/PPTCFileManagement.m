@@ -209,6 +209,50 @@ static NSString *moduleName = @"FilesManagement";
     [self waitForExpectations:@[expectation] timeout:10.0];
 }
 
+- (void)testUploadNewFileFromDisk_video {
+    NSString *methodName = @"UploadNewFile";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/files" statusCode:200 headers:nil];
+    
+    NSURL *fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.mp4", [NSUUID UUID].UUIDString]];
+    XCTAssertTrue([self.file_video.data writeToURL:fileURL atomically:YES]);
+    
+    [PPFileManagement uploadNewFile:self.device.deviceId deviceId:self.device.deviceId fileExtension:@"mp4" expectedSize:self.file_video.size duration:self.file_video.duration rotate:self.file_video.rotate fileId:self.file_video.fileId thumbnail:self.file_video.thumbnail incomplete:PPFileIncompleteTrue type:self.file_video.type contentType:@"video/mp4" authorizationType:PPFileManagementAuthorizationTypeDeviceAuthenticationToken token:self.authToken sessionId:nil fileURL:fileURL progressBlock:^(NSProgress *progress) {
+        
+        XCTAssertLessThanOrEqual(progress.completedUnitCount, (int64_t)self.file_video.data.length);
+        
+    } callback:^(NSString *status, PPFile *fileFragment, PPFileTotalFileSpace totalFileSpace, PPFileUsedFileSpace usedFileSpace, PPFileTwitterShare twitterShare, NSString *twitterAccount, NSString *contentUrl, PPFileStoragePolicy storagePolicy, NSDictionary *uploadHeaders, NSError *error) {
+        
+        XCTAssertNil(error);
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
+- (void)testUploadNewFileS3FromDisk_video {
+    NSString *methodName = @"UploadNewFileS3";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:[NSURL URLWithString:self.contentUrl].path statusCode:200 headers:nil];
+    
+    NSURL *fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.mp4", [NSUUID UUID].UUIDString]];
+    XCTAssertTrue([self.file_video.data writeToURL:fileURL atomically:YES]);
+    
+    [PPFileManagement uploadS3File:self.file_video.type contentType:@"video/mp4" fileURL:fileURL contentUrl:self.contentUrl uploadHeaders:self.uploadHeaders progressBlock:nil callback:^(NSError *error) {
+        
+        XCTAssertNil(error);
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
+
 - (void)testUploadNewFile_audio {
     NSString *methodName = @"UploadNewFile";
     XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
@@ -378,7 +422,24 @@ static NSString *moduleName = @"FilesManagement";
     [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:[NSString stringWithFormat:@"/cloud/json/files/%@", @(self.file_image.fileId)] statusCode:200 headers:nil];
     
     [PPFileManagement uploadFileFragment:self.file_image.fileId proxyId:self.device.deviceId fileExtension:@"jpeg" thumbnail:PPFileThumbnailTrue incomplete:PPFileIncompleteFalse index:0 contentType:@"image/jpeg" authorizationType:PPFileManagementAuthorizationTypeDeviceAuthenticationToken token:self.authToken sessionId:nil data:self.file_image.data callback:^(NSString *status, PPFile *fileFragment, PPFileTotalFileSpace totalFileSpace, PPFileUsedFileSpace usedFileSpace, PPFileTwitterShare twitterShare, NSString *twitterAccount, NSString *contentUrl, PPFileStoragePolicy storagePolicy, NSDictionary *uploadHeaders, NSError *error) {
+    
+        XCTAssertNil(error);
+        [expectation fulfill];
+        
+    }];
+    
+    [self waitForExpectations:@[expectation] timeout:10.0];
+}
 
+- (void)testUploadFileFragmentFromStream {
+    NSString *methodName = @"UploadFileFragment";
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:[NSString stringWithFormat:@"/cloud/json/files/%@", @(self.file_image.fileId)] statusCode:200 headers:nil];
+    
+    NSInputStream *inputStream = [NSInputStream inputStreamWithData:self.file_image.data];
+    [PPFileManagement uploadFileFragment:self.file_image.fileId proxyId:self.device.deviceId fileExtension:@"jpeg" thumbnail:PPFileThumbnailTrue incomplete:PPFileIncompleteFalse index:0 contentType:@"image/jpeg" authorizationType:PPFileManagementAuthorizationTypeDeviceAuthenticationToken token:self.authToken sessionId:nil inputStream:inputStream length:(PPFileSize)self.file_image.data.length progressBlock:nil callback:^(NSString *status, PPFile *fileFragment, PPFileTotalFileSpace totalFileSpace, PPFileUsedFileSpace usedFileSpace, PPFileTwitterShare twitterShare, NSString *twitterAccount, NSString *contentUrl, PPFileStoragePolicy storagePolicy, NSDictionary *uploadHeaders, NSError *error) {
+        
         XCTAssertNil(error);
         [expectation fulfill];
         
@@ -0,0 +1,192 @@
+//
+//  PPTCNetworking.m
+//  iOS_Core_Tests
+//
+//  Copyright © 2023 People Power Company. All rights reserved.
+//
+
+#import "PPBaseTestCase.h"
+#import <XCTest/XCTest.h>
+#import <Peoplepower/PPRetryPolicy.h>
+#import <Peoplepower/PPDeviceProxyFileUpload.h>
+#if !TARGET_OS_WATCH
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#endif
+
+@interface PPTCNetworking : PPBaseTestCase
+
+@end
+
+@implementation PPTCNetworking
+
+- (void)setUp {
+    [super setUp];
+    
+    // Configure test cloud
+    NSDictionary *cloudDict = (NSDictionary *)[PPAppResources getPlistEntry:PLIST_KEY_TEST_CLOUD filename:PLIST_FILE_UNIT_TESTS];
+    PPCloudConnectivityCloud *cloud = [PPCloudConnectivityCloud initWithDictionary:cloudDict];
+    [PPUrl setCustomCloud:cloud];
+}
+
+- (void)tearDown {
+#if !TARGET_OS_WATCH
+    [HTTPStubs removeAllStubs];
+#endif
+    [super tearDown];
+}
+
+#pragma mark - Retry policy
+
+- (void)testRetryPolicyDecorrelatedJitter {
+    PPRetryPolicy *policy = [[PPRetryPolicy alloc] init];
+    policy.maximumDelay = 20;
+    policy.maximumBudget = 100;
+    
+    // Each delay falls between the base and three times the previous one, capped at the maximum
+    NSTimeInterval previous = 0;
+    NSMutableSet *delays = [[NSMutableSet alloc] initWithCapacity:0];
+    for(NSInteger i = 0; i < 50; i++) {
+        NSTimeInterval delay = [policy retryDelayForHost:@"retry.test" baseDelay:2];
+        XCTAssertGreaterThanOrEqual(delay, 2);
+        XCTAssertLessThanOrEqual(delay, MIN(20, MAX(2, previous) * 3));
+        [delays addObject:@(delay)];
+        previous = delay;
+    }
+    XCTAssertGreaterThan(delays.count, 1);
+    XCTAssertEqual(policy.retries, 50);
+    
+    // A success starts the backoff over
+    [policy recordSuccessForHost:@"retry.test"];
+    XCTAssertLessThanOrEqual([policy retryDelayForHost:@"retry.test" baseDelay:2], 6);
+}
+
+- (void)testRetryPolicyCircuitBreaker {
+    PPRetryPolicy *policy = [[PPRetryPolicy alloc] init];
+    policy.failureThreshold = 3;
+    policy.openInterval = 0.2;
+    
+    NSMutableArray *events = [[NSMutableArray alloc] initWithCapacity:0];
+    policy.eventBlock = ^(PPRetryPolicyEvent event, NSString *host, NSTimeInterval delay) {
+        [events addObject:@(event)];
+    };
+    
+    for(NSInteger i = 0; i < 3; i++) {
+        XCTAssertTrue([policy allowsRequestToHost:@"circuit.test"]);
+        [policy recordFailureForHost:@"circuit.test"];
+    }
+    XCTAssertEqual([policy circuitStateForHost:@"circuit.test"], PPRetryPolicyCircuitStateOpen);
+    XCTAssertFalse([policy allowsRequestToHost:@"circuit.test"]);
+    XCTAssertEqual([policy retryDelayForHost:@"circuit.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    XCTAssertGreaterThanOrEqual([policy reconnectDelayForHost:@"circuit.test" baseDelay:1], 1);
+    XCTAssertEqual([policy circuitStateForHost:@"other.test"], PPRetryPolicyCircuitStateClosed);
+    
+    // After the open interval a single probe goes through
+    [NSThread sleepForTimeInterval:0.3];
+    XCTAssertEqual([policy circuitStateForHost:@"circuit.test"], PPRetryPolicyCircuitStateHalfOpen);
+    XCTAssertTrue([policy allowsRequestToHost:@"circuit.test"]);
+    XCTAssertFalse([policy allowsRequestToHost:@"circuit.test"]);
+    
+    [policy recordSuccessForHost:@"circuit.test"];
+    XCTAssertEqual([policy circuitStateForHost:@"circuit.test"], PPRetryPolicyCircuitStateClosed);
+    XCTAssertTrue([policy allowsRequestToHost:@"circuit.test"]);
+    
+    XCTAssertEqual(policy.openedCircuits, 1);
+    XCTAssertEqual(policy.rejectedRequests, 2);
+    XCTAssertEqual(policy.deniedRetries, 1);
+    XCTAssertTrue([events containsObject:@(PPRetryPolicyEventCircuitOpened)]);
+    XCTAssertTrue([events containsObject:@(PPRetryPolicyEventRetryDenied)]);
+    XCTAssertEqualObjects(events.lastObject, @(PPRetryPolicyEventCircuitClosed));
+}
+
+- (void)testRetryPolicyProbeReleased {
+    PPRetryPolicy *policy = [[PPRetryPolicy alloc] init];
+    policy.failureThreshold = 1;
+    policy.openInterval = 0.1;
+    policy.probeInterval = 0.2;
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://probe.test/upload"]];
+    
+    [policy recordFailureForHost:@"probe.test"];
+    [NSThread sleepForTimeInterval:0.2];
+    
+    // A cancelled probe lets the next request probe
+    XCTAssertTrue([policy allowsRequestToHost:@"probe.test"]);
+    XCTAssertFalse([policy allowsRequestToHost:@"probe.test"]);
+    [policy recordRequest:request response:nil error:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+    XCTAssertEqual([policy circuitStateForHost:@"probe.test"], PPRetryPolicyCircuitStateHalfOpen);
+    XCTAssertTrue([policy allowsRequestToHost:@"probe.test"]);
+    
+    // So does a probe that was never sent
+    [policy cancelProbeForHost:@"probe.test"];
+    XCTAssertTrue([policy allowsRequestToHost:@"probe.test"]);
+    
+    // And one that never reports back
+    XCTAssertFalse([policy allowsRequestToHost:@"probe.test"]);
+    [NSThread sleepForTimeInterval:0.3];
+    XCTAssertTrue([policy allowsRequestToHost:@"probe.test"]);
+}
+
+- (void)testRetryPolicyBudget {
+    PPRetryPolicy *policy = [[PPRetryPolicy alloc] init];
+    policy.maximumBudget = 2;
+    policy.budgetRatio = 0.5;
+    
+    XCTAssertNotEqual([policy retryDelayForHost:@"budget.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    XCTAssertNotEqual([policy retryDelayForHost:@"budget.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    XCTAssertEqual([policy retryDelayForHost:@"budget.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    
+    // Two successes earn one retry back
+    [policy recordSuccessForHost:@"budget.test"];
+    [policy recordSuccessForHost:@"budget.test"];
+    XCTAssertNotEqual([policy retryDelayForHost:@"budget.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    XCTAssertEqual([policy retryDelayForHost:@"budget.test" baseDelay:1], RETRY_POLICY_NO_RETRY);
+    XCTAssertEqual(policy.retries, 3);
+    XCTAssertEqual(policy.deniedRetries, 2);
+}
+
+/**
+ * Server errors seen by the HTTP bridge open the circuit, and uploads then fail without reaching the server
+ */
+- (void)testRetryPolicyOpensCircuitForUploads {
+#if !TARGET_OS_WATCH
+    __block NSInteger requests = 0;
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path rangeOfString:@"/cloud/json/files"].location != NSNotFound;
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        @synchronized(self) {
+            requests++;
+        }
+        return [HTTPStubsResponse responseWithData:[NSData data] statusCode:503 headers:nil];
+    }];
+    
+    PPRetryPolicy *policy = [PPRetryPolicy sharedPolicy];
+    NSInteger failureThreshold = policy.failureThreshold;
+    [policy reset];
+    policy.failureThreshold = 1;
+    
+    for(NSInteger i = 0; i < 2; i++) {
+        XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:@"FileUpload"];
+        PPDeviceProxyFileUpload *upload = [[PPDeviceProxyFileUpload alloc] initWithData:[[NSMutableData alloc] initWithLength:64 * 1024] proxyId:@"proxy" authToken:@"_TOKEN_"];
+        upload.fileExtension = @"mp4";
+        upload.contentType = @"video/mp4";
+        upload.type = PPFileFileTypeVideo;
+        upload.attemptLimit = 0;
+        [upload startWithAcknowledgmentBlock:nil callback:^(PPFileId fileId, PPFileFragments totalFragments, PPFileUsedFileSpace usedSpace, PPFileTotalFileSpace totalSpace, PPFileFilesAction action, PPFileThumbnail thumbnail, PPFileTwitterShare twitterShare, NSError *error) {
+            
+            XCTAssertNotNil(error);
+            [expectation fulfill];
+            
+        }];
+        [self waitForExpectations:@[expectation] timeout:10.0];
+    }
+    
+    @synchronized(self) {
+        XCTAssertEqual(requests, 1);
+    }
+    XCTAssertEqual([policy circuitStateForHost:[[PPCloudEngine sharedAppEngine] getBaseURL].host], PPRetryPolicyCircuitStateOpen);
+    
+    [policy reset];
+    policy.failureThreshold = failureThreshold;
+#endif
+}
+
+@end
@@ -0,0 +1,151 @@
+//
+//  PPTCParseBenchmarks.m
+//  Peoplepower-Tests
+//
+//  Copyright © 2023 People Power Company. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import <Peoplepower/PPBaseModel.h>
+#import <Peoplepower/PPCircle.h>
+#import <Peoplepower/PPCommunityPost.h>
+#import <Peoplepower/PPDevice.h>
+#import <Peoplepower/PPDeviceMeasurementsReading.h>
+#import <Peoplepower/PPDeviceType.h>
+#import <Peoplepower/PPFile.h>
+#import <Peoplepower/PPLocationNarrative.h>
+#import <Peoplepower/PPRule.h>
+
+/**
+ * Builds one model object from one element of the response array
+ */
+typedef id (^PPTCParseBenchmarkBlock)(NSDictionary *dictionary);
+
+/**
+ * Number of objects in each synthetic response
+ */
+static NSInteger const kParseBenchmarkObjects = 10000;
+
+/**
+ * Parse throughput of each model class.
+ * The recorded response of an API is scaled up by repeating the elements of its array, then parsed with
+ * processJSONResponse and turned into model objects with initWithDictionary:, the way the SDK callbacks do.
+ * Each test measures clock time, CPU and peak memory with XCTest baselines, and logs objects per second
+ * and the heap blocks and bytes still held by the parsed objects.
+ */
+@interface PPTCParseBenchmarks : XCTestCase
+
+@end
+
+@implementation PPTCParseBenchmarks
+
+#pragma mark - Fixtures
+
+- (NSData *)responseForModule:(NSString *)moduleName methodName:(NSString *)methodName key:(NSString *)key count:(NSInteger)count {
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:[NSString stringWithFormat:@"%@-%@-ResponseData", moduleName, methodName] ofType:@"json"];
+    NSDictionary *fixture = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+    NSArray *elements = [fixture objectForKey:key];
+    XCTAssertGreaterThan(elements.count, 0, @"%@-%@ has no %@", moduleName, methodName, key);
+    if(elements.count == 0) {
+        return nil;
+    }
+    
+    NSMutableArray *scaled = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        [scaled addObject:[elements objectAtIndex:i % elements.count]];
+    }
+    NSMutableDictionary *response = fixture.mutableCopy;
+    [response setObject:scaled forKey:key];
+    return [NSJSONSerialization dataWithJSONObject:response options:0 error:nil];
+}
+
+- (NSArray *)parseResponse:(NSData *)responseData key:(NSString *)key block:(PPTCParseBenchmarkBlock)block {
+    NSError *error;
+    NSDictionary *root = [PPBaseModel processJSONResponse:responseData error:&error];
+    XCTAssertNil(error);
+    NSMutableArray *objects = [[NSMutableArray alloc] initWithCapacity:0];
+    for(NSDictionary *dictionary in [root objectForKey:key]) {
+        id object = block(dictionary);
+        if(object) {
+            [objects addObject:object];
+        }
+    }
+    return objects;
+}
+
+- (void)measureParseOfModule:(NSString *)moduleName methodName:(NSString *)methodName key:(NSString *)key block:(PPTCParseBenchmarkBlock)block {
+    NSData *responseData = [self responseForModule:moduleName methodName:methodName key:key count:kParseBenchmarkObjects];
+    if(!responseData) {
+        return;
+    }
+    
+    // One pass outside of the measurement for throughput and heap use
+    malloc_statistics_t before;
+    malloc_statistics_t after;
+    malloc_zone_statistics(NULL, &before);
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    NSArray *objects = [self parseResponse:responseData key:key block:block];
+    CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - start;
+    malloc_zone_statistics(NULL, &after);
+    
+    XCTAssertEqual(objects.count, kParseBenchmarkObjects);
+    NSLog(@"%s %@ %@: %lu objects from %lu bytes, %.0f objects/s, %.1f MB/s, %ld blocks and %ld bytes held", __PRETTY_FUNCTION__, moduleName, methodName, (unsigned long)objects.count, (unsigned long)responseData.length, objects.count / duration, responseData.length / duration / 1048576.0, (long)after.blocks_in_use - (long)before.blocks_in_use, (long)after.size_in_use - (long)before.size_in_use);
+    objects = nil;
+    
+    [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTCPUMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:^{
+        [self parseResponse:responseData key:key block:block];
+    }];
+}
+
+#pragma mark - Models
+
+- (void)testPerformanceParseDevices {
+    [self measureParseOfModule:@"Devices" methodName:@"GetListOfDevices" key:@"devices" block:^id(NSDictionary *dictionary) {
+        return [PPDevice initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseMeasurementsReadings {
+    [self measureParseOfModule:@"DeviceMeasurements" methodName:@"GetHistoryOfMeasurements" key:@"readings" block:^id(NSDictionary *dictionary) {
+        return [PPDeviceMeasurementsReading initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseFiles {
+    [self measureParseOfModule:@"FilesManagement" methodName:@"GetFiles" key:@"files" block:^id(NSDictionary *dictionary) {
+        return [PPFile initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseRules {
+    [self measureParseOfModule:@"Rules" methodName:@"GetRules" key:@"rules" block:^id(NSDictionary *dictionary) {
+        return [PPRule initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseDeviceTypes {
+    [self measureParseOfModule:@"Products" methodName:@"GetSupportedProducts" key:@"deviceTypes" block:^id(NSDictionary *dictionary) {
+        return [PPDeviceType initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseCommunityPosts {
+    [self measureParseOfModule:@"Community" methodName:@"GetPosts" key:@"posts" block:^id(NSDictionary *dictionary) {
+        return [PPCommunityPost initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseNarratives {
+    [self measureParseOfModule:@"UserAccounts" methodName:@"GetNarratives" key:@"narratives" block:^id(NSDictionary *dictionary) {
+        return [PPLocationNarrative initWithDictionary:dictionary];
+    }];
+}
+
+- (void)testPerformanceParseCircles {
+    [self measureParseOfModule:@"Circles" methodName:@"GetCircles" key:@"circles" block:^id(NSDictionary *dictionary) {
+        return [PPCircle initWithDictionary:dictionary];
+    }];
+}
+
+@end
@@ -8,6 +8,12 @@
 
 #import "PPBaseTestCase.h"
 #import <Peoplepower/PPDeviceTypes.h>
+#import <Peoplepower/PPCloudEngine.h>
+#import <Peoplepower/PPHTTPCache.h>
+#import <Peoplepower/PPHTTPMetrics.h>
+#if !TARGET_OS_WATCH
+#import <OHHTTPStubs/OHHTTPStubs.h>
+#endif
 
 static NSString *moduleName = @"Products";
 
@@ -91,6 +97,145 @@ static NSString *moduleName = @"Products";
     
 }
 
+/**
+ * Get supported products twice with the conditional request cache enabled.
+ * The second request is revalidated with If-None-Match and answered from the cache.
+ **/
+- (void)testGetSupportedProductsNotModified {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetSupportedProducts";
+    
+    PPHTTPCache *cache = [PPHTTPCache sharedCache];
+    [cache removeAllCachedResponses];
+    [cache resetStatistics];
+    [PPCloudEngine setHTTPCacheEnabled:YES];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/deviceTypes" statusCode:200 headers:@{@"ETag": @"\"v1\"", @"Content-Type": @"application/json"}];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    __block NSArray *fullDeviceTypes;
+    [PPDeviceTypes getSupportedProducts:PPDeviceTypeIdNone attrName:nil attrValue:nil own:PPDeviceTypesOwnNone simple:PPDeviceTypesSimpleNone organizationId:PPOrganizationIdNone callback:^(NSArray *deviceTypes, NSError *error) {
+        XCTAssertNil(error);
+        fullDeviceTypes = deviceTypes;
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    XCTAssertEqual(cache.misses, 1);
+    XCTAssertEqual(cache.hits, 0);
+    
+    // Stubs added later take precedence
+    __block NSString *ifNoneMatch;
+    [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path hasSuffix:@"/cloud/json/deviceTypes"];
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        ifNoneMatch = [request valueForHTTPHeaderField:@"If-None-Match"];
+        return [HTTPStubsResponse responseWithData:[NSData data] statusCode:304 headers:@{@"ETag": @"\"v1\""}];
+    }];
+    
+    expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    [PPDeviceTypes getSupportedProducts:PPDeviceTypeIdNone attrName:nil attrValue:nil own:PPDeviceTypesOwnNone simple:PPDeviceTypesSimpleNone organizationId:PPOrganizationIdNone callback:^(NSArray *deviceTypes, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(deviceTypes.count, fullDeviceTypes.count);
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    
+    XCTAssertEqualObjects(ifNoneMatch, @"\"v1\"");
+    XCTAssertEqual(cache.hits, 1);
+    XCTAssertGreaterThan(cache.bytesSaved, 0);
+    XCTAssertEqualWithAccuracy(cache.hitRate, 0.5, 0.001);
+    
+    [PPCloudEngine setHTTPCacheEnabled:NO];
+    [cache removeAllCachedResponses];
+#endif
+}
+
+/**
+ * A 304 for a body that is no longer in the cache is followed by a request without validators.
+ **/
+- (void)testGetSupportedProductsNotModifiedEvicted {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetSupportedProducts";
+    
+    PPHTTPCache *cache = [PPHTTPCache sharedCache];
+    [cache removeAllCachedResponses];
+    [PPCloudEngine setHTTPCacheEnabled:YES];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/deviceTypes" statusCode:200 headers:@{@"ETag": @"\"v1\"", @"Content-Type": @"application/json"}];
+    
+    // The first answer is a 304 the cache has no body for
+    __block BOOL notModifiedSent = NO;
+    id<HTTPStubsDescriptor> notModifiedStub = [HTTPStubs stubRequestsPassingTest:^BOOL(NSURLRequest * _Nonnull request) {
+        return [request.URL.path hasSuffix:@"/cloud/json/deviceTypes"] && !notModifiedSent;
+    } withStubResponse:^HTTPStubsResponse * _Nonnull(NSURLRequest * _Nonnull request) {
+        notModifiedSent = YES;
+        return [HTTPStubsResponse responseWithData:[NSData data] statusCode:304 headers:@{@"ETag": @"\"v1\""}];
+    }];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    [PPDeviceTypes getSupportedProducts:PPDeviceTypeIdNone attrName:nil attrValue:nil own:PPDeviceTypesOwnNone simple:PPDeviceTypesSimpleNone organizationId:PPOrganizationIdNone callback:^(NSArray *deviceTypes, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertGreaterThan(deviceTypes.count, 0);
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    XCTAssertTrue(notModifiedSent);
+    
+    [HTTPStubs removeStub:notModifiedStub];
+    [PPCloudEngine setHTTPCacheEnabled:NO];
+    [cache removeAllCachedResponses];
+#endif
+}
+
+/**
+ * Get supported products with request metrics enabled.
+ * The request is recorded under its route with its status code, timings and parse time.
+ **/
+- (void)testGetSupportedProductsMetrics {
+#if !TARGET_OS_WATCH
+    NSString *methodName = @"GetSupportedProducts";
+    
+    PPHTTPMetrics *metrics = [PPHTTPMetrics sharedMetrics];
+    [metrics reset];
+    [PPCloudEngine setHTTPMetricsEnabled:YES];
+    
+    [self stubRequestForModule:moduleName methodName:methodName ofType:@"json" path:@"/cloud/json/deviceTypes" statusCode:200 headers:nil];
+    
+    XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:methodName];
+    [PPDeviceTypes getSupportedProducts:PPDeviceTypeIdNone attrName:nil attrValue:nil own:PPDeviceTypesOwnNone simple:PPDeviceTypesSimpleNone organizationId:PPOrganizationIdNone callback:^(NSArray *deviceTypes, NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectations:@[expectation] timeout:10.0];
+    [PPCloudEngine setHTTPMetricsEnabled:NO];
+    
+    NSDictionary *snapshot = [metrics snapshot];
+    NSDictionary *route;
+    for(NSDictionary *entry in [snapshot objectForKey:@"routes"]) {
+        if([[entry objectForKey:@"route"] isEqualToString:@"deviceTypes"]) {
+            route = entry;
+        }
+    }
+    XCTAssertNotNil(route);
+    XCTAssertEqualObjects([route objectForKey:@"method"], @"GET");
+    XCTAssertEqual([[route objectForKey:@"requests"] integerValue], 1);
+    XCTAssertEqual([[[route objectForKey:@"statusCodes"] objectForKey:@"200"] integerValue], 1);
+    XCTAssertEqual([[[route objectForKey:@"total"] objectForKey:@"count"] integerValue], 1);
+    XCTAssertEqual([[[route objectForKey:@"callbackLag"] objectForKey:@"count"] integerValue], 1);
+    XCTAssertGreaterThan([[snapshot objectForKey:@"parse"] count], 0);
+    XCTAssertNotNil([metrics exportJSON]);
+    
+    [metrics reset];
+    XCTAssertEqual([[[metrics snapshot] objectForKey:@"routes"] count], 0);
+#endif
+}
+
+- (void)testHTTPMetricsRouteTemplate {
+    XCTAssertEqualObjects([PPHTTPMetrics routeTemplateForPath:@"devices/ABC123/parameters"], @"devices/{id}/parameters");
+    XCTAssertEqualObjects([PPHTTPMetrics routeTemplateForPath:@"/deviceTypes"], @"deviceTypes");
+    XCTAssertEqualObjects([PPHTTPMetrics routeTemplateForPath:@"locations/1234/users/user@example.com"], @"locations/{id}/users/{id}");
+}
+
 #pragma mark - Supported Product Attribtues
 
 /**
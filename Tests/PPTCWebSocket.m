@@ -0,0 +1,315 @@
+//
+//  PPTCWebSocket.m
+//  iOS_Core_Tests
+//
+//  Copyright © 2023 People Power Company. All rights reserved.
+//
+
+#import "PPBaseTestCase.h"
+#import <XCTest/XCTest.h>
+#import <Peoplepower/PPWebSocket.h>
+
+/**
+ * Records the subscriptions the socket sends
+ */
+@interface PPTCRecordingWebSocket : PPWebSocket
+@property (nonatomic, strong) NSMutableArray *sentSubscriptions;
+@end
+
+@interface PPWebSocket (PPTCWebSocket)
+- (void)sendSubscription:(NSDictionary *)subscription uuid:(NSString * _Nullable __autoreleasing *)uuid;
+@end
+
+@implementation PPTCRecordingWebSocket
+
+- (void)sendSubscription:(NSDictionary *)subscription uuid:(NSString * _Nullable __autoreleasing *)uuid {
+    if(!_sentSubscriptions) {
+        _sentSubscriptions = [[NSMutableArray alloc] initWithCapacity:0];
+    }
+    [_sentSubscriptions addObject:subscription];
+    [super sendSubscription:subscription uuid:uuid];
+}
+
+@end
+
+@interface PPTCWebSocket : PPBaseTestCase <PPWebSocketDelegate>
+
+@property (nonatomic, strong) XCTestExpectation *webSocketBrokenExpectation;
+@property (nonatomic) NSInteger webSocketBrokenCode;
+
+@end
+
+@implementation PPTCWebSocket
+
+- (void)setUp {
+    [super setUp];
+}
+
+- (void)tearDown {
+    [super tearDown];
+}
+
+#pragma mark - WebSocket message pipeline
+
+- (PPWebSocket *)pipelineWebSocket {
+    return [[PPWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:nil delegate:nil];
+}
+
+/**
+ * Data event as the server sends it for a subscription
+ */
+- (NSString *)webSocketMessageWithType:(PPWebSocketType)type narrativeId:(NSInteger)narrativeId sequence:(NSInteger)sequence {
+    return [NSString stringWithFormat:@"{\"id\":\"%ld\",\"goal\":%ld,\"subscription\":{\"type\":%ld},\"data\":{\"id\":%ld,\"title\":\"Narrative\"}}", (long)sequence, (long)PPWebSocketGoalData, (long)type, (long)narrativeId];
+}
+
+- (void)testWebSocketPipelineRoutesByGoalAndType {
+    PPWebSocket *socket = [self pipelineWebSocket];
+    
+    XCTestExpectation *narrativesExpectation = [[XCTestExpectation alloc] initWithDescription:@"narratives"];
+    XCTestExpectation *organizationExpectation = [[XCTestExpectation alloc] initWithDescription:@"organizationNarratives"];
+    NSMutableArray *narratives = [[NSMutableArray alloc] initWithCapacity:0];
+    NSMutableArray *organizationNarratives = [[NSMutableArray alloc] initWithCapacity:0];
+    
+    [socket addHandlerForGoal:PPWebSocketGoalData type:PPWebSocketTypeNarratives queue:nil coalescingKeyBlock:nil block:^(NSArray<NSDictionary *> *messages) {
+        XCTAssertTrue([NSThread isMainThread]);
+        [narratives addObjectsFromArray:messages];
+        if(narratives.count == 3) {
+            [narrativesExpectation fulfill];
+        }
+    }];
+    [socket addHandlerForGoal:PPWebSocketGoalData type:PPWebSocketTypeOrganizationNarratives queue:nil coalescingKeyBlock:nil block:^(NSArray<NSDictionary *> *messages) {
+        [organizationNarratives addObjectsFromArray:messages];
+        if(organizationNarratives.count == 2) {
+            [organizationExpectation fulfill];
+        }
+    }];
+    
+    for(NSInteger i = 0; i < 3; i++) {
+        [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeNarratives narrativeId:i sequence:i]];
+        if(i < 2) {
+            [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeOrganizationNarratives narrativeId:i sequence:i]];
+        }
+    }
+    // Not claimed by any handler
+    [socket webSocket:socket.webSocket didReceiveMessage:@"{\"id\":\"status\",\"goal\":5}"];
+    [socket webSocket:socket.webSocket didReceiveMessage:@"?"];
+    
+    [self waitForExpectations:@[narrativesExpectation, organizationExpectation] timeout:5.0];
+    
+    XCTAssertEqual([[[[narratives lastObject] objectForKey:@"data"] objectForKey:@"id"] integerValue], 2);
+    XCTAssertEqual(socket.decodedMessages, 6);
+    XCTAssertEqual(socket.deliveredMessages, 5);
+    XCTAssertEqual(socket.droppedMessages, 0);
+    
+    [socket resetStatistics];
+    XCTAssertEqual(socket.decodedMessages, 0);
+    XCTAssertEqual(socket.deliveredMessages, 0);
+}
+
+/**
+ * While a handler is busy, newer messages replace waiting ones with the same key and the oldest are dropped beyond the limit
+ */
+- (void)testWebSocketPipelineCoalescesWhileHandlerIsBusy {
+    PPWebSocket *socket = [self pipelineWebSocket];
+    socket.batchInterval = 0;
+    socket.maximumPendingMessages = 4;
+    
+    dispatch_semaphore_t busy = dispatch_semaphore_create(0);
+    XCTestExpectation *firstBatchExpectation = [[XCTestExpectation alloc] initWithDescription:@"firstBatch"];
+    XCTestExpectation *secondBatchExpectation = [[XCTestExpectation alloc] initWithDescription:@"secondBatch"];
+    NSMutableArray *batches = [[NSMutableArray alloc] initWithCapacity:0];
+    
+    dispatch_queue_t queue = dispatch_queue_create("PPTCWebSocket.pipeline", DISPATCH_QUEUE_SERIAL);
+    [socket addHandlerForGoal:PPWebSocketGoalData type:PPWebSocketTypeAny queue:queue coalescingKeyBlock:^id(NSDictionary *message) {
+        return [[message objectForKey:@"data"] objectForKey:@"id"];
+    } block:^(NSArray<NSDictionary *> *messages) {
+        [batches addObject:messages];
+        if(batches.count == 1) {
+            [firstBatchExpectation fulfill];
+            dispatch_semaphore_wait(busy, DISPATCH_TIME_FOREVER);
+        }
+        else {
+            [secondBatchExpectation fulfill];
+        }
+    }];
+    
+    [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeNarratives narrativeId:100 sequence:0]];
+    [self waitForExpectations:@[firstBatchExpectation] timeout:5.0];
+    
+    // Narratives 0, 1 and 2 twice, then 3 and 4
+    NSInteger sequence = 1;
+    for(NSInteger round = 0; round < 2; round++) {
+        for(NSInteger narrativeId = 0; narrativeId < 3; narrativeId++) {
+            [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeNarratives narrativeId:narrativeId sequence:sequence++]];
+        }
+    }
+    [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeNarratives narrativeId:3 sequence:sequence++]];
+    [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeNarratives narrativeId:4 sequence:sequence++]];
+    
+    // Let the pipeline queue catch up before the handler is free again
+    [NSThread sleepForTimeInterval:0.5];
+    dispatch_semaphore_signal(busy);
+    [self waitForExpectations:@[secondBatchExpectation] timeout:5.0];
+    
+    NSArray *secondBatch = [batches objectAtIndex:1];
+    XCTAssertEqual(secondBatch.count, 4);
+    XCTAssertEqual([[[[secondBatch firstObject] objectForKey:@"data"] objectForKey:@"id"] integerValue], 1);
+    XCTAssertEqualObjects([[secondBatch firstObject] objectForKey:@"id"], @"5");
+    XCTAssertEqual([[[[secondBatch lastObject] objectForKey:@"data"] objectForKey:@"id"] integerValue], 4);
+    XCTAssertEqual(socket.coalescedMessages, 3);
+    XCTAssertEqual(socket.droppedMessages, 1);
+}
+
+- (void)testPerformanceWebSocketPipeline {
+    PPWebSocket *socket = [self pipelineWebSocket];
+    NSInteger count = 1000;
+    NSMutableArray *messages = [[NSMutableArray alloc] initWithCapacity:count];
+    for(NSInteger i = 0; i < count; i++) {
+        [messages addObject:[self webSocketMessageWithType:PPWebSocketTypeOrganizationNarratives narrativeId:i sequence:i]];
+    }
+    
+    __block NSInteger delivered = 0;
+    __block NSInteger batches = 0;
+    __block XCTestExpectation *expectation;
+    [socket addHandlerForGoal:PPWebSocketGoalData type:PPWebSocketTypeOrganizationNarratives queue:nil coalescingKeyBlock:nil block:^(NSArray<NSDictionary *> *messages) {
+        delivered += messages.count;
+        batches++;
+        if(delivered == count) {
+            [expectation fulfill];
+        }
+    }];
+    
+    [self measureBlock:^{
+        delivered = 0;
+        expectation = [[XCTestExpectation alloc] initWithDescription:@"pipeline"];
+        for(NSString *message in messages) {
+            [socket webSocket:socket.webSocket didReceiveMessage:message];
+        }
+        [self waitForExpectations:@[expectation] timeout:10.0];
+    }];
+    NSLog(@"%s main thread batches=%ld", __PRETTY_FUNCTION__, (long)batches);
+}
+
+#pragma mark - WebSocket reconnect
+
+- (void)testWebSocketKeepsSubscriptions {
+    PPWebSocket *socket = [[PPWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:@"session" delegate:self];
+    socket.autoReconnect = YES;
+    
+    NSDictionary *narratives = @{@"type": @(PPWebSocketTypeNarratives)};
+    NSDictionary *organizationNarratives = @{@"type": @(PPWebSocketTypeOrganizationNarratives)};
+    [socket subscribe:narratives];
+    [socket subscribe:organizationNarratives];
+    [socket subscribe:narratives];
+    XCTAssertEqual(socket.subscriptions.count, 2);
+    
+    [socket unsubscribe:PPWebSocketTypeNarratives];
+    XCTAssertEqualObjects(socket.subscriptions, @[organizationNarratives]);
+    
+    // Data events are decoded off the main thread and remembered to resume from
+    [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeOrganizationNarratives narrativeId:1 sequence:41]];
+    [socket webSocket:socket.webSocket didReceiveMessage:[self webSocketMessageWithType:PPWebSocketTypeOrganizationNarratives narrativeId:2 sequence:42]];
+    XCTNSPredicateExpectation *expectation = [[XCTNSPredicateExpectation alloc] initWithPredicate:[NSPredicate predicateWithFormat:@"lastEventId == '42'"] object:socket];
+    [self waitForExpectations:@[expectation] timeout:5.0];
+}
+
+/**
+ * A connection that keeps failing is retried with growing delays, without telling the delegate it broke
+ */
+- (void)testWebSocketReconnectsWithBackoff {
+    PPWebSocket *socket = [[PPWebSocket alloc] initWithURL:@"ws://127.0.0.1:1" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:@"session" delegate:self];
+    socket.autoReconnect = YES;
+    socket.reconnectBaseDelay = 0.1;
+    _webSocketBrokenExpectation = [[XCTestExpectation alloc] initWithDescription:@"websocketBroken"];
+    _webSocketBrokenExpectation.inverted = YES;
+    
+    [socket connect];
+    XCTNSPredicateExpectation *expectation = [[XCTNSPredicateExpectation alloc] initWithPredicate:[NSPredicate predicateWithFormat:@"reconnects >= 3"] object:socket];
+    [self waitForExpectations:@[expectation, _webSocketBrokenExpectation] timeout:5.0];
+    
+    // Disconnecting stops the reconnects
+    [socket disconnect];
+    NSUInteger reconnects = socket.reconnects;
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+    XCTAssertEqual(socket.reconnects, reconnects);
+}
+
+/**
+ * Endpoints without a session answer send their subscriptions as soon as the connection opens, after every reconnect
+ */
+- (void)testWebSocketResubscribesWithoutSessionAnswer {
+    NSDictionary *narratives = @{@"type": @(PPWebSocketTypeNarratives)};
+    NSArray *sockets = @[[[PPTCRecordingWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointViewer sessionId:@"session" delegate:self],
+                         [[PPTCRecordingWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointCamera sessionId:@"session" delegate:self],
+                         [[PPTCRecordingWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:nil delegate:self]];
+    for(PPTCRecordingWebSocket *socket in sockets) {
+        socket.autoReconnect = YES;
+        socket.reconnectBaseDelay = 60;
+        [socket subscribe:narratives];
+        XCTAssertEqual(socket.sentSubscriptions.count, 1);
+        
+        // The connection broke and came back
+        [socket webSocket:socket.webSocket didFailWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]];
+        XCTAssertGreaterThan([[socket valueForKey:@"reconnectDelay"] doubleValue], 0);
+        [socket webSocketDidOpen:socket.webSocket];
+        XCTAssertEqual(socket.sentSubscriptions.count, 2);
+        XCTAssertEqual([[socket valueForKey:@"reconnectDelay"] doubleValue], 0);
+        [socket disconnect];
+    }
+}
+
+/**
+ * With a session, subscriptions wait for the server to accept it
+ */
+- (void)testWebSocketResubscribesAfterSessionAnswer {
+    PPTCRecordingWebSocket *socket = [[PPTCRecordingWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:@"session" delegate:self];
+    socket.autoReconnect = YES;
+    [socket subscribe:@{@"type": @(PPWebSocketTypeNarratives)}];
+    XCTAssertEqual(socket.sentSubscriptions.count, 0);
+    
+    NSString *uuid;
+    [socket declareConnected:&uuid];
+    [socket webSocket:socket.webSocket didReceiveMessage:[NSString stringWithFormat:@"{\"id\":\"%@\",\"goal\":%ld,\"resultCode\":0}", uuid, (long)PPWebSocketGoalAuth]];
+    XCTNSPredicateExpectation *expectation = [[XCTNSPredicateExpectation alloc] initWithPredicate:[NSPredicate predicateWithFormat:@"sentSubscriptions.@count == 1"] object:socket];
+    [self waitForExpectations:@[expectation] timeout:5.0];
+    [socket disconnect];
+}
+
+/**
+ * Reconnecting can't help once the server refuses the session
+ */
+- (void)testWebSocketRefusedSessionBreaks {
+    PPWebSocket *socket = [[PPWebSocket alloc] initWithURL:@"wss://localhost" resourceEndpoint:PPWebSocketResourceEndpointDefault sessionId:@"session" delegate:self];
+    socket.autoReconnect = YES;
+    _webSocketBrokenExpectation = [[XCTestExpectation alloc] initWithDescription:@"websocketBroken"];
+    
+    NSString *uuid;
+    [socket declareConnected:&uuid];
+    [socket webSocket:socket.webSocket didReceiveMessage:[NSString stringWithFormat:@"{\"id\":\"%@\",\"goal\":%ld,\"resultCode\":%ld}", uuid, (long)PPWebSocketGoalAuth, (long)PPWebSocketErrorCodeWrongSessionID]];
+    [self waitForExpectations:@[_webSocketBrokenExpectation] timeout:5.0];
+    
+    XCTAssertEqual(_webSocketBrokenCode, PPWebSocketErrorCodeWrongSessionID);
+}
+
+#pragma mark - PPWebSocketDelegate
+
+- (void)websocketDidConnect:(SRWebSocket *)session {
+    NSLog(@"%s", __PRETTY_FUNCTION__);
+}
+
+- (void)websocketBroken {
+    NSLog(@"%s", __PRETTY_FUNCTION__);
+}
+
+- (void)websocketBroken:(NSInteger)code reason:(NSString *)reason {
+    NSLog(@"%s code=%li reason=%@", __PRETTY_FUNCTION__, (long)code, reason);
+    _webSocketBrokenCode = code;
+    [_webSocketBrokenExpectation fulfill];
+}
+
+- (void)websocket:(SRWebSocket *)webSocket didReceiveMessage:(id)message {
+    NSLog(@"%s message=%@", __PRETTY_FUNCTION__, message);
+}
+
+
+@end